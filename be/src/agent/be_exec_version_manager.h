@@ -58,8 +58,9 @@ private:
  *    c. change the string hash method in runtime filter
  *    d. elt funciton return type change to nullable(string)
  *    e. add repeat_max_num in repeat function
+ * 3: a. strings in serialized blocks are dictionary encoded when they have few distinct values
 */
-inline const int BeExecVersionManager::max_be_exec_version = 2;
+inline const int BeExecVersionManager::max_be_exec_version = 3;
 inline const int BeExecVersionManager::min_be_exec_version = 0;
 
 } // namespace doris
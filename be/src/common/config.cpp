@@ -111,6 +111,10 @@ DEFINE_mInt32(double_resize_threshold, "23");
 // There are many duplicate keys, and the hash table filled bucket is far less than the hash table build bucket.
 DEFINE_mInt64(hash_table_pre_expanse_max_rows, "65535");
 
+// When `enable_join_spill` is set, hash join starts to spill its build side into disk
+// once the query memory consumption exceeds this percent of the query memory limit.
+DEFINE_mInt32(hash_join_spill_mem_limit_percent, "80");
+
 // The maximum low water mark of the system `/proc/meminfo/MemAvailable`, Unit byte, default 1.6G,
 // actual low water mark=min(1.6G, MemTotal * 10%), avoid wasting too much memory on machines
 // with large memory larger than 16G.
@@ -157,6 +161,10 @@ DEFINE_Int32(tablet_publish_txn_max_thread, "32");
 DEFINE_Int32(publish_version_task_timeout_s, "8");
 // the count of thread to calc delete bitmap
 DEFINE_Int32(calc_delete_bitmap_max_thread, "32");
+DEFINE_mBool(enable_async_calc_delete_bitmap_on_flush, "false");
+DEFINE_mBool(enable_tablet_primary_key_filter, "false");
+DEFINE_mInt32(tablet_primary_key_filter_rebuild_percent, "20");
+DEFINE_Int32(primary_key_filter_thread_num, "1");
 // the count of thread to clear transaction task
 DEFINE_Int32(clear_transaction_task_worker_count, "1");
 // the count of thread to delete
@@ -260,6 +268,7 @@ DEFINE_mInt32(max_pushdown_conditions_per_column, "1024");
 DEFINE_mInt32(doris_max_pushdown_conjuncts_return_rate, "90");
 // (Advanced) Maximum size of per-query receive-side buffer
 DEFINE_mInt32(exchg_node_buffer_size_bytes, "20485760");
+DEFINE_mBool(enable_block_string_dict_encoding, "false");
 
 DEFINE_mInt64(column_dictionary_key_ratio_threshold, "0");
 DEFINE_mInt64(column_dictionary_key_size_threshold, "0");
@@ -314,6 +323,10 @@ DEFINE_Bool(disable_storage_page_cache, "false");
 DEFINE_Bool(disable_storage_row_cache, "true");
 // whether to disable pk page cache feature in storage
 DEFINE_Bool(disable_pk_storage_page_cache, "false");
+DEFINE_mBool(enable_segment_page_prefetch, "false");
+DEFINE_mInt32(segment_prefetch_window_rows, "16384");
+DEFINE_mInt64(segment_prefetch_merge_gap_bytes, "65536");
+DEFINE_mInt64(segment_prefetch_max_read_bytes, "8388608");
 
 // Cache for mow primary key storage page size
 DEFINE_String(pk_storage_page_cache_limit, "10%");
@@ -323,6 +336,9 @@ DEFINE_Int32(primary_key_data_page_size, "32768");
 DEFINE_mInt32(data_page_cache_stale_sweep_time_sec, "300");
 DEFINE_mInt32(index_page_cache_stale_sweep_time_sec, "600");
 DEFINE_mInt32(pk_index_page_cache_stale_sweep_time_sec, "600");
+DEFINE_mBool(enable_page_cache_admission, "false");
+DEFINE_mInt32(page_cache_admission_min_frequency, "2");
+DEFINE_mInt64(page_cache_large_scan_rows, "50000000");
 
 DEFINE_Bool(enable_low_cardinality_optimize, "true");
 DEFINE_Bool(enable_low_cardinality_cache_code, "true");
@@ -336,12 +352,20 @@ DEFINE_mBool(disable_auto_compaction, "false");
 DEFINE_mBool(enable_vertical_compaction, "true");
 // whether enable ordered data compaction
 DEFINE_mBool(enable_ordered_data_compaction, "true");
+// whether copy the data pages of value columns in compaction of rowsets with ordered data
+DEFINE_mBool(enable_page_copy_compaction, "false");
 // In vertical compaction, column number for every group
 DEFINE_mInt32(vertical_compaction_num_columns_per_group, "5");
 // In vertical compaction, max memory usage for row_source_buffer
 DEFINE_Int32(vertical_compaction_max_row_source_memory_mb, "200");
 // In vertical compaction, max dest segment file size
 DEFINE_mInt64(vertical_compaction_max_segment_size, "268435456");
+// In vertical compaction, max threads to compact the value column groups of one
+// compaction in parallel, 0 means compact them one by one.
+DEFINE_Int32(vertical_compaction_parallel_group_threads, "0");
+// In vertical compaction, max memory of the value column groups compacted in parallel,
+// fewer helper threads are used if the groups are estimated to hold more.
+DEFINE_mInt64(vertical_compaction_parallel_group_max_memory_mb, "1024");
 
 // In ordered data compaction, min segment size for input rowset
 DEFINE_mInt32(ordered_data_compaction_min_segment_size, "10485760");
@@ -403,6 +427,14 @@ DEFINE_Validator(compaction_task_num_per_fast_disk,
 // How many rounds of cumulative compaction for each round of base compaction when compaction tasks generation.
 DEFINE_mInt32(cumulative_compaction_rounds_for_each_base_compaction_round, "9");
 
+// When picking the tablet to compact, the compaction score of a tablet is multiplied by
+// 1 + weight * log2(1 + read heat), at most 2, where the read heat is the segments opened and
+// the rowsets merged by recent query scans on the tablet. Tablets close to
+// max_tablet_version_num are still picked first. 0 means pick by compaction score only.
+DEFINE_mDouble(compaction_read_heat_weight, "0");
+// The read heat of a tablet is decayed by half in this period.
+DEFINE_mInt64(compaction_read_heat_half_life_sec, "600");
+
 // Threshold to logging compaction trace, in seconds.
 DEFINE_mInt32(base_compaction_trace_threshold, "60");
 DEFINE_mInt32(cumulative_compaction_trace_threshold, "10");
@@ -472,6 +504,7 @@ DEFINE_mInt32(streaming_load_rpc_max_alive_time_sec, "1200");
 DEFINE_Int32(tablet_writer_open_rpc_timeout_sec, "60");
 // You can ignore brpc error '[E1011]The server is overcrowded' when writing data.
 DEFINE_mBool(tablet_writer_ignore_eovercrowded, "true");
+DEFINE_mBool(enable_local_tablet_writer_add_block, "false");
 DEFINE_mBool(exchange_sink_ignore_eovercrowded, "true");
 DEFINE_mInt32(slave_replica_writer_rpc_timeout_sec, "60");
 // Whether to enable stream load record function, the default is false.
@@ -557,6 +590,8 @@ DEFINE_Int32(memory_max_alignment, "16");
 DEFINE_mInt64(write_buffer_size, "209715200");
 // max buffer size used in memtable for the aggregated table, default 400MB
 DEFINE_mInt64(write_buffer_size_for_agg, "419430400");
+DEFINE_mBool(enable_memtable_normalized_key_sort, "false");
+DEFINE_mBool(enable_memtable_hash_aggregation, "false");
 
 DEFINE_Int32(load_process_max_memory_limit_percent, "50"); // 50%
 
@@ -632,6 +667,9 @@ DEFINE_mInt64(storage_flood_stage_left_capacity_bytes, "1073741824"); // 1GB
 DEFINE_Int32(flush_thread_num_per_store, "6");
 // number of thread for flushing memtable per store, for high priority load task
 DEFINE_Int32(high_priority_flush_thread_num_per_store, "6");
+DEFINE_Int32(flush_split_thread_num_per_store, "0");
+DEFINE_mInt64(memtable_flush_split_min_rows, "0");
+DEFINE_mInt32(memtable_flush_split_max_num, "4");
 
 // config for tablet meta checkpoint
 DEFINE_mInt32(tablet_meta_checkpoint_min_new_rowsets_num, "10");
@@ -734,6 +772,10 @@ DEFINE_Validator(max_send_batch_parallelism_per_job,
 DEFINE_Int32(send_batch_thread_pool_thread_num, "64");
 // number of send batch thread pool queue size
 DEFINE_Int32(send_batch_thread_pool_queue_size, "102400");
+// number of spill io threads of each data dir, spill io of pipeline operators runs in them
+DEFINE_Int32(spill_io_thread_num_per_data_dir, "4");
+// queue size of the spill io thread pool of each data dir
+DEFINE_Int32(spill_io_thread_pool_queue_size, "102400");
 // number of download cache thread pool size
 DEFINE_Int32(download_cache_thread_pool_thread_num, "48");
 // number of download cache thread pool queue size
@@ -857,6 +899,9 @@ DEFINE_mInt64(small_column_size_buffer, "100");
 // When the rows number reached this limit, will check the filter rate the of bloomfilter
 // if it is lower than a specific threshold, the predicate will be disabled.
 DEFINE_mInt32(bloom_filter_predicate_check_row_num, "204800");
+// The threshold of the filter rate above, a runtime filter which filters out a lower rate
+// of the checked rows will be disabled.
+DEFINE_mDouble(runtime_filter_min_filter_rate, "0.4");
 
 // cooldown task configs
 DEFINE_Int32(cooldown_thread_num, "5");
@@ -936,6 +981,18 @@ DEFINE_Bool(enable_java_support, "true");
 DEFINE_Bool(enable_fuzzy_mode, "false");
 
 DEFINE_Int32(pipeline_executor_size, "0");
+// Bind the pipeline workers to NUMA nodes, keep the tasks of a fragment instance on one node and
+// steal tasks from the workers of the same node first.
+DEFINE_Bool(enable_pipeline_numa_aware_scheduling, "false");
+// Blocked pipeline tasks that wait for a state without notification, e.g. pending finish, are
+// polled at this interval.
+DEFINE_mInt32(pipeline_blocked_task_check_interval_ms, "1");
+// Park blocked pipeline tasks on the dependencies they wait for, and check them again only when
+// the dependencies notify. Otherwise all blocked tasks are polled every
+// pipeline_blocked_task_check_interval_ms.
+DEFINE_mBool(enable_pipeline_task_parking, "false");
+// Parked pipeline tasks are also checked at this interval for timeouts and cancellation.
+DEFINE_mInt32(pipeline_parked_task_check_interval_ms, "10");
 DEFINE_Bool(enable_workload_group_for_scan, "false");
 
 // Temp config. True to use optimization for bitmap_index apply predicate except leaf node of the and node.
@@ -148,6 +148,10 @@ DECLARE_mInt32(double_resize_threshold);
 // There are many duplicate keys, and the hash table filled bucket is far less than the hash table build bucket.
 DECLARE_mInt64(hash_table_pre_expanse_max_rows);
 
+// When `enable_join_spill` is set, hash join starts to spill its build side into disk
+// once the query memory consumption exceeds this percent of the query memory limit.
+DECLARE_mInt32(hash_join_spill_mem_limit_percent);
+
 // The maximum low water mark of the system `/proc/meminfo/MemAvailable`, Unit byte, default 1.6G,
 // actual low water mark=min(1.6G, MemTotal * 10%), avoid wasting too much memory on machines
 // with large memory larger than 16G.
@@ -200,6 +204,17 @@ DECLARE_Int32(tablet_publish_txn_max_thread);
 DECLARE_Int32(publish_version_task_timeout_s);
 // the count of thread to calc delete bitmap
 DECLARE_Int32(calc_delete_bitmap_max_thread);
+// Whether to calculate the delete bitmap of a segment flushed by merge-on-write load in
+// background, instead of in the memtable flush thread.
+DECLARE_mBool(enable_async_calc_delete_bitmap_on_flush);
+// Whether to keep an in-memory filter over the primary keys of all rowsets of a merge-on-write
+// tablet, rebuilt after compaction, so that a key lookup probes only the segment holding the key.
+DECLARE_mBool(enable_tablet_primary_key_filter);
+// The primary key filter is rebuilt after base compaction, and after other compactions only if
+// the rows loaded since it was built reach this percent of its keys.
+DECLARE_mInt32(tablet_primary_key_filter_rebuild_percent);
+// the count of thread to rebuild the primary key filters of tablets
+DECLARE_Int32(primary_key_filter_thread_num);
 // the count of thread to clear transaction task
 DECLARE_Int32(clear_transaction_task_worker_count);
 // the count of thread to delete
@@ -305,6 +320,9 @@ DECLARE_mInt32(max_pushdown_conditions_per_column);
 DECLARE_mInt32(doris_max_pushdown_conjuncts_return_rate);
 // (Advanced) Maximum size of per-query receive-side buffer
 DECLARE_mInt32(exchg_node_buffer_size_bytes);
+// Whether the string columns of few distinct values are dictionary encoded when blocks are
+// serialized, e.g. to be sent by exchange. Only used since be_exec_version 3.
+DECLARE_mBool(enable_block_string_dict_encoding);
 
 DECLARE_mInt64(column_dictionary_key_ratio_threshold);
 DECLARE_mInt64(column_dictionary_key_size_threshold);
@@ -361,6 +379,15 @@ DECLARE_Bool(disable_storage_page_cache);
 DECLARE_Bool(disable_storage_row_cache);
 // whether to disable pk page cache feature in storage
 DECLARE_Bool(disable_pk_storage_page_cache);
+// whether to read the data pages of a segment ahead of decoding them into page cache, with
+// neighboring pages merged into large reads
+DECLARE_mBool(enable_segment_page_prefetch);
+// rows of a segment whose pages are prefetched together
+DECLARE_mInt32(segment_prefetch_window_rows);
+// neighboring pages are read together if the hole between them is not larger than this
+DECLARE_mInt64(segment_prefetch_merge_gap_bytes);
+// max bytes of one merged read
+DECLARE_mInt64(segment_prefetch_max_read_bytes);
 
 // Cache for mow primary key storage page size, it's seperated from
 // storage_page_cache_limit
@@ -373,6 +400,14 @@ DECLARE_mInt32(data_page_cache_stale_sweep_time_sec);
 DECLARE_mInt32(index_page_cache_stale_sweep_time_sec);
 // great impact on the performance of MOW, so it can be longer.
 DECLARE_mInt32(pk_index_page_cache_stale_sweep_time_sec);
+// whether a page may only enter a full page cache after it has been missed several times
+// recently, so that one large scan can not flush the frequently used pages out
+DECLARE_mBool(enable_page_cache_admission);
+// times a page must be missed recently before it is admitted into a full page cache
+DECLARE_mInt32(page_cache_admission_min_frequency);
+// a scan that reads at least this many rows of a tablet without key range is treated as
+// a large scan, whose pages always have to pass the admission check. <= 0 means disabled
+DECLARE_mInt64(page_cache_large_scan_rows);
 
 DECLARE_Bool(enable_low_cardinality_optimize);
 DECLARE_Bool(enable_low_cardinality_cache_code);
@@ -386,12 +421,20 @@ DECLARE_mBool(disable_auto_compaction);
 DECLARE_mBool(enable_vertical_compaction);
 // whether enable ordered data compaction
 DECLARE_mBool(enable_ordered_data_compaction);
+// whether copy the data pages of value columns in compaction of rowsets with ordered data
+DECLARE_mBool(enable_page_copy_compaction);
 // In vertical compaction, column number for every group
 DECLARE_mInt32(vertical_compaction_num_columns_per_group);
 // In vertical compaction, max memory usage for row_source_buffer
 DECLARE_Int32(vertical_compaction_max_row_source_memory_mb);
 // In vertical compaction, max dest segment file size
 DECLARE_mInt64(vertical_compaction_max_segment_size);
+// In vertical compaction, max threads to compact the value column groups of one
+// compaction in parallel, 0 means compact them one by one.
+DECLARE_Int32(vertical_compaction_parallel_group_threads);
+// In vertical compaction, max memory of the value column groups compacted in parallel,
+// fewer helper threads are used if the groups are estimated to hold more.
+DECLARE_mInt64(vertical_compaction_parallel_group_max_memory_mb);
 
 // In ordered data compaction, min segment size for input rowset
 DECLARE_mInt32(ordered_data_compaction_min_segment_size);
@@ -448,6 +491,14 @@ DECLARE_mInt32(compaction_task_num_per_fast_disk);
 // How many rounds of cumulative compaction for each round of base compaction when compaction tasks generation.
 DECLARE_mInt32(cumulative_compaction_rounds_for_each_base_compaction_round);
 
+// When picking the tablet to compact, the compaction score of a tablet is multiplied by
+// 1 + weight * log2(1 + read heat), at most 2, where the read heat is the segments opened and
+// the rowsets merged by recent query scans on the tablet. Tablets close to
+// max_tablet_version_num are still picked first. 0 means pick by compaction score only.
+DECLARE_mDouble(compaction_read_heat_weight);
+// The read heat of a tablet is decayed by half in this period.
+DECLARE_mInt64(compaction_read_heat_half_life_sec);
+
 // Threshold to logging compaction trace, in seconds.
 DECLARE_mInt32(base_compaction_trace_threshold);
 DECLARE_mInt32(cumulative_compaction_trace_threshold);
@@ -523,6 +574,9 @@ DECLARE_mInt32(streaming_load_rpc_max_alive_time_sec);
 DECLARE_Int32(tablet_writer_open_rpc_timeout_sec);
 // You can ignore brpc error '[E1011]The server is overcrowded' when writing data.
 DECLARE_mBool(tablet_writer_ignore_eovercrowded);
+// Whether the load blocks sent to the tablets on the same BE are handed to the load channel
+// in process, without serializing and sending them by rpc.
+DECLARE_mBool(enable_local_tablet_writer_add_block);
 DECLARE_mBool(exchange_sink_ignore_eovercrowded);
 DECLARE_mInt32(slave_replica_writer_rpc_timeout_sec);
 // Whether to enable stream load record function, the default is false.
@@ -609,6 +663,12 @@ DECLARE_Int32(memory_max_alignment);
 DECLARE_mInt64(write_buffer_size);
 // max buffer size used in memtable for the aggregated table, default 400MB
 DECLARE_mInt64(write_buffer_size_for_agg);
+// whether to sort memtable rows by fixed width memcomparable keys encoded from the leading
+// key columns, instead of comparing the key columns one by one
+DECLARE_mBool(enable_memtable_normalized_key_sort);
+// whether to merge the rows of the same key by a hash table when inserting into the memtable of
+// aggregate key table, so only distinct keys are kept and sorted at flush time
+DECLARE_mBool(enable_memtable_hash_aggregation);
 
 DECLARE_Int32(load_process_max_memory_limit_percent); // 50%
 
@@ -684,6 +744,14 @@ DECLARE_mInt64(storage_flood_stage_left_capacity_bytes); // 1GB
 DECLARE_Int32(flush_thread_num_per_store);
 // number of thread for flushing memtable per store, for high priority load task
 DECLARE_Int32(high_priority_flush_thread_num_per_store);
+// number of thread per store for writing the segments of a memtable split into several
+// key ranges, 0 means a memtable is always flushed into one segment
+DECLARE_Int32(flush_split_thread_num_per_store);
+// a memtable of duplicate key table is split into key ranges of at least so many rows,
+// and the ranges are written into separate segments in parallel. <= 0 means disabled
+DECLARE_mInt64(memtable_flush_split_min_rows);
+// max number of key ranges a memtable is split into
+DECLARE_mInt32(memtable_flush_split_max_num);
 
 // config for tablet meta checkpoint
 DECLARE_mInt32(tablet_meta_checkpoint_min_new_rowsets_num);
@@ -787,6 +855,10 @@ DECLARE_mInt32(max_send_batch_parallelism_per_job);
 DECLARE_Int32(send_batch_thread_pool_thread_num);
 // number of send batch thread pool queue size
 DECLARE_Int32(send_batch_thread_pool_queue_size);
+// number of spill io threads of each data dir, spill io of pipeline operators runs in them
+DECLARE_Int32(spill_io_thread_num_per_data_dir);
+// queue size of the spill io thread pool of each data dir
+DECLARE_Int32(spill_io_thread_pool_queue_size);
 // number of download cache thread pool size
 DECLARE_Int32(download_cache_thread_pool_thread_num);
 // number of download cache thread pool queue size
@@ -905,6 +977,9 @@ DECLARE_mInt64(small_column_size_buffer);
 // When the rows number reached this limit, will check the filter rate the of bloomfilter
 // if it is lower than a specific threshold, the predicate will be disabled.
 DECLARE_mInt32(bloom_filter_predicate_check_row_num);
+// The threshold of the filter rate above, a runtime filter which filters out a lower rate
+// of the checked rows will be disabled.
+DECLARE_mDouble(runtime_filter_min_filter_rate);
 
 // cooldown task configs
 DECLARE_Int32(cooldown_thread_num);
@@ -980,6 +1055,18 @@ DECLARE_Bool(enable_java_support);
 DECLARE_Bool(enable_fuzzy_mode);
 
 DECLARE_Int32(pipeline_executor_size);
+// Bind the pipeline workers to NUMA nodes, keep the tasks of a fragment instance on one node and
+// steal tasks from the workers of the same node first.
+DECLARE_Bool(enable_pipeline_numa_aware_scheduling);
+// Blocked pipeline tasks that wait for a state without notification, e.g. pending finish, are
+// polled at this interval.
+DECLARE_mInt32(pipeline_blocked_task_check_interval_ms);
+// Park blocked pipeline tasks on the dependencies they wait for, and check them again only when
+// the dependencies notify. Otherwise all blocked tasks are polled every
+// pipeline_blocked_task_check_interval_ms.
+DECLARE_mBool(enable_pipeline_task_parking);
+// Parked pipeline tasks are also checked at this interval for timeouts and cancellation.
+DECLARE_mInt32(pipeline_parked_task_check_interval_ms);
 DECLARE_Bool(enable_workload_group_for_scan);
 
 // Temp config. True to use optimization for bitmap_index apply predicate except leaf node of the and node.
@@ -36,6 +36,9 @@
 #include "runtime/types.h"
 #include "util/hash_util.hpp"
 #include "util/string_parser.hpp"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/columns_number.h"
+#include "vec/common/assert_cast.h"
 #include "vec/common/string_ref.h"
 #include "vec/exprs/vexpr.h"
 #include "vec/runtime/vdatetime_value.h"
@@ -336,6 +339,26 @@ Status VOlapTablePartitionParam::init() {
         }
     }
 
+    if (!_is_in_partition && _partition_slot_locs.size() == 1) {
+        PrimitiveType type = _slots[_partition_slot_locs[0]]->type().type;
+        switch (type) {
+        case TYPE_TINYINT:
+        case TYPE_SMALLINT:
+        case TYPE_INT:
+        case TYPE_BIGINT:
+        case TYPE_LARGEINT:
+        case TYPE_DATEV2:
+        case TYPE_DATETIMEV2:
+            _range_partition_type = type;
+            for (const auto& [_, part] : *_partitions_map) {
+                _ordered_range_partitions.push_back(part);
+            }
+            break;
+        default:
+            break;
+        }
+    }
+
     _mem_usage = _partition_block.allocated_bytes();
     _mem_tracker->consume(_mem_usage);
     return Status::OK();
@@ -361,6 +384,134 @@ uint32_t VOlapTablePartitionParam::find_tablet(BlockRow* block_row,
     return _compute_tablet_index(block_row, partition.num_buckets);
 }
 
+template <typename ColumnType>
+void VOlapTablePartitionParam::_find_range_partitions(
+        const vectorized::IColumn& column, const uint8_t* null_map, size_t num_rows,
+        std::vector<const VOlapTablePartition*>& partitions) const {
+    using T = typename ColumnType::value_type;
+    auto key_column = vectorized::remove_nullable(
+            _partition_block.get_by_position(_partition_slot_locs[0]).column);
+    const auto& key_data = assert_cast<const ColumnType&>(*key_column).get_data();
+    // the end key of the last partition is MAXVALUE if its row is -1
+    size_t num_end_keys = _ordered_range_partitions.size();
+    if (num_end_keys > 0 && _ordered_range_partitions.back()->end_key.second == -1) {
+        num_end_keys--;
+    }
+    std::vector<T> end_keys(num_end_keys);
+    for (size_t i = 0; i < num_end_keys; ++i) {
+        end_keys[i] = key_data[_ordered_range_partitions[i]->end_key.second];
+    }
+
+    const T* data = assert_cast<const ColumnType&>(column).get_data().data();
+    for (size_t row = 0; row < num_rows; ++row) {
+        if (null_map != nullptr && null_map[row]) {
+            continue;
+        }
+        T value = data[row];
+        // upper bound of value in end keys, the loop is compiled to conditional moves
+        const T* first = end_keys.data();
+        size_t len = num_end_keys;
+        while (len > 0) {
+            size_t half = len / 2;
+            bool go_right = first[half] <= value;
+            first = go_right ? first + half + 1 : first;
+            len = go_right ? len - half - 1 : half;
+        }
+        size_t index = first - end_keys.data();
+        if (index == _ordered_range_partitions.size()) {
+            continue;
+        }
+        const auto* part = _ordered_range_partitions[index];
+        if (part->start_key.second == -1 || key_data[part->start_key.second] <= value) {
+            partitions[row] = part;
+        }
+    }
+}
+
+void VOlapTablePartitionParam::find_partitions(
+        vectorized::Block* block, size_t num_rows,
+        std::vector<const VOlapTablePartition*>& partitions) const {
+    partitions.assign(num_rows, nullptr);
+    if (_range_partition_type == INVALID_TYPE) {
+        for (size_t row = 0; row < num_rows; ++row) {
+            BlockRow block_row = {block, static_cast<int32_t>(row)};
+            find_partition(&block_row, &partitions[row]);
+        }
+        return;
+    }
+
+    auto full_column = block->get_by_position(_partition_slot_locs[0])
+                               .column->convert_to_full_column_if_const();
+    const vectorized::IColumn* column = full_column.get();
+    const uint8_t* null_map = nullptr;
+    if (column->is_nullable()) {
+        const auto& nullable_column = assert_cast<const vectorized::ColumnNullable&>(*column);
+        null_map = nullable_column.get_null_map_data().data();
+        column = nullable_column.get_nested_column_ptr().get();
+    }
+    switch (_range_partition_type) {
+    case TYPE_TINYINT:
+        _find_range_partitions<vectorized::ColumnInt8>(*column, null_map, num_rows, partitions);
+        break;
+    case TYPE_SMALLINT:
+        _find_range_partitions<vectorized::ColumnInt16>(*column, null_map, num_rows, partitions);
+        break;
+    case TYPE_INT:
+        _find_range_partitions<vectorized::ColumnInt32>(*column, null_map, num_rows, partitions);
+        break;
+    case TYPE_BIGINT:
+        _find_range_partitions<vectorized::ColumnInt64>(*column, null_map, num_rows, partitions);
+        break;
+    case TYPE_LARGEINT:
+        _find_range_partitions<vectorized::ColumnInt128>(*column, null_map, num_rows, partitions);
+        break;
+    case TYPE_DATEV2:
+        _find_range_partitions<vectorized::ColumnUInt32>(*column, null_map, num_rows, partitions);
+        break;
+    case TYPE_DATETIMEV2:
+        _find_range_partitions<vectorized::ColumnUInt64>(*column, null_map, num_rows, partitions);
+        break;
+    default:
+        LOG(FATAL) << "unexpected range partition type " << _range_partition_type;
+    }
+    // null is less than any value, it is compared with the partition keys one by one
+    if (null_map != nullptr) {
+        for (size_t row = 0; row < num_rows; ++row) {
+            if (null_map[row]) {
+                BlockRow block_row = {block, static_cast<int32_t>(row)};
+                find_partition(&block_row, &partitions[row]);
+            }
+        }
+    }
+}
+
+void VOlapTablePartitionParam::find_tablets(
+        vectorized::Block* block, size_t num_rows,
+        const std::vector<const VOlapTablePartition*>& partitions,
+        std::vector<uint32_t>& tablet_indexes) const {
+    tablet_indexes.assign(num_rows, 0);
+    if (_distributed_slot_locs.empty()) {
+        for (size_t row = 0; row < num_rows; ++row) {
+            if (partitions[row] != nullptr) {
+                tablet_indexes[row] = butil::fast_rand() % partitions[row]->num_buckets;
+            }
+        }
+        return;
+    }
+    // the same crc32 as _compute_tablet_index, but computed column by column
+    std::vector<uint64_t> hash_vals(num_rows, 0);
+    for (auto slot_loc : _distributed_slot_locs) {
+        auto column = block->get_by_position(slot_loc).column->convert_to_full_column_if_const();
+        column->update_crcs_with_value(hash_vals, _slots[slot_loc]->type().type);
+    }
+    for (size_t row = 0; row < num_rows; ++row) {
+        if (partitions[row] != nullptr) {
+            tablet_indexes[row] =
+                    static_cast<uint32_t>(hash_vals[row] % partitions[row]->num_buckets);
+        }
+    }
+}
+
 Status VOlapTablePartitionParam::_create_partition_keys(const std::vector<TExprNode>& t_exprs,
                                                         BlockRow* part_key) {
     for (int i = 0; i < t_exprs.size(); i++) {
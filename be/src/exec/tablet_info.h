@@ -32,6 +32,7 @@
 
 #include "common/object_pool.h"
 #include "common/status.h"
+#include "runtime/define_primitive_type.h"
 #include "vec/columns/column.h"
 #include "vec/core/block.h"
 #include "vec/core/column_with_type_and_name.h"
@@ -175,6 +176,17 @@ public:
 
     uint32_t find_tablet(BlockRow* block_row, const VOlapTablePartition& partition) const;
 
+    // Find the partitions of the first `num_rows' rows in block at once, `partitions[i]' is
+    // set to nullptr if row i is not in any partition.
+    void find_partitions(vectorized::Block* block, size_t num_rows,
+                         std::vector<const VOlapTablePartition*>& partitions) const;
+
+    // Compute the tablet index of each row in its partition, rows whose partition is nullptr
+    // are skipped.
+    void find_tablets(vectorized::Block* block, size_t num_rows,
+                      const std::vector<const VOlapTablePartition*>& partitions,
+                      std::vector<uint32_t>& tablet_indexes) const;
+
     const std::vector<VOlapTablePartition*>& get_partitions() const { return _partitions; }
 
 private:
@@ -182,6 +194,11 @@ private:
 
     Status _create_partition_key(const TExprNode& t_expr, BlockRow* part_key, uint16_t pos);
 
+    template <typename ColumnType>
+    void _find_range_partitions(const vectorized::IColumn& column, const uint8_t* null_map,
+                                size_t num_rows,
+                                std::vector<const VOlapTablePartition*>& partitions) const;
+
     std::function<uint32_t(BlockRow*, int64_t)> _compute_tablet_index;
 
     // check if this partition contain this key
@@ -210,6 +227,10 @@ private:
     uint32_t _mem_usage = 0;
     // only works when using list partition, the resource is owned by _partitions
     VOlapTablePartition* _default_partition = nullptr;
+    // Range partitions ordered by end key, only set if they are partitioned by a single
+    // integer column, so partitions are found by binary search on column data directly.
+    std::vector<const VOlapTablePartition*> _ordered_range_partitions;
+    PrimitiveType _range_partition_type = INVALID_TYPE;
 };
 
 using TabletLocation = TTabletLocation;
@@ -27,6 +27,7 @@
 #include <vector>
 
 #include "common/status.h"
+#include "pipeline/wakeup_dependency.h"
 #include "runtime/datetime_value.h"
 #include "runtime/decimalv2_value.h"
 #include "runtime/define_primitive_type.h"
@@ -230,6 +231,8 @@ public:
     // this function will be called if a runtime filter sent by rpc
     // it will nodify all wait threads
     void signal();
+    // only used for consumer in pipeline, notified by signal()
+    pipeline::WakeupDependency* dependency() { return &_dependency; }
 
     // init filter with desc
     Status init_with_desc(const TRuntimeFilterDesc* desc, const TQueryOptions* options,
@@ -370,6 +373,7 @@ protected:
     // used for await or signal
     Mutex _inner_mutex;
     ConditionVariable _inner_cv;
+    pipeline::WakeupDependency _dependency;
 
     bool _is_push_down = false;
 
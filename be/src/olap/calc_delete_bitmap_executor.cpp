@@ -34,23 +34,33 @@ Status CalcDeleteBitmapToken::submit(TabletSharedPtr tablet, RowsetSharedPtr cur
                                      const segment_v2::SegmentSharedPtr& cur_segment,
                                      const std::vector<RowsetSharedPtr>& target_rowsets,
                                      int64_t end_version, RowsetWriter* rowset_writer) {
+    return submit_func(tablet->tablet_id(), [=](DeleteBitmapPtr bitmap) {
+        auto st = tablet->calc_segment_delete_bitmap(cur_rowset, cur_segment, target_rowsets,
+                                                     bitmap, end_version, rowset_writer);
+        if (!st.ok()) {
+            LOG(WARNING) << "failed to calc segment delete bitmap, tablet_id: "
+                         << tablet->tablet_id() << " rowset: " << cur_rowset->rowset_id()
+                         << " seg_id: " << cur_segment->id() << " version: " << end_version;
+        }
+        return st;
+    });
+}
+
+Status CalcDeleteBitmapToken::submit_func(int64_t tablet_id,
+                                          std::function<Status(DeleteBitmapPtr)> calc_func) {
     {
         std::shared_lock rlock(_lock);
         RETURN_IF_ERROR(_status);
     }
 
-    DeleteBitmapPtr bitmap = std::make_shared<DeleteBitmap>(tablet->tablet_id());
+    DeleteBitmapPtr bitmap = std::make_shared<DeleteBitmap>(tablet_id);
     {
         std::lock_guard wlock(_lock);
         _delete_bitmaps.push_back(bitmap);
     }
-    return _thread_token->submit_func([=, this]() {
-        auto st = tablet->calc_segment_delete_bitmap(cur_rowset, cur_segment, target_rowsets,
-                                                     bitmap, end_version, rowset_writer);
+    return _thread_token->submit_func([=, this, calc_func = std::move(calc_func)]() {
+        auto st = calc_func(bitmap);
         if (!st.ok()) {
-            LOG(WARNING) << "failed to calc segment delete bitmap, tablet_id: "
-                         << tablet->tablet_id() << " rowset: " << cur_rowset->rowset_id()
-                         << " seg_id: " << cur_segment->id() << " version: " << end_version;
             std::lock_guard wlock(_lock);
             if (_status.ok()) {
                 _status = st;
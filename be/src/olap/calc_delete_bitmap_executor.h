@@ -20,6 +20,7 @@
 #include <stdint.h>
 
 #include <atomic>
+#include <functional>
 #include <iosfwd>
 #include <memory>
 #include <utility>
@@ -54,6 +55,10 @@ public:
                   const std::vector<RowsetSharedPtr>& target_rowsets, int64_t end_version,
                   RowsetWriter* rowset_writer);
 
+    // Submit a task which calculates the delete bitmap of tablet `tablet_id' into the bitmap
+    // passed to `calc_func'.
+    Status submit_func(int64_t tablet_id, std::function<Status(DeleteBitmapPtr)> calc_func);
+
     // wait all tasks in token to be completed.
     Status wait();
 
@@ -145,6 +145,35 @@ bool Compaction::should_vertical_compaction() {
     return true;
 }
 
+bool Compaction::should_page_copy_compaction() {
+    if (!config::enable_page_copy_compaction || _tablet->keys_type() != KeysType::DUP_KEYS ||
+        _cur_tablet_schema->num_key_columns() == 0) {
+        return false;
+    }
+    // no row is merged or deleted, and the rows of all segments are already in key order
+    std::string pre_max_key;
+    for (auto& rowset : _input_rowsets) {
+        if (rowset->rowset_meta()->has_delete_predicate() ||
+            rowset->tablet_schema()->schema_version() != _cur_tablet_schema->schema_version()) {
+            return false;
+        }
+        std::vector<KeyBoundsPB> segments_key_bounds;
+        if (!rowset->get_segments_key_bounds(&segments_key_bounds).ok()) {
+            return false;
+        }
+        for (auto& key_bounds : segments_key_bounds) {
+            if (key_bounds.min_key() < pre_max_key) {
+                return false;
+            }
+            pre_max_key = key_bounds.max_key();
+        }
+    }
+    const auto& columns = _cur_tablet_schema->columns();
+    return std::any_of(columns.begin(), columns.end(), [this](const TabletColumn& column) {
+        return Merger::can_copy_column_pages(*_cur_tablet_schema, column);
+    });
+}
+
 int64_t Compaction::get_avg_segment_rows() {
     // take care of empty rowset
     // input_rowsets_size is total disk_size of input_rowset, this size is the
@@ -323,7 +352,8 @@ Status Compaction::do_compaction_impl(int64_t permits) {
 
     LOG(INFO) << "start " << compaction_name() << ". tablet=" << _tablet->full_name()
               << ", output_version=" << _output_version << ", permits: " << permits;
-    bool vertical_compaction = should_vertical_compaction();
+    bool page_copy_compaction = should_page_copy_compaction();
+    bool vertical_compaction = page_copy_compaction || should_vertical_compaction();
     RowsetWriterContext ctx;
     RETURN_IF_ERROR(construct_input_rowset_readers());
     RETURN_IF_ERROR(construct_output_rowset_writer(ctx, vertical_compaction));
@@ -344,7 +374,11 @@ Status Compaction::do_compaction_impl(int64_t permits) {
     Status res;
     {
         SCOPED_TIMER(_merge_rowsets_latency_timer);
-        if (vertical_compaction) {
+        if (page_copy_compaction && stats.rowid_conversion == nullptr) {
+            res = Merger::page_copy_rowsets(_tablet, _cur_tablet_schema, _input_rs_readers,
+                                            _output_rs_writer.get(), get_avg_segment_rows(),
+                                            &stats);
+        } else if (vertical_compaction) {
             res = Merger::vertical_merge_rowsets(_tablet, compaction_type(), _cur_tablet_schema,
                                                  _input_rs_readers, _output_rs_writer.get(),
                                                  get_avg_segment_rows(), &stats);
@@ -707,6 +741,13 @@ Status Compaction::modify_rowsets(const Merger::Statistics* stats) {
         if (!st.ok()) {
             LOG(WARNING) << "failed to remove old version delete bitmap, st: " << st;
         }
+        if (_tablet->need_update_primary_key_filter(compaction_type())) {
+            st = StorageEngine::instance()->submit_update_primary_key_filter_task(_tablet);
+            if (!st.ok()) {
+                LOG(WARNING) << "failed to submit primary key filter task, tablet: "
+                             << _tablet->tablet_id() << ", st: " << st;
+            }
+        }
     }
     return Status::OK();
 }
@@ -85,6 +85,7 @@ protected:
     int64_t get_compaction_permits();
 
     bool should_vertical_compaction();
+    bool should_page_copy_compaction();
     int64_t get_avg_segment_rows();
 
     bool handle_ordered_data_compaction();
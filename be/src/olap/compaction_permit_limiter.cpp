@@ -48,6 +48,16 @@ void CompactionPermitLimiter::request(int64_t permits) {
     DorisMetrics::instance()->compaction_used_permits->set_value(_used_permits);
 }
 
+bool CompactionPermitLimiter::try_request(int64_t permits) {
+    std::unique_lock<std::mutex> lock(_permits_mutex);
+    if (_used_permits + permits > config::total_permits_for_compaction_score) {
+        return false;
+    }
+    _used_permits += permits;
+    DorisMetrics::instance()->compaction_used_permits->set_value(_used_permits);
+    return true;
+}
+
 void CompactionPermitLimiter::release(int64_t permits) {
     std::unique_lock<std::mutex> lock(_permits_mutex);
     _used_permits -= permits;
@@ -38,6 +38,9 @@ public:
 
     void request(int64_t permits);
 
+    // Acquire "permits" without waiting, return false if they are not available now.
+    bool try_request(int64_t permits);
+
     void release(int64_t permits);
 
     int64_t usage() const { return _used_permits; }
@@ -23,14 +23,17 @@
 
 #include <algorithm>
 #include <limits>
+#include <numeric>
 #include <string>
 #include <vector>
 
 #include "bvar/bvar.h"
 #include "common/config.h"
+#include "olap/key_coder.h"
 #include "olap/memtable_memory_limiter.h"
 #include "olap/olap_define.h"
 #include "olap/tablet_schema.h"
+#include "olap/types.h"
 #include "runtime/descriptors.h"
 #include "runtime/exec_env.h"
 #include "runtime/thread_context.h"
@@ -40,6 +43,9 @@
 #include "vec/aggregate_functions/aggregate_function_reader.h"
 #include "vec/aggregate_functions/aggregate_function_simple_factory.h"
 #include "vec/columns/column.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/common/aggregation_common.h"
+#include "vec/common/assert_cast.h"
 
 namespace doris {
 
@@ -74,12 +80,18 @@ MemTable::MemTable(int64_t tablet_id, const TabletSchema* tablet_schema,
 #endif
     _arena = std::make_unique<vectorized::Arena>();
     _vec_row_comparator = std::make_shared<RowInBlockComparator>(_tablet_schema);
+    _normalized_key_sorter = std::make_unique<NormalizedKeySorter>(_tablet_schema);
     // TODO: Support ZOrderComparator in the future
     _init_columns_offset_by_slot_descs(slot_descs, tuple_desc);
     _num_columns = _tablet_schema->num_columns();
     if (_tablet_schema->is_partial_update()) {
         _num_columns = _tablet_schema->partial_input_column_size();
     }
+    if (config::enable_memtable_hash_aggregation && _keys_type == KeysType::AGG_KEYS &&
+        !_tablet_schema->is_dynamic_schema() && _tablet_schema->num_key_columns() > 0) {
+        _hash_agg_map = std::make_unique<RowInBlockHashMap>();
+        _hash_key_arena = std::make_unique<vectorized::Arena>();
+    }
 }
 void MemTable::_init_columns_offset_by_slot_descs(const std::vector<SlotDescriptor*>* slot_descs,
                                                   const TupleDescriptor* tuple_desc) {
@@ -158,6 +170,103 @@ MemTable::~MemTable() {
     DCHECK_EQ(_flush_mem_tracker->consumption(), 0);
 }
 
+// The memtable columns of these types hold the same fixed width values as storage format,
+// so they can be encoded by KeyCoder directly.
+static bool is_normalizable_key_type(FieldType type) {
+    switch (type) {
+    case FieldType::OLAP_FIELD_TYPE_BOOL:
+    case FieldType::OLAP_FIELD_TYPE_TINYINT:
+    case FieldType::OLAP_FIELD_TYPE_SMALLINT:
+    case FieldType::OLAP_FIELD_TYPE_INT:
+    case FieldType::OLAP_FIELD_TYPE_BIGINT:
+    case FieldType::OLAP_FIELD_TYPE_LARGEINT:
+    case FieldType::OLAP_FIELD_TYPE_DATEV2:
+    case FieldType::OLAP_FIELD_TYPE_DATETIMEV2:
+    case FieldType::OLAP_FIELD_TYPE_DECIMAL32:
+    case FieldType::OLAP_FIELD_TYPE_DECIMAL64:
+    case FieldType::OLAP_FIELD_TYPE_DECIMAL128I:
+        return true;
+    default:
+        return false;
+    }
+}
+
+NormalizedKeySorter::NormalizedKeySorter(const TabletSchema* tablet_schema) {
+    for (size_t cid = 0; cid < tablet_schema->num_key_columns(); ++cid) {
+        FieldType type = tablet_schema->column(cid).type();
+        if (!is_normalizable_key_type(type)) {
+            break;
+        }
+        _key_coders.push_back(get_key_coder(type));
+        _key_sizes.push_back(get_scalar_type_info(type)->size());
+    }
+}
+
+void NormalizedKeySorter::sort(const vectorized::MutableBlock& block,
+                               std::vector<RowInBlock*>& row_in_blocks, Tie& tie) const {
+    const size_t begin = tie.begin();
+    const size_t num_rows = tie.end() - begin;
+    if (num_rows < 2) {
+        return;
+    }
+
+    const size_t num_columns = _key_coders.size();
+    std::vector<const vectorized::IColumn*> columns(num_columns);
+    std::vector<const vectorized::UInt8*> null_maps(num_columns, nullptr);
+    size_t key_width = 0;
+    for (size_t cid = 0; cid < num_columns; ++cid) {
+        const vectorized::IColumn* column = block.get_column_by_position(cid).get();
+        if (column->is_nullable()) {
+            const auto* nullable_column = assert_cast<const vectorized::ColumnNullable*>(column);
+            null_maps[cid] = nullable_column->get_null_map_data().data();
+            column = nullable_column->get_nested_column_ptr().get();
+            // one more byte to tell null from values
+            key_width++;
+        }
+        columns[cid] = column;
+        key_width += _key_sizes[cid];
+    }
+
+    std::string keys;
+    keys.reserve(num_rows * key_width);
+    for (size_t i = begin; i < begin + num_rows; ++i) {
+        size_t row_pos = row_in_blocks[i]->_row_pos;
+        for (size_t cid = 0; cid < num_columns; ++cid) {
+            if (null_maps[cid] != nullptr) {
+                if (null_maps[cid][row_pos]) {
+                    // null is less than any value, the same as compare_at with -1 hint
+                    keys.append(_key_sizes[cid] + 1, '\0');
+                    continue;
+                }
+                keys.push_back('\1');
+            }
+            StringRef value = columns[cid]->get_data_at(row_pos);
+            DCHECK_EQ(value.size, _key_sizes[cid]);
+            _key_coders[cid]->full_encode_ascending(value.data, &keys);
+        }
+    }
+    DCHECK_EQ(keys.size(), num_rows * key_width);
+
+    const char* key_data = keys.data();
+    auto compare = [key_data, key_width](uint32_t lhs, uint32_t rhs) -> int {
+        return memcmp(key_data + lhs * key_width, key_data + rhs * key_width, key_width);
+    };
+    std::vector<uint32_t> order(num_rows);
+    std::iota(order.begin(), order.end(), 0);
+    pdqsort(order.begin(), order.end(),
+            [&compare](uint32_t lhs, uint32_t rhs) -> bool { return compare(lhs, rhs) < 0; });
+
+    std::vector<RowInBlock*> sorted_rows(num_rows);
+    for (size_t i = 0; i < num_rows; ++i) {
+        sorted_rows[i] = row_in_blocks[begin + order[i]];
+    }
+    std::copy(sorted_rows.begin(), sorted_rows.end(), std::next(row_in_blocks.begin(), begin));
+    tie[begin] = 0;
+    for (size_t i = 1; i < num_rows; ++i) {
+        tie[begin + i] = (compare(order[i - 1], order[i]) == 0);
+    }
+}
+
 int RowInBlockComparator::operator()(const RowInBlock* left, const RowInBlock* right) const {
     return _pblock->compare_at(left->_row_pos, right->_row_pos, _tablet_schema->num_key_columns(),
                                *_pblock, -1);
@@ -198,6 +307,17 @@ void MemTable::insert(const vectorized::Block* input_block, const std::vector<in
         }
     }
 
+    if (_hash_agg_map != nullptr) {
+        if (is_append) {
+            std::vector<int> all_rows(target_block.rows());
+            std::iota(all_rows.begin(), all_rows.end(), 0);
+            _insert_with_hash_agg(target_block, all_rows);
+        } else {
+            _insert_with_hash_agg(target_block, row_idxs);
+        }
+        return;
+    }
+
     auto num_rows = row_idxs.size();
     size_t cursor_in_mutableblock = _input_mutable_block.rows();
     if (is_append) {
@@ -217,6 +337,66 @@ void MemTable::insert(const vectorized::Block* input_block, const std::vector<in
     _stat.raw_rows += num_rows;
 }
 
+void MemTable::_insert_with_hash_agg(const vectorized::Block& block,
+                                     const std::vector<int>& row_idxs) {
+    const size_t num_key_columns = _tablet_schema->num_key_columns();
+    vectorized::ColumnRawPtrs key_columns(num_key_columns);
+    for (size_t cid = 0; cid < num_key_columns; ++cid) {
+        key_columns[cid] = block.get_by_position(cid).column.get();
+    }
+
+    // rows of new keys to append, and pairs of (row in block, row of the same key in memtable)
+    std::vector<int> new_rows;
+    std::vector<std::pair<int, RowInBlock*>> merged_rows;
+    size_t cursor_in_mutableblock = _input_mutable_block.rows();
+    for (int row : row_idxs) {
+        StringRef key = vectorized::serialize_keys_to_pool_contiguous(
+                row, num_key_columns, key_columns, *_hash_key_arena);
+        RowInBlockHashMap::LookupResult it;
+        bool inserted = false;
+        _hash_agg_map->emplace(key, it, inserted);
+        if (inserted) {
+            auto* row_in_block = new RowInBlock {cursor_in_mutableblock + new_rows.size()};
+            _row_in_blocks.emplace_back(row_in_block);
+            *lookup_result_get_mapped(it) = row_in_block;
+            new_rows.push_back(row);
+        } else {
+            _hash_key_arena->rollback(key.size);
+            merged_rows.emplace_back(row, *lookup_result_get_mapped(it));
+        }
+    }
+
+    if (!new_rows.empty()) {
+        _input_mutable_block.add_rows(&block, new_rows.data(), new_rows.data() + new_rows.size());
+        size_t input_size = block.allocated_bytes() * new_rows.size() / block.rows();
+        _mem_usage += input_size;
+        _insert_mem_tracker->consume(input_size);
+    }
+
+    // rows are merged in the order of insertion, the same as sorting rows by _row_pos
+    for (const auto& [row, dst_row] : merged_rows) {
+        if (!dst_row->has_init_agg()) {
+            dst_row->init_agg_places(_arena->aligned_alloc(_total_size_of_aggregate_states, 16),
+                                     _offsets_of_aggregate_states.data());
+            for (auto cid = num_key_columns; cid < _num_columns; cid++) {
+                auto col_ptr = _input_mutable_block.mutable_columns()[cid].get();
+                auto data = dst_row->agg_places(cid);
+                _agg_functions[cid]->create(data);
+                _agg_functions[cid]->add(data,
+                                         const_cast<const doris::vectorized::IColumn**>(&col_ptr),
+                                         dst_row->_row_pos, _arena.get());
+            }
+        }
+        for (auto cid = num_key_columns; cid < _num_columns; cid++) {
+            const auto* col_ptr = block.get_by_position(cid).column.get();
+            _agg_functions[cid]->add(dst_row->agg_places(cid), &col_ptr, row, _arena.get());
+        }
+    }
+    _num_hash_merged_rows += merged_rows.size();
+    _stat.merged_rows += merged_rows.size();
+    _stat.raw_rows += row_idxs.size();
+}
+
 void MemTable::_aggregate_two_row_in_block(vectorized::MutableBlock& mutable_block,
                                            RowInBlock* src_row, RowInBlock* dst_row) {
     if (_tablet_schema->has_sequence_col() && _seq_col_idx_in_block >= 0) {
@@ -257,7 +437,12 @@ size_t MemTable::_sort() {
     size_t same_keys_num = 0;
     // sort new rows
     Tie tie = Tie(_last_sorted_pos, _row_in_blocks.size());
-    for (size_t i = 0; i < _tablet_schema->num_key_columns(); i++) {
+    size_t num_sorted_columns = 0;
+    if (config::enable_memtable_normalized_key_sort && _normalized_key_sorter->num_columns() > 0) {
+        _normalized_key_sorter->sort(_input_mutable_block, _row_in_blocks, tie);
+        num_sorted_columns = _normalized_key_sorter->num_columns();
+    }
+    for (size_t i = num_sorted_columns; i < _tablet_schema->num_key_columns(); i++) {
         auto cmp = [&](const RowInBlock* lhs, const RowInBlock* rhs) -> int {
             return _input_mutable_block.compare_one_column(lhs->_row_pos, rhs->_row_pos, i, -1);
         };
@@ -431,7 +616,8 @@ bool MemTable::need_flush() const {
 }
 
 bool MemTable::need_agg() const {
-    if (_keys_type == KeysType::AGG_KEYS) {
+    // rows are already merged on insert
+    if (_keys_type == KeysType::AGG_KEYS && _hash_agg_map == nullptr) {
         auto max_size = config::write_buffer_size_for_agg;
         if (_tablet_schema->is_partial_update()) {
             auto update_columns_size = _tablet_schema->partial_input_column_size();
@@ -445,7 +631,8 @@ bool MemTable::need_agg() const {
 
 std::unique_ptr<vectorized::Block> MemTable::to_block() {
     size_t same_keys_num = _sort();
-    if (_keys_type == KeysType::DUP_KEYS || same_keys_num == 0) {
+    // the rows merged on insert have to be finalized from their aggregate states
+    if (_keys_type == KeysType::DUP_KEYS || (same_keys_num == 0 && _num_hash_merged_rows == 0)) {
         if (_keys_type == KeysType::DUP_KEYS && _tablet_schema->num_key_columns() == 0) {
             _output_mutable_block.swap(_input_mutable_block);
         } else {
@@ -34,10 +34,13 @@
 #include "runtime/memory/mem_tracker.h"
 #include "vec/aggregate_functions/aggregate_function.h"
 #include "vec/common/arena.h"
+#include "vec/common/hash_table/ph_hash_map.h"
+#include "vec/common/string_ref.h"
 #include "vec/core/block.h"
 
 namespace doris {
 
+class KeyCoder;
 class Schema;
 class SlotDescriptor;
 class TabletSchema;
@@ -117,6 +120,8 @@ public:
     uint8_t operator[](int i) const { return _bits[i - _begin]; }
     uint8_t& operator[](int i) { return _bits[i - _begin]; }
     Iter iter() { return Iter(*this); }
+    size_t begin() const { return _begin; }
+    size_t end() const { return _end; }
 
 private:
     const size_t _begin;
@@ -138,6 +143,29 @@ private:
     vectorized::MutableBlock* _pblock; //  corresponds to Memtable::_input_mutable_block
 };
 
+// Sort rows by the leading key columns at once, instead of comparing them column by column
+// through IColumn::compare_at. The value of each such column is encoded into a fixed width
+// memcomparable key with its KeyCoder, so rows are compared by memcmp on the keys.
+// Only the leading key columns whose memtable representation is the same as storage format
+// and has fixed width are normalized, eg. integers, DATEV2 and DECIMALV3. The remaining
+// key columns have to be sorted in the ranges of equal normalized keys.
+class NormalizedKeySorter {
+public:
+    NormalizedKeySorter(const TabletSchema* tablet_schema);
+
+    // Number of leading key columns in normalized key, 0 means it is not applicable.
+    size_t num_columns() const { return _key_coders.size(); }
+
+    // Sort the rows of `tie' range in `row_in_blocks' by normalized key, and mark the rows
+    // whose normalized key equals to the previous row in `tie'.
+    void sort(const vectorized::MutableBlock& block, std::vector<RowInBlock*>& row_in_blocks,
+              Tie& tie) const;
+
+private:
+    std::vector<const KeyCoder*> _key_coders;
+    std::vector<size_t> _key_sizes;
+};
+
 class MemTableStat {
 public:
     MemTableStat& operator+=(const MemTableStat& stat) {
@@ -172,9 +200,15 @@ public:
     ~MemTable();
 
     int64_t tablet_id() const { return _tablet_id; }
+    KeysType keys_type() const { return _keys_type; }
+    const TabletSchema* tablet_schema() const { return _tablet_schema; }
     size_t memory_usage() const {
-        return _insert_mem_tracker->consumption() + _arena->used_size() +
-               _flush_mem_tracker->consumption();
+        size_t usage = _insert_mem_tracker->consumption() + _arena->used_size() +
+                       _flush_mem_tracker->consumption();
+        if (_hash_agg_map != nullptr) {
+            usage += _hash_agg_map->get_buffer_size_in_bytes() + _hash_key_arena->used_size();
+        }
+        return usage;
     }
     // insert tuple from (row_pos) to (row_pos+num_rows)
     void insert(const vectorized::Block* block, const std::vector<int>& row_idxs,
@@ -198,6 +232,9 @@ private:
     // for vectorized
     void _aggregate_two_row_in_block(vectorized::MutableBlock& mutable_block, RowInBlock* new_row,
                                      RowInBlock* row_in_skiplist);
+    // Merge the rows of `row_idxs' in `block' into the rows of the same key in memtable by
+    // hash table, only the rows of new keys are appended to _input_mutable_block.
+    void _insert_with_hash_agg(const vectorized::Block& block, const std::vector<int>& row_idxs);
 
 private:
     int64_t _tablet_id;
@@ -206,6 +243,7 @@ private:
     const TabletSchema* _tablet_schema;
 
     std::shared_ptr<RowInBlockComparator> _vec_row_comparator;
+    std::unique_ptr<NormalizedKeySorter> _normalized_key_sorter;
 
     // `_insert_manual_mem_tracker` manually records the memory value of memtable insert()
     // `_flush_hook_mem_tracker` automatically records the memory value of memtable flush() through mem hook.
@@ -255,6 +293,16 @@ private:
     std::vector<size_t> _offsets_of_aggregate_states;
     size_t _total_size_of_aggregate_states;
     std::vector<RowInBlock*> _row_in_blocks;
+
+    // Maps the serialized key columns to the first row of the key, so the rows of aggregate
+    // key table are merged on insert. Only used if enable_memtable_hash_aggregation is set.
+    using RowInBlockHashMap = PHHashMap<StringRef, RowInBlock*, DefaultHash<StringRef>>;
+    std::unique_ptr<RowInBlockHashMap> _hash_agg_map;
+    // The serialized keys in _hash_agg_map.
+    std::unique_ptr<vectorized::Arena> _hash_key_arena;
+    // Number of rows merged on insert by _hash_agg_map.
+    size_t _num_hash_merged_rows = 0;
+
     // Memory usage without _arena.
     size_t _mem_usage;
 
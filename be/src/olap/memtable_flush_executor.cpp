@@ -27,6 +27,8 @@
 #include "common/logging.h"
 #include "olap/memtable.h"
 #include "olap/rowset/rowset_writer.h"
+#include "olap/tablet_schema.h"
+#include "util/countdown_latch.h"
 #include "util/doris_metrics.h"
 #include "util/stopwatch.hpp"
 #include "util/time.h"
@@ -37,23 +39,23 @@ using namespace ErrorCode;
 class MemtableFlushTask final : public Runnable {
 public:
     MemtableFlushTask(FlushToken* flush_token, std::unique_ptr<MemTable> memtable,
-                      int32_t segment_id, int64_t submit_task_time)
+                      std::vector<int32_t> segment_ids, int64_t submit_task_time)
             : _flush_token(flush_token),
               _memtable(std::move(memtable)),
-              _segment_id(segment_id),
+              _segment_ids(std::move(segment_ids)),
               _submit_task_time(submit_task_time) {}
 
     ~MemtableFlushTask() override = default;
 
     void run() override {
-        _flush_token->_flush_memtable(_memtable.get(), _segment_id, _submit_task_time);
+        _flush_token->_flush_memtable(_memtable.get(), _segment_ids, _submit_task_time);
         _memtable.reset();
     }
 
 private:
     FlushToken* _flush_token;
     std::unique_ptr<MemTable> _memtable;
-    int32_t _segment_id;
+    std::vector<int32_t> _segment_ids;
     int64_t _submit_task_time;
 };
 
@@ -76,8 +78,14 @@ Status FlushToken::submit(std::unique_ptr<MemTable> mem_table) {
         return Status::OK();
     }
     int64_t submit_task_time = MonotonicNanos();
-    auto task = std::make_shared<MemtableFlushTask>(
-            this, std::move(mem_table), _rowset_writer->allocate_segment_id(), submit_task_time);
+    // segment ids are allocated in the order of submission, so that the segments of a later
+    // memtable always have larger ids, no matter which memtable finishes flushing first
+    std::vector<int32_t> segment_ids(_num_flush_segments(mem_table.get()));
+    for (auto& segment_id : segment_ids) {
+        segment_id = _rowset_writer->allocate_segment_id();
+    }
+    auto task = std::make_shared<MemtableFlushTask>(this, std::move(mem_table),
+                                                    std::move(segment_ids), submit_task_time);
     _stats.flush_running_count++;
     return _flush_token->submit(std::move(task));
 }
@@ -92,17 +100,76 @@ Status FlushToken::wait() {
     return s == OK ? Status::OK() : Status::Error(s, "FlushToken meet error");
 }
 
-Status FlushToken::_do_flush_memtable(MemTable* memtable, int32_t segment_id, int64_t* flush_size) {
+int32_t FlushToken::_num_flush_segments(MemTable* memtable) const {
+    // Rows of unique and aggregate key tables are merged while flushing, the number of rows
+    // is unknown here, so a key range might be empty and leave a hole in segment ids.
+    if (_split_pool == nullptr || config::memtable_flush_split_min_rows <= 0 ||
+        memtable->keys_type() != KeysType::DUP_KEYS ||
+        memtable->tablet_schema()->is_dynamic_schema()) {
+        return 1;
+    }
+    int64_t num_segments = memtable->stat().raw_rows / config::memtable_flush_split_min_rows;
+    return std::clamp<int64_t>(num_segments, 1, std::max(config::memtable_flush_split_max_num, 1));
+}
+
+Status FlushToken::_flush_block_in_ranges(MemTable* memtable, const vectorized::Block* block,
+                                          const std::vector<int32_t>& segment_ids,
+                                          int64_t* flush_size) {
+    const size_t num_rows = block->rows();
+    const size_t num_ranges = segment_ids.size();
+    if (num_rows < num_ranges) {
+        return Status::InternalError("too few rows to flush into {} segments, rows={}",
+                                     num_ranges, num_rows);
+    }
+    std::vector<Status> statuses(num_ranges);
+    std::vector<int64_t> flush_sizes(num_ranges, 0);
+    auto flush_range = [&](size_t i) {
+        SCOPED_CONSUME_MEM_TRACKER(memtable->flush_mem_tracker());
+        size_t row_begin = num_rows * i / num_ranges;
+        size_t row_end = num_rows * (i + 1) / num_ranges;
+        SKIP_MEMORY_CHECK(statuses[i] = _rowset_writer->flush_memtable_rows(
+                                  block, row_begin, row_end - row_begin, segment_ids[i],
+                                  &flush_sizes[i]));
+    };
+
+    // the first range is written by current thread
+    CountDownLatch latch(num_ranges - 1);
+    for (size_t i = 1; i < num_ranges; ++i) {
+        auto st = _split_pool->submit_func([&flush_range, &latch, i]() {
+            flush_range(i);
+            latch.count_down();
+        });
+        if (!st.ok()) {
+            flush_range(i);
+            latch.count_down();
+        }
+    }
+    flush_range(0);
+    latch.wait();
+
+    *flush_size = 0;
+    for (size_t i = 0; i < num_ranges; ++i) {
+        RETURN_IF_ERROR(statuses[i]);
+        *flush_size += flush_sizes[i];
+    }
+    return Status::OK();
+}
+
+Status FlushToken::_do_flush_memtable(MemTable* memtable, const std::vector<int32_t>& segment_ids,
+                                      int64_t* flush_size) {
     VLOG_CRITICAL << "begin to flush memtable for tablet: " << memtable->tablet_id()
                   << ", memsize: " << memtable->memory_usage()
                   << ", rows: " << memtable->stat().raw_rows;
     int64_t duration_ns;
     SCOPED_RAW_TIMER(&duration_ns);
     std::unique_ptr<vectorized::Block> block = memtable->to_block();
-    {
+    if (segment_ids.size() > 1) {
+        // rows are sorted by key, so each segment holds a separate key range
+        RETURN_IF_ERROR(_flush_block_in_ranges(memtable, block.get(), segment_ids, flush_size));
+    } else {
         SCOPED_CONSUME_MEM_TRACKER(memtable->flush_mem_tracker());
         SKIP_MEMORY_CHECK(RETURN_IF_ERROR(
-                _rowset_writer->flush_memtable(block.get(), segment_id, flush_size)));
+                _rowset_writer->flush_memtable(block.get(), segment_ids[0], flush_size)));
     }
     _memtable_stat += memtable->stat();
     DorisMetrics::instance()->memtable_flush_total->increment(1);
@@ -112,7 +179,8 @@ Status FlushToken::_do_flush_memtable(MemTable* memtable, int32_t segment_id, in
     return Status::OK();
 }
 
-void FlushToken::_flush_memtable(MemTable* memtable, int32_t segment_id, int64_t submit_task_time) {
+void FlushToken::_flush_memtable(MemTable* memtable, const std::vector<int32_t>& segment_ids,
+                                 int64_t submit_task_time) {
     uint64_t flush_wait_time_ns = MonotonicNanos() - submit_task_time;
     _stats.flush_wait_time_ns += flush_wait_time_ns;
     // If previous flush has failed, return directly
@@ -125,7 +193,7 @@ void FlushToken::_flush_memtable(MemTable* memtable, int32_t segment_id, int64_t
     size_t memory_usage = memtable->memory_usage();
 
     int64_t flush_size;
-    Status s = _do_flush_memtable(memtable, segment_id, &flush_size);
+    Status s = _do_flush_memtable(memtable, segment_ids, &flush_size);
 
     if (!s) {
         LOG(WARNING) << "Flush memtable failed with res = " << s;
@@ -163,6 +231,15 @@ void MemTableFlushExecutor::init(const std::vector<DataDir*>& data_dirs) {
             .set_min_threads(min_threads)
             .set_max_threads(max_threads)
             .build(&_high_prio_flush_pool);
+
+    if (config::flush_split_thread_num_per_store > 0) {
+        min_threads = config::flush_split_thread_num_per_store;
+        max_threads = data_dir_num * min_threads;
+        ThreadPoolBuilder("MemTableSplitFlushThreadPool")
+                .set_min_threads(min_threads)
+                .set_max_threads(max_threads)
+                .build(&_split_flush_pool);
+    }
 }
 
 // NOTE: we use SERIAL mode here to ensure all mem-tables from one tablet are flushed in order.
@@ -173,21 +250,25 @@ Status MemTableFlushExecutor::create_flush_token(std::unique_ptr<FlushToken>& fl
         if (rowset_writer->type() == BETA_ROWSET && !should_serial) {
             // beta rowset can be flush in CONCURRENT, because each memtable using a new segment writer.
             flush_token.reset(
-                    new FlushToken(_flush_pool->new_token(ThreadPool::ExecutionMode::CONCURRENT)));
+                    new FlushToken(_flush_pool->new_token(ThreadPool::ExecutionMode::CONCURRENT),
+                                   _split_flush_pool.get()));
         } else {
             // alpha rowset do not support flush in CONCURRENT.
             flush_token.reset(
-                    new FlushToken(_flush_pool->new_token(ThreadPool::ExecutionMode::SERIAL)));
+                    new FlushToken(_flush_pool->new_token(ThreadPool::ExecutionMode::SERIAL),
+                                   _split_flush_pool.get()));
         }
     } else {
         if (rowset_writer->type() == BETA_ROWSET && !should_serial) {
             // beta rowset can be flush in CONCURRENT, because each memtable using a new segment writer.
             flush_token.reset(new FlushToken(
-                    _high_prio_flush_pool->new_token(ThreadPool::ExecutionMode::CONCURRENT)));
+                    _high_prio_flush_pool->new_token(ThreadPool::ExecutionMode::CONCURRENT),
+                    _split_flush_pool.get()));
         } else {
             // alpha rowset do not support flush in CONCURRENT.
             flush_token.reset(new FlushToken(
-                    _high_prio_flush_pool->new_token(ThreadPool::ExecutionMode::SERIAL)));
+                    _high_prio_flush_pool->new_token(ThreadPool::ExecutionMode::SERIAL),
+                    _split_flush_pool.get()));
         }
     }
     flush_token->set_rowset_writer(rowset_writer);
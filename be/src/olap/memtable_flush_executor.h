@@ -55,10 +55,15 @@ std::ostream& operator<<(std::ostream& os, const FlushStatistic& stat);
 // 1. Immediately disallow submission of any subsequent memtable
 // 2. For the memtables that have already been submitted, there is no need to flush,
 //    because the entire job will definitely fail;
+// A large memtable may be split into several key ranges after it is sorted, each range is
+// written into its own segment, and the segments are written in parallel in `split_pool'.
 class FlushToken {
 public:
-    explicit FlushToken(std::unique_ptr<ThreadPoolToken> flush_pool_token)
-            : _flush_token(std::move(flush_pool_token)), _flush_status(ErrorCode::OK) {}
+    explicit FlushToken(std::unique_ptr<ThreadPoolToken> flush_pool_token,
+                        ThreadPool* split_pool = nullptr)
+            : _flush_token(std::move(flush_pool_token)),
+              _split_pool(split_pool),
+              _flush_status(ErrorCode::OK) {}
 
     Status submit(std::unique_ptr<MemTable> mem_table);
 
@@ -79,12 +84,24 @@ public:
 private:
     friend class MemtableFlushTask;
 
-    void _flush_memtable(MemTable* mem_table, int32_t segment_id, int64_t submit_task_time);
+    void _flush_memtable(MemTable* mem_table, const std::vector<int32_t>& segment_ids,
+                         int64_t submit_task_time);
 
-    Status _do_flush_memtable(MemTable* memtable, int32_t segment_id, int64_t* flush_size);
+    Status _do_flush_memtable(MemTable* memtable, const std::vector<int32_t>& segment_ids,
+                              int64_t* flush_size);
+
+    // Return the number of segments the memtable will be flushed into.
+    int32_t _num_flush_segments(MemTable* memtable) const;
+
+    // Write the rows of the sorted block into segments of `segment_ids' in parallel, each
+    // segment gets a continuous range of rows.
+    Status _flush_block_in_ranges(MemTable* memtable, const vectorized::Block* block,
+                                  const std::vector<int32_t>& segment_ids, int64_t* flush_size);
 
     std::unique_ptr<ThreadPoolToken> _flush_token;
 
+    ThreadPool* _split_pool;
+
     // Records the current flush status of the tablet.
     // Note: Once its value is set to Failed, it cannot return to SUCCESS.
     std::atomic<int> _flush_status;
@@ -111,6 +128,9 @@ public:
     ~MemTableFlushExecutor() {
         _flush_pool->shutdown();
         _high_prio_flush_pool->shutdown();
+        if (_split_flush_pool) {
+            _split_flush_pool->shutdown();
+        }
     }
 
     // init should be called after storage engine is opened,
@@ -123,6 +143,8 @@ public:
 private:
     std::unique_ptr<ThreadPool> _flush_pool;
     std::unique_ptr<ThreadPool> _high_prio_flush_pool;
+    // for writing the key ranges of a split memtable
+    std::unique_ptr<ThreadPool> _split_flush_pool;
 };
 
 } // namespace doris
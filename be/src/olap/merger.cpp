@@ -22,8 +22,10 @@
 #include <stddef.h>
 
 #include <algorithm>
+#include <atomic>
 #include <iterator>
 #include <memory>
+#include <mutex>
 #include <numeric>
 #include <ostream>
 #include <shared_mutex>
@@ -37,14 +39,23 @@
 #include "olap/olap_define.h"
 #include "olap/reader.h"
 #include "olap/rowid_conversion.h"
+#include "olap/rowset/beta_rowset.h"
 #include "olap/rowset/rowset.h"
 #include "olap/rowset/rowset_meta.h"
 #include "olap/rowset/rowset_writer.h"
+#include "olap/rowset/segment_v2/column_reader.h"
+#include "olap/rowset/segment_v2/encoding_info.h"
+#include "olap/rowset/segment_v2/segment.h"
 #include "olap/rowset/segment_v2/segment_writer.h"
 #include "olap/storage_engine.h"
 #include "olap/tablet.h"
+#include "olap/types.h"
 #include "olap/utils.h"
+#include "runtime/memory/mem_tracker_limiter.h"
+#include "runtime/thread_context.h"
+#include "util/countdown_latch.h"
 #include "util/slice.h"
+#include "util/threadpool.h"
 #include "vec/core/block.h"
 #include "vec/olap/block_reader.h"
 #include "vec/olap/vertical_block_reader.h"
@@ -188,7 +199,8 @@ Status Merger::vertical_compact_one_group(
         TabletSharedPtr tablet, ReaderType reader_type, TabletSchemaSPtr tablet_schema, bool is_key,
         const std::vector<uint32_t>& column_group, vectorized::RowSourcesBuffer* row_source_buf,
         const std::vector<RowsetReaderSharedPtr>& src_rowset_readers,
-        RowsetWriter* dst_rowset_writer, int64_t max_rows_per_segment, Statistics* stats_output) {
+        RowsetWriter* dst_rowset_writer, int64_t max_rows_per_segment, Statistics* stats_output,
+        ColumnGroupWriter* column_group_writer) {
     // build tablet reader
     VLOG_NOTICE << "vertical compact one group, max_rows_per_segment=" << max_rows_per_segment;
     vectorized::VerticalBlockReader reader(row_source_buf);
@@ -245,7 +257,10 @@ Status Merger::vertical_compact_one_group(
                 reader.next_block_with_aggregation(&block, &eof),
                 "failed to read next block when merging rowsets of tablet " + tablet->full_name());
         RETURN_NOT_OK_STATUS_WITH_WARN(
-                dst_rowset_writer->add_columns(&block, column_group, is_key, max_rows_per_segment),
+                column_group_writer != nullptr
+                        ? column_group_writer->add_columns(&block)
+                        : dst_rowset_writer->add_columns(&block, column_group, is_key,
+                                                         max_rows_per_segment),
                 "failed to write block when merging rowsets of tablet " + tablet->full_name());
 
         if (is_key && reader_params.record_rowids && block.rows() > 0) {
@@ -267,7 +282,11 @@ Status Merger::vertical_compact_one_group(
         stats_output->merged_rows = reader.merged_rows();
         stats_output->filtered_rows = reader.filtered_rows();
     }
-    RETURN_IF_ERROR(dst_rowset_writer->flush_columns(is_key));
+    if (column_group_writer != nullptr) {
+        RETURN_IF_ERROR(column_group_writer->flush_columns());
+    } else {
+        RETURN_IF_ERROR(dst_rowset_writer->flush_columns(is_key));
+    }
 
     return Status::OK();
 }
@@ -328,6 +347,104 @@ Status Merger::vertical_compact_one_group(TabletSharedPtr tablet, ReaderType rea
     return Status::OK();
 }
 
+Status Merger::_vertical_compact_value_groups_in_parallel(
+        TabletSharedPtr tablet, ReaderType reader_type, TabletSchemaSPtr tablet_schema,
+        const std::vector<std::vector<uint32_t>>& column_groups,
+        const vectorized::RowSourcesBuffer* row_sources_buf,
+        const std::vector<RowsetReaderSharedPtr>& src_rowset_readers,
+        RowsetWriter* dst_rowset_writer, int64_t max_rows_per_segment) {
+    ThreadPool* pool = StorageEngine::instance()->vertical_compaction_thread_pool();
+    CompactionPermitLimiter* limiter = StorageEngine::instance()->compaction_permit_limiter();
+    // each helper thread holds as many permits as the compaction itself
+    int64_t permits = 0;
+    for (auto& rs_reader : src_rowset_readers) {
+        permits += rs_reader->rowset()->rowset_meta()->get_compaction_score();
+    }
+
+    std::atomic<size_t> next_group = 1;
+    std::mutex status_lock;
+    Status status;
+    auto compact_groups = [&]() {
+        for (size_t i = next_group++; i < column_groups.size(); i = next_group++) {
+            std::vector<RowsetReaderSharedPtr> rs_readers;
+            rs_readers.reserve(src_rowset_readers.size());
+            for (auto& rs_reader : src_rowset_readers) {
+                rs_readers.push_back(rs_reader->clone());
+            }
+            std::unique_ptr<vectorized::RowSourcesBuffer> row_sources_reader;
+            std::unique_ptr<ColumnGroupWriter> column_group_writer;
+            Status st = row_sources_buf->create_reader(&row_sources_reader);
+            if (st.ok()) {
+                st = dst_rowset_writer->create_column_group_writer(column_groups[i],
+                                                                   &column_group_writer);
+            }
+            if (st.ok()) {
+                st = vertical_compact_one_group(tablet, reader_type, tablet_schema, false,
+                                                column_groups[i], row_sources_reader.get(),
+                                                rs_readers, dst_rowset_writer, max_rows_per_segment,
+                                                nullptr, column_group_writer.get());
+            }
+            if (!st.ok()) {
+                std::lock_guard<std::mutex> l(status_lock);
+                if (status.ok()) {
+                    status = st;
+                }
+                // stop picking up more groups
+                next_group = column_groups.size();
+            }
+        }
+    };
+
+    // the current thread compacts groups too, helpers only run with the permits acquired
+    size_t max_helpers = std::min<size_t>(config::vertical_compaction_parallel_group_threads,
+                                          column_groups.size() - 2);
+    // A group in flight holds the encoded data of its columns in the current output segment
+    // until the segment is finalized, which is estimated from the input size.
+    double input_rows = 0;
+    double input_bytes = 0;
+    for (auto& rs_reader : src_rowset_readers) {
+        input_rows += rs_reader->rowset()->num_rows();
+        input_bytes += rs_reader->rowset()->data_disk_size();
+    }
+    size_t max_group_columns = 0;
+    for (size_t i = 1; i < column_groups.size(); ++i) {
+        max_group_columns = std::max(max_group_columns, column_groups[i].size());
+    }
+    if (input_rows > 0) {
+        double group_bytes = input_bytes / input_rows *
+                             std::min<double>(input_rows, max_rows_per_segment) *
+                             max_group_columns / tablet_schema->num_columns();
+        double max_groups_in_flight =
+                config::vertical_compaction_parallel_group_max_memory_mb * 1024.0 * 1024.0 /
+                std::max(group_bytes, 1.0);
+        if (max_groups_in_flight < max_helpers + 1) {
+            max_helpers = static_cast<size_t>(std::max(max_groups_in_flight, 1.0)) - 1;
+        }
+    }
+    size_t num_helpers = 0;
+    while (num_helpers < max_helpers && limiter->try_request(permits)) {
+        ++num_helpers;
+    }
+    auto mem_tracker = thread_context()->thread_mem_tracker_mgr->limiter_mem_tracker();
+    CountDownLatch latch(num_helpers);
+    for (size_t i = 0; i < num_helpers; ++i) {
+        auto st = pool->submit_func([&compact_groups, &latch, &mem_tracker]() {
+            SCOPED_ATTACH_TASK(mem_tracker);
+            compact_groups();
+            latch.count_down();
+        });
+        if (!st.ok()) {
+            latch.count_down();
+        }
+    }
+    compact_groups();
+    latch.wait();
+    limiter->release(permits * num_helpers);
+    VLOG_NOTICE << "compact " << column_groups.size() - 1 << " value column groups of tablet "
+                << tablet->tablet_id() << " with " << num_helpers << " helper threads";
+    return status;
+}
+
 // steps to do vertical merge:
 // 1. split columns into column groups
 // 2. compact groups one by one, generate a row_source_buf when compact key group
@@ -344,6 +461,22 @@ Status Merger::vertical_merge_rowsets(TabletSharedPtr tablet, ReaderType reader_
 
     vectorized::RowSourcesBuffer row_sources_buf(tablet->tablet_id(), tablet->tablet_path(),
                                                  reader_type);
+    // compact value groups in parallel after the key group produces the row sources
+    ThreadPool* pool = StorageEngine::instance()->vertical_compaction_thread_pool();
+    if (pool != nullptr && column_groups.size() > 2) {
+        RETURN_IF_ERROR(vertical_compact_one_group(
+                tablet, reader_type, tablet_schema, true, column_groups[0], &row_sources_buf,
+                src_rowset_readers, dst_rowset_writer, max_rows_per_segment, stats_output));
+        // readers of the value groups only share the buffer file
+        RETURN_IF_ERROR(row_sources_buf.persist());
+        RETURN_IF_ERROR(_vertical_compact_value_groups_in_parallel(
+                tablet, reader_type, tablet_schema, column_groups, &row_sources_buf,
+                src_rowset_readers, dst_rowset_writer, max_rows_per_segment));
+        VLOG_NOTICE << "finish compact groups";
+        RETURN_IF_ERROR(dst_rowset_writer->final_flush());
+        return Status::OK();
+    }
+
     // compact group one by one
     for (auto i = 0; i < column_groups.size(); ++i) {
         VLOG_NOTICE << "row source size: " << row_sources_buf.total_size();
@@ -364,4 +497,102 @@ Status Merger::vertical_merge_rowsets(TabletSharedPtr tablet, ReaderType reader_
     return Status::OK();
 }
 
+bool Merger::can_copy_column_pages(const TabletSchema& tablet_schema, const TabletColumn& column) {
+    if (column.is_key() || column.is_bf_column() || column.has_bitmap_index() ||
+        tablet_schema.get_inverted_index(column.unique_id()) != nullptr ||
+        tablet_schema.get_ngram_bf_index(column.unique_id()) != nullptr) {
+        return false;
+    }
+    // the zone maps of copied pages are merged from their string form, which is exact for
+    // integer and date types only
+    switch (column.type()) {
+    case FieldType::OLAP_FIELD_TYPE_TINYINT:
+    case FieldType::OLAP_FIELD_TYPE_SMALLINT:
+    case FieldType::OLAP_FIELD_TYPE_INT:
+    case FieldType::OLAP_FIELD_TYPE_BIGINT:
+    case FieldType::OLAP_FIELD_TYPE_LARGEINT:
+    case FieldType::OLAP_FIELD_TYPE_DATE:
+    case FieldType::OLAP_FIELD_TYPE_DATETIME:
+    case FieldType::OLAP_FIELD_TYPE_DATEV2:
+        return true;
+    default:
+        return false;
+    }
+}
+
+Status Merger::page_copy_rowsets(TabletSharedPtr tablet, TabletSchemaSPtr tablet_schema,
+                                 const std::vector<RowsetReaderSharedPtr>& src_rowset_readers,
+                                 RowsetWriter* dst_rowset_writer, int64_t max_rows_per_segment,
+                                 Statistics* stats_output) {
+    LOG(INFO) << "Start to do page copy compaction, tablet_id: " << tablet->tablet_id();
+    std::vector<segment_v2::SegmentSharedPtr> segments;
+    for (auto& rs_reader : src_rowset_readers) {
+        std::vector<segment_v2::SegmentSharedPtr> rowset_segments;
+        RETURN_IF_ERROR(std::static_pointer_cast<BetaRowset>(rs_reader->rowset())
+                                ->load_segments(&rowset_segments));
+        for (auto& segment : rowset_segments) {
+            if (segment->num_rows() > 0) {
+                segments.push_back(std::move(segment));
+            }
+        }
+    }
+
+    // a column is copied only if the pages of all the segments are written the same way as
+    // the output segment does
+    std::vector<uint32_t> copy_col_ids;
+    for (uint32_t cid = 0; cid < tablet_schema->num_columns(); ++cid) {
+        const auto& column = tablet_schema->column(cid);
+        if (!can_copy_column_pages(*tablet_schema, column)) {
+            continue;
+        }
+        auto type_info = get_type_info(&column);
+        auto encoding = segment_v2::EncodingInfo::get_default_encoding(type_info.get(), false);
+        bool can_copy = std::all_of(segments.begin(), segments.end(), [&](const auto& segment) {
+            auto* reader = segment->get_column_reader(column.unique_id());
+            return reader != nullptr && reader->get_encoding() == encoding &&
+                   reader->get_compression() == tablet_schema->compression_type() &&
+                   !reader->has_dict_page() && reader->has_zone_map();
+        });
+        if (can_copy) {
+            copy_col_ids.push_back(cid);
+        }
+    }
+
+    // every output segment is made up of whole input segments
+    OlapReaderStatistics stats;
+    std::vector<segment_v2::SegmentSharedPtr> group;
+    int64_t group_rows = 0;
+    int64_t output_rows = 0;
+    for (size_t i = 0; i <= segments.size(); ++i) {
+        if (!group.empty() &&
+            (i == segments.size() || group_rows + segments[i]->num_rows() > max_rows_per_segment)) {
+            if (StorageEngine::instance()->stopped()) {
+                return Status::Error<INTERNAL_ERROR>("tablet {} failed to do compaction, engine "
+                                                     "stopped",
+                                                     tablet->full_name());
+            }
+            RETURN_IF_ERROR(dst_rowset_writer->add_segment_by_page_copy(group, copy_col_ids,
+                                                                        &stats));
+            output_rows += group_rows;
+            group.clear();
+            group_rows = 0;
+        }
+        if (i < segments.size()) {
+            group_rows += segments[i]->num_rows();
+            group.push_back(segments[i]);
+        }
+    }
+
+    if (stats_output != nullptr) {
+        stats_output->output_rows = output_rows;
+        stats_output->merged_rows = 0;
+        stats_output->filtered_rows = 0;
+    }
+    LOG(INFO) << "finish page copy compaction, tablet_id: " << tablet->tablet_id()
+              << ", input segments: " << segments.size() << ", copied columns: "
+              << copy_col_ids.size() << "/" << tablet_schema->num_columns();
+    RETURN_IF_ERROR(dst_rowset_writer->final_flush());
+    return Status::OK();
+}
+
 } // namespace doris
@@ -28,6 +28,7 @@
 #include "olap/tablet_schema.h"
 
 namespace doris {
+class ColumnGroupWriter;
 class KeyBoundsPB;
 class RowIdConversion;
 class RowsetWriter;
@@ -64,6 +65,15 @@ public:
             const std::vector<RowsetReaderSharedPtr>& src_rowset_readers,
             RowsetWriter* dst_rowset_writer, int64_t max_rows_per_segment,
             Statistics* stats_output);
+    // Compact rowsets whose segments are sorted by key and do not overlap with each other, no
+    // row is merged or filtered. The data pages of the value columns that `can_copy_column_pages`
+    // are copied into the output segments without decoding, the other columns are rewritten.
+    static Status page_copy_rowsets(TabletSharedPtr tablet, TabletSchemaSPtr tablet_schema,
+                                    const std::vector<RowsetReaderSharedPtr>& src_rowset_readers,
+                                    RowsetWriter* dst_rowset_writer, int64_t max_rows_per_segment,
+                                    Statistics* stats_output);
+    static bool can_copy_column_pages(const TabletSchema& tablet_schema,
+                                      const TabletColumn& column);
 
 public:
     // for vertical compaction
@@ -75,7 +85,7 @@ public:
             vectorized::RowSourcesBuffer* row_source_buf,
             const std::vector<RowsetReaderSharedPtr>& src_rowset_readers,
             RowsetWriter* dst_rowset_writer, int64_t max_rows_per_segment,
-            Statistics* stats_output);
+            Statistics* stats_output, ColumnGroupWriter* column_group_writer = nullptr);
 
     // for segcompaction
     static Status vertical_compact_one_group(TabletSharedPtr tablet, ReaderType reader_type,
@@ -86,6 +96,15 @@ public:
                                              segment_v2::SegmentWriter& dst_segment_writer,
                                              int64_t max_rows_per_segment, Statistics* stats_output,
                                              uint64_t* index_size, KeyBoundsPB& key_bounds);
+
+private:
+    // compact the value column groups `column_groups[1..]` in parallel
+    static Status _vertical_compact_value_groups_in_parallel(
+            TabletSharedPtr tablet, ReaderType reader_type, TabletSchemaSPtr tablet_schema,
+            const std::vector<std::vector<uint32_t>>& column_groups,
+            const vectorized::RowSourcesBuffer* row_sources_buf,
+            const std::vector<RowsetReaderSharedPtr>& src_rowset_readers,
+            RowsetWriter* dst_rowset_writer, int64_t max_rows_per_segment);
 };
 
 } // namespace doris
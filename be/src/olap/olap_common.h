@@ -340,6 +340,9 @@ struct OlapReaderStatistics {
 
     int64_t total_pages_num = 0;
     int64_t cached_pages_num = 0;
+    // merged reads issued ahead of decoding, and the pages they put into the page cache
+    int64_t prefetch_io_num = 0;
+    int64_t prefetched_pages_num = 0;
 
     int64_t rows_bitmap_index_filtered = 0;
     int64_t bitmap_index_filter_timer = 0;
@@ -359,6 +362,8 @@ struct OlapReaderStatistics {
     int64_t filtered_segment_number = 0;
     // total number of segment
     int64_t total_segment_number = 0;
+    // number of rowsets merged by key when reading
+    int64_t merged_rowset_number = 0;
 
     io::FileCacheStatistics file_cache_stats;
     int64_t load_segments_timer = 0;
@@ -141,6 +141,12 @@ Status StorageEngine::start_bg_threads() {
             .set_min_threads(config::cold_data_compaction_thread_num)
             .set_max_threads(config::cold_data_compaction_thread_num)
             .build(&_cold_data_compaction_thread_pool);
+    if (config::vertical_compaction_parallel_group_threads > 0) {
+        ThreadPoolBuilder("VerticalCompactionGroupThreadPool")
+                .set_min_threads(config::vertical_compaction_parallel_group_threads)
+                .set_max_threads(config::vertical_compaction_parallel_group_threads)
+                .build(&_vertical_compaction_thread_pool);
+    }
 
     // compaction tasks producer thread
     RETURN_IF_ERROR(Thread::create(
@@ -166,6 +172,11 @@ Status StorageEngine::start_bg_threads() {
             .set_min_threads(config::multi_get_max_threads)
             .set_max_threads(config::multi_get_max_threads)
             .build(&_bg_multi_get_thread_pool);
+
+    ThreadPoolBuilder("PrimaryKeyFilterThreadPool")
+            .set_min_threads(config::primary_key_filter_thread_num)
+            .set_max_threads(config::primary_key_filter_thread_num)
+            .build(&_primary_key_filter_thread_pool);
     RETURN_IF_ERROR(Thread::create(
             "StorageEngine", "tablet_checkpoint_tasks_producer_thread",
             [this, data_dirs]() { this->_tablet_checkpoint_callback(data_dirs); },
@@ -1016,6 +1027,36 @@ Status StorageEngine::submit_seg_compaction_task(SegcompactionWorker* worker,
             std::bind<void>(&StorageEngine::_handle_seg_compaction, this, worker, segments));
 }
 
+Status StorageEngine::submit_update_primary_key_filter_task(TabletSharedPtr tablet) {
+    if (_primary_key_filter_thread_pool == nullptr) {
+        return tablet->update_primary_key_filter();
+    }
+    {
+        std::lock_guard<std::mutex> l(_primary_key_filter_mutex);
+        if (!_primary_key_filter_submitted_tablets.insert(tablet->tablet_id()).second) {
+            // the queued task builds the filter over the latest rowsets anyway
+            return Status::OK();
+        }
+    }
+    auto st = _primary_key_filter_thread_pool->submit_func([this, tablet]() {
+        {
+            // a compaction finished during the build queues the tablet again
+            std::lock_guard<std::mutex> l(_primary_key_filter_mutex);
+            _primary_key_filter_submitted_tablets.erase(tablet->tablet_id());
+        }
+        auto st = tablet->update_primary_key_filter();
+        if (!st.ok()) {
+            LOG(WARNING) << "failed to update primary key filter, tablet: "
+                         << tablet->tablet_id() << ", st: " << st;
+        }
+    });
+    if (!st.ok()) {
+        std::lock_guard<std::mutex> l(_primary_key_filter_mutex);
+        _primary_key_filter_submitted_tablets.erase(tablet->tablet_id());
+    }
+    return st;
+}
+
 Status StorageEngine::process_index_change_task(const TAlterInvertedIndexReq& request) {
     auto tablet_id = request.tablet_id;
     TabletSharedPtr tablet = _tablet_manager->get_tablet(tablet_id);
@@ -19,10 +19,124 @@
 
 #include <glog/logging.h>
 
+#include <algorithm>
 #include <ostream>
 
+#include "common/config.h"
+#include "util/bit_util.h"
+#include "util/doris_metrics.h"
+#include "util/hash_util.hpp"
+
 namespace doris {
 
+FrequencySketch::FrequencySketch(size_t width)
+        : _width(BitUtil::RoundUpToPowerOfTwo(std::max<size_t>(width, 1))),
+          _sample_size(10 * _width),
+          _counters(new std::atomic<uint8_t>[kDepth * _width]()) {}
+
+void FrequencySketch::increment(uint64_t hash) {
+    size_t indexes[kDepth];
+    uint8_t min_count = kMaxFrequency;
+    for (int row = 0; row < kDepth; ++row) {
+        indexes[row] = _index(hash, row);
+        min_count = std::min(min_count, _counters[indexes[row]].load(std::memory_order_relaxed));
+    }
+    if (min_count == kMaxFrequency) {
+        return;
+    }
+    // conservative update: only the smallest counters are increased, which keeps the
+    // overestimation caused by hash collisions low
+    for (int row = 0; row < kDepth; ++row) {
+        if (_counters[indexes[row]].load(std::memory_order_relaxed) == min_count) {
+            _counters[indexes[row]].store(static_cast<uint8_t>(min_count + 1),
+                                          std::memory_order_relaxed);
+        }
+    }
+    if (_additions.fetch_add(1, std::memory_order_relaxed) + 1 >= _sample_size) {
+        _age();
+    }
+}
+
+uint32_t FrequencySketch::frequency(uint64_t hash) const {
+    uint8_t min_count = kMaxFrequency;
+    for (int row = 0; row < kDepth; ++row) {
+        min_count = std::min(min_count,
+                             _counters[_index(hash, row)].load(std::memory_order_relaxed));
+    }
+    return min_count;
+}
+
+void FrequencySketch::_age() {
+    std::unique_lock<std::mutex> lock(_age_lock, std::try_to_lock);
+    if (!lock.owns_lock() || _additions.load(std::memory_order_relaxed) < _sample_size) {
+        // another thread is aging or has just aged the counters
+        return;
+    }
+    for (size_t i = 0; i < kDepth * _width; ++i) {
+        _counters[i].store(static_cast<uint8_t>(_counters[i].load(std::memory_order_relaxed) >> 1),
+                           std::memory_order_relaxed);
+    }
+    _additions.store(_sample_size / 2, std::memory_order_relaxed);
+}
+
+// Pages are 64KB in general, but small pages are common in small segments and index pages,
+// so reserve one counter per 16KB of the cache.
+static constexpr size_t kSketchBytesPerCounter = 16 * 1024;
+static constexpr size_t kSketchMinWidth = 1024;
+static constexpr size_t kSketchMaxWidth = 4 * 1024 * 1024;
+
+static std::unique_ptr<FrequencySketch> create_sketch(Cache* cache) {
+    size_t width = std::clamp(cache->get_total_capacity() / kSketchBytesPerCounter,
+                              kSketchMinWidth, kSketchMaxWidth);
+    return std::make_unique<FrequencySketch>(width);
+}
+
+static void update_lookup_metrics(segment_v2::PageTypePB page_type, bool hit) {
+    auto* metrics = DorisMetrics::instance();
+    switch (page_type) {
+    case segment_v2::DATA_PAGE:
+        (hit ? metrics->data_page_cache_lookup_hit_total
+             : metrics->data_page_cache_lookup_miss_total)
+                ->increment(1);
+        break;
+    case segment_v2::INDEX_PAGE:
+        (hit ? metrics->index_page_cache_lookup_hit_total
+             : metrics->index_page_cache_lookup_miss_total)
+                ->increment(1);
+        break;
+    case segment_v2::PRIMARY_KEY_INDEX_PAGE:
+        (hit ? metrics->pk_index_page_cache_lookup_hit_total
+             : metrics->pk_index_page_cache_lookup_miss_total)
+                ->increment(1);
+        break;
+    default:
+        break;
+    }
+}
+
+static void update_admission_metrics(segment_v2::PageTypePB page_type, bool admitted) {
+    auto* metrics = DorisMetrics::instance();
+    switch (page_type) {
+    case segment_v2::DATA_PAGE:
+        (admitted ? metrics->data_page_cache_admitted_total
+                  : metrics->data_page_cache_rejected_total)
+                ->increment(1);
+        break;
+    case segment_v2::INDEX_PAGE:
+        (admitted ? metrics->index_page_cache_admitted_total
+                  : metrics->index_page_cache_rejected_total)
+                ->increment(1);
+        break;
+    case segment_v2::PRIMARY_KEY_INDEX_PAGE:
+        (admitted ? metrics->pk_index_page_cache_admitted_total
+                  : metrics->pk_index_page_cache_rejected_total)
+                ->increment(1);
+        break;
+    default:
+        break;
+    }
+}
+
 StoragePageCache* StoragePageCache::_s_instance = nullptr;
 
 void StoragePageCache::create_global_cache(size_t capacity, int32_t index_cache_percentage,
@@ -52,12 +166,25 @@ StoragePageCache::StoragePageCache(size_t capacity, int32_t index_cache_percenta
         _pk_index_page_cache =
                 std::make_unique<PKIndexPageCache>(pk_index_cache_capacity, num_shards);
     }
+
+    if (_data_page_cache) {
+        _data_page_sketch = create_sketch(_data_page_cache->get());
+    }
+    if (_index_page_cache) {
+        _index_page_sketch = create_sketch(_index_page_cache->get());
+    }
+    if (_pk_index_page_cache) {
+        _pk_index_page_sketch = create_sketch(_pk_index_page_cache->get());
+    }
 }
 
 bool StoragePageCache::lookup(const CacheKey& key, PageCacheHandle* handle,
-                              segment_v2::PageTypePB page_type) {
+                              segment_v2::PageTypePB page_type, bool record_access) {
     auto cache = _get_page_cache(page_type);
     auto lru_handle = cache->lookup(key.encode());
+    if (record_access) {
+        update_lookup_metrics(page_type, lru_handle != nullptr);
+    }
     if (lru_handle == nullptr) {
         return false;
     }
@@ -84,4 +211,33 @@ void StoragePageCache::insert(const CacheKey& key, DataPage* data, PageCacheHand
     handle->update_last_visit_time();
 }
 
+bool StoragePageCache::admit(const CacheKey& key, size_t charge,
+                             segment_v2::PageTypePB page_type, bool large_scan,
+                             bool record_access) {
+    auto sketch = _get_sketch(page_type);
+    if (!config::enable_page_cache_admission || sketch == nullptr) {
+        return true;
+    }
+    std::string encoded_key = key.encode();
+    uint64_t hash = HashUtil::xxHash64WithSeed(encoded_key.data(), encoded_key.size(), 0);
+    if (record_access) {
+        sketch->increment(hash);
+    }
+
+    bool admitted = false;
+    auto cache = _get_page_cache(page_type);
+    if (!large_scan && cache->get_usage() + charge <= cache->get_total_capacity()) {
+        // nothing needs to be evicted for this page
+        admitted = true;
+    } else {
+        // the pending access is not recorded yet, count it in
+        int frequency = sketch->frequency(hash) + (record_access ? 0 : 1);
+        admitted = frequency >= config::page_cache_admission_min_frequency;
+    }
+    if (record_access) {
+        update_admission_metrics(page_type, admitted);
+    }
+    return admitted;
+}
+
 } // namespace doris
@@ -22,7 +22,9 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 
@@ -73,9 +75,47 @@ private:
 
 using DataPage = PageBase<Allocator<false>>;
 
+// A count-min sketch estimating how often a key was seen recently. Each key maps to one
+// 4-bit counter in each of the kDepth rows, and the estimate is the minimum of them.
+// All counters are halved after every `sample size' increments, so that the frequency
+// of keys which are not seen any more decays.
+// Counters are updated without lock, lost updates under contention are acceptable.
+class FrequencySketch {
+public:
+    static constexpr uint32_t kMaxFrequency = 15;
+
+    // `width' is the number of counters per row, rounded up to a power of two.
+    explicit FrequencySketch(size_t width);
+
+    // Increase the frequency of the key with given hash by one.
+    void increment(uint64_t hash);
+
+    // Return the estimated frequency of the key with given hash.
+    uint32_t frequency(uint64_t hash) const;
+
+private:
+    static constexpr int kDepth = 4;
+
+    size_t _index(uint64_t hash, int row) const {
+        // double hashing, the odd step makes the rows independent enough
+        auto h = static_cast<uint32_t>(hash) + row * static_cast<uint32_t>((hash >> 32) | 1);
+        return row * _width + (h & (_width - 1));
+    }
+    void _age();
+
+    size_t _width;
+    size_t _sample_size;
+    std::unique_ptr<std::atomic<uint8_t>[]> _counters;
+    std::atomic<size_t> _additions {0};
+    std::mutex _age_lock;
+};
+
 // Wrapper around Cache, and used for cache page of column data
 // in Segment.
-// TODO(zc): We should add some metric to see cache hit/miss rate.
+//
+// To keep one large scan from flushing the frequently used pages out, a page read from
+// file is only admitted into a full cache after it has been missed
+// config::page_cache_admission_min_frequency times recently (see admit()).
 class StoragePageCache {
 public:
     // The unique key identifying entries in the page cache.
@@ -143,8 +183,12 @@ public:
     //
     // Cache type selection is determined by page_type argument
     //
+    // The lookup is not counted in the metrics if `record_access' is false, which is used
+    // when the page is going to be looked up again soon, eg. when it is prefetched.
+    //
     // Return true if entry is found, otherwise return false.
-    bool lookup(const CacheKey& key, PageCacheHandle* handle, segment_v2::PageTypePB page_type);
+    bool lookup(const CacheKey& key, PageCacheHandle* handle, segment_v2::PageTypePB page_type,
+                bool record_access = true);
 
     // Insert a page with key into this cache.
     // Given handle will be set to valid reference.
@@ -154,6 +198,16 @@ public:
     void insert(const CacheKey& key, DataPage* data, PageCacheHandle* handle,
                 segment_v2::PageTypePB page_type, bool in_memory = false);
 
+    // Decide whether a page missed in the cache should be inserted after it is read.
+    // `charge' is the estimated size of the page.
+    //
+    // The page is admitted if the cache still has room for it, or if it has been missed
+    // often enough recently. Pages of a large scan are admitted only by frequency.
+    // The miss is counted into the frequency and the decision into the metrics unless
+    // `record_access' is false, see lookup().
+    bool admit(const CacheKey& key, size_t charge, segment_v2::PageTypePB page_type,
+               bool large_scan, bool record_access = true);
+
     // Page cache available check.
     // When percentage is set to 0 or 100, the index or data cache will not be allocated.
     bool is_cache_available(segment_v2::PageTypePB page_type) {
@@ -172,6 +226,24 @@ private:
     // delete bitmap in unique key with mow
     std::unique_ptr<PKIndexPageCache> _pk_index_page_cache = nullptr;
 
+    // miss frequency of pages, one for each page cache above
+    std::unique_ptr<FrequencySketch> _data_page_sketch = nullptr;
+    std::unique_ptr<FrequencySketch> _index_page_sketch = nullptr;
+    std::unique_ptr<FrequencySketch> _pk_index_page_sketch = nullptr;
+
+    FrequencySketch* _get_sketch(segment_v2::PageTypePB page_type) {
+        switch (page_type) {
+        case segment_v2::DATA_PAGE:
+            return _data_page_sketch.get();
+        case segment_v2::INDEX_PAGE:
+            return _index_page_sketch.get();
+        case segment_v2::PRIMARY_KEY_INDEX_PAGE:
+            return _pk_index_page_sketch.get();
+        default:
+            return nullptr;
+        }
+    }
+
     Cache* _get_page_cache(segment_v2::PageTypePB page_type) {
         switch (page_type) {
         case segment_v2::DATA_PAGE: {
@@ -0,0 +1,226 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/primary_key_filter.h"
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <limits>
+
+#include "runtime/memory/mem_tracker.h"
+#include "util/murmur_hash3.h"
+
+namespace doris {
+
+static constexpr uint32_t kFingerprintMask = 0xffff0000;
+static constexpr uint32_t kSegmentMask = 0x0000ffff;
+static constexpr int kMaxBuildAttempts = 16;
+
+static inline uint64_t mix64(uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+static inline uint64_t rotl64(uint64_t h, int r) {
+    return (h << r) | (h >> (64 - r));
+}
+
+// map a 32 bit hash to [0, n) without division
+static inline uint32_t reduce(uint32_t hash, uint32_t n) {
+    return static_cast<uint32_t>((static_cast<uint64_t>(hash) * n) >> 32);
+}
+
+static inline uint32_t fingerprint(uint64_t hash) {
+    return static_cast<uint32_t>(hash ^ (hash >> 32)) & kFingerprintMask;
+}
+
+PrimaryKeyFilter::PrimaryKeyFilter(const std::vector<RowsetSharedPtr>& rowsets, int64_t version,
+                                   std::shared_ptr<MemTracker> mem_tracker)
+        : _version(version), _mem_tracker(std::move(mem_tracker)) {
+    _rowset_ids.reserve(rowsets.size());
+    for (auto& rs : rowsets) {
+        _rowset_ids.push_back(rs->rowset_id());
+    }
+}
+
+PrimaryKeyFilter::~PrimaryKeyFilter() {
+    if (_mem_tracker != nullptr) {
+        _mem_tracker->release(_tracked_bytes);
+    }
+}
+
+Status PrimaryKeyFilter::start_segment(uint32_t rowset_idx, uint32_t segment_id) {
+    DCHECK_LT(rowset_idx, _rowset_ids.size());
+    if (_segments.size() > kSegmentMask) {
+        return Status::NotSupported("too many segments for primary key filter: {}",
+                                    _segments.size());
+    }
+    _segments.emplace_back(rowset_idx, segment_id);
+    return Status::OK();
+}
+
+void PrimaryKeyFilter::add_key(const Slice& key) {
+    DCHECK(!_segments.empty());
+    _key_hashes.push_back(_hash_key(key));
+    _key_segments.push_back(static_cast<uint16_t>(_segments.size() - 1));
+}
+
+uint64_t PrimaryKeyFilter::_hash_key(const Slice& key) {
+    uint64_t hash = 0;
+    murmur_hash3_x64_64(key.data, static_cast<int>(key.size), 0, &hash);
+    return hash;
+}
+
+void PrimaryKeyFilter::_get_slots(uint64_t hash, uint32_t* slots) const {
+    slots[0] = reduce(static_cast<uint32_t>(hash), _block_length);
+    slots[1] = reduce(static_cast<uint32_t>(rotl64(hash, 21)), _block_length) + _block_length;
+    slots[2] = reduce(static_cast<uint32_t>(rotl64(hash, 42)), _block_length) + 2 * _block_length;
+}
+
+Status PrimaryKeyFilter::build() {
+    _num_keys = _key_hashes.size();
+    if (_num_keys > std::numeric_limits<uint32_t>::max()) {
+        return Status::NotSupported("too many keys for primary key filter: {}", _num_keys);
+    }
+    {
+        // The seed is applied on the hashes of the keys, two keys with the same hash are
+        // mapped to the same slots with any seed and can never be peeled.
+        std::vector<uint64_t> sorted_hashes(_key_hashes);
+        std::sort(sorted_hashes.begin(), sorted_hashes.end());
+        if (std::adjacent_find(sorted_hashes.begin(), sorted_hashes.end()) !=
+            sorted_hashes.end()) {
+            return Status::NotSupported("duplicate key hash in primary key filter of {} keys",
+                                        _num_keys);
+        }
+    }
+    _block_length = static_cast<uint32_t>((32 + 1.23 * _num_keys) / 3) + 1;
+    size_t capacity = 3 * static_cast<size_t>(_block_length);
+
+    // Peel the 3-partite hypergraph of keys: repeatedly remove a key which is the only
+    // one mapped to a slot, the slot is then free to encode that key. Distinct hashes may
+    // still form a cycle with a small probability, so retry with another seed.
+    std::vector<uint32_t> slot_counts(capacity);
+    std::vector<uint32_t> slot_keys(capacity);
+    std::vector<uint32_t> queue;
+    std::vector<std::pair<uint32_t, uint32_t>> stack; // (key, slot)
+    queue.reserve(capacity);
+    stack.reserve(_num_keys);
+    uint32_t slots[3];
+    bool peeled = false;
+    for (int attempt = 0; attempt < kMaxBuildAttempts && !peeled; ++attempt) {
+        _seed = mix64(attempt + 1);
+        std::fill(slot_counts.begin(), slot_counts.end(), 0);
+        std::fill(slot_keys.begin(), slot_keys.end(), 0);
+        queue.clear();
+        stack.clear();
+        for (uint32_t k = 0; k < _num_keys; ++k) {
+            _get_slots(mix64(_key_hashes[k] + _seed), slots);
+            for (auto slot : slots) {
+                ++slot_counts[slot];
+                slot_keys[slot] ^= k;
+            }
+        }
+        for (uint32_t slot = 0; slot < capacity; ++slot) {
+            if (slot_counts[slot] == 1) {
+                queue.push_back(slot);
+            }
+        }
+        while (!queue.empty()) {
+            uint32_t slot = queue.back();
+            queue.pop_back();
+            if (slot_counts[slot] != 1) {
+                continue;
+            }
+            uint32_t k = slot_keys[slot];
+            stack.emplace_back(k, slot);
+            _get_slots(mix64(_key_hashes[k] + _seed), slots);
+            for (auto s : slots) {
+                slot_keys[s] ^= k;
+                if (--slot_counts[s] == 1) {
+                    queue.push_back(s);
+                }
+            }
+        }
+        peeled = stack.size() == _num_keys;
+    }
+    if (!peeled) {
+        return Status::InternalError("failed to build primary key filter of {} keys", _num_keys);
+    }
+
+    // Assign the slots in the reverse order of peeling, the slot of each key is the last
+    // of its 3 slots to be assigned.
+    _fingerprints.assign(capacity, 0);
+    for (auto it = stack.rbegin(); it != stack.rend(); ++it) {
+        auto [k, slot] = *it;
+        uint64_t hash = mix64(_key_hashes[k] + _seed);
+        _get_slots(hash, slots);
+        _fingerprints[slot] = (fingerprint(hash) | _key_segments[k]) ^ _fingerprints[slots[0]] ^
+                              _fingerprints[slots[1]] ^ _fingerprints[slots[2]];
+    }
+
+    std::vector<uint64_t>().swap(_key_hashes);
+    std::vector<uint16_t>().swap(_key_segments);
+    if (_mem_tracker != nullptr) {
+        _tracked_bytes = memory_usage();
+        _mem_tracker->consume(_tracked_bytes);
+    }
+    return Status::OK();
+}
+
+bool PrimaryKeyFilter::lookup(const Slice& key, uint32_t* rowset_idx, uint32_t* segment_id) const {
+    if (_num_keys == 0) {
+        return false;
+    }
+    uint64_t hash = mix64(_hash_key(key) + _seed);
+    uint32_t slots[3];
+    _get_slots(hash, slots);
+    uint32_t value = _fingerprints[slots[0]] ^ _fingerprints[slots[1]] ^ _fingerprints[slots[2]];
+    if ((value & kFingerprintMask) != fingerprint(hash)) {
+        return false;
+    }
+    uint32_t segment = value & kSegmentMask;
+    if (segment >= _segments.size()) {
+        return false;
+    }
+    *rowset_idx = _segments[segment].first;
+    *segment_id = _segments[segment].second;
+    return true;
+}
+
+bool PrimaryKeyFilter::covered_by(const std::vector<RowsetSharedPtr>& rowsets) const {
+    // The rowsets of a tablet are only ever merged by compaction, two rowset sets covering
+    // the same versions with the same number of rowsets are the same.
+    if (_rowset_ids.empty() || rowsets.size() < _rowset_ids.size()) {
+        return false;
+    }
+    size_t offset = rowsets.size() - _rowset_ids.size();
+    return rowsets[offset]->rowset_id() == _rowset_ids.front() &&
+           rowsets.back()->rowset_id() == _rowset_ids.back();
+}
+
+size_t PrimaryKeyFilter::memory_usage() const {
+    return _fingerprints.capacity() * sizeof(uint32_t) +
+           _segments.capacity() * sizeof(std::pair<uint32_t, uint32_t>) +
+           _key_hashes.capacity() * sizeof(uint64_t) + _key_segments.capacity() * sizeof(uint16_t);
+}
+
+} // namespace doris
@@ -0,0 +1,106 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "common/status.h"
+#include "olap/olap_common.h"
+#include "olap/rowset/rowset.h"
+#include "util/slice.h"
+
+namespace doris {
+
+class MemTracker;
+
+// In-memory filter over the live primary keys of all the rowsets of a
+// merge-on-write tablet, rebuilt after compaction.
+//
+// It is a 3-wise xor filter that stores a 16 bit fingerprint together with the
+// segment which holds the key, so a lookup tells the only segment that may hold
+// the key instead of probing the bloom filter of every segment. A key that is
+// not in the filter has a 2^-16 chance to be reported in a random segment, the
+// caller must still check the primary key index of that segment.
+//
+// The filter is immutable once built. It covers the rowsets of the tablet at
+// `version` and stays valid for lookups over any later rowset set that still
+// ends with exactly these rowsets, see covered_by().
+class PrimaryKeyFilter {
+public:
+    // `rowsets` must be all the rowsets of the tablet at `version`, sorted by
+    // version in descending order. The memory of the built filter is charged to
+    // `mem_tracker` if it's not null.
+    PrimaryKeyFilter(const std::vector<RowsetSharedPtr>& rowsets, int64_t version,
+                     std::shared_ptr<MemTracker> mem_tracker = nullptr);
+    ~PrimaryKeyFilter();
+
+    // Start adding the keys of the segment `segment_id` of the `rowset_idx`-th rowset.
+    Status start_segment(uint32_t rowset_idx, uint32_t segment_id);
+
+    // Add a key of the current segment. Each key can be added only once, i.e. only the
+    // rows not marked deleted should be added.
+    void add_key(const Slice& key);
+
+    // Build the filter from the added keys. Fail if two keys have the same hash,
+    // which can't be stored in the filter.
+    Status build();
+
+    // Return false if `key` is not in the covered rowsets. Otherwise return the
+    // position of the only segment which may hold the key.
+    bool lookup(const Slice& key, uint32_t* rowset_idx, uint32_t* segment_id) const;
+
+    // Return true if `rowsets`, sorted by version in descending order, end with
+    // the rowsets covered by this filter.
+    bool covered_by(const std::vector<RowsetSharedPtr>& rowsets) const;
+
+    size_t num_rowsets() const { return _rowset_ids.size(); }
+    size_t num_keys() const { return _num_keys; }
+    int64_t version() const { return _version; }
+    size_t memory_usage() const;
+
+private:
+    static uint64_t _hash_key(const Slice& key);
+    void _get_slots(uint64_t hash, uint32_t* slots) const;
+
+    // only ids are kept to not hold the files of compacted rowsets
+    std::vector<RowsetId> _rowset_ids;
+    int64_t _version;
+    // (rowset_idx, segment_id) of the segments, the index is stored in the filter
+    std::vector<std::pair<uint32_t, uint32_t>> _segments;
+
+    // keys and the segments holding them, only used while building
+    std::vector<uint64_t> _key_hashes;
+    std::vector<uint16_t> _key_segments;
+
+    std::shared_ptr<MemTracker> _mem_tracker;
+    // bytes charged to _mem_tracker
+    size_t _tracked_bytes = 0;
+
+    size_t _num_keys = 0;
+    uint64_t _seed = 0;
+    uint32_t _block_length = 0;
+    // each fingerprint is 16 bit fingerprint << 16 | segment index
+    std::vector<uint32_t> _fingerprints;
+};
+
+} // namespace doris
@@ -111,6 +111,9 @@ public:
         // for compaction, schema_change, check_sum: we don't use page cache
         // for query and config::disable_storage_page_cache is false, we use page cache
         bool use_page_cache = false;
+        // for query reading a lot of rows, the pages read have to prove they are used
+        // frequently before entering page cache, see StoragePageCache::admit()
+        bool large_scan = false;
         Version version = Version(-1, 0);
 
         std::vector<OlapTuple> start_key;
@@ -199,6 +199,7 @@ Status BetaRowsetReader::get_segment_iterators(RowsetReaderContext* read_context
         }
     }
     _read_options.use_page_cache = read_context->use_page_cache;
+    _read_options.large_scan = read_context->large_scan;
     _read_options.tablet_schema = read_context->tablet_schema;
     _read_options.record_rowids = read_context->record_rowids;
     _read_options.use_topn_opt = read_context->use_topn_opt;
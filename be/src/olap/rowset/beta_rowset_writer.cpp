@@ -36,6 +36,7 @@
 #include "io/fs/file_reader_options.h"
 #include "io/fs/file_system.h"
 #include "io/fs/file_writer.h"
+#include "olap/calc_delete_bitmap_executor.h"
 #include "olap/olap_define.h"
 #include "olap/rowset/beta_rowset.h"
 #include "olap/rowset/rowset_factory.h"
@@ -74,6 +75,9 @@ BetaRowsetWriter::BetaRowsetWriter()
 }
 
 BetaRowsetWriter::~BetaRowsetWriter() {
+    if (_calc_delete_bitmap_token != nullptr) {
+        _calc_delete_bitmap_token->cancel();
+    }
     /* Note that segcompaction is async and in parallel with load job. So we should handle carefully
      * when the job is cancelled. Although it is meaningless to continue segcompaction when the job
      * is cancelled, the objects involved in the job should be preserved during segcompaction to
@@ -126,6 +130,12 @@ Status BetaRowsetWriter::init(const RowsetWriterContext& rowset_writer_context)
     _context.segment_collector = std::make_shared<SegmentCollectorT<BetaRowsetWriter>>(this);
     _context.file_writer_creator = std::make_shared<FileWriterCreatorT<BetaRowsetWriter>>(this);
     _segment_creator.init(_context);
+    if (config::enable_async_calc_delete_bitmap_on_flush && _context.mow_context != nullptr &&
+        _context.tablet != nullptr && _context.tablet->enable_unique_key_merge_on_write() &&
+        !_context.tablet_schema->is_partial_update()) {
+        _calc_delete_bitmap_token =
+                StorageEngine::instance()->calc_delete_bitmap_executor()->create_token();
+    }
     return Status::OK();
 }
 
@@ -134,7 +144,7 @@ Status BetaRowsetWriter::add_block(const vectorized::Block* block) {
 }
 
 Status BetaRowsetWriter::_generate_delete_bitmap(int32_t segment_id) {
-    SCOPED_RAW_TIMER(&_delete_bitmap_ns);
+    SCOPED_ATOMIC_TIMER(&_delete_bitmap_ns);
     if (!_context.tablet->enable_unique_key_merge_on_write() ||
         _context.tablet_schema->is_partial_update()) {
         return Status::OK();
@@ -148,9 +158,25 @@ Status BetaRowsetWriter::_generate_delete_bitmap(int32_t segment_id) {
         std::shared_lock meta_rlock(_context.tablet->get_header_lock());
         specified_rowsets = _context.tablet->get_rowset_by_ids(&_context.mow_context->rowset_ids);
     }
+    if (_calc_delete_bitmap_token != nullptr) {
+        return _calc_delete_bitmap_token->submit_func(
+                _context.tablet->tablet_id(),
+                [this, rowset, segments, specified_rowsets](DeleteBitmapPtr delete_bitmap) {
+                    SCOPED_ATOMIC_TIMER(&_delete_bitmap_ns);
+                    return _calc_delete_bitmap(rowset, segments, specified_rowsets,
+                                               delete_bitmap);
+                });
+    }
+    return _calc_delete_bitmap(rowset, segments, specified_rowsets,
+                               _context.mow_context->delete_bitmap);
+}
+
+Status BetaRowsetWriter::_calc_delete_bitmap(
+        const RowsetSharedPtr& rowset, const std::vector<segment_v2::SegmentSharedPtr>& segments,
+        const std::vector<RowsetSharedPtr>& specified_rowsets, DeleteBitmapPtr delete_bitmap) {
     OlapStopWatch watch;
     RETURN_IF_ERROR(_context.tablet->calc_delete_bitmap(
-            rowset, segments, specified_rowsets, _context.mow_context->delete_bitmap,
+            rowset, segments, specified_rowsets, delete_bitmap,
             _context.mow_context->max_version, nullptr));
     size_t total_rows = std::accumulate(
             segments.begin(), segments.end(), 0,
@@ -443,7 +469,7 @@ Status BetaRowsetWriter::flush_memtable(vectorized::Block* block, int32_t segmen
         RETURN_IF_ERROR(_unfold_variant_column(*block, flush_schema));
     }
     {
-        SCOPED_RAW_TIMER(&_segment_writer_ns);
+        SCOPED_ATOMIC_TIMER(&_segment_writer_ns);
         RETURN_IF_ERROR(
                 _segment_creator.flush_single_block(block, segment_id, flush_size, flush_schema));
     }
@@ -452,6 +478,24 @@ Status BetaRowsetWriter::flush_memtable(vectorized::Block* block, int32_t segmen
     return Status::OK();
 }
 
+Status BetaRowsetWriter::flush_memtable_rows(const vectorized::Block* block, size_t row_offset,
+                                             size_t num_rows, int32_t segment_id,
+                                             int64_t* flush_size) {
+    if (num_rows == 0) {
+        return Status::OK();
+    }
+    // variant columns are unfolded by whole block, see flush_memtable()
+    DCHECK(!_context.tablet_schema->is_dynamic_schema());
+    {
+        SCOPED_ATOMIC_TIMER(&_segment_writer_ns);
+        RETURN_IF_ERROR(_segment_creator.flush_block_rows(block, row_offset, num_rows, segment_id,
+                                                          flush_size));
+    }
+    RETURN_IF_ERROR(_generate_delete_bitmap(segment_id));
+    RETURN_IF_ERROR(_segcompaction_if_necessary());
+    return Status::OK();
+}
+
 Status BetaRowsetWriter::flush_single_block(const vectorized::Block* block) {
     return _segment_creator.flush_single_block(block);
 }
@@ -506,6 +550,18 @@ RowsetSharedPtr BetaRowsetWriter::build() {
         LOG(WARNING) << "failed to close segment creator when build new rowset, res=" << status;
         return nullptr;
     }
+    if (_calc_delete_bitmap_token != nullptr) {
+        status = _calc_delete_bitmap_token->wait();
+        if (status.ok()) {
+            status = _calc_delete_bitmap_token->get_delete_bitmap(
+                    _context.mow_context->delete_bitmap);
+        }
+        if (!status.ok()) {
+            LOG(WARNING) << "failed to calc delete bitmap of segments when build new rowset, res="
+                         << status;
+            return nullptr;
+        }
+    }
     // if _segment_start_id is not zero, that means it's a transient rowset writer for
     // MoW partial update, don't need to do segment compaction.
     if (_segment_start_id == 0) {
@@ -48,6 +48,8 @@
 #include "util/spinlock.h"
 
 namespace doris {
+class CalcDeleteBitmapToken;
+
 namespace vectorized {
 class Block;
 } // namespace vectorized
@@ -95,6 +97,10 @@ public:
     Status flush_memtable(vectorized::Block* block, int32_t segment_id,
                           int64_t* flush_size) override;
 
+    // This method is thread-safe.
+    Status flush_memtable_rows(const vectorized::Block* block, size_t row_offset, size_t num_rows,
+                               int32_t segment_id, int64_t* flush_size) override;
+
     // Return the file size flushed to disk in "flush_size"
     // This method is thread-safe.
     Status flush_single_block(const vectorized::Block* block) override;
@@ -142,6 +148,10 @@ private:
     Status _create_file_writer(std::string path, io::FileWriterPtr& file_writer);
     Status _check_segment_number_limit();
     Status _generate_delete_bitmap(int32_t segment_id);
+    Status _calc_delete_bitmap(const RowsetSharedPtr& rowset,
+                               const std::vector<segment_v2::SegmentSharedPtr>& segments,
+                               const std::vector<RowsetSharedPtr>& specified_rowsets,
+                               DeleteBitmapPtr delete_bitmap);
     void _build_rowset_meta(std::shared_ptr<RowsetMeta> rowset_meta);
 
     // segment compaction
@@ -220,9 +230,14 @@ protected:
     fmt::memory_buffer vlog_buffer;
 
     std::shared_ptr<MowContext> _mow_context;
-
-    int64_t _delete_bitmap_ns = 0;
-    int64_t _segment_writer_ns = 0;
+    // Calculates the delete bitmaps of flushed segments in background for merge-on-write
+    // tables, so they overlap with the following memtable flushes.
+    std::unique_ptr<CalcDeleteBitmapToken> _calc_delete_bitmap_token;
+
+    // includes the time of the calculations in background, which overlaps with the flushes
+    std::atomic<int64_t> _delete_bitmap_ns {0};
+    // the ranges of a split memtable are written concurrently
+    std::atomic<int64_t> _segment_writer_ns {0};
 };
 
 } // namespace doris
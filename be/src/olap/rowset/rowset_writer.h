@@ -34,6 +34,22 @@
 namespace doris {
 
 class MemTable;
+struct OlapReaderStatistics;
+
+namespace segment_v2 {
+class Segment;
+} // namespace segment_v2
+
+// Writes a value column group in vertical compaction, see
+// RowsetWriter::create_column_group_writer().
+class ColumnGroupWriter {
+public:
+    virtual ~ColumnGroupWriter() = default;
+
+    virtual Status add_columns(const vectorized::Block* block) = 0;
+    // flush the columns of the last segment
+    virtual Status flush_columns() = 0;
+};
 
 class RowsetWriter {
 public:
@@ -65,6 +81,22 @@ public:
         return Status::Error<ErrorCode::NOT_IMPLEMENTED_ERROR>(
                 "RowsetWriter not support flush_columns");
     }
+    // Create a writer of the value column group `col_ids` once the key column group is
+    // flushed. Writers of different value column groups can be used concurrently.
+    virtual Status create_column_group_writer(const std::vector<uint32_t>& col_ids,
+                                              std::unique_ptr<ColumnGroupWriter>* writer) {
+        return Status::Error<ErrorCode::NOT_IMPLEMENTED_ERROR>(
+                "RowsetWriter not support create_column_group_writer");
+    }
+    // For page copy compaction: write all rows of `segments`, which are sorted by key and do
+    // not overlap with each other, into a new segment in order. Columns `copy_col_ids` are
+    // copied by data pages, the others are read and written again.
+    virtual Status add_segment_by_page_copy(
+            const std::vector<std::shared_ptr<segment_v2::Segment>>& segments,
+            const std::vector<uint32_t>& copy_col_ids, OlapReaderStatistics* stats) {
+        return Status::Error<ErrorCode::NOT_IMPLEMENTED_ERROR>(
+                "RowsetWriter not support add_segment_by_page_copy");
+    }
     virtual Status final_flush() {
         return Status::Error<ErrorCode::NOT_IMPLEMENTED_ERROR>(
                 "RowsetWriter not support final_flush");
@@ -76,6 +108,15 @@ public:
                 "RowsetWriter not support flush_memtable");
     }
 
+    // Flush rows [row_offset, row_offset + num_rows) of a sorted memtable block into the
+    // segment `segment_id', so that one memtable can be flushed into several segments in
+    // parallel.
+    virtual Status flush_memtable_rows(const vectorized::Block* block, size_t row_offset,
+                                       size_t num_rows, int32_t segment_id, int64_t* flush_size) {
+        return Status::Error<ErrorCode::NOT_IMPLEMENTED_ERROR>(
+                "RowsetWriter not support flush_memtable_rows");
+    }
+
     virtual Status flush_single_block(const vectorized::Block* block) {
         return Status::Error<ErrorCode::NOT_IMPLEMENTED_ERROR>(
                 "RowsetWriter not support flush_single_block");
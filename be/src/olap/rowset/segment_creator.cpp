@@ -47,13 +47,21 @@ Status SegmentFlusher::init(const RowsetWriterContext& rowset_writer_context) {
 
 Status SegmentFlusher::flush_single_block(const vectorized::Block* block, int32_t segment_id,
                                           int64_t* flush_size, TabletSchemaSPtr flush_schema) {
-    if (block->rows() == 0) {
+    return flush_block_rows(block, 0, block->rows(), segment_id, flush_size, flush_schema);
+}
+
+Status SegmentFlusher::flush_block_rows(const vectorized::Block* block, size_t row_offset,
+                                        size_t num_rows, int32_t segment_id, int64_t* flush_size,
+                                        TabletSchemaSPtr flush_schema) {
+    if (num_rows == 0) {
         return Status::OK();
     }
+    DCHECK_LE(row_offset + num_rows, block->rows());
     std::unique_ptr<segment_v2::SegmentWriter> writer;
-    bool no_compression = block->bytes() <= config::segment_compression_threshold_kb * 1024;
+    size_t bytes = block->bytes() * num_rows / block->rows();
+    bool no_compression = bytes <= config::segment_compression_threshold_kb * 1024;
     RETURN_IF_ERROR(_create_segment_writer(writer, segment_id, no_compression, flush_schema));
-    RETURN_IF_ERROR(_add_rows(writer, block, 0, block->rows()));
+    RETURN_IF_ERROR(_add_rows(writer, block, row_offset, num_rows));
     RETURN_IF_ERROR(_flush_segment_writer(writer, flush_size));
     return Status::OK();
 }
@@ -233,6 +241,17 @@ Status SegmentCreator::flush_single_block(const vectorized::Block* block, int32_
     return Status::OK();
 }
 
+Status SegmentCreator::flush_block_rows(const vectorized::Block* block, size_t row_offset,
+                                        size_t num_rows, int32_t segment_id,
+                                        int64_t* flush_size) {
+    if (num_rows == 0) {
+        return Status::OK();
+    }
+    RETURN_IF_ERROR(_segment_flusher.flush_block_rows(block, row_offset, num_rows, segment_id,
+                                                      flush_size));
+    return Status::OK();
+}
+
 Status SegmentCreator::close() {
     RETURN_IF_ERROR(flush());
     RETURN_IF_ERROR(_segment_flusher.close());
@@ -94,6 +94,12 @@ public:
                               int64_t* flush_size = nullptr,
                               TabletSchemaSPtr flush_schema = nullptr);
 
+    // Same as above, but only flush rows [row_offset, row_offset + num_rows) of the block.
+    // This method is thread-safe.
+    Status flush_block_rows(const vectorized::Block* block, size_t row_offset, size_t num_rows,
+                            int32_t segment_id, int64_t* flush_size = nullptr,
+                            TabletSchemaSPtr flush_schema = nullptr);
+
     int64_t num_rows_written() const { return _num_rows_written; }
 
     int64_t num_rows_filtered() const { return _num_rows_filtered; }
@@ -179,6 +185,12 @@ public:
         return flush_single_block(block, allocate_segment_id());
     }
 
+    // Flush rows [row_offset, row_offset + num_rows) of a block into a single segment,
+    // with pre-allocated segment_id.
+    // This method is thread-safe.
+    Status flush_block_rows(const vectorized::Block* block, size_t row_offset, size_t num_rows,
+                            int32_t segment_id, int64_t* flush_size = nullptr);
+
     Status close();
 
 private:
@@ -245,6 +245,13 @@ Status ColumnReader::read_page(const ColumnIteratorOptions& iter_opts, const Pag
                                PageHandle* handle, Slice* page_body, PageFooterPB* footer,
                                BlockCompressionCodec* codec) const {
     iter_opts.sanity_check();
+    PageReadOptions opts = page_read_options(iter_opts, pp, codec);
+    return PageIO::read_and_decompress_page(opts, handle, page_body, footer);
+}
+
+PageReadOptions ColumnReader::page_read_options(const ColumnIteratorOptions& iter_opts,
+                                                const PagePointer& pp,
+                                                BlockCompressionCodec* codec) const {
     PageReadOptions opts;
     opts.file_reader = iter_opts.file_reader;
     opts.page_pointer = pp;
@@ -252,6 +259,7 @@ Status ColumnReader::read_page(const ColumnIteratorOptions& iter_opts, const Pag
     opts.stats = iter_opts.stats;
     opts.verify_checksum = _opts.verify_checksum;
     opts.use_page_cache = iter_opts.use_page_cache;
+    opts.large_scan = iter_opts.large_scan;
     opts.kept_in_memory = _opts.kept_in_memory;
     opts.type = iter_opts.type;
     opts.encoding_info = _encoding_info;
@@ -260,8 +268,7 @@ Status ColumnReader::read_page(const ColumnIteratorOptions& iter_opts, const Pag
     if (iter_opts.type == INDEX_PAGE) {
         opts.pre_decode = false;
     }
-
-    return PageIO::read_and_decompress_page(opts, handle, page_body, footer);
+    return opts;
 }
 
 Status ColumnReader::get_row_ranges_by_zone_map(
@@ -531,6 +538,27 @@ Status ColumnReader::_load_bloom_filter_index(bool use_page_cache, bool kept_in_
     return Status::OK();
 }
 
+Status ColumnReader::get_data_pages(std::vector<PagePointer>* pages,
+                                    std::vector<ZoneMapPB>* zone_maps) {
+    RETURN_IF_ERROR(_load_ordinal_index(_use_index_page_cache, _opts.kept_in_memory));
+    pages->clear();
+    for (auto iter = _ordinal_index->begin(); iter.valid(); iter.next()) {
+        pages->push_back(iter.page());
+    }
+    if (zone_maps != nullptr) {
+        if (_zone_map_index_meta == nullptr) {
+            return Status::NotSupported("column {} has no zone map", _meta.unique_id());
+        }
+        RETURN_IF_ERROR(_load_zone_map_index(_use_index_page_cache, _opts.kept_in_memory));
+        *zone_maps = _zone_map_index->page_zone_maps();
+        if (zone_maps->size() != pages->size()) {
+            return Status::Corruption("column {} has {} data pages but {} page zone maps",
+                                      _meta.unique_id(), pages->size(), zone_maps->size());
+        }
+    }
+    return Status::OK();
+}
+
 Status ColumnReader::seek_to_first(OrdinalPageIndexIterator* iter) {
     RETURN_IF_ERROR(_load_ordinal_index(_use_index_page_cache, _opts.kept_in_memory));
     *iter = _ordinal_index->begin();
@@ -966,6 +994,23 @@ Status FileColumnIterator::seek_to_ordinal(ordinal_t ord) {
     return Status::OK();
 }
 
+Status FileColumnIterator::collect_prefetch_pages(const roaring::Roaring& row_bitmap,
+                                                  ordinal_t first, ordinal_t last,
+                                                  std::vector<PageReadOptions>* pages) {
+    OrdinalPageIndexIterator iter;
+    RETURN_IF_ERROR(_reader->seek_at_or_before(first, &iter));
+    for (; iter.valid() && iter.first_ordinal() <= last; iter.next()) {
+        ordinal_t from = std::max(first, iter.first_ordinal());
+        ordinal_t to = std::min(last, iter.last_ordinal());
+        // rank(x) is the number of rows not greater than x
+        uint64_t selected_rows = row_bitmap.rank(to) - (from == 0 ? 0 : row_bitmap.rank(from - 1));
+        if (selected_rows > 0) {
+            pages->push_back(_reader->page_read_options(_opts, iter.page(), _compress_codec));
+        }
+    }
+    return Status::OK();
+}
+
 Status FileColumnIterator::seek_to_page_start() {
     return seek_to_ordinal(_page.first_ordinal);
 }
@@ -24,6 +24,7 @@
 #include <cstdint> // for uint32_t
 #include <memory>  // for unique_ptr
 #include <mutex>
+#include <roaring/roaring.hh>
 #include <string>
 #include <utility>
 #include <vector>
@@ -37,6 +38,7 @@
 #include "olap/rowset/segment_v2/common.h"
 #include "olap/rowset/segment_v2/ordinal_page_index.h" // for OrdinalPageIndexIterator
 #include "olap/rowset/segment_v2/page_handle.h"        // for PageHandle
+#include "olap/rowset/segment_v2/page_io.h"            // for PageReadOptions
 #include "olap/rowset/segment_v2/page_pointer.h"
 #include "olap/rowset/segment_v2/parsed_page.h" // for ParsedPage
 #include "olap/types.h"
@@ -85,6 +87,7 @@ struct ColumnIteratorOptions {
     // reader statistics
     OlapReaderStatistics* stats = nullptr;
     bool use_page_cache = false;
+    bool large_scan = false;
     // for page cache allocation
     // page types are divided into DATA_PAGE & INDEX_PAGE
     // INDEX_PAGE including index_page, dict_page and short_key_page
@@ -131,6 +134,10 @@ public:
                      PageHandle* handle, Slice* page_body, PageFooterPB* footer,
                      BlockCompressionCodec* codec) const;
 
+    // the options read_page() reads the page with
+    PageReadOptions page_read_options(const ColumnIteratorOptions& iter_opts,
+                                      const PagePointer& pp, BlockCompressionCodec* codec) const;
+
     bool is_nullable() const { return _meta.is_nullable(); }
 
     const EncodingInfo* encoding_info() const { return _encoding_info; }
@@ -167,6 +174,14 @@ public:
 
     PagePointer get_dict_page_pointer() const { return _meta.dict_page(); }
 
+    bool has_dict_page() const { return _meta.has_dict_page(); }
+
+    EncodingTypePB get_encoding() const { return _meta.encoding(); }
+
+    // Get the pointers of all data pages in order, and the zone map of each page if
+    // `zone_maps` is not null, used to copy the pages without decoding them.
+    Status get_data_pages(std::vector<PagePointer>* pages, std::vector<ZoneMapPB>* zone_maps);
+
     bool is_empty() const { return _num_rows == 0; }
 
     CompressionTypePB get_compression() const { return _meta.compression(); }
@@ -317,6 +332,13 @@ public:
 
     virtual bool is_all_dict_encoding() const { return false; }
 
+    // Collect the data pages holding any row of `row_bitmap' in [first, last], so that
+    // they can be prefetched before being read.
+    virtual Status collect_prefetch_pages(const roaring::Roaring& row_bitmap, ordinal_t first,
+                                          ordinal_t last, std::vector<PageReadOptions>* pages) {
+        return Status::OK();
+    }
+
 protected:
     ColumnIteratorOptions _opts;
 };
@@ -364,6 +386,9 @@ public:
 
     bool is_all_dict_encoding() const override { return _is_all_dict_encoding; }
 
+    Status collect_prefetch_pages(const roaring::Roaring& row_bitmap, ordinal_t first,
+                                  ordinal_t last, std::vector<PageReadOptions>* pages) override;
+
 private:
     void _seek_to_pos_in_page(ParsedPage* page, ordinal_t offset_in_page) const;
     Status _load_next_page(bool* eos);
@@ -31,6 +31,7 @@
 #include "olap/rowset/segment_v2/bitmap_index_writer.h"
 #include "olap/rowset/segment_v2/bloom_filter.h"
 #include "olap/rowset/segment_v2/bloom_filter_index_writer.h"
+#include "olap/rowset/segment_v2/column_reader.h"
 #include "olap/rowset/segment_v2/encoding_info.h"
 #include "olap/rowset/segment_v2/inverted_index_writer.h"
 #include "olap/rowset/segment_v2/options.h"
@@ -728,6 +729,44 @@ Status ScalarColumnWriter::finish_current_page() {
     return Status::OK();
 }
 
+Status ScalarColumnWriter::append_pages(ColumnReader* reader,
+                                        const ColumnIteratorOptions& iter_opts) {
+    if (reader->get_encoding() != _encoding_info->encoding() ||
+        reader->get_compression() != _opts.meta->compression() || reader->has_dict_page() ||
+        reader->is_nullable() != is_nullable() || _opts.need_bitmap_index ||
+        _opts.need_bloom_filter || _opts.inverted_index != nullptr) {
+        return Status::NotSupported("can not copy pages of column {}", _opts.meta->unique_id());
+    }
+    RETURN_IF_ERROR(finish_current_page());
+
+    std::vector<PagePointer> page_pointers;
+    std::vector<ZoneMapPB> zone_maps;
+    RETURN_IF_ERROR(
+            reader->get_data_pages(&page_pointers, _opts.need_zone_map ? &zone_maps : nullptr));
+    for (size_t i = 0; i < page_pointers.size(); ++i) {
+        std::unique_ptr<Page> page(new Page());
+        OwnedSlice body;
+        RETURN_IF_ERROR(PageIO::read_raw_page(
+                reader->page_read_options(iter_opts, page_pointers[i], nullptr), &body,
+                &page->footer));
+        if (page->footer.type() != DATA_PAGE) {
+            return Status::Corruption("Bad page: expect data page, but got {}",
+                                      page->footer.type());
+        }
+        // only the ordinal of the page changes, the page body is written as is
+        auto data_page_footer = page->footer.mutable_data_page_footer();
+        data_page_footer->set_first_ordinal(_next_rowid);
+        _next_rowid += data_page_footer->num_values();
+        if (_opts.need_zone_map) {
+            RETURN_IF_ERROR(_zone_map_index_builder->add_page_zone_map(zone_maps[i]));
+        }
+        page->data.emplace_back(std::move(body));
+        _push_back_page(page.release());
+    }
+    _first_rowid = _next_rowid;
+    return Status::OK();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 StructColumnWriter::StructColumnWriter(
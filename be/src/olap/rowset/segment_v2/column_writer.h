@@ -76,7 +76,9 @@ struct ColumnWriterOptions {
 };
 
 class BitmapIndexWriter;
+class ColumnReader;
 class EncodingInfo;
+struct ColumnIteratorOptions;
 class NullBitmapBuilder;
 class OrdinalIndexWriter;
 class PageBuilder;
@@ -207,6 +209,11 @@ public:
     Status append_data_in_current_page(const uint8_t** ptr, size_t* num_written);
 
     Status append_data_in_current_page(const uint8_t* ptr, size_t* num_written);
+
+    // Append all the data pages of the column read by `reader` without decoding them. The
+    // column must be written with the same encoding and compression as this one, without
+    // dictionary page, and have zone map if this one needs it.
+    Status append_pages(ColumnReader* reader, const ColumnIteratorOptions& iter_opts);
     friend class ArrayColumnWriter;
 
 private:
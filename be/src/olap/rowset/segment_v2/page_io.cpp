@@ -111,48 +111,12 @@ Status PageIO::write_page(io::FileWriter* writer, const std::vector<Slice>& body
     return Status::OK();
 }
 
-Status PageIO::read_and_decompress_page(const PageReadOptions& opts, PageHandle* handle,
-                                        Slice* body, PageFooterPB* footer) {
-    opts.sanity_check();
-    opts.stats->total_pages_num++;
-
-    auto cache = StoragePageCache::instance();
-    PageCacheHandle cache_handle;
-    StoragePageCache::CacheKey cache_key(opts.file_reader->path().native(),
-                                         opts.file_reader->size(), opts.page_pointer.offset);
-    if (opts.use_page_cache && cache->is_cache_available(opts.type) &&
-        cache->lookup(cache_key, &cache_handle, opts.type)) {
-        // we find page in cache, use it
-        *handle = PageHandle(std::move(cache_handle));
-        opts.stats->cached_pages_num++;
-        // parse body and footer
-        Slice page_slice = handle->data();
-        uint32_t footer_size = decode_fixed32_le((uint8_t*)page_slice.data + page_slice.size - 4);
-        std::string footer_buf(page_slice.data + page_slice.size - 4 - footer_size, footer_size);
-        if (!footer->ParseFromString(footer_buf)) {
-            return Status::Corruption("Bad page: invalid footer");
-        }
-        *body = Slice(page_slice.data, page_slice.size - 4 - footer_size);
-        return Status::OK();
-    }
-
-    // every page contains 4 bytes footer length and 4 bytes checksum
-    const uint32_t page_size = opts.page_pointer.size;
-    if (page_size < 8) {
-        return Status::Corruption("Bad page: too small size ({})", page_size);
-    }
-
-    // hold compressed page at first, reset to decompressed page later
-    std::unique_ptr<DataPage> page = std::make_unique<DataPage>(page_size);
-    Slice page_slice(page->data(), page_size);
-    {
-        SCOPED_RAW_TIMER(&opts.stats->io_ns);
-        size_t bytes_read = 0;
-        RETURN_IF_ERROR(opts.file_reader->read_at(opts.page_pointer.offset, page_slice, &bytes_read,
-                                                  &opts.io_ctx));
-        DCHECK_EQ(bytes_read, page_size);
-        opts.stats->compressed_bytes_read += page_size;
-    }
+// Verify, decompress and pre-decode a page read from file, then insert it into the page
+// cache if `insert_into_cache' is true. `page' holds the raw bytes of `opts.page_pointer'.
+static Status decode_page(const PageReadOptions& opts, std::unique_ptr<DataPage> page,
+                          bool insert_into_cache, PageHandle* handle, Slice* body,
+                          PageFooterPB* footer) {
+    Slice page_slice(page->data(), opts.page_pointer.size);
 
     if (opts.verify_checksum) {
         uint32_t expect = decode_fixed32_le((uint8_t*)page_slice.data + page_slice.size - 4);
@@ -211,8 +175,12 @@ Status PageIO::read_and_decompress_page(const PageReadOptions& opts, PageHandle*
 
     *body = Slice(page_slice.data, page_slice.size - 4 - footer_size);
     page->reset_size(page_slice.size);
-    if (opts.use_page_cache && cache->is_cache_available(opts.type)) {
+    if (insert_into_cache) {
         // insert this page into cache and return the cache handle
+        auto cache = StoragePageCache::instance();
+        PageCacheHandle cache_handle;
+        StoragePageCache::CacheKey cache_key(opts.file_reader->path().native(),
+                                             opts.file_reader->size(), opts.page_pointer.offset);
         cache->insert(cache_key, page.get(), &cache_handle, opts.type, opts.kept_in_memory);
         *handle = PageHandle(std::move(cache_handle));
     } else {
@@ -222,5 +190,177 @@ Status PageIO::read_and_decompress_page(const PageReadOptions& opts, PageHandle*
     return Status::OK();
 }
 
+Status PageIO::read_and_decompress_page(const PageReadOptions& opts, PageHandle* handle,
+                                        Slice* body, PageFooterPB* footer) {
+    opts.sanity_check();
+    opts.stats->total_pages_num++;
+
+    auto cache = StoragePageCache::instance();
+    PageCacheHandle cache_handle;
+    StoragePageCache::CacheKey cache_key(opts.file_reader->path().native(),
+                                         opts.file_reader->size(), opts.page_pointer.offset);
+    const bool use_page_cache = opts.use_page_cache && cache->is_cache_available(opts.type);
+    if (use_page_cache && cache->lookup(cache_key, &cache_handle, opts.type)) {
+        // we find page in cache, use it
+        *handle = PageHandle(std::move(cache_handle));
+        opts.stats->cached_pages_num++;
+        // parse body and footer
+        Slice page_slice = handle->data();
+        uint32_t footer_size = decode_fixed32_le((uint8_t*)page_slice.data + page_slice.size - 4);
+        std::string footer_buf(page_slice.data + page_slice.size - 4 - footer_size, footer_size);
+        if (!footer->ParseFromString(footer_buf)) {
+            return Status::Corruption("Bad page: invalid footer");
+        }
+        *body = Slice(page_slice.data, page_slice.size - 4 - footer_size);
+        return Status::OK();
+    }
+
+    // every page contains 4 bytes footer length and 4 bytes checksum
+    const uint32_t page_size = opts.page_pointer.size;
+    if (page_size < 8) {
+        return Status::Corruption("Bad page: too small size ({})", page_size);
+    }
+
+    // hold compressed page at first, reset to decompressed page later
+    std::unique_ptr<DataPage> page = std::make_unique<DataPage>(page_size);
+    Slice page_slice(page->data(), page_size);
+    {
+        SCOPED_RAW_TIMER(&opts.stats->io_ns);
+        size_t bytes_read = 0;
+        RETURN_IF_ERROR(opts.file_reader->read_at(opts.page_pointer.offset, page_slice, &bytes_read,
+                                                  &opts.io_ctx));
+        DCHECK_EQ(bytes_read, page_size);
+        opts.stats->compressed_bytes_read += page_size;
+    }
+
+    // the page is decoded before being cached, its compressed size is the best guess here
+    bool admitted =
+            use_page_cache && cache->admit(cache_key, page_size, opts.type, opts.large_scan);
+    return decode_page(opts, std::move(page), admitted, handle, body, footer);
+}
+
+Status PageIO::read_raw_page(const PageReadOptions& opts, OwnedSlice* body,
+                             PageFooterPB* footer) {
+    opts.sanity_check();
+    const uint32_t page_size = opts.page_pointer.size;
+    if (page_size < 8) {
+        return Status::Corruption("Bad page: too small size ({})", page_size);
+    }
+    faststring buf;
+    buf.resize(page_size);
+    {
+        SCOPED_RAW_TIMER(&opts.stats->io_ns);
+        size_t bytes_read = 0;
+        RETURN_IF_ERROR(opts.file_reader->read_at(opts.page_pointer.offset,
+                                                  Slice(buf.data(), page_size), &bytes_read,
+                                                  &opts.io_ctx));
+        DCHECK_EQ(bytes_read, page_size);
+        opts.stats->compressed_bytes_read += page_size;
+    }
+
+    // the page is written out again, so always verify it
+    uint32_t expect = decode_fixed32_le(buf.data() + page_size - 4);
+    uint32_t actual = crc32c::Value(reinterpret_cast<const char*>(buf.data()), page_size - 4);
+    if (expect != actual) {
+        return Status::Corruption("Bad page: checksum mismatch (actual={} vs expect={})", actual,
+                                  expect);
+    }
+    uint32_t footer_size = decode_fixed32_le(buf.data() + page_size - 8);
+    if (footer_size > page_size - 8) {
+        return Status::Corruption("Bad page: invalid footer size ({})", footer_size);
+    }
+    uint32_t body_size = page_size - 8 - footer_size;
+    if (!footer->ParseFromArray(buf.data() + body_size, footer_size)) {
+        return Status::Corruption("Bad page: invalid footer");
+    }
+    buf.resize(body_size);
+    *body = buf.build();
+    return Status::OK();
+}
+
+Status PageIO::prefetch_pages(std::vector<PageReadOptions> pages, size_t merge_gap_bytes,
+                              size_t max_read_bytes, std::vector<PageHandle>* handles) {
+    auto cache = StoragePageCache::instance();
+    // pages already cached need no I/O, and can not be inserted again anyway. Pages the
+    // cache would not admit are left to the normal read path. The access is recorded when
+    // the page is read, so neither the lookup nor the admission is recorded here.
+    pages.erase(std::remove_if(pages.begin(), pages.end(),
+                               [&](const PageReadOptions& opts) {
+                                   if (!opts.use_page_cache ||
+                                       !cache->is_cache_available(opts.type)) {
+                                       return true;
+                                   }
+                                   PageCacheHandle cache_handle;
+                                   StoragePageCache::CacheKey cache_key(
+                                           opts.file_reader->path().native(),
+                                           opts.file_reader->size(), opts.page_pointer.offset);
+                                   if (cache->lookup(cache_key, &cache_handle, opts.type,
+                                                     false)) {
+                                       handles->emplace_back(std::move(cache_handle));
+                                       return true;
+                                   }
+                                   return !cache->admit(cache_key, opts.page_pointer.size,
+                                                        opts.type, opts.large_scan, false);
+                               }),
+                pages.end());
+    if (pages.empty()) {
+        return Status::OK();
+    }
+    std::sort(pages.begin(), pages.end(),
+              [](const PageReadOptions& lhs, const PageReadOptions& rhs) {
+                  return lhs.page_pointer.offset < rhs.page_pointer.offset;
+              });
+
+    std::vector<char> buffer;
+    size_t begin = 0;
+    while (begin < pages.size()) {
+        // merge the following pages while the hole between them is small enough
+        const uint64_t range_start = pages[begin].page_pointer.offset;
+        uint64_t range_end = range_start + pages[begin].page_pointer.size;
+        size_t end = begin + 1;
+        for (; end < pages.size(); ++end) {
+            const PagePointer& pp = pages[end].page_pointer;
+            if (pp.offset > range_end + merge_gap_bytes ||
+                pp.offset + pp.size - range_start > max_read_bytes) {
+                break;
+            }
+            range_end = std::max(range_end, pp.offset + pp.size);
+        }
+
+        const PageReadOptions& first = pages[begin];
+        first.sanity_check();
+        buffer.resize(range_end - range_start);
+        {
+            SCOPED_RAW_TIMER(&first.stats->io_ns);
+            size_t bytes_read = 0;
+            RETURN_IF_ERROR(first.file_reader->read_at(range_start,
+                                                       Slice(buffer.data(), buffer.size()),
+                                                       &bytes_read, &first.io_ctx));
+            DCHECK_EQ(bytes_read, buffer.size());
+            first.stats->compressed_bytes_read += buffer.size();
+            first.stats->prefetch_io_num++;
+        }
+
+        for (size_t i = begin; i < end; ++i) {
+            const PageReadOptions& opts = pages[i];
+            const uint32_t page_size = opts.page_pointer.size;
+            if (page_size < 8) {
+                return Status::Corruption("Bad page: too small size ({})", page_size);
+            }
+            std::unique_ptr<DataPage> page = std::make_unique<DataPage>(page_size);
+            memcpy(page->data(), buffer.data() + (opts.page_pointer.offset - range_start),
+                   page_size);
+            PageHandle handle;
+            Slice body;
+            PageFooterPB footer;
+            RETURN_IF_ERROR(decode_page(opts, std::move(page), true, &handle, &body, &footer));
+            handles->emplace_back(std::move(handle));
+            opts.stats->prefetched_pages_num++;
+        }
+        begin = end;
+    }
+    return Status::OK();
+}
+
 } // namespace segment_v2
 } // namespace doris
@@ -54,6 +54,9 @@ struct PageReadOptions {
     bool verify_checksum = true;
     // whether to use page cache in read path
     bool use_page_cache = false;
+    // pages of a large scan are only admitted into page cache if they are missed often,
+    // see StoragePageCache::admit()
+    bool large_scan = false;
     // if true, use DURABLE CachePriority in page cache
     // currently used for in memory olap table
     bool kept_in_memory = false;
@@ -117,6 +120,25 @@ public:
     //     `footer' stores the page footer.
     static Status read_and_decompress_page(const PageReadOptions& opts, PageHandle* handle,
                                            Slice* body, PageFooterPB* footer);
+
+    // Read a page according to `opts' as stored in file, i.e. without decompressing its body,
+    // so that the page can be written into another file as is.
+    // On success
+    //     `body' holds the page body, compressed if the page was compressed,
+    //     `footer' stores the page footer.
+    static Status read_raw_page(const PageReadOptions& opts, OwnedSlice* body,
+                                PageFooterPB* footer);
+
+    // Read `pages' ahead of decoding them and put them into the page cache, so that the
+    // following read_and_decompress_page() calls hit the cache. Pages already cached are
+    // skipped, the others are read in as few I/Os as possible: neighboring pages are merged
+    // into one read if the hole between them is at most `merge_gap_bytes', and one read
+    // is at most `max_read_bytes' unless a single page is larger.
+    // The cache handles of the pages in cache are appended to `handles', which keeps them
+    // from being evicted before they are read.
+    // All `pages' must share the same file reader and stats.
+    static Status prefetch_pages(std::vector<PageReadOptions> pages, size_t merge_gap_bytes,
+                                 size_t max_read_bytes, std::vector<PageHandle>* handles);
 };
 
 } // namespace segment_v2
@@ -355,6 +355,12 @@ Status Segment::new_inverted_index_iterator(const TabletColumn& tablet_column,
 }
 
 Status Segment::lookup_row_key(const Slice& key, bool with_seq_col, RowLocation* row_location) {
+    std::unique_ptr<segment_v2::IndexedColumnIterator> index_iterator;
+    return lookup_row_key(key, with_seq_col, row_location, &index_iterator);
+}
+
+Status Segment::lookup_row_key(const Slice& key, bool with_seq_col, RowLocation* row_location,
+                               std::unique_ptr<segment_v2::IndexedColumnIterator>* index_iterator) {
     RETURN_IF_ERROR(load_pk_index_and_bf());
     bool has_seq_col = _tablet_schema->has_sequence_col();
     size_t seq_col_length = 0;
@@ -370,13 +376,14 @@ Status Segment::lookup_row_key(const Slice& key, bool with_seq_col, RowLocation*
         return Status::NotFound("Can't find key in the segment");
     }
     bool exact_match = false;
-    std::unique_ptr<segment_v2::IndexedColumnIterator> index_iterator;
-    RETURN_IF_ERROR(_pk_index_reader->new_iterator(&index_iterator));
-    RETURN_IF_ERROR(index_iterator->seek_at_or_after(&key_without_seq, &exact_match));
+    if (*index_iterator == nullptr) {
+        RETURN_IF_ERROR(_pk_index_reader->new_iterator(index_iterator));
+    }
+    RETURN_IF_ERROR((*index_iterator)->seek_at_or_after(&key_without_seq, &exact_match));
     if (!has_seq_col && !exact_match) {
         return Status::NotFound("Can't find key in the segment");
     }
-    row_location->row_id = index_iterator->get_current_ordinal();
+    row_location->row_id = (*index_iterator)->get_current_ordinal();
     row_location->segment_id = _segment_id;
     row_location->rowset_id = _rowset_id;
 
@@ -386,7 +393,7 @@ Status Segment::lookup_row_key(const Slice& key, bool with_seq_col, RowLocation*
                 _pk_index_reader->type_info()->type(), 1, 0);
         auto index_column = index_type->create_column();
         size_t num_read = num_to_read;
-        RETURN_IF_ERROR(index_iterator->next_batch(&num_read, index_column));
+        RETURN_IF_ERROR((*index_iterator)->next_batch(&num_read, index_column));
         DCHECK(num_to_read == num_read);
 
         Slice sought_key =
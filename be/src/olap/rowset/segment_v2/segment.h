@@ -57,6 +57,7 @@ struct RowLocation;
 namespace segment_v2 {
 
 class BitmapIndexIterator;
+class IndexedColumnIterator;
 class Segment;
 class InvertedIndexIterator;
 
@@ -90,6 +91,12 @@ public:
     Status new_column_iterator(const TabletColumn& tablet_column,
                                std::unique_ptr<ColumnIterator>* iter);
 
+    // nullptr if this segment has no data of the column, e.g. the column is added later
+    ColumnReader* get_column_reader(int32_t unique_id) {
+        auto it = _column_readers.find(unique_id);
+        return it == _column_readers.end() ? nullptr : it->second.get();
+    }
+
     Status new_bitmap_index_iterator(const TabletColumn& tablet_column,
                                      std::unique_ptr<BitmapIndexIterator>* iter);
 
@@ -109,6 +116,12 @@ public:
 
     Status lookup_row_key(const Slice& key, bool with_seq_col, RowLocation* row_location);
 
+    // The same as above, but seeks with `index_iterator', which is created at the first call.
+    // When ascending keys are looked up with the same iterator, each seek goes on from the
+    // data page of the last one instead of reading the page again.
+    Status lookup_row_key(const Slice& key, bool with_seq_col, RowLocation* row_location,
+                          std::unique_ptr<segment_v2::IndexedColumnIterator>* index_iterator);
+
     Status read_key_by_rowid(uint32_t row_id, std::string* key);
 
     // only used by UT
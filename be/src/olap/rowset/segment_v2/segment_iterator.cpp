@@ -23,6 +23,7 @@
 
 #include <algorithm>
 #include <boost/iterator/iterator_facade.hpp>
+#include <future>
 #include <memory>
 #include <numeric>
 #include <set>
@@ -43,11 +44,13 @@
 #include "olap/iterators.h"
 #include "olap/like_column_predicate.h"
 #include "olap/olap_common.h"
+#include "olap/page_cache.h"
 #include "olap/primary_key_index.h"
 #include "olap/rowset/segment_v2/bitmap_index_reader.h"
 #include "olap/rowset/segment_v2/column_reader.h"
 #include "olap/rowset/segment_v2/indexed_column_reader.h"
 #include "olap/rowset/segment_v2/inverted_index_reader.h"
+#include "olap/rowset/segment_v2/page_io.h"
 #include "olap/rowset/segment_v2/row_ranges.h"
 #include "olap/rowset/segment_v2/segment.h"
 #include "olap/schema.h"
@@ -55,6 +58,7 @@
 #include "olap/tablet_schema.h"
 #include "olap/types.h"
 #include "olap/utils.h"
+#include "runtime/exec_env.h"
 #include "runtime/query_context.h"
 #include "runtime/runtime_predicate.h"
 #include "runtime/runtime_state.h"
@@ -63,6 +67,7 @@
 #include "util/doris_metrics.h"
 #include "util/key_util.h"
 #include "util/simd/bits.h"
+#include "util/threadpool.h"
 #include "vec/columns/column.h"
 #include "vec/columns/column_const.h"
 #include "vec/columns/column_nullable.h"
@@ -86,6 +91,18 @@ namespace doris {
 using namespace ErrorCode;
 namespace segment_v2 {
 
+// Prefetch of a window of pages running in background. It owns what the read needs, so
+// that the iterator could go away without waiting for it.
+struct SegmentIterator::PagePrefetchTask {
+    // keeps the file reader alive
+    std::shared_ptr<Segment> segment;
+    OlapReaderStatistics stats;
+    // the prefetched pages, pinned in page cache until the window is read
+    std::vector<PageHandle> pages;
+    std::promise<Status> promise;
+    std::future<Status> future;
+};
+
 SegmentIterator::~SegmentIterator() = default;
 
 // A fast range iterator for roaring bitmap. Output ranges use closed-open form, like [from, to).
@@ -289,6 +306,11 @@ Status SegmentIterator::_lazy_init() {
     } else {
         _range_iter.reset(new BitmapRangeIterator(_row_bitmap));
     }
+    // pages are prefetched into page cache, and forward only
+    _enable_page_prefetch = config::enable_segment_page_prefetch && _opts.use_page_cache &&
+                            !_opts.read_orderby_key_reverse &&
+                            _opts.io_ctx.reader_type == ReaderType::READER_QUERY &&
+                            StoragePageCache::instance()->is_cache_available(DATA_PAGE);
     return Status::OK();
 }
 
@@ -375,6 +397,7 @@ Status SegmentIterator::_prepare_seek(const StorageReadOptions::KeyRange& key_ra
             ColumnIteratorOptions iter_opts;
             iter_opts.stats = _opts.stats;
             iter_opts.use_page_cache = _opts.use_page_cache;
+            iter_opts.large_scan = _opts.large_scan;
             iter_opts.file_reader = _file_reader.get();
             iter_opts.io_ctx = _opts.io_ctx;
             RETURN_IF_ERROR(_column_iterators[unique_id]->init(iter_opts));
@@ -1034,6 +1057,7 @@ Status SegmentIterator::_init_return_column_iterators() {
             ColumnIteratorOptions iter_opts;
             iter_opts.stats = _opts.stats;
             iter_opts.use_page_cache = _opts.use_page_cache;
+            iter_opts.large_scan = _opts.large_scan;
             iter_opts.file_reader = _file_reader.get();
             iter_opts.io_ctx = _opts.io_ctx;
             // If the col is predicate column, then should read the last page to check
@@ -1577,6 +1601,9 @@ Status SegmentIterator::_read_columns_by_index(uint32_t nrows_read_limit, uint32
         if (!has_next_range) {
             break;
         }
+        if (_enable_page_prefetch) {
+            _prefetch_pages(range_from);
+        }
         if (_cur_rowid == 0 || _cur_rowid != range_from) {
             _cur_rowid = range_from;
             _opts.stats->block_first_read_seek_num += 1;
@@ -1603,6 +1630,110 @@ Status SegmentIterator::_read_columns_by_index(uint32_t nrows_read_limit, uint32
     return Status::OK();
 }
 
+void SegmentIterator::_prefetch_pages(rowid_t rowid) {
+    const rowid_t window_rows = std::max(config::segment_prefetch_window_rows, 1);
+    if (rowid >= _prefetch_end) {
+        // nothing read ahead covers rowid (the first read, or the row bitmap skips many rows),
+        // read the window starting at it right now
+        _wait_prefetch_task();
+        rowid_t end = std::min<rowid_t>(rowid + window_rows, num_rows());
+        std::vector<PageReadOptions> pages;
+        std::vector<PageHandle> handles;
+        Status st = _collect_prefetch_pages(rowid, end, &pages);
+        if (st.ok()) {
+            st = PageIO::prefetch_pages(std::move(pages),
+                                        config::segment_prefetch_merge_gap_bytes,
+                                        config::segment_prefetch_max_read_bytes, &handles);
+        }
+        _prefetched_pages.swap(handles);
+        if (!st.ok()) {
+            // the following reads will read the pages themselves, and report the error if any
+            LOG(WARNING) << "failed to prefetch pages of segment " << _segment->id() << ": "
+                         << st;
+        }
+        _prefetch_window_start = _prefetch_end = end;
+    } else if (rowid >= _prefetch_window_start) {
+        // reached the window read in background
+        _wait_prefetch_task();
+        _prefetch_window_start = _prefetch_end;
+    } else {
+        return;
+    }
+
+    // read the next window in background while decoding the current one
+    if (_prefetch_end < num_rows()) {
+        _prefetch_end = std::min<rowid_t>(_prefetch_end + window_rows, num_rows());
+        _submit_prefetch_task(_prefetch_window_start, _prefetch_end);
+    }
+}
+
+Status SegmentIterator::_collect_prefetch_pages(rowid_t first, rowid_t end,
+                                                std::vector<PageReadOptions>* pages) {
+    if (first >= end) {
+        return Status::OK();
+    }
+    for (auto cid : _first_read_column_ids) {
+        auto iter = _column_iterators.find(_schema->unique_id(cid));
+        if (iter == _column_iterators.end() || iter->second == nullptr) {
+            continue;
+        }
+        RETURN_IF_ERROR(iter->second->collect_prefetch_pages(_row_bitmap, first, end - 1, pages));
+    }
+    return Status::OK();
+}
+
+void SegmentIterator::_submit_prefetch_task(rowid_t first, rowid_t end) {
+    auto* thread_pool = ExecEnv::GetInstance()->buffered_reader_prefetch_thread_pool();
+    if (thread_pool == nullptr) {
+        return;
+    }
+    std::vector<PageReadOptions> pages;
+    if (!_collect_prefetch_pages(first, end, &pages).ok() || pages.empty()) {
+        return;
+    }
+
+    auto task = std::make_shared<PagePrefetchTask>();
+    task->segment = _segment;
+    task->future = task->promise.get_future();
+    for (auto& page : pages) {
+        // the scanner keeps updating its own statistics meanwhile
+        page.stats = &task->stats;
+        page.io_ctx.file_cache_stats = nullptr;
+        page.io_ctx.query_id = nullptr;
+    }
+    auto mem_tracker = thread_context()->thread_mem_tracker_mgr->limiter_mem_tracker();
+    auto st = thread_pool->submit_func([task, pages = std::move(pages), mem_tracker]() mutable {
+        // the read buffers are charged to the query
+        SCOPED_ATTACH_TASK(mem_tracker);
+        task->promise.set_value(PageIO::prefetch_pages(std::move(pages),
+                                                       config::segment_prefetch_merge_gap_bytes,
+                                                       config::segment_prefetch_max_read_bytes,
+                                                       &task->pages));
+    });
+    if (st.ok()) {
+        _prefetch_task = std::move(task);
+    }
+}
+
+void SegmentIterator::_wait_prefetch_task() {
+    if (_prefetch_task == nullptr) {
+        return;
+    }
+    Status st = _prefetch_task->future.get();
+    if (!st.ok()) {
+        LOG(WARNING) << "failed to prefetch pages of segment " << _segment->id() << ": " << st;
+    }
+    const auto& stats = _prefetch_task->stats;
+    _opts.stats->compressed_bytes_read += stats.compressed_bytes_read;
+    _opts.stats->uncompressed_bytes_read += stats.uncompressed_bytes_read;
+    _opts.stats->decompress_ns += stats.decompress_ns;
+    _opts.stats->prefetch_io_num += stats.prefetch_io_num;
+    _opts.stats->prefetched_pages_num += stats.prefetched_pages_num;
+    // the pages of the previous window are not needed any more
+    _prefetched_pages.swap(_prefetch_task->pages);
+    _prefetch_task.reset();
+}
+
 void SegmentIterator::_replace_version_col(size_t num_rows) {
     // Only the rowset with single version need to replace the version column.
     // Doris can't determine the version before publish_version finished, so
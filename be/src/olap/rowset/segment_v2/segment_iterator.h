@@ -41,6 +41,8 @@
 #include "olap/row_cursor.h"
 #include "olap/row_cursor_cell.h"
 #include "olap/rowset/segment_v2/common.h"
+#include "olap/rowset/segment_v2/page_handle.h"
+#include "olap/rowset/segment_v2/page_io.h"
 #include "olap/rowset/segment_v2/segment.h"
 #include "olap/schema.h"
 #include "util/runtime_profile.h"
@@ -212,6 +214,13 @@ private:
                                        vectorized::MutableColumns& column_block, size_t nrows);
     [[nodiscard]] Status _read_columns_by_index(uint32_t nrows_read_limit, uint32_t& nrows_read,
                                                 bool set_block_rowid);
+    // make sure the pages of the first read columns holding `rowid' have been read into
+    // page cache, and keep the window after it prefetching in background
+    void _prefetch_pages(rowid_t rowid);
+    Status _collect_prefetch_pages(rowid_t first, rowid_t end,
+                                   std::vector<PageReadOptions>* pages);
+    void _submit_prefetch_task(rowid_t first, rowid_t end);
+    void _wait_prefetch_task();
     void _replace_version_col(size_t num_rows);
     void _init_current_block(vectorized::Block* block,
                              std::vector<vectorized::MutableColumnPtr>& non_pred_vector);
@@ -328,6 +337,7 @@ private:
 
     class BitmapRangeIterator;
     class BackwardBitmapRangeIterator;
+    struct PagePrefetchTask;
 
     std::shared_ptr<Segment> _segment;
     SchemaSPtr _schema;
@@ -346,6 +356,17 @@ private:
     std::unique_ptr<BitmapRangeIterator> _range_iter;
     // the next rowid to read
     rowid_t _cur_rowid;
+    // members related to page prefetch
+    // --------------------------------------------
+    // pages of rows before _prefetch_window_start are in page cache, the ones of rows in
+    // [_prefetch_window_start, _prefetch_end) are being read by _prefetch_task
+    bool _enable_page_prefetch = false;
+    rowid_t _prefetch_window_start = 0;
+    rowid_t _prefetch_end = 0;
+    std::shared_ptr<PagePrefetchTask> _prefetch_task;
+    // pages of the window being read, pinned in page cache so that they are not evicted and
+    // read again before the iterator reaches them
+    std::vector<PageHandle> _prefetched_pages;
     // members related to lazy materialization read
     // --------------------------------------------
     // whether lazy materialization read should be used.
@@ -38,9 +38,11 @@
 #include "olap/primary_key_index.h"
 #include "olap/row_cursor.h"                      // RowCursor // IWYU pragma: keep
 #include "olap/rowset/rowset_writer_context.h"    // RowsetWriterContext
+#include "olap/rowset/segment_v2/column_reader.h"
 #include "olap/rowset/segment_v2/column_writer.h" // ColumnWriter
 #include "olap/rowset/segment_v2/page_io.h"
 #include "olap/rowset/segment_v2/page_pointer.h"
+#include "olap/rowset/segment_v2/segment.h"
 #include "olap/segment_loader.h"
 #include "olap/short_key_index.h"
 #include "olap/tablet_schema.h"
@@ -258,6 +260,23 @@ Status SegmentWriter::init(const std::vector<uint32_t>& col_ids, bool has_key) {
     return Status::OK();
 }
 
+Status SegmentWriter::create_column_group_writer(const std::vector<uint32_t>& col_ids,
+                                                 std::unique_ptr<SegmentWriter>* writer) {
+    DCHECK(_column_writers.empty());
+    writer->reset(new SegmentWriter(_file_writer, _segment_id, _tablet_schema, _tablet, _data_dir,
+                                    _max_row_per_segment, _opts, nullptr));
+    (*writer)->_row_count = _row_count;
+    return (*writer)->init(col_ids, false);
+}
+
+void SegmentWriter::merge_column_group(SegmentWriter* writer) {
+    DCHECK(writer->_column_writers.empty());
+    for (auto& column_meta : *writer->_footer.mutable_columns()) {
+        _footer.add_columns()->Swap(&column_meta);
+    }
+    writer->_footer.clear_columns();
+}
+
 Status SegmentWriter::_create_writers(
         const TabletSchema& tablet_schema, const std::vector<uint32_t>& col_ids,
         std::function<Status(uint32_t, const TabletColumn&)> create_column_writer) {
@@ -694,6 +713,26 @@ Status SegmentWriter::append_block(const vectorized::Block* block, size_t row_po
     return Status::OK();
 }
 
+Status SegmentWriter::append_segment_pages(Segment* segment, OlapReaderStatistics* stats) {
+    DCHECK(!_has_key);
+    ColumnIteratorOptions iter_opts;
+    iter_opts.file_reader = segment->file_reader().get();
+    iter_opts.stats = stats;
+    iter_opts.type = DATA_PAGE;
+    for (size_t i = 0; i < _column_writers.size(); ++i) {
+        const auto& column = _tablet_schema->column(_column_ids[i]);
+        auto* reader = segment->get_column_reader(column.unique_id());
+        auto* writer = dynamic_cast<ScalarColumnWriter*>(_column_writers[i].get());
+        if (reader == nullptr || writer == nullptr || reader->num_rows() != segment->num_rows()) {
+            return Status::NotSupported("can not copy pages of column {} from segment {}",
+                                        column.name(), segment->id());
+        }
+        RETURN_IF_ERROR(writer->append_pages(reader, iter_opts));
+    }
+    _num_rows_written += segment->num_rows();
+    return Status::OK();
+}
+
 int64_t SegmentWriter::max_row_to_add(size_t row_avg_size_in_bytes) {
     auto segment_size = estimate_segment_size();
     if (PREDICT_FALSE(segment_size >= MAX_SEGMENT_SIZE ||
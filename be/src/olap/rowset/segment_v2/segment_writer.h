@@ -56,6 +56,7 @@ class MemTracker;
 class ShortKeyIndexBuilder;
 class PrimaryKeyIndexBuilder;
 class KeyCoder;
+struct OlapReaderStatistics;
 struct RowsetWriterContext;
 
 namespace io {
@@ -64,6 +65,8 @@ class FileWriter;
 
 namespace segment_v2 {
 
+class Segment;
+
 extern const char* k_segment_magic;
 extern const uint32_t k_segment_magic_length;
 
@@ -92,10 +95,21 @@ public:
     // for vertical compaction
     Status init(const std::vector<uint32_t>& col_ids, bool has_key);
 
+    // For parallel vertical compaction, after the key column group is finalized: create a
+    // writer of the value column group `col_ids` of this segment. Column groups are written
+    // into the same file, so finalizing them must be serialized by the caller. Once finalized,
+    // the column metas are moved into this segment by merge_column_group().
+    Status create_column_group_writer(const std::vector<uint32_t>& col_ids,
+                                      std::unique_ptr<SegmentWriter>* writer);
+    void merge_column_group(SegmentWriter* writer);
+
     template <typename RowType>
     Status append_row(const RowType& row);
 
     Status append_block(const vectorized::Block* block, size_t row_pos, size_t num_rows);
+    // For page copy compaction: append all rows of the value column group from `segment`
+    // by copying its data pages without decoding them.
+    Status append_segment_pages(Segment* segment, OlapReaderStatistics* stats);
     Status append_block_with_partial_content(const vectorized::Block* block, size_t row_pos,
                                              size_t num_rows);
 
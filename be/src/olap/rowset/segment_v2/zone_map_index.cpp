@@ -118,6 +118,41 @@ Status TypedZoneMapIndexWriter<Type>::flush() {
     return Status::OK();
 }
 
+template <PrimitiveType Type>
+Status TypedZoneMapIndexWriter<Type>::add_page_zone_map(const ZoneMapPB& zone_map) {
+    // The page zone map is kept as is, the segment zone map is updated by its values, which
+    // are parsed the same way as readers do.
+    if (zone_map.pass_all()) {
+        reset_segment_zone_map();
+    } else if (zone_map.has_not_null()) {
+        RETURN_IF_ERROR(_field->from_string(_page_zone_map.min_value, zone_map.min()));
+        RETURN_IF_ERROR(_field->from_string(_page_zone_map.max_value, zone_map.max()));
+        if (_field->compare(_segment_zone_map.min_value, _page_zone_map.min_value) > 0) {
+            _field->type_info()->direct_copy(_segment_zone_map.min_value,
+                                             _page_zone_map.min_value);
+        }
+        if (_field->compare(_segment_zone_map.max_value, _page_zone_map.max_value) < 0) {
+            _field->type_info()->direct_copy(_segment_zone_map.max_value,
+                                             _page_zone_map.max_value);
+        }
+        _reset_zone_map(&_page_zone_map);
+    }
+    if (zone_map.has_null()) {
+        _segment_zone_map.has_null = true;
+    }
+    if (zone_map.has_not_null()) {
+        _segment_zone_map.has_not_null = true;
+    }
+
+    std::string serialized_zone_map;
+    if (!zone_map.SerializeToString(&serialized_zone_map)) {
+        return Status::InternalError("serialize zone map failed");
+    }
+    _estimated_size += serialized_zone_map.size() + sizeof(uint32_t);
+    _values.push_back(std::move(serialized_zone_map));
+    return Status::OK();
+}
+
 template <PrimitiveType Type>
 Status TypedZoneMapIndexWriter<Type>::finish(io::FileWriter* file_writer,
                                              ColumnIndexMetaPB* index_meta) {
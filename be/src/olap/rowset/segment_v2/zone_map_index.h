@@ -88,6 +88,9 @@ public:
 
     virtual Status finish(io::FileWriter* file_writer, ColumnIndexMetaPB* index_meta) = 0;
 
+    // add the zone map of a data page copied from another segment
+    virtual Status add_page_zone_map(const ZoneMapPB& zone_map) = 0;
+
     virtual void moidfy_index_before_flush(ZoneMap& zone_map) = 0;
 
     virtual uint64_t size() const = 0;
@@ -114,6 +117,8 @@ public:
 
     Status finish(io::FileWriter* file_writer, ColumnIndexMetaPB* index_meta) override;
 
+    Status add_page_zone_map(const ZoneMapPB& zone_map) override;
+
     void moidfy_index_before_flush(ZoneMap& zone_map) override;
 
     uint64_t size() const override { return _estimated_size; }
@@ -33,9 +33,13 @@
 #include "io/fs/file_reader_writer_fwd.h"
 #include "io/fs/file_system.h"
 #include "io/fs/file_writer.h"
+#include "olap/iterators.h"
+#include "olap/olap_common.h"
 #include "olap/rowset/beta_rowset.h"
 #include "olap/rowset/rowset_meta.h"
 #include "olap/rowset/rowset_writer_context.h"
+#include "olap/rowset/segment_v2/segment.h"
+#include "olap/schema.h"
 #include "util/slice.h"
 #include "util/spinlock.h"
 #include "vec/core/block.h"
@@ -205,6 +209,111 @@ Status VerticalBetaRowsetWriter::_create_segment_writer(
     return Status::OK();
 }
 
+Status VerticalBetaRowsetWriter::create_column_group_writer(
+        const std::vector<uint32_t>& col_ids, std::unique_ptr<ColumnGroupWriter>* writer) {
+    writer->reset(new VerticalColumnGroupWriter(this, col_ids));
+    return Status::OK();
+}
+
+Status VerticalColumnGroupWriter::_create_segment_writer() {
+    auto& segment_writers = _rowset_writer->_segment_writers;
+    if (_cur_writer_idx >= segment_writers.size()) {
+        return Status::InternalError("column group has more rows than key group, segments: {}",
+                                     segment_writers.size());
+    }
+    std::lock_guard<std::mutex> l(_rowset_writer->_column_group_lock);
+    return segment_writers[_cur_writer_idx]->create_column_group_writer(_col_ids,
+                                                                        &_segment_writer);
+}
+
+Status VerticalColumnGroupWriter::add_columns(const vectorized::Block* block) {
+    size_t num_rows = block->rows();
+    size_t row_pos = 0;
+    while (row_pos < num_rows) {
+        if (_segment_writer == nullptr) {
+            RETURN_IF_ERROR(_create_segment_writer());
+        }
+        // keep rows aligned with key columns of the segment
+        size_t limit = std::min<size_t>(
+                num_rows - row_pos,
+                _segment_writer->row_count() - _segment_writer->num_rows_written());
+        if (limit > 0) {
+            RETURN_IF_ERROR(_segment_writer->append_block(block, row_pos, limit));
+            row_pos += limit;
+        }
+        if (_segment_writer->num_rows_written() == _segment_writer->row_count()) {
+            RETURN_IF_ERROR(flush_columns());
+            ++_cur_writer_idx;
+        }
+    }
+    return Status::OK();
+}
+
+Status VerticalColumnGroupWriter::flush_columns() {
+    if (_segment_writer == nullptr) {
+        return Status::OK();
+    }
+    uint64_t index_size = 0;
+    std::lock_guard<std::mutex> l(_rowset_writer->_column_group_lock);
+    RETURN_IF_ERROR(_segment_writer->finalize_columns_data());
+    RETURN_IF_ERROR(_segment_writer->finalize_columns_index(&index_size));
+    _rowset_writer->_segment_writers[_cur_writer_idx]->merge_column_group(_segment_writer.get());
+    _rowset_writer->_total_index_size +=
+            static_cast<int64_t>(index_size) + _segment_writer->get_inverted_index_file_size();
+    _segment_writer.reset();
+    return Status::OK();
+}
+
+Status VerticalBetaRowsetWriter::add_segment_by_page_copy(
+        const std::vector<std::shared_ptr<segment_v2::Segment>>& segments,
+        const std::vector<uint32_t>& copy_col_ids, OlapReaderStatistics* stats) {
+    // the key column group holds all the columns not copied, including all key columns
+    std::vector<uint32_t> key_col_ids;
+    for (uint32_t cid = 0; cid < _context.tablet_schema->num_columns(); ++cid) {
+        if (std::find(copy_col_ids.begin(), copy_col_ids.end(), cid) == copy_col_ids.end()) {
+            key_col_ids.push_back(cid);
+        }
+    }
+    std::unique_ptr<segment_v2::SegmentWriter> writer;
+    RETURN_IF_ERROR(_create_segment_writer(key_col_ids, true, &writer));
+    _segment_writers.emplace_back(std::move(writer));
+    _cur_writer_idx = _segment_writers.size() - 1;
+    auto& segment_writer = _segment_writers[_cur_writer_idx];
+
+    auto schema = std::make_shared<Schema>(_context.tablet_schema->columns(), key_col_ids);
+    StorageReadOptions read_options;
+    read_options.stats = stats;
+    read_options.use_page_cache = false;
+    read_options.tablet_schema = _context.tablet_schema;
+    vectorized::Block block = _context.tablet_schema->create_block(key_col_ids);
+    size_t num_rows = 0;
+    for (auto& segment : segments) {
+        std::unique_ptr<RowwiseIterator> iter;
+        RETURN_IF_ERROR(segment->new_iterator(schema, read_options, &iter));
+        while (true) {
+            auto st = iter->next_batch(&block);
+            if (st.is<END_OF_FILE>()) {
+                break;
+            }
+            RETURN_IF_ERROR(st);
+            RETURN_IF_ERROR(segment_writer->append_block(&block, 0, block.rows()));
+            block.clear_column_data();
+        }
+        num_rows += segment->num_rows();
+    }
+    RETURN_IF_ERROR(_flush_columns(&segment_writer, true));
+
+    if (!copy_col_ids.empty()) {
+        RETURN_IF_ERROR(segment_writer->init(copy_col_ids, false));
+        for (auto& segment : segments) {
+            RETURN_IF_ERROR(segment_writer->append_segment_pages(segment.get(), stats));
+        }
+        RETURN_IF_ERROR(_flush_columns(&segment_writer));
+    }
+    _num_rows_written += num_rows;
+    return Status::OK();
+}
+
 Status VerticalBetaRowsetWriter::final_flush() {
     for (auto& segment_writer : _segment_writers) {
         uint64_t segment_size = 0;
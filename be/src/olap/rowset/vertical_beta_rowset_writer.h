@@ -21,6 +21,7 @@
 #include <stdint.h>
 
 #include <memory>
+#include <mutex>
 #include <vector>
 
 #include "common/status.h"
@@ -44,12 +45,21 @@ public:
     // flush last segment's column
     Status flush_columns(bool is_key) override;
 
+    Status create_column_group_writer(const std::vector<uint32_t>& col_ids,
+                                      std::unique_ptr<ColumnGroupWriter>* writer) override;
+
+    Status add_segment_by_page_copy(
+            const std::vector<std::shared_ptr<segment_v2::Segment>>& segments,
+            const std::vector<uint32_t>& copy_col_ids, OlapReaderStatistics* stats) override;
+
     // flush when all column finished, flush column footer
     Status final_flush() override;
 
     int64_t num_rows() const override { return _total_key_group_rows; }
 
 private:
+    friend class VerticalColumnGroupWriter;
+
     // only key group will create segment writer
     Status _create_segment_writer(const std::vector<uint32_t>& column_ids, bool is_key,
                                   std::unique_ptr<segment_v2::SegmentWriter>* writer);
@@ -61,6 +71,30 @@ private:
     std::vector<std::unique_ptr<segment_v2::SegmentWriter>> _segment_writers;
     size_t _cur_writer_idx = 0;
     size_t _total_key_group_rows = 0;
+    // serialize the column group writers writing into segment files
+    std::mutex _column_group_lock;
+};
+
+// Writes a value column group into the segments created by the key column group, each
+// segment by a separate segment writer sharing its file.
+class VerticalColumnGroupWriter : public ColumnGroupWriter {
+public:
+    VerticalColumnGroupWriter(VerticalBetaRowsetWriter* rowset_writer,
+                              const std::vector<uint32_t>& col_ids)
+            : _rowset_writer(rowset_writer), _col_ids(col_ids) {}
+
+    Status add_columns(const vectorized::Block* block) override;
+
+    Status flush_columns() override;
+
+private:
+    Status _create_segment_writer();
+
+    VerticalBetaRowsetWriter* _rowset_writer;
+    std::vector<uint32_t> _col_ids;
+    size_t _cur_writer_idx = 0;
+    // writer of the column group in the `_cur_writer_idx`-th segment
+    std::unique_ptr<segment_v2::SegmentWriter> _segment_writer;
 };
 
 } // namespace doris
\ No newline at end of file
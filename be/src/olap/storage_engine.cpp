@@ -120,6 +120,7 @@ StorageEngine::StorageEngine(const EngineOptions& options)
           _stopped(false),
           _segcompaction_mem_tracker(std::make_shared<MemTracker>("SegCompaction")),
           _segment_meta_mem_tracker(std::make_shared<MemTracker>("SegmentMeta")),
+          _primary_key_filter_mem_tracker(std::make_shared<MemTracker>("PrimaryKeyFilter")),
           _stop_background_threads_latch(1),
           _tablet_manager(new TabletManager(config::tablet_map_shard_size)),
           _txn_manager(new TxnManager(config::txn_map_shard_size, config::txn_shard_size)),
@@ -158,6 +159,13 @@ StorageEngine::~StorageEngine() {
     if (_cold_data_compaction_thread_pool) {
         _cold_data_compaction_thread_pool->shutdown();
     }
+    if (_primary_key_filter_thread_pool) {
+        _primary_key_filter_thread_pool->shutdown();
+    }
+    // after the compaction pools, whose tasks may wait for the tasks of this pool
+    if (_vertical_compaction_thread_pool) {
+        _vertical_compaction_thread_pool->shutdown();
+    }
     _clear();
     _s_instance = nullptr;
 }
@@ -201,6 +201,9 @@ public:
 
     std::shared_ptr<MemTracker> segment_meta_mem_tracker() { return _segment_meta_mem_tracker; }
     std::shared_ptr<MemTracker> segcompaction_mem_tracker() { return _segcompaction_mem_tracker; }
+    std::shared_ptr<MemTracker> primary_key_filter_mem_tracker() {
+        return _primary_key_filter_mem_tracker;
+    }
 
     // check cumulative compaction config
     void check_cumulative_compaction_config();
@@ -209,12 +212,20 @@ public:
                                   bool force);
     Status submit_seg_compaction_task(SegcompactionWorker* worker,
                                       SegCompactionCandidatesSharedPtr segments);
+    // Rebuild the primary key filter of `tablet` in background, see
+    // Tablet::update_primary_key_filter().
+    Status submit_update_primary_key_filter_task(TabletSharedPtr tablet);
 
     std::unique_ptr<ThreadPool>& tablet_publish_txn_thread_pool() {
         return _tablet_publish_txn_thread_pool;
     }
     bool stopped() { return _stopped; }
     ThreadPool* get_bg_multiget_threadpool() { return _bg_multi_get_thread_pool.get(); }
+    // nullptr if value column groups of vertical compaction are compacted one by one
+    ThreadPool* vertical_compaction_thread_pool() {
+        return _vertical_compaction_thread_pool.get();
+    }
+    CompactionPermitLimiter* compaction_permit_limiter() { return &_permit_limiter; }
 
     Status process_index_change_task(const TAlterInvertedIndexReq& reqest);
 
@@ -387,6 +398,8 @@ private:
     // This mem tracker is only for tracking memory use by segment meta data such as footer or index page.
     // The memory consumed by querying is tracked in segment iterator.
     std::shared_ptr<MemTracker> _segment_meta_mem_tracker;
+    // Count the memory of the primary key filters of merge-on-write tablets.
+    std::shared_ptr<MemTracker> _primary_key_filter_mem_tracker;
 
     CountDownLatch _stop_background_threads_latch;
     scoped_refptr<Thread> _unused_rowset_monitor_thread;
@@ -434,11 +447,16 @@ private:
     std::unique_ptr<ThreadPool> _single_replica_compaction_thread_pool;
     std::unique_ptr<ThreadPool> _seg_compaction_thread_pool;
     std::unique_ptr<ThreadPool> _cold_data_compaction_thread_pool;
+    std::unique_ptr<ThreadPool> _vertical_compaction_thread_pool;
 
     std::unique_ptr<ThreadPool> _tablet_publish_txn_thread_pool;
 
     std::unique_ptr<ThreadPool> _tablet_meta_checkpoint_thread_pool;
     std::unique_ptr<ThreadPool> _bg_multi_get_thread_pool;
+    std::unique_ptr<ThreadPool> _primary_key_filter_thread_pool;
+    std::mutex _primary_key_filter_mutex;
+    // tablets whose primary key filter rebuild is queued, a tablet is queued only once
+    std::unordered_set<TTabletId> _primary_key_filter_submitted_tablets;
 
     CompactionPermitLimiter _permit_limiter;
 
@@ -38,6 +38,7 @@
 #include <algorithm>
 #include <atomic>
 #include <boost/container/detail/std_fwd.hpp>
+#include <cmath>
 #include <roaring/roaring.hh>
 
 // IWYU pragma: no_include <opentelemetry/common/threadlocal.h>
@@ -83,6 +84,7 @@
 #include "olap/olap_common.h"
 #include "olap/olap_define.h"
 #include "olap/olap_meta.h"
+#include "olap/primary_key_filter.h"
 #include "olap/primary_key_index.h"
 #include "olap/rowid_conversion.h"
 #include "olap/rowset/beta_rowset.h"
@@ -1007,6 +1009,37 @@ uint32_t Tablet::calc_compaction_score(
     }
 }
 
+static double decay_read_heat(double heat, int64_t elapsed_ms) {
+    int64_t half_life_ms = config::compaction_read_heat_half_life_sec * 1000;
+    if (half_life_ms <= 0 || elapsed_ms <= 0) {
+        return heat;
+    }
+    return heat * std::exp2(-static_cast<double>(elapsed_ms) / half_life_ms);
+}
+
+void Tablet::update_read_amplification(int64_t num_segments, int64_t num_merged_rowsets) {
+    int64_t now_ms = UnixMillis();
+    std::lock_guard lock(_read_heat_lock);
+    _read_heat = decay_read_heat(_read_heat, now_ms - _read_heat_update_ms) + num_segments +
+                 num_merged_rowsets;
+    _read_heat_update_ms = now_ms;
+}
+
+double Tablet::read_heat(int64_t now_ms) const {
+    std::lock_guard lock(_read_heat_lock);
+    return decay_read_heat(_read_heat, now_ms - _read_heat_update_ms);
+}
+
+double Tablet::calc_compaction_priority(uint32_t compaction_score, int64_t now_ms) const {
+    // the boost is capped, so a cold tablet of a much higher score is still compacted first
+    static constexpr double MAX_READ_HEAT_BOOST = 2;
+    if (config::compaction_read_heat_weight <= 0) {
+        return compaction_score;
+    }
+    double boost = 1 + config::compaction_read_heat_weight * std::log2(1 + read_heat(now_ms));
+    return compaction_score * std::min(boost, MAX_READ_HEAT_BOOST);
+}
+
 uint32_t Tablet::calc_cold_data_compaction_score() const {
     uint32_t score = 0;
     std::vector<RowsetMetaSharedPtr> cooldowned_rowsets;
@@ -2756,7 +2789,7 @@ Status Tablet::lookup_row_key(const Slice& encoded_key, bool with_seq_col,
                               const std::vector<RowsetSharedPtr>& specified_rowsets,
                               RowLocation* row_location, uint32_t version,
                               std::vector<std::unique_ptr<SegmentCacheHandle>>& segment_caches,
-                              RowsetSharedPtr* rowset) {
+                              RowsetSharedPtr* rowset, PkIndexIterators* pk_iterators) {
     SCOPED_BVAR_LATENCY(g_tablet_lookup_rowkey_latency);
     size_t seq_col_length = 0;
     if (_schema->has_sequence_col() && with_seq_col) {
@@ -2765,18 +2798,40 @@ Status Tablet::lookup_row_key(const Slice& encoded_key, bool with_seq_col,
     Slice key_without_seq = Slice(encoded_key.get_data(), encoded_key.get_size() - seq_col_length);
     RowLocation loc;
 
+    std::shared_ptr<const PrimaryKeyFilter> pk_filter;
+    {
+        std::lock_guard<std::mutex> l(_pk_filter_lock);
+        pk_filter = _pk_filter;
+    }
+    // The oldest rowsets which are covered by the primary key filter are not probed one by one.
+    size_t num_unfiltered_rowsets = specified_rowsets.size();
+    if (pk_filter != nullptr && pk_filter->covered_by(specified_rowsets)) {
+        num_unfiltered_rowsets -= pk_filter->num_rowsets();
+    }
+
     for (size_t i = 0; i < specified_rowsets.size(); i++) {
+        std::vector<uint32_t> picked_segments;
+        if (i == num_unfiltered_rowsets) {
+            uint32_t rowset_idx = 0;
+            uint32_t segment_id = 0;
+            if (!pk_filter->lookup(key_without_seq, &rowset_idx, &segment_id)) {
+                break;
+            }
+            i += rowset_idx;
+            picked_segments.emplace_back(segment_id);
+        }
         auto& rs = specified_rowsets[i];
-        auto& segments_key_bounds = rs->rowset_meta()->get_segments_key_bounds();
         int num_segments = rs->num_segments();
-        DCHECK_EQ(segments_key_bounds.size(), num_segments);
-        std::vector<uint32_t> picked_segments;
-        for (int i = num_segments - 1; i >= 0; i--) {
-            if (key_without_seq.compare(segments_key_bounds[i].max_key()) > 0 ||
-                key_without_seq.compare(segments_key_bounds[i].min_key()) < 0) {
-                continue;
+        if (picked_segments.empty()) {
+            auto& segments_key_bounds = rs->rowset_meta()->get_segments_key_bounds();
+            DCHECK_EQ(segments_key_bounds.size(), num_segments);
+            for (int i = num_segments - 1; i >= 0; i--) {
+                if (key_without_seq.compare(segments_key_bounds[i].max_key()) > 0 ||
+                    key_without_seq.compare(segments_key_bounds[i].min_key()) < 0) {
+                    continue;
+                }
+                picked_segments.emplace_back(i);
             }
-            picked_segments.emplace_back(i);
         }
         if (picked_segments.empty()) {
             continue;
@@ -2790,8 +2845,14 @@ Status Tablet::lookup_row_key(const Slice& encoded_key, bool with_seq_col,
         auto& segments = segment_caches[i]->get_segments();
         DCHECK_EQ(segments.size(), num_segments);
 
+        if (pk_iterators != nullptr && (*pk_iterators)[i].empty()) {
+            (*pk_iterators)[i].resize(num_segments);
+        }
         for (auto id : picked_segments) {
-            Status s = segments[id]->lookup_row_key(encoded_key, with_seq_col, &loc);
+            Status s = pk_iterators != nullptr
+                               ? segments[id]->lookup_row_key(encoded_key, with_seq_col, &loc,
+                                                              &(*pk_iterators)[i][id])
+                               : segments[id]->lookup_row_key(encoded_key, with_seq_col, &loc);
             if (s.is<NOT_FOUND>()) {
                 continue;
             }
@@ -2819,6 +2880,10 @@ Status Tablet::lookup_row_key(const Slice& encoded_key, bool with_seq_col,
             // find it and return
             return s;
         }
+        if (i >= num_unfiltered_rowsets) {
+            // the filter gives the only segment which may hold a live row of the key
+            break;
+        }
     }
     g_tablet_pk_not_found << 1;
     return Status::NotFound("can't find key in all rowsets");
@@ -2899,6 +2964,10 @@ Status Tablet::calc_segment_delete_bitmap(RowsetSharedPtr rowset,
     // will update the lru cache, and there will be obvious lock competition in multithreading
     // scenarios, so using a segment_caches to cache SegmentCacheHandle.
     std::vector<std::unique_ptr<SegmentCacheHandle>> segment_caches(specified_rowsets.size());
+    // Keys of the segment are looked up in ascending order. An iterator of the primary key index
+    // is kept for each target segment, so the seek of a key on the page of the previous one does
+    // not load the page again.
+    PkIndexIterators pk_iterators(specified_rowsets.size());
     while (remaining > 0) {
         std::unique_ptr<segment_v2::IndexedColumnIterator> iter;
         RETURN_IF_ERROR(pk_idx->new_iterator(&iter));
@@ -2934,7 +3003,7 @@ Status Tablet::calc_segment_delete_bitmap(RowsetSharedPtr rowset,
 
             RowsetSharedPtr rowset_find;
             auto st = lookup_row_key(key, true, specified_rowsets, &loc, dummy_version.first - 1,
-                                     segment_caches, &rowset_find);
+                                     segment_caches, &rowset_find, &pk_iterators);
             bool expected_st = st.ok() || st.is<NOT_FOUND>() || st.is<ALREADY_EXIST>();
             DCHECK(expected_st) << "unexpected error status while lookup_row_key:" << st;
             if (!expected_st) {
@@ -3065,6 +3134,108 @@ std::vector<RowsetSharedPtr> Tablet::get_rowset_by_ids(
     return rowsets;
 }
 
+bool Tablet::need_update_primary_key_filter(ReaderType compaction_type) {
+    if (keys_type() != UNIQUE_KEYS || !enable_unique_key_merge_on_write()) {
+        return false;
+    }
+    std::shared_ptr<const PrimaryKeyFilter> pk_filter;
+    {
+        std::lock_guard<std::mutex> l(_pk_filter_lock);
+        if (!config::enable_tablet_primary_key_filter) {
+            _pk_filter.reset();
+            return false;
+        }
+        pk_filter = _pk_filter;
+    }
+    if (pk_filter == nullptr || compaction_type == ReaderType::READER_BASE_COMPACTION ||
+        compaction_type == ReaderType::READER_FULL_COMPACTION) {
+        return true;
+    }
+    int64_t new_rows = 0;
+    {
+        std::shared_lock rlock(_meta_lock);
+        for (auto& [version, rs] : _rs_version_map) {
+            if (version.second > pk_filter->version()) {
+                new_rows += rs->num_rows();
+            }
+        }
+    }
+    return new_rows * 100 >= static_cast<int64_t>(pk_filter->num_keys()) *
+                                     config::tablet_primary_key_filter_rebuild_percent;
+}
+
+Status Tablet::update_primary_key_filter() {
+    if (!config::enable_tablet_primary_key_filter || keys_type() != UNIQUE_KEYS ||
+        !enable_unique_key_merge_on_write()) {
+        std::lock_guard<std::mutex> l(_pk_filter_lock);
+        _pk_filter.reset();
+        return Status::OK();
+    }
+    OlapStopWatch watch;
+    std::vector<RowsetSharedPtr> rowsets;
+    int64_t version = 0;
+    {
+        std::shared_lock rlock(_meta_lock);
+        rowsets = get_rowset_by_ids(nullptr);
+        version = max_version_unlocked().second;
+    }
+    size_t seq_col_length = 0;
+    if (_schema->has_sequence_col()) {
+        seq_col_length = _schema->column(_schema->sequence_col_idx()).length() + 1;
+    }
+
+    // Only the rows not deleted at `version` are added, so each key is added once.
+    // the old filter is kept until the new one is built, lookups check if it's still valid
+    auto pk_filter = std::make_shared<PrimaryKeyFilter>(
+            rowsets, version, StorageEngine::instance()->primary_key_filter_mem_tracker());
+    for (uint32_t i = 0; i < rowsets.size(); i++) {
+        auto& rs = rowsets[i];
+        if (rs->num_segments() == 0) {
+            continue;
+        }
+        SegmentCacheHandle segment_cache;
+        RETURN_IF_ERROR(SegmentLoader::instance()->load_segments(
+                std::static_pointer_cast<BetaRowset>(rs), &segment_cache, true));
+        for (auto& seg : segment_cache.get_segments()) {
+            RETURN_IF_ERROR(seg->load_pk_index_and_bf());
+            RETURN_IF_ERROR(pk_filter->start_segment(i, seg->id()));
+            auto pk_idx = seg->get_primary_key_index();
+            auto index_type = vectorized::DataTypeFactory::instance().create_data_type(
+                    pk_idx->type_info()->type(), 1, 0);
+            std::unique_ptr<segment_v2::IndexedColumnIterator> iter;
+            RETURN_IF_ERROR(pk_idx->new_iterator(&iter));
+            uint32_t num_rows = pk_idx->num_rows();
+            uint32_t row_id = 0;
+            while (row_id < num_rows) {
+                auto index_column = index_type->create_column();
+                size_t num_read = std::min<size_t>(1024, num_rows - row_id);
+                RETURN_IF_ERROR(iter->seek_to_ordinal(row_id));
+                RETURN_IF_ERROR(iter->next_batch(&num_read, index_column));
+                if (num_read == 0) {
+                    return Status::InternalError("failed to read primary key index of segment {}",
+                                                 seg->id());
+                }
+                for (size_t j = 0; j < num_read; j++, row_id++) {
+                    if (_tablet_meta->delete_bitmap().contains_agg_without_cache(
+                                {rs->rowset_id(), seg->id(), version}, row_id)) {
+                        continue;
+                    }
+                    auto key = index_column->get_data_at(j);
+                    pk_filter->add_key(Slice(key.data, key.size - seq_col_length));
+                }
+            }
+        }
+    }
+    RETURN_IF_ERROR(pk_filter->build());
+    LOG(INFO) << "update primary key filter of tablet: " << tablet_id()
+              << ", rowsets: " << pk_filter->num_rowsets() << ", keys: " << pk_filter->num_keys()
+              << ", memory: " << pk_filter->memory_usage() << ", version: " << version
+              << ", cost: " << watch.get_elapse_time_us() << "(us)";
+    std::lock_guard<std::mutex> l(_pk_filter_lock);
+    _pk_filter = std::move(pk_filter);
+    return Status::OK();
+}
+
 Status Tablet::generate_new_block_for_partial_update(
         TabletSchemaSPtr rowset_schema, const PartialUpdateReadPlan& read_plan_ori,
         const PartialUpdateReadPlan& read_plan_update,
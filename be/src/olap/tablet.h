@@ -40,6 +40,7 @@
 
 #include "common/config.h"
 #include "common/status.h"
+#include "io/io_common.h"
 #include "olap/base_tablet.h"
 #include "olap/binlog_config.h"
 #include "olap/data_dir.h"
@@ -71,6 +72,7 @@ class TTabletInfo;
 class TabletMetaPB;
 class TupleDescriptor;
 class CalcDeleteBitmapToken;
+class PrimaryKeyFilter;
 enum CompressKind : int;
 class RowsetBinlogMetasPB;
 
@@ -85,6 +87,9 @@ enum KeysType : int;
 enum SortType : int;
 
 using TabletSharedPtr = std::shared_ptr<Tablet>;
+// Primary key index iterators of the segments of rowsets, see Tablet::lookup_row_key.
+using PkIndexIterators =
+        std::vector<std::vector<std::unique_ptr<segment_v2::IndexedColumnIterator>>>;
 
 enum TabletStorageType { STORAGE_TYPE_LOCAL, STORAGE_TYPE_REMOTE, STORAGE_TYPE_REMOTE_AND_LOCAL };
 
@@ -214,6 +219,14 @@ public:
     uint32_t calc_compaction_score(
             CompactionType compaction_type,
             std::shared_ptr<CumulativeCompactionPolicy> cumulative_compaction_policy);
+    // Record the read amplification of a query scan on this tablet, i.e. the number of
+    // segments opened and the number of rowsets merged by key.
+    void update_read_amplification(int64_t num_segments, int64_t num_merged_rowsets);
+    // The read amplification of recent query scans, decayed by half every
+    // `compaction_read_heat_half_life_sec`. Tablets which are not queried have 0.
+    double read_heat(int64_t now_ms) const;
+    // The compaction score boosted by the read heat, see `compaction_read_heat_weight`.
+    double calc_compaction_priority(uint32_t compaction_score, int64_t now_ms) const;
 
     // operation for clone
     void calc_missed_versions(int64_t spec_version, std::vector<Version>* missed_versions);
@@ -416,11 +429,16 @@ public:
     // Lookup the row location of `encoded_key`, the function sets `row_location` on success.
     // NOTE: the method only works in unique key model with primary key index, you will got a
     //       not supported error in other data model.
+    // If `pk_iterators` is given, the primary key index iterators of the segments are kept in
+    // it for the next lookup, which is cheaper if keys are looked up in ascending order.
+    // The rowsets covered by the primary key filter of the tablet, if any, are not probed one
+    // by one, only the segment given by the filter is.
     Status lookup_row_key(const Slice& encoded_key, bool with_seq_col,
                           const std::vector<RowsetSharedPtr>& specified_rowsets,
                           RowLocation* row_location, uint32_t version,
                           std::vector<std::unique_ptr<SegmentCacheHandle>>& segment_caches,
-                          RowsetSharedPtr* rowset = nullptr);
+                          RowsetSharedPtr* rowset = nullptr,
+                          PkIndexIterators* pk_iterators = nullptr);
 
     // Lookup a row with TupleDescriptor and fill Block
     Status lookup_row_data(const Slice& encoded_key, const RowLocation& row_location,
@@ -459,6 +477,17 @@ public:
                                       DeleteBitmapPtr delete_bitmap, int64_t end_version,
                                       RowsetWriter* rowset_writer);
 
+    // Rebuild the primary key filter over all the rowsets of the tablet, used by
+    // lookup_row_key(). Called in background after compaction, see
+    // need_update_primary_key_filter().
+    Status update_primary_key_filter();
+
+    // Whether to rebuild the primary key filter after a compaction of `compaction_type`. It's
+    // rebuilt after base and full compaction, and after other compactions only if the rows
+    // loaded since the filter was built reach tablet_primary_key_filter_rebuild_percent of its
+    // keys. Until then lookups skip a filter whose rowsets were compacted.
+    bool need_update_primary_key_filter(ReaderType compaction_type);
+
     Status calc_delete_bitmap_between_segments(
             RowsetSharedPtr rowset, const std::vector<segment_v2::SegmentSharedPtr>& segments,
             DeleteBitmapPtr delete_bitmap);
@@ -631,6 +660,11 @@ private:
     // during publish_txn, which might take hundreds of milliseconds
     mutable std::mutex _rowset_update_lock;
 
+    // Filter over the primary keys of the rowsets of a merge-on-write tablet, see
+    // update_primary_key_filter().
+    mutable std::mutex _pk_filter_lock;
+    std::shared_ptr<const PrimaryKeyFilter> _pk_filter;
+
     // After version 0.13, all newly created rowsets are saved in _rs_version_map.
     // And if rowset being compacted, the old rowsetis will be saved in _stale_rs_version_map;
     std::unordered_map<Version, RowsetSharedPtr, HashOfVersion> _rs_version_map;
@@ -657,6 +691,11 @@ private:
     std::atomic<int32_t> _newly_created_rowset_num;
     std::atomic<int64_t> _last_checkpoint_time;
 
+    // decayed read amplification of query scans, see update_read_amplification()
+    mutable std::mutex _read_heat_lock;
+    double _read_heat = 0;
+    int64_t _read_heat_update_ms = 0;
+
     // cumulative compaction policy
     std::shared_ptr<CumulativeCompactionPolicy> _cumulative_compaction_policy;
     std::string_view _cumulative_compaction_type;
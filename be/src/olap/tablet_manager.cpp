@@ -31,6 +31,7 @@
 #include <list>
 #include <mutex>
 #include <ostream>
+#include <utility>
 
 // IWYU pragma: no_include <opentelemetry/common/threadlocal.h>
 #include "common/compiler_util.h" // IWYU pragma: keep
@@ -748,6 +749,8 @@ TabletSharedPtr TabletManager::find_best_tablet_to_compaction(
             compaction_type == CompactionType::BASE_COMPACTION ? "base" : "cumulative";
     uint32_t highest_score = 0;
     uint32_t compaction_score = 0;
+    double highest_priority = 0;
+    bool best_near_version_limit = false;
     TabletSharedPtr best_tablet;
     for (const auto& tablets_shard : _tablets_shards) {
         std::shared_lock rdlock(tablets_shard.lock);
@@ -800,8 +803,21 @@ TabletSharedPtr TabletManager::find_best_tablet_to_compaction(
             if (current_compaction_score < 5) {
                 tablet_ptr->set_skip_compaction(true, compaction_type, UnixSeconds());
             }
-            if (current_compaction_score > highest_score) {
-                highest_score = current_compaction_score;
+            highest_score = std::max(highest_score, current_compaction_score);
+            // With the read heat boost, tablets which are queried with high read amplification
+            // are compacted first, tablets which are not queried fall behind with the bare
+            // compaction score. The boost must not delay tablets close to the version limit,
+            // they reject loads soon, so they are compacted first. Without the boost tablets
+            // are picked by compaction score only.
+            bool near_version_limit =
+                    config::compaction_read_heat_weight > 0 &&
+                    tablet_ptr->version_count() > config::max_tablet_version_num - 100;
+            double priority =
+                    tablet_ptr->calc_compaction_priority(current_compaction_score, now_ms);
+            if (std::make_pair(near_version_limit, priority) >
+                std::make_pair(best_near_version_limit, highest_priority)) {
+                best_near_version_limit = near_version_limit;
+                highest_priority = priority;
                 compaction_score = current_compaction_score;
                 best_tablet = tablet_ptr;
             }
@@ -813,8 +829,8 @@ TabletSharedPtr TabletManager::find_best_tablet_to_compaction(
                       << "compaction_type=" << compaction_type_str
                       << ", tablet_id=" << best_tablet->tablet_id() << ", path=" << data_dir->path()
                       << ", compaction_score=" << compaction_score
-                      << ", highest_score=" << highest_score;
-        *score = compaction_score;
+                      << ", priority=" << highest_priority << ", highest_score=" << highest_score;
+        *score = highest_score;
     }
     return best_tablet;
 }
@@ -39,6 +39,9 @@ class AggSinkOperator final : public StreamingOperator<AggSinkOperatorBuilder> {
 public:
     AggSinkOperator(OperatorBuilderBase* operator_builder, ExecNode* node);
     bool can_write() override { return true; }
+    // blocked while the spilt hash table is being written by the spill io thread pool
+    bool is_blocked_by_spill_io() const override { return _node->is_spill_io_running(); }
+    bool is_pending_finish() const override { return _node->is_spill_io_running(); }
 };
 
 } // namespace pipeline
@@ -44,6 +44,8 @@ public:
     // should skip `alloc_resource()` function call, only sink operator
     // call the function
     Status open(RuntimeState*) override { return Status::OK(); }
+    bool is_blocked_by_spill_io() const override { return _node->is_waiting_for_spill_io(); }
+    bool is_pending_finish() const override { return _node->is_spill_io_running(); }
 };
 
 } // namespace pipeline
@@ -115,6 +115,7 @@ Status DataQueue::get_block_from_queue(std::unique_ptr<vectorized::Block>* outpu
             }
             _cur_bytes_in_queue[_flag_queue_idx] -= (*output_block)->allocated_bytes();
             _cur_blocks_nums_in_queue[_flag_queue_idx] -= 1;
+            _write_dependency.notify();
         } else {
             if (_is_finished[_flag_queue_idx]) {
                 _data_exhausted = true;
@@ -137,16 +138,19 @@ void DataQueue::push_block(std::unique_ptr<vectorized::Block> block, int child_i
         _max_bytes_in_queue = std::max(_max_bytes_in_queue, _cur_bytes_in_queue[0].load());
         _max_size_of_queue = std::max(_max_size_of_queue, (int64)_queue_blocks[0].size());
     }
+    _read_dependency.notify();
 }
 
 void DataQueue::set_finish(int child_idx) {
     _is_finished[child_idx] = true;
+    _read_dependency.notify();
 }
 
 void DataQueue::set_canceled(int child_idx) {
     DCHECK(!_is_finished[child_idx]);
     _is_canceled[child_idx] = true;
     _is_finished[child_idx] = true;
+    _read_dependency.notify();
 }
 
 bool DataQueue::is_finish(int child_idx) {
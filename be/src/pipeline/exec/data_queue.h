@@ -25,6 +25,7 @@
 #include <vector>
 
 #include "common/status.h"
+#include "pipeline/wakeup_dependency.h"
 #include "vec/core/block.h"
 
 namespace doris {
@@ -59,6 +60,11 @@ public:
 
     bool data_exhausted() const { return _data_exhausted; }
 
+    // notifies when a block is pushed or a child finishes
+    WakeupDependency* read_dependency() { return &_read_dependency; }
+    // notifies when a block is taken from the queue
+    WakeupDependency* write_dependency() { return &_write_dependency; }
+
 private:
     std::vector<std::unique_ptr<std::mutex>> _queue_blocks_lock;
     std::vector<std::deque<std::unique_ptr<vectorized::Block>>> _queue_blocks;
@@ -79,6 +85,9 @@ private:
     // only used by streaming agg source operator
     bool _data_exhausted = false;
 
+    WakeupDependency _read_dependency;
+    WakeupDependency _write_dependency;
+
     //this only use to record the queue[0] for profile
     int64_t _max_bytes_in_queue = 0;
     int64_t _max_size_of_queue = 0;
@@ -43,6 +43,10 @@ bool DistinctStreamingAggSinkOperator::can_write() {
     return _data_queue->has_enough_space_to_push();
 }
 
+WakeupDependency* DistinctStreamingAggSinkOperator::write_dependency() {
+    return _data_queue->write_dependency();
+}
+
 Status DistinctStreamingAggSinkOperator::sink(RuntimeState* state, vectorized::Block* in_block,
                                               SourceState source_state) {
     if (in_block && in_block->rows() > 0) {
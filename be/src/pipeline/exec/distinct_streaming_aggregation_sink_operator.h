@@ -60,6 +60,8 @@ public:
 
     bool can_write() override;
 
+    WakeupDependency* write_dependency() override;
+
     Status close(RuntimeState* state) override;
 
     bool reached_limited_rows() {
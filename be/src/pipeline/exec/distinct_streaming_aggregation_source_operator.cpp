@@ -40,6 +40,10 @@ bool DistinctStreamingAggSourceOperator::can_read() {
     return _data_queue->has_data_or_finished();
 }
 
+WakeupDependency* DistinctStreamingAggSourceOperator::read_dependency() {
+    return _data_queue->read_dependency();
+}
+
 Status DistinctStreamingAggSourceOperator::pull_data(RuntimeState* state, vectorized::Block* block,
                                                      bool* eos) {
     std::unique_ptr<vectorized::Block> agg_block;
@@ -54,6 +54,8 @@ class DistinctStreamingAggSourceOperator final
 public:
     DistinctStreamingAggSourceOperator(OperatorBuilderBase*, ExecNode*, std::shared_ptr<DataQueue>);
     bool can_read() override;
+
+    WakeupDependency* read_dependency() override;
     Status get_block(RuntimeState*, vectorized::Block*, SourceState& source_state) override;
     Status open(RuntimeState*) override { return Status::OK(); }
     Status pull_data(RuntimeState* state, vectorized::Block* output_block, bool* eos);
@@ -289,6 +289,8 @@ Status ExchangeSinkBuffer::_send_rpc(InstanceLoId id) {
     } else {
         _instance_to_sending_by_pipeline[id] = true;
     }
+    // a request is sent or the queue is drained, the sink may be able to write again
+    _dependency.notify();
 
     return Status::OK();
 }
@@ -304,8 +306,11 @@ void ExchangeSinkBuffer::_construct_request(InstanceLoId id, PUniqueId finst_id)
 }
 
 void ExchangeSinkBuffer::_ended(InstanceLoId id) {
-    std::unique_lock<std::mutex> lock(*_instance_to_package_queue_mutex[id]);
-    _instance_to_sending_by_pipeline[id] = true;
+    {
+        std::unique_lock<std::mutex> lock(*_instance_to_package_queue_mutex[id]);
+        _instance_to_sending_by_pipeline[id] = true;
+    }
+    _dependency.notify();
 }
 
 void ExchangeSinkBuffer::_failed(InstanceLoId id, const std::string& err) {
@@ -318,6 +323,7 @@ void ExchangeSinkBuffer::_set_receiver_eof(InstanceLoId id) {
     std::unique_lock<std::mutex> lock(*_instance_to_package_queue_mutex[id]);
     _instance_to_receiver_eof[id] = true;
     _instance_to_sending_by_pipeline[id] = true;
+    _dependency.notify();
 }
 
 bool ExchangeSinkBuffer::_is_receiver_eof(InstanceLoId id) {
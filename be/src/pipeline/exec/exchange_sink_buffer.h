@@ -33,6 +33,7 @@
 
 #include "common/global_types.h"
 #include "common/status.h"
+#include "pipeline/wakeup_dependency.h"
 #include "runtime/runtime_state.h"
 #include "service/backend_options.h"
 
@@ -168,6 +169,8 @@ public:
     Status add_block(TransmitInfo&& request);
     Status add_block(BroadcastTransmitInfo&& request);
     bool can_write() const;
+    // Notified when a rpc finishes, the broadcast blocks it holds are released as well.
+    WakeupDependency* dependency() { return &_dependency; }
     bool is_pending_finish();
     void close();
     void set_rpc_time(InstanceLoId id, int64_t start_rpc_time, int64_t receive_rpc_time);
@@ -201,6 +204,7 @@ private:
     int _be_number;
     std::atomic<int64_t> _rpc_count = 0;
     PipelineFragmentContext* _context;
+    WakeupDependency _dependency;
 
     Status _send_rpc(InstanceLoId);
     // must hold the _instance_to_package_queue_mutex[id] mutex to opera
@@ -76,6 +76,15 @@ bool ExchangeSinkOperator::can_write() {
     return _sink_buffer->can_write() && _sink->channel_all_can_write();
 }
 
+WakeupDependency* ExchangeSinkOperator::write_dependency() {
+    if (_sink_buffer->can_write()) {
+        if (auto* dependency = _sink->channel_write_dependency()) {
+            return dependency;
+        }
+    }
+    return _sink_buffer->dependency();
+}
+
 bool ExchangeSinkOperator::is_pending_finish() const {
     return _sink_buffer->is_pending_finish();
 }
@@ -31,6 +31,10 @@ bool ExchangeSourceOperator::can_read() {
     return _node->_stream_recvr->ready_to_read();
 }
 
+WakeupDependency* ExchangeSourceOperator::read_dependency() {
+    return _node->_stream_recvr->read_dependency();
+}
+
 bool ExchangeSourceOperator::is_pending_finish() const {
     return false;
 }
@@ -41,6 +41,7 @@ class ExchangeSourceOperator final : public SourceOperator<ExchangeSourceOperato
 public:
     ExchangeSourceOperator(OperatorBuilderBase*, ExecNode*);
     bool can_read() override;
+    WakeupDependency* read_dependency() override;
     bool is_pending_finish() const override;
 };
 
@@ -39,7 +39,10 @@ class HashJoinBuildSink final : public StreamingOperator<HashJoinBuildSinkBuilde
 public:
     HashJoinBuildSink(OperatorBuilderBase* operator_builder, ExecNode* node);
     bool can_write() override { return _node->can_sink_write(); }
-    bool is_pending_finish() const override { return !_node->ready_for_finish(); }
+    bool is_blocked_by_spill_io() const override { return _node->is_spill_io_running(); }
+    bool is_pending_finish() const override {
+        return !_node->ready_for_finish() || _node->is_spill_io_running();
+    }
 };
 
 } // namespace pipeline
@@ -79,6 +79,10 @@ bool MultiCastDataStreamerSourceOperator::runtime_filters_are_ready_or_timeout()
     return vectorized::RuntimeFilterConsumer::runtime_filters_are_ready_or_timeout();
 }
 
+WakeupDependency* MultiCastDataStreamerSourceOperator::runtime_filter_dependency() {
+    return vectorized::RuntimeFilterConsumer::runtime_filter_dependency();
+}
+
 bool MultiCastDataStreamerSourceOperator::can_read() {
     return _multi_cast_data_streamer->can_read(_consumer_id);
 }
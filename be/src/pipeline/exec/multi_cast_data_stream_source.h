@@ -70,6 +70,8 @@ public:
 
     bool runtime_filters_are_ready_or_timeout() override;
 
+    WakeupDependency* runtime_filter_dependency() override;
+
     Status sink(RuntimeState* state, vectorized::Block* block, SourceState source_state) override {
         return Status::OK();
     }
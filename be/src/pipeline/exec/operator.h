@@ -86,6 +86,7 @@ enum class SinkState : uint8_t {
 
 class OperatorBuilderBase;
 class OperatorBase;
+class WakeupDependency;
 
 using OperatorPtr = std::shared_ptr<OperatorBase>;
 using Operators = std::vector<OperatorPtr>;
@@ -199,6 +200,17 @@ public:
 
     virtual bool can_write() { return false; } // for sink
 
+    // The dependencies that notify when can_read(), runtime_filters_are_ready_or_timeout() and
+    // can_write() may become true, so a blocked task is parked on them instead of being polled.
+    // They are asked after the check fails, nullptr means the state can only be polled.
+    virtual WakeupDependency* read_dependency() { return nullptr; }
+    virtual WakeupDependency* runtime_filter_dependency() { return nullptr; }
+    virtual WakeupDependency* write_dependency() { return nullptr; }
+
+    // The operator could not go on until its spill io running in the spill io thread pool
+    // finishes, the pipeline task is blocked as BLOCKED_FOR_SPILL_IO meanwhile.
+    virtual bool is_blocked_by_spill_io() const { return false; }
+
     /**
      * The main method to execute a pipeline task.
      * Now it is a pull-based pipeline and operators pull data from its child by this method.
@@ -42,4 +42,8 @@ ResultSinkOperator::ResultSinkOperator(OperatorBuilderBase* operator_builder, Da
 bool ResultSinkOperator::can_write() {
     return _sink->_sender->can_sink();
 }
+
+WakeupDependency* ResultSinkOperator::write_dependency() {
+    return _sink->_sender->dependency();
+}
 } // namespace doris::pipeline
\ No newline at end of file
@@ -39,6 +39,8 @@ public:
     ResultSinkOperator(OperatorBuilderBase* operator_builder, DataSink* sink);
 
     bool can_write() override;
+
+    WakeupDependency* write_dependency() override;
 };
 
 } // namespace pipeline
@@ -52,6 +52,14 @@ bool ScanOperator::can_read() {
     }
 }
 
+WakeupDependency* ScanOperator::read_dependency() {
+    // the scan node is opened by the task, the scanners are not created before that
+    if (!_node->_opened || _node->_scanner_ctx == nullptr) {
+        return nullptr;
+    }
+    return _node->_scanner_ctx->dependency();
+}
+
 bool ScanOperator::is_pending_finish() const {
     return _node->_scanner_ctx && !_node->_scanner_ctx->no_schedule();
 }
@@ -64,6 +72,10 @@ bool ScanOperator::runtime_filters_are_ready_or_timeout() {
     return _node->runtime_filters_are_ready_or_timeout();
 }
 
+WakeupDependency* ScanOperator::runtime_filter_dependency() {
+    return _node->runtime_filter_dependency();
+}
+
 std::string ScanOperator::debug_string() const {
     fmt::memory_buffer debug_string_buffer;
     fmt::format_to(debug_string_buffer, "{}, scanner_ctx is null: {} ",
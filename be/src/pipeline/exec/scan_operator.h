@@ -44,10 +44,14 @@ public:
 
     bool can_read() override; // for source
 
+    WakeupDependency* read_dependency() override;
+
     bool is_pending_finish() const override;
 
     bool runtime_filters_are_ready_or_timeout() override;
 
+    WakeupDependency* runtime_filter_dependency() override;
+
     std::string debug_string() const override;
 
     Status try_close(RuntimeState* state) override;
@@ -41,6 +41,8 @@ public:
     SortSinkOperator(OperatorBuilderBase* operator_builder, ExecNode* sort_node);
 
     bool can_write() override { return true; }
+    bool is_blocked_by_spill_io() const override { return _node->is_spill_io_running(); }
+    bool is_pending_finish() const override { return _node->is_spill_io_running(); }
 };
 
 } // namespace pipeline
@@ -42,6 +42,8 @@ class SortSourceOperator final : public SourceOperator<SortSourceOperatorBuilder
 public:
     SortSourceOperator(OperatorBuilderBase* operator_builder, ExecNode* sort_node);
     Status open(RuntimeState*) override { return Status::OK(); }
+    bool is_blocked_by_spill_io() const override { return _node->is_spill_io_running(); }
+    bool is_pending_finish() const override { return _node->is_spill_io_running(); }
 };
 
 } // namespace pipeline
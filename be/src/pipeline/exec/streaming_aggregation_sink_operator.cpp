@@ -52,6 +52,10 @@ bool StreamingAggSinkOperator::can_write() {
     return _data_queue->has_enough_space_to_push();
 }
 
+WakeupDependency* StreamingAggSinkOperator::write_dependency() {
+    return _data_queue->write_dependency();
+}
+
 Status StreamingAggSinkOperator::sink(RuntimeState* state, vectorized::Block* in_block,
                                       SourceState source_state) {
     Status ret = Status::OK();
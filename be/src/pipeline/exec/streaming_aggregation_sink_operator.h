@@ -58,6 +58,8 @@ public:
 
     bool can_write() override;
 
+    WakeupDependency* write_dependency() override;
+
     Status close(RuntimeState* state) override;
 
 private:
@@ -56,6 +56,10 @@ bool UnionSourceOperator::can_read() {
     return _has_data() || _data_queue->is_all_finish();
 }
 
+WakeupDependency* UnionSourceOperator::read_dependency() {
+    return _data_queue->read_dependency();
+}
+
 Status UnionSourceOperator::pull_data(RuntimeState* state, vectorized::Block* block, bool* eos) {
     // here we precess const expr firstly
     if (_need_read_for_const_expr) {
@@ -56,6 +56,8 @@ public:
                      SourceState& source_state) override;
     bool can_read() override;
 
+    WakeupDependency* read_dependency() override;
+
     Status pull_data(RuntimeState* state, vectorized::Block* output_block, bool* eos);
 
 private:
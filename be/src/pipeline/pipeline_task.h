@@ -53,7 +53,8 @@ namespace doris::pipeline {
  *              |                                    |          ^        |                      transfer 7|
  *              |------------------------------------|          |--------|---------------------------------------> FINISHED
  *                transfer 1                                   transfer 9          transfer 8
- * BLOCKED include BLOCKED_FOR_DEPENDENCY, BLOCKED_FOR_SOURCE and BLOCKED_FOR_SINK.
+ * BLOCKED include BLOCKED_FOR_DEPENDENCY, BLOCKED_FOR_SOURCE, BLOCKED_FOR_SINK, BLOCKED_FOR_RF and
+ * BLOCKED_FOR_SPILL_IO.
  *
  * transfer 0 (NOT_READY -> BLOCKED): this pipeline task has some incomplete dependencies
  * transfer 1 (NOT_READY -> RUNNABLE): this pipeline task has no incomplete dependencies
@@ -77,6 +78,7 @@ enum class PipelineTaskState : uint8_t {
     FINISHED = 6,
     CANCELED = 7,
     BLOCKED_FOR_RF = 8,
+    BLOCKED_FOR_SPILL_IO = 9, // wait for the spill io running in the spill io thread pool
 };
 
 inline const char* get_state_name(PipelineTaskState idx) {
@@ -99,12 +101,15 @@ inline const char* get_state_name(PipelineTaskState idx) {
         return "CANCELED";
     case PipelineTaskState::BLOCKED_FOR_RF:
         return "BLOCKED_FOR_RF";
+    case PipelineTaskState::BLOCKED_FOR_SPILL_IO:
+        return "BLOCKED_FOR_SPILL_IO";
     }
     __builtin_unreachable();
 }
 
 class TaskQueue;
 class PriorityTaskQueue;
+class WakeupDependency;
 
 // The class do the pipeline task. Minest schdule union by task scheduler
 class PipelineTask {
@@ -135,6 +140,13 @@ public:
     void set_state(PipelineTaskState state);
 
     bool is_pending_finish() {
+        // the operators in the middle of the pipeline, e.g. the probe of a spilled hash join,
+        // may be waiting for their spill io
+        for (size_t i = 1; i < _operators.size(); ++i) {
+            if (_operators[i]->is_pending_finish()) {
+                return true;
+            }
+        }
         bool source_ret = _source->is_pending_finish();
         if (source_ret) {
             return true;
@@ -159,6 +171,45 @@ public:
 
     bool sink_can_write() { return _sink->can_write(); }
 
+    // Whether the task is still blocked in its BLOCKED_FOR_SOURCE, BLOCKED_FOR_RF or
+    // BLOCKED_FOR_SINK state.
+    bool is_blocked() {
+        switch (_cur_state) {
+        case PipelineTaskState::BLOCKED_FOR_SOURCE:
+            return !source_can_read();
+        case PipelineTaskState::BLOCKED_FOR_RF:
+            return !runtime_filters_are_ready_or_timeout();
+        case PipelineTaskState::BLOCKED_FOR_SINK:
+            return !sink_can_write();
+        default:
+            return false;
+        }
+    }
+
+    // The dependency that notifies when the state the task is blocked for changes, nullptr if the
+    // state can only be polled.
+    WakeupDependency* blocking_dependency() {
+        switch (_cur_state) {
+        case PipelineTaskState::BLOCKED_FOR_SOURCE:
+            return _source->read_dependency();
+        case PipelineTaskState::BLOCKED_FOR_RF:
+            return _source->runtime_filter_dependency();
+        case PipelineTaskState::BLOCKED_FOR_SINK:
+            return _sink->write_dependency();
+        default:
+            return nullptr;
+        }
+    }
+
+    bool is_blocked_by_spill_io() {
+        for (auto& op : _operators) {
+            if (op->is_blocked_by_spill_io()) {
+                return true;
+            }
+        }
+        return _sink->is_blocked_by_spill_io();
+    }
+
     Status finalize();
 
     PipelineFragmentContext* fragment_context() { return _fragment_context; }
@@ -299,6 +350,7 @@ private:
     RuntimeProfile::Counter* _block_counts;
     RuntimeProfile::Counter* _block_by_source_counts;
     RuntimeProfile::Counter* _block_by_sink_counts;
+    RuntimeProfile::Counter* _block_by_spill_io_counts;
     RuntimeProfile::Counter* _schedule_counts;
     MonotonicStopWatch _wait_source_watcher;
     RuntimeProfile::Counter* _wait_source_timer;
@@ -306,6 +358,8 @@ private:
     RuntimeProfile::Counter* _wait_bf_timer;
     MonotonicStopWatch _wait_sink_watcher;
     RuntimeProfile::Counter* _wait_sink_timer;
+    MonotonicStopWatch _wait_spill_io_watcher;
+    RuntimeProfile::Counter* _wait_spill_io_timer;
     MonotonicStopWatch _wait_worker_watcher;
     RuntimeProfile::Counter* _wait_worker_timer;
     // TODO we should calculate the time between when really runnable and runnable
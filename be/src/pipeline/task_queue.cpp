@@ -19,10 +19,14 @@
 
 // IWYU pragma: no_include <bits/chrono.h>
 #include <chrono> // IWYU pragma: keep
+#include <map>
 #include <string>
 
+#include "common/config.h"
 #include "common/logging.h"
+#include "pipeline/pipeline_fragment_context.h"
 #include "pipeline/pipeline_task.h"
+#include "util/cpu_info.h"
 
 namespace doris {
 namespace pipeline {
@@ -137,8 +141,35 @@ int PriorityTaskQueue::task_size() {
 
 MultiCoreTaskQueue::~MultiCoreTaskQueue() = default;
 
+int TaskQueue::numa_node_of_core(size_t core_id) const {
+    std::vector<int> numa_nodes;
+    for (int node = 0; node < CpuInfo::get_max_num_numa_nodes(); ++node) {
+        if (!CpuInfo::get_cores_of_numa_node(node).empty()) {
+            numa_nodes.push_back(node);
+        }
+    }
+    if (numa_nodes.empty()) {
+        return 0;
+    }
+    return numa_nodes[core_id * numa_nodes.size() / _core_size];
+}
+
 MultiCoreTaskQueue::MultiCoreTaskQueue(size_t core_size) : TaskQueue(core_size), _closed(false) {
     _prio_task_queue_list.reset(new PriorityTaskQueue[core_size]);
+    _core_numa_node.resize(core_size);
+    _core_idx_in_node.resize(core_size);
+    std::map<int, size_t> node_groups;
+    for (size_t core_id = 0; core_id < core_size; ++core_id) {
+        int numa_node =
+                config::enable_pipeline_numa_aware_scheduling ? numa_node_of_core(core_id) : 0;
+        auto [it, inserted] = node_groups.emplace(numa_node, _numa_node_cores.size());
+        if (inserted) {
+            _numa_node_cores.emplace_back();
+        }
+        _core_numa_node[core_id] = it->second;
+        _core_idx_in_node[core_id] = _numa_node_cores[it->second].size();
+        _numa_node_cores[it->second].push_back(core_id);
+    }
 }
 
 void MultiCoreTaskQueue::close() {
@@ -174,26 +205,42 @@ PipelineTask* MultiCoreTaskQueue::take(size_t core_id) {
 
 PipelineTask* MultiCoreTaskQueue::_steal_take(size_t core_id) {
     DCHECK(core_id < _core_size);
-    size_t next_id = core_id;
-    for (size_t i = 1; i < _core_size; ++i) {
-        ++next_id;
-        if (next_id == _core_size) {
-            next_id = 0;
-        }
-        DCHECK(next_id < _core_size);
-        auto task = _prio_task_queue_list[next_id].try_take(true);
-        if (task) {
-            task->set_core_id(next_id);
-            return task;
+    // steal from the workers of the same NUMA node first, then from the other nodes
+    size_t numa_node = _core_numa_node[core_id];
+    for (size_t n = 0; n < _numa_node_cores.size(); ++n) {
+        const auto& cores = _numa_node_cores[(numa_node + n) % _numa_node_cores.size()];
+        size_t start = n == 0 ? _core_idx_in_node[core_id] + 1 : 0;
+        for (size_t i = 0; i < cores.size(); ++i) {
+            size_t next_id = cores[(start + i) % cores.size()];
+            if (next_id == core_id) {
+                continue;
+            }
+            DCHECK(next_id < _core_size);
+            auto task = _prio_task_queue_list[next_id].try_take(true);
+            if (task) {
+                task->set_core_id(next_id);
+                return task;
+            }
         }
     }
     return nullptr;
 }
 
+size_t MultiCoreTaskQueue::_numa_node_of_instance(const TUniqueId& instance_id) const {
+    if (_numa_node_cores.size() == 1) {
+        return 0;
+    }
+    // Keep the tasks of a fragment instance on one NUMA node, so the blocks and hash tables
+    // shared by them are allocated by the threads of that node and stay local to it.
+    return static_cast<uint64_t>(instance_id.hi ^ instance_id.lo) % _numa_node_cores.size();
+}
+
 Status MultiCoreTaskQueue::push_back(PipelineTask* task) {
     int core_id = task->get_previous_core_id();
     if (core_id < 0) {
-        core_id = _next_core.fetch_add(1) % _core_size;
+        auto instance_id = task->fragment_context()->get_fragment_instance_id();
+        const auto& cores = _numa_node_cores[_numa_node_of_instance(instance_id)];
+        core_id = cores[_next_core.fetch_add(1) % cores.size()];
     }
     return push_back(task, core_id);
 }
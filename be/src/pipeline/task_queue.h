@@ -16,6 +16,7 @@
 // under the License.
 #pragma once
 
+#include <gen_cpp/Types_types.h>
 #include <glog/logging.h>
 #include <stddef.h>
 #include <stdint.h>
@@ -27,6 +28,7 @@
 #include <ostream>
 #include <queue>
 #include <set>
+#include <vector>
 
 #include "common/status.h"
 #include "pipeline_task.h"
@@ -57,6 +59,10 @@ public:
 
     int cores() const { return _core_size; }
 
+    // The NUMA node that the worker `core_id` runs on when workers are bound to NUMA nodes,
+    // the workers are spread evenly over the nodes which have cpu cores.
+    int numa_node_of_core(size_t core_id) const;
+
 protected:
     size_t _core_size;
     static constexpr auto WAIT_CORE_TASK_TIMEOUT_MS = 100;
@@ -162,7 +168,15 @@ public:
 private:
     PipelineTask* _steal_take(size_t core_id);
 
+    size_t _numa_node_of_instance(const TUniqueId& instance_id) const;
+
     std::unique_ptr<PriorityTaskQueue[]> _prio_task_queue_list;
+    // The workers grouped by NUMA node, all workers are in one group if NUMA aware scheduling
+    // is disabled. Tasks are stolen from the workers of the same group first.
+    std::vector<std::vector<size_t>> _numa_node_cores;
+    // the group of each worker, and the position of the worker in the group
+    std::vector<size_t> _core_numa_node;
+    std::vector<size_t> _core_idx_in_node;
     std::atomic<size_t> _next_core = 0;
     std::atomic<bool> _closed;
 };
@@ -21,6 +21,7 @@
 #include <gen_cpp/Types_types.h>
 #include <gen_cpp/types.pb.h>
 #include <glog/logging.h>
+#include <pthread.h>
 #include <sched.h>
 
 #include <algorithm>
@@ -30,15 +31,20 @@
 #include <ostream>
 #include <string>
 #include <thread>
+#include <unordered_set>
 
+#include "common/config.h"
 #include "common/signal_handler.h"
 #include "pipeline/pipeline_task.h"
 #include "pipeline/task_queue.h"
+#include "pipeline/wakeup_dependency.h"
 #include "pipeline_fragment_context.h"
 #include "runtime/query_context.h"
-#include "util/sse_util.hpp"
+#include "util/cpu_info.h"
+#include "util/stopwatch.hpp"
 #include "util/thread.h"
 #include "util/threadpool.h"
+#include "util/time.h"
 #include "util/uid_util.h"
 #include "vec/runtime/vdatetime_value.h"
 
@@ -80,28 +86,57 @@ Status BlockedTaskScheduler::add_blocked_task(PipelineTask* task) {
     return Status::OK();
 }
 
+void BlockedTaskScheduler::wake_up(PipelineTask* task) {
+    std::unique_lock<std::mutex> lock(_task_mutex);
+    _woken_tasks.push_back(task);
+    _task_cond.notify_one();
+}
+
 void BlockedTaskScheduler::_schedule() {
     _started.store(true);
     std::list<PipelineTask*> local_blocked_tasks;
-    int empty_times = 0;
+    std::vector<PipelineTask*> woken_tasks;
     std::vector<PipelineTask*> ready_tasks;
+    MonotonicStopWatch parked_check_watch;
+    parked_check_watch.start();
 
     while (!_shutdown) {
+        const int64_t parked_check_interval_ns =
+                config::pipeline_parked_task_check_interval_ms * NANOS_PER_MILLIS;
         {
             std::unique_lock<std::mutex> lock(this->_task_mutex);
-            local_blocked_tasks.splice(local_blocked_tasks.end(), _blocked_tasks);
-            if (local_blocked_tasks.empty()) {
-                while (!_shutdown.load() && _blocked_tasks.empty()) {
-                    _task_cond.wait_for(lock, std::chrono::milliseconds(10));
+            if (ready_tasks.empty() && _blocked_tasks.empty() && _woken_tasks.empty()) {
+                // Nothing changed in the last pass. The tasks that can only be polled are checked
+                // again after the blocked task interval, the parked tasks only when they are woken
+                // up, or for timeouts after the parked task interval.
+                int64_t wait_ns = std::max<int64_t>(
+                        parked_check_interval_ns - parked_check_watch.elapsed_time(), 0);
+                if (!local_blocked_tasks.empty()) {
+                    wait_ns = std::min<int64_t>(
+                            wait_ns,
+                            config::pipeline_blocked_task_check_interval_ms * NANOS_PER_MILLIS);
                 }
-
+                _task_cond.wait_for(lock, std::chrono::nanoseconds(wait_ns), [this]() {
+                    return _shutdown.load() || !_blocked_tasks.empty() || !_woken_tasks.empty();
+                });
                 if (_shutdown.load()) {
                     break;
                 }
-
-                DCHECK(!_blocked_tasks.empty());
-                local_blocked_tasks.splice(local_blocked_tasks.end(), _blocked_tasks);
             }
+            local_blocked_tasks.splice(local_blocked_tasks.end(), _blocked_tasks);
+            woken_tasks.swap(_woken_tasks);
+        }
+        ready_tasks.clear();
+
+        // the dependencies have removed the woken tasks already
+        for (auto* task : woken_tasks) {
+            _parked_tasks.erase(task);
+            local_blocked_tasks.push_back(task);
+        }
+        woken_tasks.clear();
+        if (parked_check_watch.elapsed_time() >= parked_check_interval_ns) {
+            _unpark_all(local_blocked_tasks);
+            parked_check_watch.reset();
         }
 
         auto iter = local_blocked_tasks.begin();
@@ -148,19 +183,25 @@ void BlockedTaskScheduler::_schedule() {
                 if (task->source_can_read()) {
                     _make_task_run(local_blocked_tasks, iter, ready_tasks);
                 } else {
-                    iter++;
+                    _park_or_poll(local_blocked_tasks, iter, ready_tasks);
                 }
             } else if (state == PipelineTaskState::BLOCKED_FOR_RF) {
                 if (task->runtime_filters_are_ready_or_timeout()) {
                     _make_task_run(local_blocked_tasks, iter, ready_tasks);
                 } else {
-                    iter++;
+                    _park_or_poll(local_blocked_tasks, iter, ready_tasks);
                 }
             } else if (state == PipelineTaskState::BLOCKED_FOR_SINK) {
                 if (task->sink_can_write()) {
                     _make_task_run(local_blocked_tasks, iter, ready_tasks);
                 } else {
+                    _park_or_poll(local_blocked_tasks, iter, ready_tasks);
+                }
+            } else if (state == PipelineTaskState::BLOCKED_FOR_SPILL_IO) {
+                if (task->is_blocked_by_spill_io()) {
                     iter++;
+                } else {
+                    _make_task_run(local_blocked_tasks, iter, ready_tasks);
                 }
             } else {
                 // TODO: DCHECK the state
@@ -168,27 +209,9 @@ void BlockedTaskScheduler::_schedule() {
             }
         }
 
-        if (ready_tasks.empty()) {
-            empty_times += 1;
-        } else {
-            empty_times = 0;
-            for (auto& task : ready_tasks) {
-                task->stop_schedule_watcher();
-                _task_queue->push_back(task);
-            }
-            ready_tasks.clear();
-        }
-
-        if (empty_times != 0 && (empty_times & (EMPTY_TIMES_TO_YIELD - 1)) == 0) {
-#ifdef __x86_64__
-            _mm_pause();
-#else
-            sched_yield();
-#endif
-        }
-        if (empty_times == EMPTY_TIMES_TO_YIELD * 10) {
-            empty_times = 0;
-            sched_yield();
+        for (auto& task : ready_tasks) {
+            task->stop_schedule_watcher();
+            _task_queue->push_back(task);
         }
     }
     LOG(INFO) << "BlockedTaskScheduler schedule thread stop";
@@ -205,6 +228,47 @@ void BlockedTaskScheduler::_make_task_run(std::list<PipelineTask*>& local_tasks,
     ready_tasks.emplace_back(task);
 }
 
+void BlockedTaskScheduler::_park_or_poll(std::list<PipelineTask*>& local_tasks,
+                                         std::list<PipelineTask*>::iterator& task_itr,
+                                         std::vector<PipelineTask*>& ready_tasks) {
+    if (!config::enable_pipeline_task_parking) {
+        task_itr++;
+        return;
+    }
+    auto* task = *task_itr;
+    auto* dependency = task->blocking_dependency();
+    if (dependency == nullptr) {
+        task_itr++;
+        return;
+    }
+    uint64_t wakeup_seq = dependency->wakeup_seq();
+    // the state may have changed before the sequence is read
+    if (!task->is_blocked()) {
+        _make_task_run(local_tasks, task_itr, ready_tasks);
+    } else if (dependency->park(task, this, wakeup_seq)) {
+        _parked_tasks.emplace(task, dependency);
+        local_tasks.erase(task_itr++);
+    } else {
+        task_itr++;
+    }
+}
+
+void BlockedTaskScheduler::_unpark_all(std::list<PipelineTask*>& local_tasks) {
+    std::unordered_set<WakeupDependency*> dependencies;
+    for (auto& [task, dependency] : _parked_tasks) {
+        dependencies.insert(dependency);
+    }
+    std::vector<PipelineTask*> tasks;
+    for (auto* dependency : dependencies) {
+        dependency->unpark_all(this, &tasks);
+    }
+    // the tasks being woken up are left to the wakeups
+    for (auto* task : tasks) {
+        _parked_tasks.erase(task);
+        local_tasks.push_back(task);
+    }
+}
+
 TaskScheduler::~TaskScheduler() {
     shutdown();
 }
@@ -231,7 +295,30 @@ Status TaskScheduler::schedule_task(PipelineTask* task) {
     // TODO control num of task
 }
 
+// Bind the current thread to the cpu cores of `numa_node`, so the memory it touches first is
+// allocated on that node.
+static void bind_to_numa_node(int numa_node) {
+#ifndef __APPLE__
+    if (numa_node >= CpuInfo::get_max_num_numa_nodes()) {
+        return;
+    }
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    for (int cpu : CpuInfo::get_cores_of_numa_node(numa_node)) {
+        CPU_SET(cpu, &cpu_set);
+    }
+    int ret = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+    if (ret != 0) {
+        LOG(WARNING) << "failed to bind pipeline worker to numa node " << numa_node
+                     << ", error: " << ret;
+    }
+#endif
+}
+
 void TaskScheduler::_do_work(size_t index) {
+    if (config::enable_pipeline_numa_aware_scheduling) {
+        bind_to_numa_node(_task_queue->numa_node_of_core(index));
+    }
     const auto& marker = _markers[index];
     while (*marker) {
         auto* task = _task_queue->take(index);
@@ -313,6 +400,7 @@ void TaskScheduler::_do_work(size_t index) {
         case PipelineTaskState::BLOCKED_FOR_SOURCE:
         case PipelineTaskState::BLOCKED_FOR_SINK:
         case PipelineTaskState::BLOCKED_FOR_RF:
+        case PipelineTaskState::BLOCKED_FOR_SPILL_IO:
         case PipelineTaskState::BLOCKED_FOR_DEPENDENCY:
             _blocked_task_scheduler->add_blocked_task(task);
             break;
@@ -24,6 +24,7 @@
 #include <list>
 #include <memory>
 #include <mutex>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -39,6 +40,7 @@ class ThreadPool;
 
 namespace pipeline {
 class TaskQueue;
+class WakeupDependency;
 } // namespace pipeline
 } // namespace doris
 
@@ -54,25 +56,35 @@ public:
     void shutdown();
     Status add_blocked_task(PipelineTask* task);
 
+    // Called by the dependency that `task` is parked on when the state it waits for changes.
+    void wake_up(PipelineTask* task);
+
 private:
     std::shared_ptr<TaskQueue> _task_queue;
 
     std::mutex _task_mutex;
     std::condition_variable _task_cond;
     std::list<PipelineTask*> _blocked_tasks;
+    std::vector<PipelineTask*> _woken_tasks;
+
+    // The tasks parked on their dependencies, only accessed by the schedule thread. They are
+    // checked again when they are woken up, and at pipeline_parked_task_check_interval_ms.
+    std::unordered_map<PipelineTask*, WakeupDependency*> _parked_tasks;
 
     scoped_refptr<Thread> _thread;
     std::atomic<bool> _started;
     std::atomic<bool> _shutdown;
 
-    static constexpr auto EMPTY_TIMES_TO_YIELD = 64;
-
 private:
     void _schedule();
     void _make_task_run(std::list<PipelineTask*>& local_tasks,
                         std::list<PipelineTask*>::iterator& task_itr,
                         std::vector<PipelineTask*>& ready_tasks,
                         PipelineTaskState state = PipelineTaskState::RUNNABLE);
+    void _park_or_poll(std::list<PipelineTask*>& local_tasks,
+                       std::list<PipelineTask*>::iterator& task_itr,
+                       std::vector<PipelineTask*>& ready_tasks);
+    void _unpark_all(std::list<PipelineTask*>& local_tasks);
 };
 
 class TaskScheduler {
@@ -0,0 +1,67 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "pipeline/wakeup_dependency.h"
+
+#include <algorithm>
+
+#include "pipeline/task_scheduler.h"
+
+namespace doris::pipeline {
+
+bool WakeupDependency::park(PipelineTask* task, BlockedTaskScheduler* scheduler,
+                            uint64_t wakeup_seq) {
+    std::lock_guard<std::mutex> l(_lock);
+    _num_parked_tasks.fetch_add(1);
+    if (_wakeup_seq.load() != wakeup_seq) {
+        _num_parked_tasks.fetch_sub(1);
+        return false;
+    }
+    _parked_tasks.emplace_back(task, scheduler);
+    return true;
+}
+
+void WakeupDependency::unpark_all(BlockedTaskScheduler* scheduler,
+                                  std::vector<PipelineTask*>* tasks) {
+    std::lock_guard<std::mutex> l(_lock);
+    auto it = std::remove_if(_parked_tasks.begin(), _parked_tasks.end(),
+                             [&](const auto& parked_task) {
+                                 if (parked_task.second != scheduler) {
+                                     return false;
+                                 }
+                                 tasks->push_back(parked_task.first);
+                                 return true;
+                             });
+    _num_parked_tasks.fetch_sub(_parked_tasks.end() - it);
+    _parked_tasks.erase(it, _parked_tasks.end());
+}
+
+void WakeupDependency::_wake_up_parked_tasks() {
+    std::vector<std::pair<PipelineTask*, BlockedTaskScheduler*>> parked_tasks;
+    {
+        std::lock_guard<std::mutex> l(_lock);
+        parked_tasks.swap(_parked_tasks);
+        _num_parked_tasks.fetch_sub(parked_tasks.size());
+    }
+    // A scheduler does not release a parked task before it is unparked or handed back, so the
+    // tasks are still alive here.
+    for (auto& [task, scheduler] : parked_tasks) {
+        scheduler->wake_up(task);
+    }
+}
+
+} // namespace doris::pipeline
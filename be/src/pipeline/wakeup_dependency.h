@@ -0,0 +1,67 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace doris::pipeline {
+
+class BlockedTaskScheduler;
+class PipelineTask;
+
+// A state that blocked pipeline tasks wait for, owned by the object that changes it, e.g. the
+// blocks of an exchange receiver, a scanner context or a data queue, the rpcs of an exchange sink
+// buffer, or a runtime filter. A blocked task is parked on the dependency that blocks it, and the
+// owner calls notify() when the state changes. notify() hands the tasks parked on it back to their
+// BlockedTaskSchedulers to be checked again, the other blocked tasks are not touched.
+class WakeupDependency {
+public:
+    // Read before checking the state, and passed to park().
+    uint64_t wakeup_seq() const { return _wakeup_seq.load(); }
+
+    // Park `task` of `scheduler` until notify(). Returns false without parking the task if
+    // notify() is called after `wakeup_seq` was read, the state should be checked again then.
+    bool park(PipelineTask* task, BlockedTaskScheduler* scheduler, uint64_t wakeup_seq);
+
+    // Remove the tasks of `scheduler` parked here and append them to `tasks`. The tasks that
+    // notify() is handing back to the scheduler are not among them.
+    void unpark_all(BlockedTaskScheduler* scheduler, std::vector<PipelineTask*>* tasks);
+
+    void notify() {
+        _wakeup_seq.fetch_add(1);
+        // park() counts the task before checking the sequence, so a notification is never lost
+        if (_num_parked_tasks.load() > 0) {
+            _wake_up_parked_tasks();
+        }
+    }
+
+private:
+    void _wake_up_parked_tasks();
+
+    std::atomic<uint64_t> _wakeup_seq = 0;
+    std::atomic<int> _num_parked_tasks = 0;
+    std::mutex _lock;
+    std::vector<std::pair<PipelineTask*, BlockedTaskScheduler*>> _parked_tasks;
+};
+
+} // namespace doris::pipeline
@@ -26,8 +26,10 @@
 #include <numeric>
 #include <random>
 
+#include "common/config.h"
 #include "io/fs/file_system.h"
 #include "io/fs/local_file_system.h"
+#include "util/threadpool.h"
 #include "util/time.h"
 #include "vec/core/block_spill_reader.h"
 #include "vec/core/block_spill_writer.h"
@@ -37,7 +39,18 @@ static const std::string BLOCK_SPILL_DIR = "spill";
 static const std::string BLOCK_SPILL_GC_DIR = "spill_gc";
 BlockSpillManager::BlockSpillManager(const std::vector<StorePath>& paths) : _store_paths(paths) {}
 
+BlockSpillManager::~BlockSpillManager() = default;
+
 Status BlockSpillManager::init() {
+    _io_thread_pools.resize(_store_paths.size());
+    for (size_t i = 0; i < _store_paths.size(); ++i) {
+        RETURN_IF_ERROR(ThreadPoolBuilder(fmt::format("SpillIOThreadPool-{}", i))
+                                .set_min_threads(1)
+                                .set_max_threads(config::spill_io_thread_num_per_data_dir)
+                                .set_max_queue_size(config::spill_io_thread_pool_queue_size)
+                                .build(&_io_thread_pools[i]));
+    }
+
     for (const auto& path : _store_paths) {
         auto dir = fmt::format("{}/{}", path.path, BLOCK_SPILL_GC_DIR);
         bool exists = true;
@@ -103,20 +116,31 @@ void BlockSpillManager::gc(int64_t max_file_count) {
     }
 }
 
-Status BlockSpillManager::get_writer(int32_t batch_size, vectorized::BlockSpillWriterUPtr& writer,
-                                     RuntimeProfile* profile) {
-    int64_t id;
+size_t BlockSpillManager::select_data_dir() const {
     std::vector<int> indices(_store_paths.size());
     std::iota(indices.begin(), indices.end(), 0);
     std::shuffle(indices.begin(), indices.end(), std::mt19937 {std::random_device {}()});
+    return indices[0];
+}
+
+Status BlockSpillManager::get_writer(int32_t batch_size, vectorized::BlockSpillWriterUPtr& writer,
+                                     RuntimeProfile* profile) {
+    return get_writer(select_data_dir(), batch_size, writer, profile);
+}
 
-    std::string path = _store_paths[indices[0]].path + "/" + BLOCK_SPILL_DIR;
+Status BlockSpillManager::get_writer(size_t data_dir_index, int32_t batch_size,
+                                     vectorized::BlockSpillWriterUPtr& writer,
+                                     RuntimeProfile* profile) {
+    int64_t id;
+    DCHECK_LT(data_dir_index, _store_paths.size());
+    std::string path = _store_paths[data_dir_index].path + "/" + BLOCK_SPILL_DIR;
     std::string unique_name = boost::uuids::to_string(boost::uuids::random_generator()());
     path += "/" + unique_name;
     {
         std::lock_guard<std::mutex> l(lock_);
         id = id_++;
         id_to_file_paths_[id] = path;
+        id_to_data_dir_indices_[id] = data_dir_index;
     }
 
     writer.reset(new vectorized::BlockSpillWriter(id, batch_size, path, profile));
@@ -138,5 +162,18 @@ Status BlockSpillManager::get_reader(int64_t stream_id, vectorized::BlockSpillRe
 void BlockSpillManager::remove(int64_t stream_id) {
     std::lock_guard<std::mutex> l(lock_);
     id_to_file_paths_.erase(stream_id);
+    id_to_data_dir_indices_.erase(stream_id);
+}
+
+size_t BlockSpillManager::get_data_dir_index(int64_t stream_id) {
+    std::lock_guard<std::mutex> l(lock_);
+    auto it = id_to_data_dir_indices_.find(stream_id);
+    CHECK(it != id_to_data_dir_indices_.end());
+    return it->second;
+}
+
+Status BlockSpillManager::submit_io(size_t data_dir_index, std::function<void()> io_task) {
+    DCHECK_LT(data_dir_index, _io_thread_pools.size());
+    return _io_thread_pools[data_dir_index]->submit_func(std::move(io_task));
 }
 } // namespace doris
@@ -19,6 +19,7 @@
 
 #include <stdint.h>
 
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -32,6 +33,7 @@
 
 namespace doris {
 class RuntimeProfile;
+class ThreadPool;
 
 namespace vectorized {
 
@@ -42,12 +44,19 @@ using BlockSpillReaderUPtr = std::unique_ptr<BlockSpillReader>;
 class BlockSpillManager {
 public:
     BlockSpillManager(const std::vector<StorePath>& paths);
+    ~BlockSpillManager();
 
     Status init();
 
+    // Select the data dir of a new spill stream randomly.
+    size_t select_data_dir() const;
+
     Status get_writer(int32_t batch_size, vectorized::BlockSpillWriterUPtr& writer,
                       RuntimeProfile* profile);
 
+    Status get_writer(size_t data_dir_index, int32_t batch_size,
+                      vectorized::BlockSpillWriterUPtr& writer, RuntimeProfile* profile);
+
     Status get_reader(int64_t stream_id, vectorized::BlockSpillReaderUPtr& reader,
                       RuntimeProfile* profile, bool delete_after_read = true);
 
@@ -55,10 +64,19 @@ public:
 
     void gc(int64_t max_file_count);
 
+    size_t get_data_dir_index(int64_t stream_id);
+
+    // Run the spill io of the streams in a data dir in the io thread pool of the data dir,
+    // so that the io does not block the pipeline workers and a slow disk does not delay
+    // the spill io of other disks.
+    Status submit_io(size_t data_dir_index, std::function<void()> io_task);
+
 private:
     std::vector<StorePath> _store_paths;
+    std::vector<std::unique_ptr<ThreadPool>> _io_thread_pools;
     std::mutex lock_;
     int64_t id_ = 0;
     std::unordered_map<int64_t, std::string> id_to_file_paths_;
+    std::unordered_map<int64_t, size_t> id_to_data_dir_indices_;
 };
 } // namespace doris
\ No newline at end of file
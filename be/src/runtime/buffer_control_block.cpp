@@ -166,6 +166,7 @@ void BufferControlBlock::get_batch(GetResultBatchCtx* ctx) {
         _batch_queue.pop_front();
         _buffer_rows -= result->result_batch.rows.size();
         _data_removal.notify_one();
+        _dependency.notify();
 
         ctx->on_data(result, _packet_num);
         _packet_num++;
@@ -206,6 +207,7 @@ Status BufferControlBlock::cancel() {
     _is_cancelled = true;
     _data_removal.notify_all();
     _data_arrival.notify_all();
+    _dependency.notify();
     for (auto& ctx : _waiting_rpc) {
         ctx->on_failure(Status::Cancelled("Cancelled"));
     }
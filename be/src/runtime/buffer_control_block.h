@@ -29,6 +29,7 @@
 #include <mutex>
 
 #include "common/status.h"
+#include "pipeline/wakeup_dependency.h"
 #include "runtime/query_statistics.h"
 
 namespace google {
@@ -80,6 +81,9 @@ public:
 
     const TUniqueId& fragment_id() const { return _fragment_id; }
 
+    // Notified when the results are fetched or the buffer is cancelled, so it may sink again.
+    pipeline::WakeupDependency* dependency() { return &_dependency; }
+
     void set_query_statistics(std::shared_ptr<QueryStatistics> statistics) {
         _query_statistics = statistics;
     }
@@ -123,6 +127,8 @@ protected:
     std::condition_variable _data_arrival;
     // signal removal of data by stream consumer
     std::condition_variable _data_removal;
+    // the same as _data_removal, for the pipeline tasks
+    pipeline::WakeupDependency _dependency;
 
     std::deque<GetResultBatchCtx*> _waiting_rpc;
 
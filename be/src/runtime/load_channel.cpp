@@ -114,7 +114,8 @@ Status LoadChannel::_get_tablets_channel(std::shared_ptr<TabletsChannel>& channe
 }
 
 Status LoadChannel::add_batch(const PTabletWriterAddBlockRequest& request,
-                              PTabletWriterAddBlockResult* response) {
+                              PTabletWriterAddBlockResult* response,
+                              const vectorized::Block* block) {
     SCOPED_TIMER(_add_batch_timer);
     COUNTER_UPDATE(_add_batch_times, 1);
     int64_t index_id = request.index_id();
@@ -127,8 +128,8 @@ Status LoadChannel::add_batch(const PTabletWriterAddBlockRequest& request,
     }
 
     // 2. add block to tablets channel
-    if (request.has_block()) {
-        RETURN_IF_ERROR(channel->add_batch(request, response));
+    if (request.has_block() || block != nullptr) {
+        RETURN_IF_ERROR(channel->add_batch(request, response, block));
         _add_batch_number_counter->update(1);
     }
 
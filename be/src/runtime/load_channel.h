@@ -50,6 +50,10 @@ namespace doris {
 class PTabletWriterOpenRequest;
 class OpenPartitionRequest;
 
+namespace vectorized {
+class Block;
+} // namespace vectorized
+
 // A LoadChannel manages tablets channels for all indexes
 // corresponding to a certain load job
 class LoadChannel {
@@ -63,7 +67,8 @@ public:
 
     // this batch must belong to a index in one transaction
     Status add_batch(const PTabletWriterAddBlockRequest& request,
-                     PTabletWriterAddBlockResult* response);
+                     PTabletWriterAddBlockResult* response,
+                     const vectorized::Block* block = nullptr);
 
     // return true if this load channel has been opened and all tablets channels are closed then.
     bool is_finished();
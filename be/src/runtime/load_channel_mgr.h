@@ -45,6 +45,10 @@ class PTabletWriterCancelRequest;
 class PTabletWriterOpenRequest;
 class Thread;
 
+namespace vectorized {
+class Block;
+} // namespace vectorized
+
 // LoadChannelMgr -> LoadChannel -> TabletsChannel -> DeltaWriter
 // All dispatched load data for this backend is routed from this class
 class LoadChannelMgr {
@@ -57,8 +61,11 @@ public:
     // open a new load channel if not exist
     Status open(const PTabletWriterOpenRequest& request);
 
+    // If `block' is not null, it is the data of the request sent by a sink on the same BE, and
+    // is written instead of the serialized block in request.
     Status add_batch(const PTabletWriterAddBlockRequest& request,
-                     PTabletWriterAddBlockResult* response);
+                     PTabletWriterAddBlockResult* response,
+                     const vectorized::Block* block = nullptr);
 
     // cancel all tablet stream for 'load_id' load
     Status cancel(const PTabletWriterCancelRequest& request);
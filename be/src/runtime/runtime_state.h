@@ -287,6 +287,11 @@ public:
         return _query_options.disable_stream_preaggregations;
     }
 
+    bool enable_adaptive_preaggregation() const {
+        return _query_options.__isset.enable_adaptive_preaggregation &&
+               _query_options.enable_adaptive_preaggregation;
+    }
+
     bool enable_spill() const { return _query_options.enable_spilling; }
 
     int32_t runtime_filter_wait_time_ms() const {
@@ -420,6 +425,16 @@ public:
                        : 0;
     }
 
+    bool enable_join_spill() const {
+        return _query_options.__isset.enable_join_spill && _query_options.enable_join_spill;
+    }
+
+    int external_join_partition_bits() const {
+        return _query_options.__isset.external_join_partition_bits
+                       ? _query_options.external_join_partition_bits
+                       : 4;
+    }
+
     bool enable_insert_strict() const {
         return _query_options.__isset.enable_insert_strict && _query_options.enable_insert_strict;
     }
@@ -403,7 +403,8 @@ std::ostream& operator<<(std::ostream& os, const TabletsChannelKey& key) {
 }
 
 Status TabletsChannel::add_batch(const PTabletWriterAddBlockRequest& request,
-                                 PTabletWriterAddBlockResult* response) {
+                                 PTabletWriterAddBlockResult* response,
+                                 const vectorized::Block* block) {
     SCOPED_TIMER(_add_batch_timer);
     int64_t cur_seq = 0;
     _add_batch_number_counter->update(1);
@@ -438,9 +439,12 @@ Status TabletsChannel::add_batch(const PTabletWriterAddBlockRequest& request,
         }
     }
 
-    auto get_send_data = [&]() { return vectorized::Block(request.block()); };
-
-    auto send_data = get_send_data();
+    // the block sent by a sink on the same BE is written directly without deserialization
+    vectorized::Block deserialized_data;
+    if (block == nullptr) {
+        deserialized_data = vectorized::Block(request.block());
+    }
+    const vectorized::Block& send_data = block != nullptr ? *block : deserialized_data;
 
     auto write_tablet_data = [&](uint32_t tablet_id,
                                  std::function<Status(DeltaWriter * writer)> write_func) {
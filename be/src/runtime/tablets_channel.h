@@ -59,6 +59,10 @@ class PUniqueId;
 class TupleDescriptor;
 class OpenPartitionRequest;
 
+namespace vectorized {
+class Block;
+} // namespace vectorized
+
 struct TabletsChannelKey {
     UniqueId id;
     int64_t index_id;
@@ -92,8 +96,10 @@ public:
     Status open(const PTabletWriterOpenRequest& request);
 
     // no-op when this channel has been closed or cancelled
+    // `block' is written instead of the block in request if it is not null.
     Status add_batch(const PTabletWriterAddBlockRequest& request,
-                     PTabletWriterAddBlockResult* response);
+                     PTabletWriterAddBlockResult* response,
+                     const vectorized::Block* block = nullptr);
 
     // Mark sender with 'sender_id' as closed.
     // If all senders are closed, close this channel, set '*finished' to true, update 'tablet_vec'
@@ -173,6 +173,26 @@ DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(tablet_schema_cache_count, MetricUnit::NOUN
 DEFINE_GAUGE_CORE_METRIC_PROTOTYPE_2ARG(tablet_schema_cache_memory_bytes, MetricUnit::BYTES);
 DEFINE_GAUGE_CORE_METRIC_PROTOTYPE_2ARG(lru_cache_memory_bytes, MetricUnit::BYTES);
 
+#define DEFINE_PAGE_CACHE_LOOKUP_COUNTER_METRIC(name, type, status)                             \
+    DEFINE_COUNTER_METRIC_PROTOTYPE_5ARG(name, MetricUnit::NOUNIT, "", page_cache_lookup_total, \
+                                         Labels({{"type", #type}, {"status", #status}}));
+#define DEFINE_PAGE_CACHE_ADMISSION_COUNTER_METRIC(name, type, status)                             \
+    DEFINE_COUNTER_METRIC_PROTOTYPE_5ARG(name, MetricUnit::NOUNIT, "", page_cache_admission_total, \
+                                         Labels({{"type", #type}, {"status", #status}}));
+
+DEFINE_PAGE_CACHE_LOOKUP_COUNTER_METRIC(data_page_cache_lookup_hit_total, data, hit);
+DEFINE_PAGE_CACHE_LOOKUP_COUNTER_METRIC(data_page_cache_lookup_miss_total, data, miss);
+DEFINE_PAGE_CACHE_LOOKUP_COUNTER_METRIC(index_page_cache_lookup_hit_total, index, hit);
+DEFINE_PAGE_CACHE_LOOKUP_COUNTER_METRIC(index_page_cache_lookup_miss_total, index, miss);
+DEFINE_PAGE_CACHE_LOOKUP_COUNTER_METRIC(pk_index_page_cache_lookup_hit_total, pk_index, hit);
+DEFINE_PAGE_CACHE_LOOKUP_COUNTER_METRIC(pk_index_page_cache_lookup_miss_total, pk_index, miss);
+DEFINE_PAGE_CACHE_ADMISSION_COUNTER_METRIC(data_page_cache_admitted_total, data, admitted);
+DEFINE_PAGE_CACHE_ADMISSION_COUNTER_METRIC(data_page_cache_rejected_total, data, rejected);
+DEFINE_PAGE_CACHE_ADMISSION_COUNTER_METRIC(index_page_cache_admitted_total, index, admitted);
+DEFINE_PAGE_CACHE_ADMISSION_COUNTER_METRIC(index_page_cache_rejected_total, index, rejected);
+DEFINE_PAGE_CACHE_ADMISSION_COUNTER_METRIC(pk_index_page_cache_admitted_total, pk_index, admitted);
+DEFINE_PAGE_CACHE_ADMISSION_COUNTER_METRIC(pk_index_page_cache_rejected_total, pk_index, rejected);
+
 DEFINE_GAUGE_CORE_METRIC_PROTOTYPE_2ARG(upload_total_byte, MetricUnit::BYTES);
 DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(upload_rowset_count, MetricUnit::ROWSETS);
 DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(upload_fail_count, MetricUnit::ROWSETS);
@@ -307,6 +327,19 @@ DorisMetrics::DorisMetrics() : _metric_registry(_s_registry_name) {
     INT_UGAUGE_METRIC_REGISTER(_server_metric_entity, tablet_schema_cache_memory_bytes);
     INT_GAUGE_METRIC_REGISTER(_server_metric_entity, lru_cache_memory_bytes);
 
+    INT_COUNTER_METRIC_REGISTER(_server_metric_entity, data_page_cache_lookup_hit_total);
+    INT_COUNTER_METRIC_REGISTER(_server_metric_entity, data_page_cache_lookup_miss_total);
+    INT_COUNTER_METRIC_REGISTER(_server_metric_entity, index_page_cache_lookup_hit_total);
+    INT_COUNTER_METRIC_REGISTER(_server_metric_entity, index_page_cache_lookup_miss_total);
+    INT_COUNTER_METRIC_REGISTER(_server_metric_entity, pk_index_page_cache_lookup_hit_total);
+    INT_COUNTER_METRIC_REGISTER(_server_metric_entity, pk_index_page_cache_lookup_miss_total);
+    INT_COUNTER_METRIC_REGISTER(_server_metric_entity, data_page_cache_admitted_total);
+    INT_COUNTER_METRIC_REGISTER(_server_metric_entity, data_page_cache_rejected_total);
+    INT_COUNTER_METRIC_REGISTER(_server_metric_entity, index_page_cache_admitted_total);
+    INT_COUNTER_METRIC_REGISTER(_server_metric_entity, index_page_cache_rejected_total);
+    INT_COUNTER_METRIC_REGISTER(_server_metric_entity, pk_index_page_cache_admitted_total);
+    INT_COUNTER_METRIC_REGISTER(_server_metric_entity, pk_index_page_cache_rejected_total);
+
     INT_COUNTER_METRIC_REGISTER(_server_metric_entity, local_file_reader_total);
     INT_COUNTER_METRIC_REGISTER(_server_metric_entity, s3_file_reader_total);
     INT_COUNTER_METRIC_REGISTER(_server_metric_entity, hdfs_file_reader_total);
@@ -205,6 +205,20 @@ public:
     UIntGauge* tablet_schema_cache_memory_bytes;
     IntGauge* lru_cache_memory_bytes;
 
+    // Storage page cache metrics, labeled by page cache type
+    IntCounter* data_page_cache_lookup_hit_total;
+    IntCounter* data_page_cache_lookup_miss_total;
+    IntCounter* index_page_cache_lookup_hit_total;
+    IntCounter* index_page_cache_lookup_miss_total;
+    IntCounter* pk_index_page_cache_lookup_hit_total;
+    IntCounter* pk_index_page_cache_lookup_miss_total;
+    IntCounter* data_page_cache_admitted_total;
+    IntCounter* data_page_cache_rejected_total;
+    IntCounter* index_page_cache_admitted_total;
+    IntCounter* index_page_cache_rejected_total;
+    IntCounter* pk_index_page_cache_admitted_total;
+    IntCounter* pk_index_page_cache_rejected_total;
+
     UIntGauge* scanner_thread_pool_queue_size;
     UIntGauge* add_batch_task_queue_size;
     UIntGauge* send_batch_thread_pool_thread_num;
@@ -204,6 +204,51 @@ public:
         data.template prefetch_by_hash<READ>(hash_value);
     }
 
+    /// Hash the keys of rows [0, rows) in one pass. The result is used by the batched
+    /// emplace_keys/find_keys below, which prefetch the bucket of the row that is
+    /// HASH_MAP_PREFETCH_DIST rows ahead, so the lookups do not stall on cache misses one by one
+    /// when the hash table is much larger than the cache.
+    template <typename Data>
+    void get_hash_values(const Data& data, size_t rows, Arena& pool,
+                         std::vector<size_t>& hash_values) {
+        if (hash_values.size() < rows) {
+            hash_values.resize(rows);
+        }
+        for (size_t i = 0; i < rows; ++i) {
+            auto key_holder = static_cast<Derived&>(*this).get_key_holder(i, pool);
+            hash_values[i] = data.hash(key_holder_get_key(key_holder));
+        }
+    }
+
+    /// Emplace rows [begin, end) with the hash values computed by get_hash_values,
+    /// f(row, emplace_result) is called for every row.
+    /// Null keys are not handled here, HashMethodSingleLowNullableColumn should not use it.
+    template <typename Data, typename Func>
+    void emplace_keys(Data& data, const std::vector<size_t>& hash_values, size_t begin,
+                      size_t end, Arena& pool, Func&& f) {
+        for (size_t i = begin; i < end; ++i) {
+            if (LIKELY(i + HASH_MAP_PREFETCH_DIST < end)) {
+                prefetch_by_hash<false>(data, hash_values[i + HASH_MAP_PREFETCH_DIST]);
+            }
+            auto emplace_result = emplace_key(data, hash_values[i], i, pool);
+            f(i, emplace_result);
+        }
+    }
+
+    /// Find rows [begin, end) with the hash values computed by get_hash_values,
+    /// f(row, find_result) is called for every row.
+    template <typename Data, typename Func>
+    void find_keys(Data& data, const std::vector<size_t>& hash_values, size_t begin, size_t end,
+                   Arena& pool, Func&& f) {
+        for (size_t i = begin; i < end; ++i) {
+            if (LIKELY(i + HASH_MAP_PREFETCH_DIST < end)) {
+                prefetch_by_hash<true>(data, hash_values[i + HASH_MAP_PREFETCH_DIST]);
+            }
+            auto find_result = find_key_with_hash(data, hash_values[i], i, pool);
+            f(i, find_result);
+        }
+    }
+
     ALWAYS_INLINE auto get_key_holder(size_t row, Arena& pool) {
         return static_cast<Derived&>(*this).get_key_holder(row, pool);
     }
@@ -232,6 +232,11 @@ public:
 
     void ALWAYS_INLINE prefetch_by_hash(size_t hash_value) { _hash_map.prefetch_hash(hash_value); }
 
+    template <bool READ>
+    void ALWAYS_INLINE prefetch_by_hash(size_t hash_value) {
+        _hash_map.prefetch_hash(hash_value);
+    }
+
     void ALWAYS_INLINE prefetch_by_key(Key key) { _hash_map.prefetch(key); }
 
     /// Call func(const Key &, Mapped &) for each hash map element.
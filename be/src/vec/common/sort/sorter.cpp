@@ -75,22 +75,24 @@ Status MergeSorterState::add_sorted_block(Block& block) {
     auto total_bytes_used = bytes_used + block.bytes();
     if (is_spilled_ || (external_sort_bytes_threshold_ > 0 &&
                         total_bytes_used >= external_sort_bytes_threshold_)) {
+        // The sink of the sort is blocked until the previous async spill io finishes.
+        DCHECK(!io_running_);
+        RETURN_IF_ERROR(io_status_);
         is_spilled_ = true;
-        BlockSpillWriterUPtr spill_block_writer;
-        RETURN_IF_ERROR(ExecEnv::GetInstance()->block_spill_mgr()->get_writer(
-                spill_block_batch_size_, spill_block_writer, block_spill_profile_));
-
-        RETURN_IF_ERROR(spill_block_writer->write(block));
-        spilled_sorted_block_streams_.emplace_back(spill_block_writer->get_id());
-
-        COUNTER_UPDATE(spilled_block_count_, 1);
-        COUNTER_UPDATE(spilled_original_block_size_, spill_block_writer->get_written_bytes());
-        RETURN_IF_ERROR(spill_block_writer->close());
-
         if (init_merge_sorted_block_) {
             init_merge_sorted_block_ = false;
             merge_sorted_block_ = block.clone_empty();
         }
+
+        const auto data_dir_index = ExecEnv::GetInstance()->block_spill_mgr()->select_data_dir();
+        if (async_io_) {
+            auto spill_block = std::make_shared<Block>(std::move(block));
+            RETURN_IF_ERROR(_submit_spill_io(data_dir_index, [this, spill_block, data_dir_index]() {
+                return _spill_block(data_dir_index, *spill_block);
+            }));
+        } else {
+            RETURN_IF_ERROR(_spill_block(data_dir_index, block));
+        }
     } else {
         sorted_blocks_.emplace_back(std::move(block));
     }
@@ -111,27 +113,13 @@ void MergeSorterState::_build_merge_tree_not_spilled(const SortDescription& sort
 Status MergeSorterState::build_merge_tree(const SortDescription& sort_description) {
     _build_merge_tree_not_spilled(sort_description);
 
-    if (spilled_sorted_block_streams_.size() > 0) {
-        if (sorted_blocks_.size() > 0) {
-            BlockSpillWriterUPtr spill_block_writer;
-            RETURN_IF_ERROR(ExecEnv::GetInstance()->block_spill_mgr()->get_writer(
-                    spill_block_batch_size_, spill_block_writer, block_spill_profile_));
-
-            if (sorted_blocks_.size() == 1) {
-                RETURN_IF_ERROR(spill_block_writer->write(sorted_blocks_[0]));
-            } else {
-                bool eos = false;
-
-                // merge blocks in memory and write merge result to disk
-                while (!eos) {
-                    merge_sorted_block_.clear_column_data();
-                    RETURN_IF_ERROR(_merge_sort_read_not_spilled(spill_block_batch_size_,
-                                                                 &merge_sorted_block_, &eos));
-                    RETURN_IF_ERROR(spill_block_writer->write(merge_sorted_block_));
-                }
-            }
-            spilled_sorted_block_streams_.emplace_back(spill_block_writer->get_id());
-            RETURN_IF_ERROR(spill_block_writer->close());
+    if (is_spilled_) {
+        if (async_io_) {
+            // The last spill io may be still running, the spilled runs are merged by the spill
+            // io thread pool when the sorted data is read, see `_prepare_spilled_merge`.
+            pending_sort_description_ = sort_description;
+            merge_pending_ = true;
+            return Status::OK();
         }
         RETURN_IF_ERROR(_merge_spilled_blocks(sort_description));
     }
@@ -141,6 +129,12 @@ Status MergeSorterState::build_merge_tree(const SortDescription& sort_descriptio
 Status MergeSorterState::merge_sort_read(doris::RuntimeState* state,
                                          doris::vectorized::Block* block, bool* eos) {
     if (is_spilled_) {
+        bool ready = false;
+        RETURN_IF_ERROR(_prepare_spilled_merge(&ready));
+        if (!ready) {
+            *eos = false;
+            return Status::OK();
+        }
         RETURN_IF_ERROR(merger_->get_next(block, eos));
     } else {
         if (sorted_blocks_.empty()) {
@@ -195,6 +189,116 @@ Status MergeSorterState::_merge_sort_read_not_spilled(int batch_size,
     return Status::OK();
 }
 
+SpilledRunReadAhead::SpilledRunReadAhead(BlockSpillReaderUPtr reader, size_t data_dir_index,
+                                         bool async)
+        : _reader(std::move(reader)),
+          _data_dir_index(data_dir_index),
+          _async(async),
+          _mem_tracker(thread_context()->thread_mem_tracker_mgr->limiter_mem_tracker()) {}
+
+SpilledRunReadAhead::~SpilledRunReadAhead() {
+    // the sort source is pending finish until the reading finishes
+    DCHECK(!_reading);
+}
+
+Status SpilledRunReadAhead::start() {
+    return _async ? _submit_read() : Status::OK();
+}
+
+Status SpilledRunReadAhead::read(Block* block, bool* eos) {
+    if (!_async) {
+        return _reader->read(block, eos);
+    }
+    DCHECK(!_reading);
+    RETURN_IF_ERROR(_status);
+    block->swap(_block);
+    *eos = _eos;
+    if (!_eos) {
+        RETURN_IF_ERROR(_submit_read());
+    }
+    return Status::OK();
+}
+
+Status SpilledRunReadAhead::_submit_read() {
+    _reading = true;
+    auto st = ExecEnv::GetInstance()->block_spill_mgr()->submit_io(_data_dir_index, [this]() {
+        SCOPED_ATTACH_TASK(_mem_tracker);
+        // `_block` is only accessed by this io task until `_reading` is reset
+        _status = _reader->read(&_block, &_eos);
+        _reading = false;
+    });
+    if (!st.ok()) {
+        _reading = false;
+    }
+    return st;
+}
+
+bool MergeSorterState::is_spill_io_running() const {
+    if (io_running_) {
+        return true;
+    }
+    // `spilled_block_readers_` is not changed by the spill io thread pool once `io_running_`
+    // is reset
+    return std::any_of(spilled_block_readers_.begin(), spilled_block_readers_.end(),
+                       [](const auto& reader) { return reader->is_reading(); });
+}
+
+Status MergeSorterState::_submit_spill_io(size_t data_dir_index,
+                                          std::function<Status()> io_func) {
+    DCHECK(!io_running_);
+    io_running_ = true;
+    auto st = ExecEnv::GetInstance()->block_spill_mgr()->submit_io(
+            data_dir_index,
+            [this, mem_tracker = thread_context()->thread_mem_tracker_mgr->limiter_mem_tracker(),
+             io_func = std::move(io_func)]() mutable {
+                SCOPED_ATTACH_TASK(mem_tracker);
+                io_status_ = io_func();
+                // release the resources captured by `io_func` with the query mem tracker
+                io_func = nullptr;
+                io_running_ = false;
+            });
+    if (!st.ok()) {
+        io_running_ = false;
+    }
+    return st;
+}
+
+Status MergeSorterState::_prepare_spilled_merge(bool* ready) {
+    *ready = false;
+    if (is_spill_io_running()) {
+        // The pipeline task is blocked by `is_spill_io_running()` until the io finishes.
+        return Status::OK();
+    }
+    RETURN_IF_ERROR(io_status_);
+
+    if (merge_pending_) {
+        merge_pending_ = false;
+        const auto data_dir_index = ExecEnv::GetInstance()->block_spill_mgr()->select_data_dir();
+        return _submit_spill_io(data_dir_index, [this]() {
+            return _merge_spilled_blocks(pending_sort_description_);
+        });
+    }
+    if (!merger_prepared_) {
+        // the first block of each run has been read ahead
+        RETURN_IF_ERROR(_prepare_merger());
+    }
+    *ready = true;
+    return Status::OK();
+}
+
+Status MergeSorterState::_spill_block(size_t data_dir_index, const Block& block) {
+    BlockSpillWriterUPtr spill_block_writer;
+    RETURN_IF_ERROR(ExecEnv::GetInstance()->block_spill_mgr()->get_writer(
+            data_dir_index, spill_block_batch_size_, spill_block_writer, block_spill_profile_));
+
+    RETURN_IF_ERROR(spill_block_writer->write(block));
+    spilled_sorted_block_streams_.emplace_back(spill_block_writer->get_id());
+
+    COUNTER_UPDATE(spilled_block_count_, 1);
+    COUNTER_UPDATE(spilled_original_block_size_, spill_block_writer->get_written_bytes());
+    return spill_block_writer->close();
+}
+
 int MergeSorterState::_calc_spill_blocks_to_merge() const {
     int count = external_sort_bytes_threshold_ / BLOCK_SPILL_BATCH_BYTES;
     return std::max(2, count);
@@ -202,20 +306,41 @@ int MergeSorterState::_calc_spill_blocks_to_merge() const {
 
 // merge all the intermediate spilled blocks
 Status MergeSorterState::_merge_spilled_blocks(const SortDescription& sort_description) {
+    auto* spill_manager = ExecEnv::GetInstance()->block_spill_mgr();
+    if (sorted_blocks_.size() > 0) {
+        BlockSpillWriterUPtr spill_block_writer;
+        RETURN_IF_ERROR(spill_manager->get_writer(spill_block_batch_size_, spill_block_writer,
+                                                  block_spill_profile_));
+
+        if (sorted_blocks_.size() == 1) {
+            RETURN_IF_ERROR(spill_block_writer->write(sorted_blocks_[0]));
+        } else {
+            bool eos = false;
+
+            // merge blocks in memory and write merge result to disk
+            while (!eos) {
+                merge_sorted_block_.clear_column_data();
+                RETURN_IF_ERROR(_merge_sort_read_not_spilled(spill_block_batch_size_,
+                                                             &merge_sorted_block_, &eos));
+                RETURN_IF_ERROR(spill_block_writer->write(merge_sorted_block_));
+            }
+        }
+        spilled_sorted_block_streams_.emplace_back(spill_block_writer->get_id());
+        RETURN_IF_ERROR(spill_block_writer->close());
+    }
+
     int num_of_blocks_to_merge = _calc_spill_blocks_to_merge();
-    while (true) {
+    while (spilled_sorted_block_streams_.size() > num_of_blocks_to_merge) {
         // pick some spilled blocks to merge, and spill the merged result
         // to disk, until all splled blocks can be merged in a run.
-        RETURN_IF_ERROR(_create_intermediate_merger(num_of_blocks_to_merge, sort_description));
-        if (spilled_sorted_block_streams_.empty()) {
-            break;
-        }
+        RETURN_IF_ERROR(
+                _create_intermediate_merger(num_of_blocks_to_merge, sort_description, false));
 
         bool eos = false;
 
         BlockSpillWriterUPtr spill_block_writer;
-        RETURN_IF_ERROR(ExecEnv::GetInstance()->block_spill_mgr()->get_writer(
-                spill_block_batch_size_, spill_block_writer, block_spill_profile_));
+        RETURN_IF_ERROR(spill_manager->get_writer(spill_block_batch_size_, spill_block_writer,
+                                                  block_spill_profile_));
 
         while (!eos) {
             merge_sorted_block_.clear_column_data();
@@ -225,30 +350,49 @@ Status MergeSorterState::_merge_spilled_blocks(const SortDescription& sort_descr
         spilled_sorted_block_streams_.emplace_back(spill_block_writer->get_id());
         RETURN_IF_ERROR(spill_block_writer->close());
     }
-    return Status::OK();
+    // The runs of the final merge are read ahead by the spill io thread pools if async, and
+    // `merger_` is prepared when the first blocks of them are read.
+    return _create_intermediate_merger(num_of_blocks_to_merge, sort_description, async_io_);
 }
 
 Status MergeSorterState::_create_intermediate_merger(int num_blocks,
-                                                     const SortDescription& sort_description) {
+                                                     const SortDescription& sort_description,
+                                                     bool async) {
     spilled_block_readers_.clear();
 
-    std::vector<BlockSupplier> child_block_suppliers;
     merger_.reset(new VSortedRunMerger(sort_description, spill_block_batch_size_, limit_, offset_,
                                        profile_));
+    // In pipeline engine, the merger returns before it reads the next block of a run, so a run
+    // is read at most once in one `get_next`.
+    merger_->set_pipeline_engine_enabled(async);
+    merger_prepared_ = false;
 
     for (int i = 0; i < num_blocks && !spilled_sorted_block_streams_.empty(); ++i) {
         auto stream_id = spilled_sorted_block_streams_.front();
+        auto* spill_manager = ExecEnv::GetInstance()->block_spill_mgr();
+        const auto data_dir_index = spill_manager->get_data_dir_index(stream_id);
         BlockSpillReaderUPtr spilled_block_reader;
-        RETURN_IF_ERROR(ExecEnv::GetInstance()->block_spill_mgr()->get_reader(
-                stream_id, spilled_block_reader, block_spill_profile_));
-        child_block_suppliers.emplace_back(std::bind(std::mem_fn(&BlockSpillReader::read),
-                                                     spilled_block_reader.get(),
-                                                     std::placeholders::_1, std::placeholders::_2));
-        spilled_block_readers_.emplace_back(std::move(spilled_block_reader));
+        RETURN_IF_ERROR(
+                spill_manager->get_reader(stream_id, spilled_block_reader, block_spill_profile_));
+        auto read_ahead = std::make_unique<SpilledRunReadAhead>(std::move(spilled_block_reader),
+                                                                data_dir_index, async);
+        RETURN_IF_ERROR(read_ahead->start());
+        spilled_block_readers_.emplace_back(std::move(read_ahead));
 
         spilled_sorted_block_streams_.pop_front();
     }
+    return async ? Status::OK() : _prepare_merger();
+}
+
+Status MergeSorterState::_prepare_merger() {
+    std::vector<BlockSupplier> child_block_suppliers;
+    for (auto& read_ahead : spilled_block_readers_) {
+        child_block_suppliers.emplace_back(std::bind(std::mem_fn(&SpilledRunReadAhead::read),
+                                                     read_ahead.get(), std::placeholders::_1,
+                                                     std::placeholders::_2));
+    }
     RETURN_IF_ERROR(merger_->prepare(child_block_suppliers));
+    merger_prepared_ = true;
     return Status::OK();
 }
 
@@ -357,7 +501,7 @@ Status FullSorter::_do_sort() {
         // if one block totally greater the heap top of _block_priority_queue
         // we can throw the block data directly.
         if (_state->num_rows() < _offset + _limit) {
-            _state->add_sorted_block(desc_block);
+            RETURN_IF_ERROR(_state->add_sorted_block(desc_block));
             // if it's spilled, sorted_block is not added into sorted block vector,
             // so it's should not be added to _block_priority_queue, since
             // sorted_block will be destroyed when _do_sort is finished
@@ -370,7 +514,7 @@ Status FullSorter::_do_sort() {
                     std::make_unique<MergeSortCursorImpl>(desc_block, _sort_description);
             MergeSortBlockCursor block_cursor(tmp_cursor_impl.get());
             if (!block_cursor.totally_greater(_block_priority_queue.top())) {
-                _state->add_sorted_block(desc_block);
+                RETURN_IF_ERROR(_state->add_sorted_block(desc_block));
                 if (!_state->is_spilled()) {
                     _block_priority_queue.emplace(_pool->add(new MergeSortCursorImpl(
                             _state->last_sorted_block(), _sort_description)));
@@ -379,7 +523,7 @@ Status FullSorter::_do_sort() {
         }
     } else {
         // dispose normal sort logic
-        _state->add_sorted_block(desc_block);
+        RETURN_IF_ERROR(_state->add_sorted_block(desc_block));
     }
     if (_state->is_spilled()) {
         std::priority_queue<MergeSortBlockCursor> tmp;
@@ -20,7 +20,9 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <atomic>
 #include <deque>
+#include <functional>
 #include <memory>
 #include <queue>
 #include <vector>
@@ -38,12 +40,43 @@
 #include "vec/utils/util.hpp"
 
 namespace doris {
+class MemTrackerLimiter;
 class ObjectPool;
 class RowDescriptor;
 } // namespace doris
 
 namespace doris::vectorized {
 
+// Read a spilled sorted run block by block. If `async`, the next block is read ahead in the
+// spill io thread pool of the data dir of the run while the current block is being merged, and
+// `read` could only be called when `is_reading()` is false. Otherwise the blocks are read by
+// the calling thread.
+class SpilledRunReadAhead {
+public:
+    SpilledRunReadAhead(BlockSpillReaderUPtr reader, size_t data_dir_index, bool async);
+
+    ~SpilledRunReadAhead();
+
+    Status start();
+
+    Status read(Block* block, bool* eos);
+
+    bool is_reading() const { return _reading; }
+
+private:
+    Status _submit_read();
+
+    BlockSpillReaderUPtr _reader;
+    const size_t _data_dir_index;
+    const bool _async;
+    std::shared_ptr<MemTrackerLimiter> _mem_tracker;
+
+    std::atomic<bool> _reading = false;
+    Block _block;
+    bool _eos = false;
+    Status _status;
+};
+
 // TODO: now we only use merge sort
 class MergeSorterState {
     ENABLE_FACTORY_CREATOR(MergeSorterState);
@@ -60,6 +93,7 @@ public:
               limit_(limit),
               profile_(profile) {
         external_sort_bytes_threshold_ = state->external_sort_bytes_threshold();
+        async_io_ = state->enable_pipeline_exec();
         if (profile != nullptr) {
             block_spill_profile_ = profile->create_child("BlockSpill", true, true);
             spilled_block_count_ = ADD_COUNTER(block_spill_profile_, "BlockCount", TUnit::UNIT);
@@ -88,6 +122,10 @@ public:
 
     bool is_spilled() const { return is_spilled_; }
 
+    // When the pipeline engine is used, the spill io runs in the spill io thread pools, and the
+    // sink and the source of the sort are blocked until it finishes.
+    bool is_spill_io_running() const;
+
     const Block& last_sorted_block() const { return sorted_blocks_.back(); }
 
     std::vector<Block>& get_sorted_block() { return sorted_blocks_; }
@@ -103,9 +141,23 @@ private:
 
     Status _merge_sort_read_not_spilled(int batch_size, doris::vectorized::Block* block, bool* eos);
 
+    // Write `block` into a new spill stream.
+    Status _spill_block(size_t data_dir_index, const Block& block);
+
+    // Spill the sorted blocks in memory, and merge the spilled runs until they could be merged
+    // in one run by `merger_`.
     Status _merge_spilled_blocks(const SortDescription& sort_description);
 
-    Status _create_intermediate_merger(int num_blocks, const SortDescription& sort_description);
+    Status _create_intermediate_merger(int num_blocks, const SortDescription& sort_description,
+                                       bool async);
+
+    Status _prepare_merger();
+
+    // Set `ready` if `merger_` could merge the spilled runs now, otherwise the spill io is running
+    // and `is_spill_io_running()` is true until it finishes.
+    Status _prepare_spilled_merge(bool* ready);
+
+    Status _submit_spill_io(size_t data_dir_index, std::function<Status()> io_func);
 
     std::priority_queue<MergeSortCursor> priority_queue_;
     std::vector<MergeSortCursorImpl> cursors_;
@@ -122,9 +174,18 @@ private:
     bool is_spilled_ = false;
     bool init_merge_sorted_block_ = true;
     std::deque<int64_t> spilled_sorted_block_streams_;
-    std::vector<BlockSpillReaderUPtr> spilled_block_readers_;
+    std::vector<std::unique_ptr<SpilledRunReadAhead>> spilled_block_readers_;
     Block merge_sorted_block_;
     std::unique_ptr<VSortedRunMerger> merger_;
+    bool merger_prepared_ = false;
+
+    bool async_io_ = false;
+    std::atomic<bool> io_running_ = false;
+    // status of the last finished async spill io task
+    Status io_status_;
+    // the spilled runs are merged by an async spill io task when the sorted data is read
+    bool merge_pending_ = false;
+    SortDescription pending_sort_description_;
 
     RuntimeProfile* profile_;
     RuntimeProfile* block_spill_profile_;
@@ -161,6 +222,8 @@ public:
 
     virtual bool is_spilled() const { return false; }
 
+    virtual bool is_spill_io_running() const { return false; }
+
     // for topn runtime predicate
     const SortDescription& get_sort_description() { return _sort_description; }
     virtual Field get_top_value() { return Field {Field::Types::Null}; }
@@ -203,6 +266,8 @@ public:
 
     bool is_spilled() const override { return _state->is_spilled(); }
 
+    bool is_spill_io_running() const override { return _state->is_spill_io_running(); }
+
 private:
     bool _reach_limit() {
         return _state->unsorted_block_->rows() > buffered_block_size_ ||
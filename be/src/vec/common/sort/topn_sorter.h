@@ -59,6 +59,8 @@ public:
 
     bool is_spilled() const override { return _state->is_spilled(); }
 
+    bool is_spill_io_running() const override { return _state->is_spill_io_running(); }
+
     static constexpr size_t TOPN_SORT_THRESHOLD = 256;
 
 private:
@@ -89,7 +89,9 @@ Block::Block(const PBlock& pblock) {
     CHECK(BeExecVersionManager::check_be_exec_version(be_exec_version));
 
     const char* buf = nullptr;
-    std::string compression_scratch;
+    // The columns are deserialized straight from the decompressed data, which is not
+    // initialized before decompression, unlike a std::string.
+    faststring compression_scratch;
     if (pblock.compressed()) {
         // Decompress
         SCOPED_RAW_TIMER(&_decompress_time_ns);
@@ -101,7 +103,7 @@ Block::Block(const PBlock& pblock) {
             get_block_compression_codec(pblock.compression_type(), &codec);
             uncompressed_size = pblock.uncompressed_size();
             compression_scratch.resize(uncompressed_size);
-            Slice decompressed_slice(compression_scratch);
+            Slice decompressed_slice(compression_scratch.data(), compression_scratch.size());
             codec->decompress(Slice(compressed_data, compressed_size), &decompressed_slice);
             DCHECK(uncompressed_size == decompressed_slice.size);
         } else {
@@ -110,11 +112,11 @@ Block::Block(const PBlock& pblock) {
             DCHECK(success) << "snappy::GetUncompressedLength failed";
             compression_scratch.resize(uncompressed_size);
             success = snappy::RawUncompress(compressed_data, compressed_size,
-                                            compression_scratch.data());
+                                            reinterpret_cast<char*>(compression_scratch.data()));
             DCHECK(success) << "snappy::RawUncompress failed";
         }
         _decompressed_bytes = uncompressed_size;
-        buf = compression_scratch.data();
+        buf = reinterpret_cast<const char*>(compression_scratch.data());
     } else {
         buf = pblock.column_values().data();
     }
@@ -816,7 +818,8 @@ Status Block::serialize(int be_exec_version, PBlock* pblock,
     }
 
     // serialize data values
-    // when data type is HLL, content_uncompressed_size maybe larger than real size.
+    // when data type is HLL or strings are dictionary encoded, content_uncompressed_size maybe
+    // larger than real size, it is shrunk to the real size after serialization.
     std::string column_values;
     try {
         column_values.resize(content_uncompressed_size);
@@ -831,6 +834,9 @@ Status Block::serialize(int be_exec_version, PBlock* pblock,
     for (const auto& c : *this) {
         buf = c.type->serialize(*(c.column), buf, pblock->be_exec_version());
     }
+    DCHECK_LE(buf - column_values.data(), content_uncompressed_size);
+    content_uncompressed_size = buf - column_values.data();
+    column_values.resize(content_uncompressed_size);
     *uncompressed_bytes = content_uncompressed_size;
 
     // compress
@@ -20,17 +20,21 @@
 
 #include "vec/data_types/data_type_string.h"
 
+#include <parallel_hashmap/phmap.h>
 #include <string.h>
 
 #include <typeinfo>
 #include <utility>
+#include <vector>
 
+#include "common/config.h"
 #include "vec/columns/column.h"
 #include "vec/columns/column_const.h"
 #include "vec/columns/column_string.h"
 #include "vec/common/assert_cast.h"
 #include "vec/common/string_buffer.hpp"
 #include "vec/common/string_ref.h"
+#include "vec/common/unaligned.h"
 #include "vec/core/field.h"
 #include "vec/io/reader_buffer.h"
 
@@ -73,9 +77,156 @@ bool DataTypeString::equals(const IDataType& rhs) const {
     return typeid(rhs) == typeid(*this);
 }
 
+// Since be_exec_version 3, the data starts with a byte of the encoding.
+static constexpr int STRING_ENCODING_BE_EXEC_VERSION = 3;
+static constexpr uint8_t STRING_PLAIN_ENCODING = 0;
+static constexpr uint8_t STRING_DICT_ENCODING = 1;
+// try the dictionary encoding only for columns of at least so many rows
+static constexpr size_t DICT_ENCODING_MIN_ROWS = 64;
+// the number of rows sampled to estimate the cardinality before building the dictionary
+static constexpr size_t DICT_ENCODING_SAMPLE_ROWS = 64;
+
+// Whether the distinct values of the rows sampled evenly from the column are few enough for the
+// dictionary encoding, so the dictionary is not built for columns of high cardinality.
+static bool sample_low_cardinality(const ColumnString& column) {
+    size_t row_num = column.size();
+    size_t step = row_num / DICT_ENCODING_SAMPLE_ROWS;
+    phmap::flat_hash_set<StringRef, StringRefHash> sample_values;
+    for (size_t i = 0; i < DICT_ENCODING_SAMPLE_ROWS; ++i) {
+        sample_values.insert(column.get_data_at(i * step));
+    }
+    return sample_values.size() <= DICT_ENCODING_SAMPLE_ROWS / 2;
+}
+
+// dictionary encoding:
+//  row num | dict size | <dict offset array> | dict length | <dict value array> |
+//  code width | <code array>
+// Returns nullptr and writes nothing if the column has too many distinct values, or if the
+// encoded data is not smaller than the plain encoding.
+static char* serialize_dict(const ColumnString& column, char* buf) {
+    size_t row_num = column.size();
+    if (row_num < DICT_ENCODING_MIN_ROWS || !sample_low_cardinality(column)) {
+        return nullptr;
+    }
+    size_t plain_bytes = sizeof(IColumn::Offset) * row_num + column.get_chars().size();
+    phmap::flat_hash_map<StringRef, uint32_t, StringRefHash> dict;
+    std::vector<StringRef> dict_values;
+    std::vector<uint32_t> codes(row_num);
+    size_t dict_value_len = 0;
+    for (size_t i = 0; i < row_num; ++i) {
+        auto value = column.get_data_at(i);
+        auto [it, inserted] = dict.try_emplace(value, dict_values.size());
+        if (inserted) {
+            dict_values.push_back(value);
+            dict_value_len += value.size;
+            // give up early on columns of high cardinality
+            if (dict_values.size() > row_num / 2) {
+                return nullptr;
+            }
+        }
+        codes[i] = it->second;
+    }
+    uint8_t code_width = dict_values.size() <= 256 ? 1 : (dict_values.size() <= 65536 ? 2 : 4);
+    size_t dict_bytes = sizeof(IColumn::Offset) * (dict_values.size() + 1) + sizeof(uint64_t) +
+                        dict_value_len + sizeof(uint8_t) + code_width * row_num;
+    if (dict_bytes >= plain_bytes) {
+        return nullptr;
+    }
+
+    // row num
+    *reinterpret_cast<IColumn::Offset*>(buf) = row_num;
+    buf += sizeof(IColumn::Offset);
+    // dict size and offsets
+    *reinterpret_cast<IColumn::Offset*>(buf) = dict_values.size();
+    buf += sizeof(IColumn::Offset);
+    IColumn::Offset offset = 0;
+    for (const auto& value : dict_values) {
+        offset += value.size;
+        *reinterpret_cast<IColumn::Offset*>(buf) = offset;
+        buf += sizeof(IColumn::Offset);
+    }
+    // dict length and values
+    *reinterpret_cast<uint64_t*>(buf) = dict_value_len;
+    buf += sizeof(uint64_t);
+    for (const auto& value : dict_values) {
+        memcpy(buf, value.data, value.size);
+        buf += value.size;
+    }
+    // codes
+    *reinterpret_cast<uint8_t*>(buf) = code_width;
+    buf += sizeof(uint8_t);
+    for (size_t i = 0; i < row_num; ++i) {
+        switch (code_width) {
+        case 1:
+            *reinterpret_cast<uint8_t*>(buf) = codes[i];
+            break;
+        case 2:
+            *reinterpret_cast<uint16_t*>(buf) = codes[i];
+            break;
+        default:
+            *reinterpret_cast<uint32_t*>(buf) = codes[i];
+            break;
+        }
+        buf += code_width;
+    }
+    return buf;
+}
+
+static const char* deserialize_dict(const char* buf, ColumnString* column) {
+    ColumnString::Chars& data = column->get_chars();
+    ColumnString::Offsets& offsets = column->get_offsets();
+
+    // row num
+    IColumn::Offset row_num = *reinterpret_cast<const IColumn::Offset*>(buf);
+    buf += sizeof(IColumn::Offset);
+    // dict size and offsets
+    IColumn::Offset dict_size = *reinterpret_cast<const IColumn::Offset*>(buf);
+    buf += sizeof(IColumn::Offset);
+    std::vector<IColumn::Offset> dict_offsets(dict_size + 1);
+    memcpy(dict_offsets.data() + 1, buf, sizeof(IColumn::Offset) * dict_size);
+    buf += sizeof(IColumn::Offset) * dict_size;
+    // dict length and values
+    uint64_t dict_value_len = *reinterpret_cast<const uint64_t*>(buf);
+    buf += sizeof(uint64_t);
+    const char* dict_data = buf;
+    buf += dict_value_len;
+    // codes
+    uint8_t code_width = *reinterpret_cast<const uint8_t*>(buf);
+    buf += sizeof(uint8_t);
+    const char* codes = buf;
+    buf += code_width * row_num;
+
+    auto code_at = [&](size_t i) -> uint32_t {
+        switch (code_width) {
+        case 1:
+            return reinterpret_cast<const uint8_t*>(codes)[i];
+        case 2:
+            return unaligned_load<uint16_t>(codes + i * 2);
+        default:
+            return unaligned_load<uint32_t>(codes + i * 4);
+        }
+    };
+    offsets.resize(row_num);
+    IColumn::Offset offset = 0;
+    for (size_t i = 0; i < row_num; ++i) {
+        uint32_t code = code_at(i);
+        offset += dict_offsets[code + 1] - dict_offsets[code];
+        offsets[i] = offset;
+    }
+    data.resize(offset);
+    for (size_t i = 0; i < row_num; ++i) {
+        uint32_t code = code_at(i);
+        memcpy(data.data() + offsets[i - 1], dict_data + dict_offsets[code],
+               dict_offsets[code + 1] - dict_offsets[code]);
+    }
+    return buf;
+}
+
 // binary: <size array> | total length | <value array>
 //  <size array> : row num | offset1 |offset2 | ...
 //  <value array> : <value1> | <value2 | ...
+// Since be_exec_version 3 the data starts with the encoding, and low cardinality columns are
+// dictionary encoded if enable_block_string_dict_encoding is true, see serialize_dict().
 int64_t DataTypeString::get_uncompressed_serialized_bytes(const IColumn& column,
                                                           int be_exec_version) const {
     auto ptr = column.convert_to_full_column_if_const();
@@ -86,7 +237,9 @@ int64_t DataTypeString::get_uncompressed_serialized_bytes(const IColumn& column,
                data_column.get_chars().size() + column.size();
     }
 
-    return sizeof(IColumn::Offset) * (column.size() + 1) + sizeof(uint64_t) +
+    // the dictionary encoding is used only if it is smaller than the plain encoding
+    int64_t encoding_bytes = be_exec_version >= STRING_ENCODING_BE_EXEC_VERSION;
+    return encoding_bytes + sizeof(IColumn::Offset) * (column.size() + 1) + sizeof(uint64_t) +
            data_column.get_chars().size();
 }
 
@@ -94,6 +247,18 @@ char* DataTypeString::serialize(const IColumn& column, char* buf, int be_exec_ve
     auto ptr = column.convert_to_full_column_if_const();
     const auto& data_column = assert_cast<const ColumnString&>(*ptr.get());
 
+    if (be_exec_version >= STRING_ENCODING_BE_EXEC_VERSION) {
+        char* end = config::enable_block_string_dict_encoding
+                            ? serialize_dict(data_column, buf + sizeof(uint8_t))
+                            : nullptr;
+        if (end != nullptr) {
+            *reinterpret_cast<uint8_t*>(buf) = STRING_DICT_ENCODING;
+            return end;
+        }
+        *reinterpret_cast<uint8_t*>(buf) = STRING_PLAIN_ENCODING;
+        buf += sizeof(uint8_t);
+    }
+
     if (be_exec_version == 0) {
         // row num
         *reinterpret_cast<IColumn::Offset*>(buf) = column.size();
@@ -140,6 +305,15 @@ const char* DataTypeString::deserialize(const char* buf, IColumn* column,
     ColumnString::Chars& data = column_string->get_chars();
     ColumnString::Offsets& offsets = column_string->get_offsets();
 
+    if (be_exec_version >= STRING_ENCODING_BE_EXEC_VERSION) {
+        uint8_t encoding = *reinterpret_cast<const uint8_t*>(buf);
+        buf += sizeof(uint8_t);
+        if (encoding == STRING_DICT_ENCODING) {
+            return deserialize_dict(buf, column_string);
+        }
+        DCHECK_EQ(encoding, STRING_PLAIN_ENCODING);
+    }
+
     if (be_exec_version == 0) {
         // row num
         IColumn::Offset row_num = *reinterpret_cast<const IColumn::Offset*>(buf);
@@ -76,6 +76,11 @@ struct ProcessHashTableProbe {
     void _pre_serialize_key(const ColumnRawPtrs& key_columns, const size_t key_rows,
                             std::vector<StringRef>& serialized_keys);
 
+    // Compute the hash values of all the rows in current probe block before probing
+    template <typename HashTableType, typename KeyGetter>
+    void _compute_probe_side_hash_values(HashTableType& hash_table_ctx, KeyGetter& key_getter,
+                                         size_t probe_rows);
+
     // Process full outer join/ right join / right semi/anti join to output the join result
     // in hash table
     template <typename HashTableType>
@@ -87,6 +92,7 @@ struct ProcessHashTableProbe {
     const std::vector<Block>& _build_blocks;
     std::unique_ptr<Arena> _arena;
     std::vector<StringRef> _probe_keys;
+    std::vector<size_t> _probe_side_hash_values;
 
     std::vector<uint32_t> _probe_indexs;
     std::vector<int8_t> _build_block_offsets;
@@ -106,6 +112,7 @@ struct ProcessHashTableProbe {
     RuntimeProfile::Counter* _build_side_output_timer;
     RuntimeProfile::Counter* _probe_side_output_timer;
     RuntimeProfile::Counter* _probe_process_hashtable_timer;
+    RuntimeProfile::Counter* _probe_side_compute_hash_timer;
     static constexpr int PROBE_SIDE_EXPLODE_RATE = 3;
 };
 
@@ -48,7 +48,8 @@ ProcessHashTableProbe<JoinOpType>::ProcessHashTableProbe(HashJoinNode* join_node
           _search_hashtable_timer(join_node->_search_hashtable_timer),
           _build_side_output_timer(join_node->_build_side_output_timer),
           _probe_side_output_timer(join_node->_probe_side_output_timer),
-          _probe_process_hashtable_timer(join_node->_probe_process_hashtable_timer) {}
+          _probe_process_hashtable_timer(join_node->_probe_process_hashtable_timer),
+          _probe_side_compute_hash_timer(join_node->_probe_side_compute_hash_timer) {}
 
 template <int JoinOpType>
 template <bool have_other_join_conjunct>
@@ -206,6 +207,26 @@ void ProcessHashTableProbe<JoinOpType>::_pre_serialize_key(
     }
 }
 
+template <int JoinOpType>
+template <typename HashTableType, typename KeyGetter>
+void ProcessHashTableProbe<JoinOpType>::_compute_probe_side_hash_values(
+        HashTableType& hash_table_ctx, KeyGetter& key_getter, size_t probe_rows) {
+    SCOPED_TIMER(_probe_side_compute_hash_timer);
+    // Hash the whole probe block in one tight pass, so the probe loop below only has to do
+    // the bucket lookups and can prefetch the bucket of a row PREFETCH_STEP ahead without
+    // hashing its key a second time.
+    _probe_side_hash_values.resize(probe_rows);
+    for (size_t k = 0; k < probe_rows; ++k) {
+        if constexpr (ColumnsHashing::IsPreSerializedKeysHashMethodTraits<KeyGetter>::value) {
+            _probe_side_hash_values[k] =
+                    hash_table_ctx.hash_table.hash(key_getter.get_key_holder(k, *_arena).key);
+        } else {
+            _probe_side_hash_values[k] =
+                    hash_table_ctx.hash_table.hash(key_getter.get_key_holder(k, *_arena));
+        }
+    }
+}
+
 template <int JoinOpType>
 template <bool need_null_map_for_probe, bool ignore_null, typename HashTableType>
 Status ProcessHashTableProbe<JoinOpType>::do_process(HashTableType& hash_table_ctx,
@@ -237,6 +258,10 @@ Status ProcessHashTableProbe<JoinOpType>::do_process(HashTableType& hash_table_c
         key_getter.set_serialized_keys(_probe_keys.data());
     }
 
+    if (probe_index == 0) {
+        _compute_probe_side_hash_values(hash_table_ctx, key_getter, probe_rows);
+    }
+
     auto& mcol = mutable_block.mutable_columns();
     int current_offset = 0;
 
@@ -305,18 +330,25 @@ Status ProcessHashTableProbe<JoinOpType>::do_process(HashTableType& hash_table_c
                     }
                 }
                 int last_offset = current_offset;
-                auto find_result = !need_null_map_for_probe
-                                           ? key_getter.find_key(hash_table_ctx.hash_table,
-                                                                 probe_index, *_arena)
-                                   : (*null_map)[probe_index]
-                                           ? decltype(key_getter.find_key(hash_table_ctx.hash_table,
-                                                                          probe_index,
-                                                                          *_arena)) {nullptr, false}
-                                           : key_getter.find_key(hash_table_ctx.hash_table,
-                                                                 probe_index, *_arena);
+                auto find_result =
+                        !need_null_map_for_probe
+                                ? key_getter.find_key_with_hash(
+                                          hash_table_ctx.hash_table,
+                                          _probe_side_hash_values[probe_index], probe_index,
+                                          *_arena)
+                        : (*null_map)[probe_index]
+                                ? decltype(key_getter.find_key_with_hash(
+                                          hash_table_ctx.hash_table,
+                                          _probe_side_hash_values[probe_index], probe_index,
+                                          *_arena)) {nullptr, false}
+                                : key_getter.find_key_with_hash(
+                                          hash_table_ctx.hash_table,
+                                          _probe_side_hash_values[probe_index], probe_index,
+                                          *_arena);
                 if (probe_index + PREFETCH_STEP < probe_rows) {
-                    key_getter.template prefetch<true>(hash_table_ctx.hash_table,
-                                                       probe_index + PREFETCH_STEP, *_arena);
+                    key_getter.template prefetch_by_hash<true>(
+                            hash_table_ctx.hash_table,
+                            _probe_side_hash_values[probe_index + PREFETCH_STEP]);
                 }
 
                 auto current_probe_index = probe_index;
@@ -478,6 +510,10 @@ Status ProcessHashTableProbe<JoinOpType>::do_process_with_other_join_conjuncts(
             key_getter.set_serialized_keys(_probe_keys.data());
         }
 
+        if (probe_index == 0) {
+            _compute_probe_side_hash_values(hash_table_ctx, key_getter, probe_rows);
+        }
+
         int right_col_idx = _join_node->_left_table_data_types.size();
         int right_col_len = _join_node->_right_table_data_types.size();
 
@@ -564,18 +600,25 @@ Status ProcessHashTableProbe<JoinOpType>::do_process_with_other_join_conjuncts(
                 }
 
                 auto last_offset = current_offset;
-                auto find_result = !need_null_map_for_probe
-                                           ? key_getter.find_key(hash_table_ctx.hash_table,
-                                                                 probe_index, *_arena)
-                                   : (*null_map)[probe_index]
-                                           ? decltype(key_getter.find_key(hash_table_ctx.hash_table,
-                                                                          probe_index,
-                                                                          *_arena)) {nullptr, false}
-                                           : key_getter.find_key(hash_table_ctx.hash_table,
-                                                                 probe_index, *_arena);
+                auto find_result =
+                        !need_null_map_for_probe
+                                ? key_getter.find_key_with_hash(
+                                          hash_table_ctx.hash_table,
+                                          _probe_side_hash_values[probe_index], probe_index,
+                                          *_arena)
+                        : (*null_map)[probe_index]
+                                ? decltype(key_getter.find_key_with_hash(
+                                          hash_table_ctx.hash_table,
+                                          _probe_side_hash_values[probe_index], probe_index,
+                                          *_arena)) {nullptr, false}
+                                : key_getter.find_key_with_hash(
+                                          hash_table_ctx.hash_table,
+                                          _probe_side_hash_values[probe_index], probe_index,
+                                          *_arena);
                 if (probe_index + PREFETCH_STEP < probe_rows) {
-                    key_getter.template prefetch<true>(hash_table_ctx.hash_table,
-                                                       probe_index + PREFETCH_STEP, *_arena);
+                    key_getter.template prefetch_by_hash<true>(
+                            hash_table_ctx.hash_table,
+                            _probe_side_hash_values[probe_index + PREFETCH_STEP]);
                 }
 
                 auto current_probe_index = probe_index;
@@ -43,8 +43,11 @@
 #include "exprs/runtime_filter.h"
 #include "exprs/runtime_filter_slots.h"
 #include "gutil/strings/substitute.h"
+#include "runtime/block_spill_manager.h"
 #include "runtime/define_primitive_type.h"
 #include "runtime/descriptors.h"
+#include "runtime/exec_env.h"
+#include "runtime/memory/mem_tracker_limiter.h"
 #include "runtime/query_context.h"
 #include "runtime/runtime_filter_mgr.h"
 #include "runtime/runtime_state.h"
@@ -437,6 +440,12 @@ Status HashJoinNode::prepare(RuntimeState* state) {
             runtime_profile()->add_info_string("ShareHashTableEnabled", "false");
         }
     }
+    // The build side of broadcast join may be shared by other instances, and null aware left anti
+    // join / mark join need to know whether there is null in the whole build side, so they could
+    // not be joined partition by partition.
+    _can_spill = state->enable_join_spill() && !_is_broadcast_join && !_is_mark_join &&
+                 _join_op != TJoinOp::NULL_AWARE_LEFT_ANTI_JOIN &&
+                 _join_op != TJoinOp::CROSS_JOIN;
 
     _memory_usage_counter = ADD_LABEL_COUNTER(runtime_profile(), "MemoryUsage");
 
@@ -473,6 +482,8 @@ Status HashJoinNode::prepare(RuntimeState* state) {
             ADD_CHILD_TIMER(probe_phase_profile, "ProbeWhenProbeSideOutputTime", "ProbeTime");
     _probe_process_hashtable_timer =
             ADD_CHILD_TIMER(probe_phase_profile, "ProbeWhenProcessHashTableTime", "ProbeTime");
+    _probe_side_compute_hash_timer =
+            ADD_CHILD_TIMER(probe_phase_profile, "ProbeSideHashComputingTime", "ProbeTime");
     _open_timer = ADD_TIMER(runtime_profile(), "OpenTime");
     _allocate_resource_timer = ADD_TIMER(runtime_profile(), "AllocateResourceTime");
     _process_other_join_conjunct_timer = ADD_TIMER(runtime_profile(), "OtherJoinConjunctTime");
@@ -530,6 +541,10 @@ Status HashJoinNode::close(RuntimeState* state) {
 }
 
 bool HashJoinNode::need_more_input_data() const {
+    if (_spill_context) {
+        // After all probe rows are spilled, probe blocks are read from the spill files.
+        return !_spill_context->probe_input_eos;
+    }
     return (_probe_block.rows() == 0 || _probe_index == _probe_block.rows()) && !_probe_eos &&
            !_short_circuit_for_probe;
 }
@@ -541,11 +556,20 @@ void HashJoinNode::prepare_for_next() {
 
 Status HashJoinNode::pull(doris::RuntimeState* state, vectorized::Block* output_block, bool* eos) {
     SCOPED_TIMER(_probe_timer);
-    if (_short_circuit_for_probe) {
+    if (_spill_context) {
+        RETURN_IF_ERROR(_pull_spilled_partitions(state, output_block, eos));
+    } else if (_short_circuit_for_probe) {
         // If we use a short-circuit strategy, should return empty block directly.
         *eos = true;
         return Status::OK();
+    } else {
+        RETURN_IF_ERROR(_probe_hash_table(state, output_block, eos));
     }
+    reached_limit(output_block, eos);
+    return Status::OK();
+}
+
+Status HashJoinNode::_probe_hash_table(RuntimeState* state, Block* output_block, bool* eos) {
     _join_block.clear_column_data();
 
     MutableBlock mutable_join_block(&_join_block);
@@ -636,41 +660,59 @@ Status HashJoinNode::pull(doris::RuntimeState* state, vectorized::Block* output_
 
     RETURN_IF_ERROR(_build_output_block(&temp_block, output_block, false));
     _reset_tuple_is_null_column();
-    reached_limit(output_block, eos);
     return Status::OK();
 }
 
-Status HashJoinNode::push(RuntimeState* /*state*/, vectorized::Block* input_block, bool eos) {
+Status HashJoinNode::push(RuntimeState* state, vectorized::Block* input_block, bool eos) {
+    if (_spill_context) {
+        DCHECK(!_spill_context->probe_input_eos);
+        DCHECK(!_spill_context->io_running);
+        RETURN_IF_ERROR(_spill_context->io_status);
+        if (input_block->rows() > 0) {
+            RETURN_IF_ERROR(_spill_partition_block(state, *input_block, false));
+        }
+        RETURN_IF_ERROR(_flush_spill_partitions(state, false, eos));
+        // The spill files are opened for reading by the flush, `pull` waits for it if it is
+        // running in the spill io thread pool.
+        _spill_context->probe_input_eos = eos;
+        return Status::OK();
+    }
+
     _probe_eos = eos;
     if (input_block->rows() > 0) {
-        COUNTER_UPDATE(_probe_rows_counter, input_block->rows());
-        int probe_expr_ctxs_sz = _probe_expr_ctxs.size();
-        _probe_columns.resize(probe_expr_ctxs_sz);
+        RETURN_IF_ERROR(_push_probe_block(input_block));
+    }
+    return Status::OK();
+}
 
-        std::vector<int> res_col_ids(probe_expr_ctxs_sz);
-        RETURN_IF_ERROR(
-                _do_evaluate(*input_block, _probe_expr_ctxs, *_probe_expr_call_timer, res_col_ids));
-        if (_join_op == TJoinOp::RIGHT_OUTER_JOIN || _join_op == TJoinOp::FULL_OUTER_JOIN) {
-            _probe_column_convert_to_null = _convert_block_to_null(*input_block);
-        }
-        // TODO: Now we are not sure whether a column is nullable only by ExecNode's `row_desc`
-        //  so we have to initialize this flag by the first probe block.
-        if (!_has_set_need_null_map_for_probe) {
-            _has_set_need_null_map_for_probe = true;
-            _need_null_map_for_probe = _need_probe_null_map(*input_block, res_col_ids);
-        }
-        if (_need_null_map_for_probe) {
-            if (_null_map_column == nullptr) {
-                _null_map_column = ColumnUInt8::create();
-            }
-            _null_map_column->get_data().assign(input_block->rows(), (uint8_t)0);
-        }
+Status HashJoinNode::_push_probe_block(Block* input_block) {
+    COUNTER_UPDATE(_probe_rows_counter, input_block->rows());
+    int probe_expr_ctxs_sz = _probe_expr_ctxs.size();
+    _probe_columns.resize(probe_expr_ctxs_sz);
 
-        RETURN_IF_ERROR(_extract_join_column<false>(*input_block, _null_map_column, _probe_columns,
-                                                    res_col_ids));
-        if (&_probe_block != input_block) {
-            input_block->swap(_probe_block);
+    std::vector<int> res_col_ids(probe_expr_ctxs_sz);
+    RETURN_IF_ERROR(
+            _do_evaluate(*input_block, _probe_expr_ctxs, *_probe_expr_call_timer, res_col_ids));
+    if (_join_op == TJoinOp::RIGHT_OUTER_JOIN || _join_op == TJoinOp::FULL_OUTER_JOIN) {
+        _probe_column_convert_to_null = _convert_block_to_null(*input_block);
+    }
+    // TODO: Now we are not sure whether a column is nullable only by ExecNode's `row_desc`
+    //  so we have to initialize this flag by the first probe block.
+    if (!_has_set_need_null_map_for_probe) {
+        _has_set_need_null_map_for_probe = true;
+        _need_null_map_for_probe = _need_probe_null_map(*input_block, res_col_ids);
+    }
+    if (_need_null_map_for_probe) {
+        if (_null_map_column == nullptr) {
+            _null_map_column = ColumnUInt8::create();
         }
+        _null_map_column->get_data().assign(input_block->rows(), (uint8_t)0);
+    }
+
+    RETURN_IF_ERROR(_extract_join_column<false>(*input_block, _null_map_column, _probe_columns,
+                                                res_col_ids));
+    if (&_probe_block != input_block) {
+        input_block->swap(_probe_block);
     }
     return Status::OK();
 }
@@ -684,7 +726,8 @@ Status HashJoinNode::get_next(RuntimeState* state, Block* output_block, bool* eo
         return Status::OK();
     }
 
-    if (_join_op == TJoinOp::RIGHT_OUTER_JOIN) {
+    // When spilled, the hash table is built partition by partition after all probe rows are read.
+    if (_join_op == TJoinOp::RIGHT_OUTER_JOIN && !_spill_context) {
         const auto hash_table_empty = std::visit(
                 Overload {[&](std::monostate&) -> bool {
                               LOG(FATAL) << "FATAL: uninited hash table";
@@ -822,60 +865,78 @@ Status HashJoinNode::_materialize_build_side(RuntimeState* state) {
     return Status::OK();
 }
 
-Status HashJoinNode::sink(doris::RuntimeState* state, vectorized::Block* in_block, bool eos) {
-    SCOPED_TIMER(_build_timer);
-
+Status HashJoinNode::_append_build_side_block(RuntimeState* state, Block* block, bool eos) {
     // make one block for each 4 gigabytes
     constexpr static auto BUILD_BLOCK_MAX_SIZE = 4 * 1024UL * 1024UL * 1024UL;
 
-    if (_short_circuit_for_null_in_probe_side) {
-        // TODO: if _short_circuit_for_null_in_probe_side is true we should finish current pipeline task.
-        DCHECK(state->enable_pipeline_exec());
-        return Status::OK();
+    _build_side_mem_used += block->allocated_bytes();
+
+    if (block->rows() != 0) {
+        SCOPED_TIMER(_build_side_merge_block_timer);
+        RETURN_IF_ERROR(_build_side_mutable_block.merge(*block));
     }
-    if (_should_build_hash_table) {
-        // If eos or have already met a null value using short-circuit strategy, we do not need to pull
-        // data from probe side.
-        _build_side_mem_used += in_block->allocated_bytes();
 
-        if (in_block->rows() != 0) {
-            SCOPED_TIMER(_build_side_merge_block_timer);
-            RETURN_IF_ERROR(_build_side_mutable_block.merge(*in_block));
+    if (UNLIKELY(_build_side_mem_used - _build_side_last_mem_used > BUILD_BLOCK_MAX_SIZE)) {
+        if (_build_blocks->size() == _MAX_BUILD_BLOCK_COUNT) {
+            return Status::NotSupported(
+                    strings::Substitute("data size of right table in hash join > $0",
+                                        BUILD_BLOCK_MAX_SIZE * _MAX_BUILD_BLOCK_COUNT));
         }
+        _build_blocks->emplace_back(_build_side_mutable_block.to_block());
 
-        if (UNLIKELY(_build_side_mem_used - _build_side_last_mem_used > BUILD_BLOCK_MAX_SIZE)) {
-            if (_build_blocks->size() == _MAX_BUILD_BLOCK_COUNT) {
-                return Status::NotSupported(
-                        strings::Substitute("data size of right table in hash join > $0",
-                                            BUILD_BLOCK_MAX_SIZE * _MAX_BUILD_BLOCK_COUNT));
-            }
-            _build_blocks->emplace_back(_build_side_mutable_block.to_block());
+        COUNTER_UPDATE(_build_blocks_memory_usage, (*_build_blocks)[_build_block_idx].bytes());
 
-            COUNTER_UPDATE(_build_blocks_memory_usage, (*_build_blocks)[_build_block_idx].bytes());
+        // TODO:: Rethink may we should do the process after we receive all build blocks ?
+        // which is better.
+        RETURN_IF_ERROR(_process_build_block(state, (*_build_blocks)[_build_block_idx],
+                                             _build_block_idx));
 
-            // TODO:: Rethink may we should do the process after we receive all build blocks ?
-            // which is better.
-            RETURN_IF_ERROR(_process_build_block(state, (*_build_blocks)[_build_block_idx],
-                                                 _build_block_idx));
+        _build_side_mutable_block = MutableBlock();
+        ++_build_block_idx;
+        _build_side_last_mem_used = _build_side_mem_used;
+    }
 
-            _build_side_mutable_block = MutableBlock();
-            ++_build_block_idx;
-            _build_side_last_mem_used = _build_side_mem_used;
+    if (eos && !_build_side_mutable_block.empty()) {
+        if (_build_blocks->size() == _MAX_BUILD_BLOCK_COUNT) {
+            return Status::NotSupported(
+                    strings::Substitute("data size of right table in hash join > $0",
+                                        BUILD_BLOCK_MAX_SIZE * _MAX_BUILD_BLOCK_COUNT));
         }
+        _build_blocks->emplace_back(_build_side_mutable_block.to_block());
+        COUNTER_UPDATE(_build_blocks_memory_usage, (*_build_blocks)[_build_block_idx].bytes());
+        RETURN_IF_ERROR(_process_build_block(state, (*_build_blocks)[_build_block_idx],
+                                             _build_block_idx));
     }
+    return Status::OK();
+}
 
-    if (_should_build_hash_table && eos) {
-        if (!_build_side_mutable_block.empty()) {
-            if (_build_blocks->size() == _MAX_BUILD_BLOCK_COUNT) {
-                return Status::NotSupported(
-                        strings::Substitute("data size of right table in hash join > $0",
-                                            BUILD_BLOCK_MAX_SIZE * _MAX_BUILD_BLOCK_COUNT));
+Status HashJoinNode::sink(doris::RuntimeState* state, vectorized::Block* in_block, bool eos) {
+    SCOPED_TIMER(_build_timer);
+
+    if (_short_circuit_for_null_in_probe_side) {
+        // TODO: if _short_circuit_for_null_in_probe_side is true we should finish current pipeline task.
+        DCHECK(state->enable_pipeline_exec());
+        return Status::OK();
+    }
+    if (_should_build_hash_table) {
+        // If eos or have already met a null value using short-circuit strategy, we do not need to pull
+        // data from probe side.
+        if (_spill_context) {
+            DCHECK(!_spill_context->io_running);
+            RETURN_IF_ERROR(_spill_context->io_status);
+            RETURN_IF_ERROR(_spill_partition_block(state, *in_block, true));
+            RETURN_IF_ERROR(_flush_spill_partitions(state, true, eos));
+        } else {
+            RETURN_IF_ERROR(_append_build_side_block(state, in_block, eos));
+            if (!eos && _should_spill_build_side(state)) {
+                RETURN_IF_ERROR(_spill_build_side(state));
             }
-            _build_blocks->emplace_back(_build_side_mutable_block.to_block());
-            COUNTER_UPDATE(_build_blocks_memory_usage, (*_build_blocks)[_build_block_idx].bytes());
-            RETURN_IF_ERROR(_process_build_block(state, (*_build_blocks)[_build_block_idx],
-                                                 _build_block_idx));
         }
+    }
+
+    if (_should_build_hash_table && eos && _spill_context) {
+        RETURN_IF_ERROR(_ignore_runtime_filters(state));
+    } else if (_should_build_hash_table && eos) {
         auto ret = std::visit(Overload {[&](std::monostate&) -> Status {
                                             LOG(FATAL) << "FATAL: uninited hash table";
                                             __builtin_unreachable();
@@ -960,8 +1021,398 @@ Status HashJoinNode::sink(doris::RuntimeState* state, vectorized::Block* in_bloc
     if (!_build_blocks->empty() && _join_op == TJoinOp::NULL_AWARE_LEFT_ANTI_JOIN) {
         _probe_ignore_null = true;
     }
-    _init_short_circuit_for_probe();
+    if (_spill_context) {
+        // The build side is empty only in the partition being joined, not in the whole join.
+        _short_circuit_for_probe = false;
+    } else {
+        _init_short_circuit_for_probe();
+    }
+
+    return Status::OK();
+}
+
+bool HashJoinNode::_should_spill_build_side(RuntimeState* state) const {
+    if (!_can_spill) {
+        return false;
+    }
+    auto query_mem_tracker = state->query_mem_tracker();
+    if (query_mem_tracker == nullptr || !query_mem_tracker->has_limit()) {
+        return false;
+    }
+    return query_mem_tracker->consumption() >=
+           query_mem_tracker->limit() / 100 * config::hash_join_spill_mem_limit_percent;
+}
+
+Status HashJoinNode::_spill_build_side(RuntimeState* state) {
+    DCHECK(_spill_context == nullptr);
+    _spill_context = std::make_unique<HashJoinSpillContext>(state->external_join_partition_bits());
+    _spill_context->async_io = state->enable_pipeline_exec();
+    // All spill files of the join are in the same data dir, so that the spill io of it runs in
+    // one io thread pool one task at a time.
+    _spill_context->data_dir_index = ExecEnv::GetInstance()->block_spill_mgr()->select_data_dir();
+    auto* spill_profile = _runtime_profile->create_child("Spill", true, true);
+    _spill_context->runtime_profile = spill_profile;
+    _spill_context->build_rows_counter =
+            ADD_COUNTER(spill_profile, "SpilledBuildRows", TUnit::UNIT);
+    _spill_context->probe_rows_counter =
+            ADD_COUNTER(spill_profile, "SpilledProbeRows", TUnit::UNIT);
+    _spill_context->partition_timer = ADD_TIMER(spill_profile, "PartitionTime");
+    runtime_profile()->add_info_string("GraceHashJoin", "true");
+    runtime_profile()->add_info_string("SpillPartitions",
+                                       std::to_string(_spill_context->partition_count));
+
+    for (auto& block : *_build_blocks) {
+        RETURN_IF_ERROR(_spill_partition_block(state, block, true));
+    }
+    if (!_build_side_mutable_block.empty()) {
+        auto block = _build_side_mutable_block.to_block();
+        RETURN_IF_ERROR(_spill_partition_block(state, block, true));
+    }
+    _reset_hash_table(state);
+    return _flush_spill_partitions(state, true, false);
+}
+
+Status HashJoinNode::_spill_partition_block(RuntimeState* state, Block& block,
+                                            bool is_build_side) {
+    auto& spill_context = *_spill_context;
+    SCOPED_TIMER(spill_context.partition_timer);
+    const size_t rows = block.rows();
+    if (rows == 0) {
+        return Status::OK();
+    }
+
+    // `_process_build_block` may have appended the result columns of build exprs to the block.
+    const size_t origin_columns =
+            is_build_side ? _right_table_data_types.size() : _left_table_data_types.size();
+    auto& exprs = is_build_side ? _build_expr_ctxs : _probe_expr_ctxs;
+    std::vector<int> res_col_ids(exprs.size());
+    RETURN_IF_ERROR(_do_evaluate(block, exprs,
+                                 is_build_side ? *_build_expr_call_timer : *_probe_expr_call_timer,
+                                 res_col_ids));
+
+    // Nullable and not nullable join columns get the same hash value for the same not null value,
+    // so the rows which could be joined always fall into the same partition.
+    std::vector<uint64_t> hash_values(rows, 0);
+    for (auto col_id : res_col_ids) {
+        block.get_by_position(col_id).column->update_hashes_with_value(hash_values.data());
+    }
+    block.erase_tail(origin_columns);
+    if (is_build_side &&
+        (_join_op == TJoinOp::LEFT_OUTER_JOIN || _join_op == TJoinOp::FULL_OUTER_JOIN)) {
+        // keep the column types same as the build blocks converted in `_process_build_block`
+        _convert_block_to_null(block);
+    }
+
+    std::vector<std::vector<int>> partition_rows(spill_context.partition_count);
+    for (int i = 0; i < rows; ++i) {
+        partition_rows[spill_context.get_partition_index(hash_values[i])].push_back(i);
+    }
+
+    auto& buffers = is_build_side ? spill_context.build_buffers : spill_context.probe_buffers;
+    for (size_t i = 0; i < spill_context.partition_count; ++i) {
+        const auto& indices = partition_rows[i];
+        if (indices.empty()) {
+            continue;
+        }
+        if (buffers[i].columns() == 0) {
+            buffers[i] = MutableBlock(block.clone_empty());
+        }
+        RETURN_IF_CATCH_EXCEPTION(
+                buffers[i].add_rows(&block, indices.data(), indices.data() + indices.size()));
+    }
+    COUNTER_UPDATE(is_build_side ? spill_context.build_rows_counter
+                                 : spill_context.probe_rows_counter,
+                   rows);
+    return Status::OK();
+}
+
+Status HashJoinNode::_flush_spill_partitions(RuntimeState* state, bool is_build_side,
+                                             bool eos) {
+    auto& spill_context = *_spill_context;
+    auto& buffers = is_build_side ? spill_context.build_buffers : spill_context.probe_buffers;
+    std::vector<std::pair<size_t, Block>> blocks;
+    for (size_t i = 0; i < spill_context.partition_count; ++i) {
+        auto& buffer = buffers[i];
+        if (buffer.rows() == 0 || (!eos && buffer.rows() < state->batch_size())) {
+            continue;
+        }
+        blocks.emplace_back(i, buffer.to_block());
+        buffer = MutableBlock();
+    }
+    if (blocks.empty() && !eos) {
+        return Status::OK();
+    }
 
+    if (!spill_context.async_io) {
+        RETURN_IF_ERROR(spill_context.write_blocks(is_build_side, blocks, eos));
+        if (!is_build_side && eos) {
+            RETURN_IF_ERROR(spill_context.prepare_for_reading());
+        }
+        return Status::OK();
+    }
+
+    auto spill_blocks = std::make_shared<std::vector<std::pair<size_t, Block>>>(std::move(blocks));
+    return _submit_spill_io(state, [this, spill_blocks, is_build_side, eos]() {
+        RETURN_IF_ERROR(_spill_context->write_blocks(is_build_side, *spill_blocks, eos));
+        spill_blocks->clear();
+        if (!is_build_side && eos) {
+            RETURN_IF_ERROR(_spill_context->prepare_for_reading());
+        }
+        return Status::OK();
+    });
+}
+
+Status HashJoinNode::_submit_spill_io(RuntimeState* state, std::function<Status()> io_func) {
+    auto& spill_context = *_spill_context;
+    DCHECK(!spill_context.io_running);
+    spill_context.io_running = true;
+    auto st = ExecEnv::GetInstance()->block_spill_mgr()->submit_io(
+            spill_context.data_dir_index, [this, state, io_func = std::move(io_func)]() mutable {
+                SCOPED_ATTACH_TASK(state);
+                _spill_context->io_status = io_func();
+                // release the resources captured by `io_func` with the query mem tracker
+                io_func = nullptr;
+                _spill_context->io_running = false;
+            });
+    if (!st.ok()) {
+        spill_context.io_running = false;
+    }
+    return st;
+}
+
+Status HashJoinNode::_load_spilled_partition(RuntimeState* state, bool* ready) {
+    auto& spill_context = *_spill_context;
+    std::vector<Block> blocks;
+    if (spill_context.async_io) {
+        if (!spill_context.build_read_blocks_ready) {
+            *ready = false;
+            return _submit_spill_io(state, [this]() {
+                RETURN_IF_ERROR(_spill_context->read_build_blocks(
+                        _spill_context->build_read_blocks));
+                _spill_context->build_read_blocks_ready = true;
+                return Status::OK();
+            });
+        }
+        blocks.swap(spill_context.build_read_blocks);
+        spill_context.build_read_blocks_ready = false;
+    } else {
+        RETURN_IF_ERROR(spill_context.read_build_blocks(blocks));
+    }
+
+    _reset_hash_table(state);
+    for (size_t i = 0; i < blocks.size(); ++i) {
+        RETURN_IF_CANCELLED(state);
+        RETURN_IF_ERROR(_append_build_side_block(state, &blocks[i], i + 1 == blocks.size()));
+        Block().swap(blocks[i]);
+
+        // A partition is not partitioned again, so the join fails if the build side of one
+        // partition still could not fit into memory.
+        auto query_mem_tracker = state->query_mem_tracker();
+        if (query_mem_tracker != nullptr && query_mem_tracker->has_limit() &&
+            query_mem_tracker->consumption() > query_mem_tracker->limit()) {
+            return Status::MemoryLimitExceeded(
+                    "the build side of spilled partition {} of hash join(id {}) exceeds the "
+                    "memory limit {} of query, try a larger external_join_partition_bits",
+                    spill_context.partition_cursor, id(), query_mem_tracker->limit());
+        }
+    }
+    _process_hashtable_ctx_variants_init(state);
+
+    _probe_eos = false;
+    prepare_for_next();
+    spill_context.partition_loaded = true;
+    *ready = true;
+    return Status::OK();
+}
+
+Status HashJoinNode::_read_spilled_probe_block(RuntimeState* state, bool* ready) {
+    // the number of probe blocks read ahead by one async spill io task
+    constexpr static size_t PROBE_READ_AHEAD_BLOCKS = 8;
+
+    auto& spill_context = *_spill_context;
+    *ready = true;
+    if (!spill_context.probe_readers[spill_context.partition_cursor]) {
+        _probe_eos = true;
+        return Status::OK();
+    }
+
+    Block block;
+    if (spill_context.async_io) {
+        if (spill_context.probe_read_blocks.empty() && !spill_context.probe_read_eos) {
+            *ready = false;
+            return _submit_spill_io(state, [this]() {
+                return _spill_context->read_probe_blocks(PROBE_READ_AHEAD_BLOCKS);
+            });
+        }
+        if (!spill_context.probe_read_blocks.empty()) {
+            block.swap(spill_context.probe_read_blocks.front());
+            spill_context.probe_read_blocks.pop_front();
+        }
+        _probe_eos = spill_context.probe_read_blocks.empty() && spill_context.probe_read_eos;
+    } else {
+        RETURN_IF_ERROR(spill_context.probe_readers[spill_context.partition_cursor]->read(
+                &block, &_probe_eos));
+    }
+    if (block.rows() > 0) {
+        RETURN_IF_ERROR(_push_probe_block(&block));
+    }
+    return Status::OK();
+}
+
+Status HashJoinNode::_pull_spilled_partitions(RuntimeState* state, Block* output_block,
+                                              bool* eos) {
+    auto& spill_context = *_spill_context;
+    DCHECK(spill_context.probe_input_eos);
+    while (spill_context.partition_cursor < spill_context.partition_count) {
+        RETURN_IF_CANCELLED(state);
+        if (spill_context.io_running) {
+            // The pipeline task is blocked by `is_spill_io_running()` until the io finishes.
+            return Status::OK();
+        }
+        RETURN_IF_ERROR(spill_context.io_status);
+
+        bool ready = true;
+        if (!spill_context.partition_loaded) {
+            RETURN_IF_ERROR(_load_spilled_partition(state, &ready));
+            if (!ready) {
+                return Status::OK();
+            }
+        }
+
+        if (!_probe_eos && (_probe_block.rows() == 0 || _probe_index == _probe_block.rows())) {
+            prepare_for_next();
+            RETURN_IF_ERROR(_read_spilled_probe_block(state, &ready));
+            if (!ready) {
+                return Status::OK();
+            }
+            continue;
+        }
+
+        bool partition_eos = false;
+        RETURN_IF_ERROR(_probe_hash_table(state, output_block, &partition_eos));
+        if (partition_eos) {
+            auto& probe_reader = spill_context.probe_readers[spill_context.partition_cursor];
+            if (probe_reader) {
+                RETURN_IF_ERROR(probe_reader->close());
+                probe_reader.reset();
+            }
+            spill_context.probe_read_eos = false;
+            spill_context.partition_loaded = false;
+            ++spill_context.partition_cursor;
+        }
+        if (output_block->rows() > 0) {
+            return Status::OK();
+        }
+    }
+    *eos = true;
+    return Status::OK();
+}
+
+void HashJoinNode::_reset_hash_table(RuntimeState* state) {
+    _hash_table_variants = std::make_shared<HashTableVariants>();
+    _hash_table_init(state);
+    _arena = std::make_shared<Arena>();
+    _build_blocks->clear();
+    _inserted_rows.clear();
+    _build_block_idx = 0;
+    _build_side_mem_used = 0;
+    _build_side_last_mem_used = 0;
+    _build_side_mutable_block = MutableBlock();
+    _build_bf_cardinality = 0;
+    // Spilled build blocks of outer join have been converted to nullable, so the null flags of
+    // build side should be decided again by the loaded blocks.
+    _has_set_need_null_map_for_build = false;
+}
+
+Status HashJoinNode::_ignore_runtime_filters(RuntimeState* state) {
+    for (auto* runtime_filter : _runtime_filters) {
+        runtime_filter->set_ignored();
+        if (runtime_filter->has_remote_target()) {
+            std::string msg = fmt::format(
+                    "fragment instance {} ignore runtime filter(id {}) because: hash join "
+                    "build side is spilled",
+                    print_id(state->fragment_instance_id()), runtime_filter->filter_id());
+            runtime_filter->set_ignored_msg(msg);
+            RETURN_IF_ERROR(runtime_filter->publish());
+            continue;
+        }
+        std::vector<IRuntimeFilter*> consumers;
+        RETURN_IF_ERROR(state->runtime_filter_mgr()->get_consume_filters(
+                runtime_filter->filter_id(), consumers));
+        for (auto* consumer : consumers) {
+            consumer->set_ignored();
+            consumer->signal();
+        }
+    }
+    return Status::OK();
+}
+
+Status HashJoinSpillContext::write_blocks(bool is_build_side,
+                                          std::vector<std::pair<size_t, Block>>& blocks, bool eos) {
+    auto& writers = is_build_side ? build_writers : probe_writers;
+    for (auto& [partition_index, block] : blocks) {
+        auto& writer = writers[partition_index];
+        if (!writer) {
+            RETURN_IF_ERROR(ExecEnv::GetInstance()->block_spill_mgr()->get_writer(
+                    data_dir_index, std::numeric_limits<int32_t>::max(), writer,
+                    runtime_profile));
+        }
+        RETURN_IF_ERROR(writer->write(block));
+    }
+    if (eos) {
+        for (auto& writer : writers) {
+            if (writer) {
+                RETURN_IF_ERROR(writer->close());
+            }
+        }
+    }
+    return Status::OK();
+}
+
+Status HashJoinSpillContext::read_build_blocks(std::vector<Block>& blocks) {
+    auto& reader = build_readers[partition_cursor];
+    if (!reader) {
+        return Status::OK();
+    }
+    bool eos = false;
+    while (!eos) {
+        Block block;
+        RETURN_IF_ERROR(reader->read(&block, &eos));
+        blocks.emplace_back(std::move(block));
+    }
+    RETURN_IF_ERROR(reader->close());
+    reader.reset();
+    return Status::OK();
+}
+
+Status HashJoinSpillContext::read_probe_blocks(size_t max_blocks) {
+    auto& reader = probe_readers[partition_cursor];
+    for (size_t i = 0; i < max_blocks && !probe_read_eos; ++i) {
+        Block block;
+        RETURN_IF_ERROR(reader->read(&block, &probe_read_eos));
+        if (block.rows() > 0) {
+            probe_read_blocks.emplace_back(std::move(block));
+        }
+    }
+    return Status::OK();
+}
+
+Status HashJoinSpillContext::prepare_for_reading() {
+    auto* manager = ExecEnv::GetInstance()->block_spill_mgr();
+    build_readers.resize(partition_count);
+    probe_readers.resize(partition_count);
+    for (size_t i = 0; i != partition_count; ++i) {
+        if (build_writers[i]) {
+            RETURN_IF_ERROR(manager->get_reader(build_writers[i]->get_id(), build_readers[i],
+                                                runtime_profile, true));
+            build_writers[i].reset();
+        }
+        if (probe_writers[i]) {
+            RETURN_IF_ERROR(manager->get_reader(probe_writers[i]->get_id(), probe_readers[i],
+                                                runtime_profile, true));
+            probe_writers[i].reset();
+        }
+    }
     return Status::OK();
 }
 
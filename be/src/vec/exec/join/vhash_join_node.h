@@ -21,6 +21,9 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <atomic>
+#include <deque>
+#include <functional>
 #include <iosfwd>
 #include <memory>
 #include <string>
@@ -41,6 +44,8 @@
 #include "vec/common/hash_table/partitioned_hash_map.h"
 #include "vec/common/string_ref.h"
 #include "vec/core/block.h"
+#include "vec/core/block_spill_reader.h"
+#include "vec/core/block_spill_writer.h"
 #include "vec/core/types.h"
 #include "vec/exec/join/join_op.h" // IWYU pragma: keep
 #include "vec/exprs/vexpr_fwd.h"
@@ -218,6 +223,96 @@ using HashTableIteratorVariants =
         std::variant<std::monostate, ForwardIterator<RowRefList>,
                      ForwardIterator<RowRefListWithFlag>, ForwardIterator<RowRefListWithFlags>>;
 
+// Grace hash join: once the build side can not fit into memory, both build side and probe side
+// are partitioned by the hash of join keys into spill files, and then joined partition by partition.
+struct HashJoinSpillContext {
+    HashJoinSpillContext(size_t partition_count_bits_)
+            : partition_count_bits(partition_count_bits_),
+              partition_count(1 << partition_count_bits),
+              build_buffers(partition_count),
+              probe_buffers(partition_count),
+              build_writers(partition_count),
+              probe_writers(partition_count) {}
+
+    ~HashJoinSpillContext() {
+        for (auto& writer : build_writers) {
+            if (writer) {
+                writer->close();
+            }
+        }
+        for (auto& writer : probe_writers) {
+            if (writer) {
+                writer->close();
+            }
+        }
+        for (auto& reader : build_readers) {
+            if (reader) {
+                reader->close();
+            }
+        }
+        for (auto& reader : probe_readers) {
+            if (reader) {
+                reader->close();
+            }
+        }
+    }
+
+    size_t get_partition_index(uint64_t hash_value) const {
+        // The high bits are used here, because the low bits of the same hash function have been
+        // used by the data stream sender to shuffle rows into this instance.
+        return hash_value >> (64 - partition_count_bits);
+    }
+
+    Status prepare_for_reading();
+
+    // Write `blocks` (partition index, block) into the spill files of build or probe side. If
+    // `eos`, the writers of the side are closed.
+    Status write_blocks(bool is_build_side, std::vector<std::pair<size_t, Block>>& blocks,
+                        bool eos);
+
+    // Read all blocks of the build side of the partition at `partition_cursor`.
+    Status read_build_blocks(std::vector<Block>& blocks);
+
+    // Read at most `max_blocks` blocks of the probe side of the partition at `partition_cursor`
+    // into `probe_read_blocks`.
+    Status read_probe_blocks(size_t max_blocks);
+
+    const size_t partition_count_bits;
+    const size_t partition_count;
+
+    // When `async_io` is set(pipeline engine), the spill io runs in the spill io thread pool of
+    // `data_dir_index` instead of the pipeline worker threads,
+    // see `HashJoinNode::_submit_spill_io`.
+    bool async_io = false;
+    size_t data_dir_index = 0;
+    std::atomic<bool> io_running = false;
+    // status of the last finished async spill io task
+    Status io_status;
+    // blocks of the partition at `partition_cursor` read ahead by the async spill io task
+    std::vector<Block> build_read_blocks;
+    bool build_read_blocks_ready = false;
+    std::deque<Block> probe_read_blocks;
+    bool probe_read_eos = false;
+
+    // probe side input is finished and all probe rows have been written into spill files
+    bool probe_input_eos = false;
+    // the build side of the partition at `partition_cursor` has been loaded into hash table
+    bool partition_loaded = false;
+    size_t partition_cursor = 0;
+
+    std::vector<MutableBlock> build_buffers;
+    std::vector<MutableBlock> probe_buffers;
+    std::vector<BlockSpillWriterUPtr> build_writers;
+    std::vector<BlockSpillWriterUPtr> probe_writers;
+    std::vector<BlockSpillReaderUPtr> build_readers;
+    std::vector<BlockSpillReaderUPtr> probe_readers;
+
+    RuntimeProfile* runtime_profile = nullptr;
+    RuntimeProfile::Counter* build_rows_counter = nullptr;
+    RuntimeProfile::Counter* probe_rows_counter = nullptr;
+    RuntimeProfile::Counter* partition_timer = nullptr;
+};
+
 class HashJoinNode final : public VJoinNodeBase {
 public:
     // TODO: Best prefetch step is decided by machine. We should also provide a
@@ -254,6 +349,10 @@ public:
 
     bool should_build_hash_table() const { return _should_build_hash_table; }
 
+    bool is_spilled() const { return _spill_context != nullptr; }
+
+    bool is_spill_io_running() const { return _spill_context && _spill_context->io_running; }
+
     bool ready_for_finish() {
         if (_runtime_filter_slots == nullptr) {
             return true;
@@ -305,6 +404,7 @@ private:
     RuntimeProfile::Counter* _build_side_output_timer;
     RuntimeProfile::Counter* _probe_side_output_timer;
     RuntimeProfile::Counter* _probe_process_hashtable_timer;
+    RuntimeProfile::Counter* _probe_side_compute_hash_timer;
     RuntimeProfile::Counter* _build_side_compute_hash_timer;
     RuntimeProfile::Counter* _build_side_merge_block_timer;
     RuntimeProfile::Counter* _build_runtime_filter_timer;
@@ -366,10 +466,50 @@ private:
 
     SharedHashTableContextPtr _shared_hash_table_context = nullptr;
 
+    // whether this join could fall back to grace hash join when the memory is running out
+    bool _can_spill = false;
+    std::unique_ptr<HashJoinSpillContext> _spill_context;
+
     Status _materialize_build_side(RuntimeState* state) override;
 
     Status _process_build_block(RuntimeState* state, Block& block, uint8_t offset);
 
+    // Merge `block` into `_build_blocks` and insert the merged blocks into the hash table.
+    Status _append_build_side_block(RuntimeState* state, Block* block, bool eos);
+
+    Status _push_probe_block(Block* input_block);
+
+    Status _probe_hash_table(RuntimeState* state, Block* output_block, bool* eos);
+
+    bool _should_spill_build_side(RuntimeState* state) const;
+
+    // Move the build side in memory into spill files and switch to grace hash join.
+    Status _spill_build_side(RuntimeState* state);
+
+    // Partition `block` by the hash of join keys into the buffers of partitions.
+    Status _spill_partition_block(RuntimeState* state, Block& block, bool is_build_side);
+
+    // Write the full buffers of partitions, or all of them if `eos`, into spill files.
+    Status _flush_spill_partitions(RuntimeState* state, bool is_build_side, bool eos);
+
+    // Run `io_func` in the spill io thread pool of the data dir of spill files.
+    Status _submit_spill_io(RuntimeState* state, std::function<Status()> io_func);
+
+    // Rebuild the hash table with the build side of the current spilled partition. `ready` is
+    // false if the partition is being read by the spill io thread pool.
+    Status _load_spilled_partition(RuntimeState* state, bool* ready);
+
+    // Push the next probe block of the current spilled partition. `ready` is false if the
+    // probe blocks are being read by the spill io thread pool.
+    Status _read_spilled_probe_block(RuntimeState* state, bool* ready);
+
+    Status _pull_spilled_partitions(RuntimeState* state, Block* output_block, bool* eos);
+
+    void _reset_hash_table(RuntimeState* state);
+
+    // The runtime filters could not be generated from a partial build side.
+    Status _ignore_runtime_filters(RuntimeState* state);
+
     Status _do_evaluate(Block& block, VExprContextSPtrs& exprs,
                         RuntimeProfile::Counter& expr_call_timer, std::vector<int>& res_col_ids);
 
@@ -85,6 +85,19 @@ bool RuntimeFilterConsumer::runtime_filters_are_ready_or_timeout() {
     return true;
 }
 
+pipeline::WakeupDependency* RuntimeFilterConsumer::runtime_filter_dependency() {
+    if (!_blocked_by_rf) {
+        return nullptr;
+    }
+    for (size_t i = 0; i < _runtime_filter_descs.size(); ++i) {
+        IRuntimeFilter* runtime_filter = _runtime_filter_ctxs[i].runtime_filter;
+        if (!runtime_filter->is_ready_or_timeout()) {
+            return runtime_filter->dependency();
+        }
+    }
+    return nullptr;
+}
+
 Status RuntimeFilterConsumer::_acquire_runtime_filter() {
     SCOPED_TIMER(_acquire_runtime_filter_timer);
     VExprSPtrs vexprs;
@@ -37,6 +37,10 @@ public:
 
     bool runtime_filters_are_ready_or_timeout();
 
+    // The dependency of a runtime filter that is neither ready nor timed out, nullptr if there
+    // is none.
+    pipeline::WakeupDependency* runtime_filter_dependency();
+
 protected:
     // Register and get all runtime filters at Init phase.
     Status _register_runtime_filter();
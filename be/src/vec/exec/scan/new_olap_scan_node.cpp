@@ -156,6 +156,9 @@ Status NewOlapScanNode::_init_profile() {
 
     _total_pages_num_counter = ADD_COUNTER(_segment_profile, "TotalPagesNum", TUnit::UNIT);
     _cached_pages_num_counter = ADD_COUNTER(_segment_profile, "CachedPagesNum", TUnit::UNIT);
+    _prefetch_io_num_counter = ADD_COUNTER(_segment_profile, "PrefetchIONum", TUnit::UNIT);
+    _prefetched_pages_num_counter =
+            ADD_COUNTER(_segment_profile, "PrefetchedPagesNum", TUnit::UNIT);
 
     _bitmap_index_filter_counter =
             ADD_COUNTER(_segment_profile, "RowsBitmapIndexFiltered", TUnit::UNIT);
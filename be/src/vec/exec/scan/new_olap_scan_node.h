@@ -165,6 +165,10 @@ private:
     // page read from cache
     // used by segment v2
     RuntimeProfile::Counter* _cached_pages_num_counter = nullptr;
+    // merged page reads issued ahead of decoding, and the pages they read
+    // used by segment v2
+    RuntimeProfile::Counter* _prefetch_io_num_counter = nullptr;
+    RuntimeProfile::Counter* _prefetched_pages_num_counter = nullptr;
 
     // row count filtered by bitmap inverted index
     RuntimeProfile::Counter* _bitmap_index_filter_counter = nullptr;
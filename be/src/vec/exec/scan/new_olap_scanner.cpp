@@ -372,6 +372,16 @@ Status NewOlapScanner::_init_tablet_reader_params(
         _tablet_reader_params.use_page_cache = true;
     }
 
+    // A scan without key range reads the whole tablet, if the tablet is big, such scan
+    // should not flush the pages of other queries out of page cache.
+    if (config::page_cache_large_scan_rows > 0 && _tablet_reader_params.start_key.empty()) {
+        int64_t num_rows = 0;
+        for (auto& rs_split : _tablet_reader_params.rs_splits) {
+            num_rows += rs_split.rs_reader->rowset()->num_rows();
+        }
+        _tablet_reader_params.large_scan = num_rows >= config::page_cache_large_scan_rows;
+    }
+
     if (_tablet->enable_unique_key_merge_on_write() && !_state->skip_delete_bitmap()) {
         _tablet_reader_params.delete_bitmap = &_tablet->tablet_meta()->delete_bitmap();
     }
@@ -486,6 +496,12 @@ Status NewOlapScanner::close(RuntimeState* state) {
     // deconstructor in reader references runtime state
     // so that it will core
     _tablet_reader_params.rs_splits.clear();
+    if (_tablet_reader != nullptr) {
+        // feed the read amplification of this scan back to compaction scheduling
+        auto& stats = _tablet_reader->stats();
+        _tablet->update_read_amplification(stats.total_segment_number,
+                                           stats.merged_rowset_number);
+    }
     _tablet_reader.reset();
 
     RETURN_IF_ERROR(VScanner::close(state));
@@ -571,6 +587,8 @@ void NewOlapScanner::_update_counters_before_close() {
 
     COUNTER_UPDATE(olap_parent->_total_pages_num_counter, stats.total_pages_num);
     COUNTER_UPDATE(olap_parent->_cached_pages_num_counter, stats.cached_pages_num);
+    COUNTER_UPDATE(olap_parent->_prefetch_io_num_counter, stats.prefetch_io_num);
+    COUNTER_UPDATE(olap_parent->_prefetched_pages_num_counter, stats.prefetched_pages_num);
 
     COUNTER_UPDATE(olap_parent->_bitmap_index_filter_counter, stats.rows_bitmap_index_filtered);
     COUNTER_UPDATE(olap_parent->_bitmap_index_filter_timer, stats.bitmap_index_filter_timer);
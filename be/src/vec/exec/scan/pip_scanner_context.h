@@ -117,6 +117,7 @@ public:
             }
         }
         _current_used_bytes += local_bytes;
+        _dependency.notify();
     }
 
     bool empty_in_queue(int id) override { return _blocks_queues[id].size_approx() == 0; }
@@ -172,6 +172,7 @@ void ScannerContext::append_blocks_to_queue(std::vector<vectorized::BlockUPtr>&
     blocks.clear();
     _blocks_queue_added_cv.notify_one();
     _queued_blocks_memory_usage->add(_cur_bytes_in_queue - old_bytes_in_queue);
+    _dependency.notify();
 }
 
 bool ScannerContext::empty_in_queue(int id) {
@@ -236,6 +237,7 @@ bool ScannerContext::set_status_on_error(const Status& status, bool need_lock) {
         _status_error = true;
         _blocks_queue_added_cv.notify_one();
         _should_stop = true;
+        _dependency.notify();
         return true;
     }
     return false;
@@ -374,6 +376,7 @@ void ScannerContext::push_back_scanner_and_reschedule(VScannerSPtr scanner) {
     // In pipeline engine, doris will close scanners when `no_schedule`.
     _num_running_scanners--;
     _ctx_finish_cv.notify_one();
+    _dependency.notify();
 }
 
 void ScannerContext::get_next_batch_of_scanners(std::list<VScannerSPtr>* current_run) {
@@ -30,6 +30,7 @@
 #include "common/factory_creator.h"
 #include "common/status.h"
 #include "concurrentqueue.h"
+#include "pipeline/wakeup_dependency.h"
 #include "util/lock.h"
 #include "util/runtime_profile.h"
 #include "vec/core/block.h"
@@ -101,6 +102,7 @@ public:
         std::lock_guard l(_transfer_lock);
         _should_stop = true;
         _blocks_queue_added_cv.notify_one();
+        _dependency.notify();
     }
 
     // Return true if this ScannerContext need no more process
@@ -155,6 +157,9 @@ public:
 
     void reschedule_scanner_ctx();
 
+    // Notified when blocks are added to the queue, a scanner finishes or the context stops.
+    pipeline::WakeupDependency* dependency() { return &_dependency; }
+
     // the unique id of this context
     std::string ctx_id;
     int32_t queue_idx = -1;
@@ -187,6 +192,8 @@ protected:
     doris::ConditionVariable _blocks_queue_added_cv;
     // Wait in clear_and_join(), by ScanNode.
     doris::ConditionVariable _ctx_finish_cv;
+    // Parked on by the pipeline tasks of the ScanNode.
+    pipeline::WakeupDependency _dependency;
 
     // The following 3 variables control the process of the scanner scheduling.
     // Use _transfer_lock to protect them.
@@ -25,6 +25,9 @@
 
 #include <array>
 #include <atomic>
+#include <cmath>
+#include <cstring>
+#include <map>
 #include <memory>
 #include <string>
 
@@ -32,10 +35,12 @@
 #include "runtime/block_spill_manager.h"
 #include "runtime/define_primitive_type.h"
 #include "runtime/descriptors.h"
+#include "runtime/exec_env.h"
 #include "runtime/memory/mem_tracker.h"
 #include "runtime/runtime_state.h"
 #include "runtime/thread_context.h"
 #include "util/telemetry/telemetry.h"
+#include "util/threadpool.h"
 #include "vec/common/hash_table/hash.h"
 #include "vec/common/hash_table/hash_table_key_holder.h"
 #include "vec/common/hash_table/hash_table_utils.h"
@@ -98,6 +103,46 @@ static constexpr StreamingHtMinReductionEntry STREAMING_HT_MIN_REDUCTION[] = {
 static constexpr int STREAMING_HT_MIN_REDUCTION_SIZE =
         sizeof(STREAMING_HT_MIN_REDUCTION) / sizeof(STREAMING_HT_MIN_REDUCTION[0]);
 
+/// Find the appropriate reduction factor in our table for the current hash table sizes.
+static double get_streaming_ht_min_reduction(size_t ht_mem) {
+    int cache_level = 0;
+    while (cache_level + 1 < STREAMING_HT_MIN_REDUCTION_SIZE &&
+           ht_mem >= STREAMING_HT_MIN_REDUCTION[cache_level + 1].min_ht_mem) {
+        ++cache_level;
+    }
+    return STREAMING_HT_MIN_REDUCTION[cache_level].streaming_ht_min_reduction;
+}
+
+double BlockKeysCardinalityEstimator::estimate(const ColumnRawPtrs& key_columns, size_t rows) {
+    _hashes.assign(rows, 0);
+    for (const auto* column : key_columns) {
+        column->update_hashes_with_value(_hashes.data());
+    }
+
+    memset(_registers, 0, sizeof(_registers));
+    for (size_t i = 0; i < rows; ++i) {
+        const uint64_t hash = _hashes[i];
+        const uint64_t remaining = hash >> PRECISION;
+        const uint8_t rank = remaining == 0 ? 64 - PRECISION + 1 : __builtin_ctzll(remaining) + 1;
+        auto& reg = _registers[hash & (NUM_REGISTERS - 1)];
+        reg = std::max(reg, rank);
+    }
+
+    double sum = 0;
+    size_t zero_registers = 0;
+    for (auto reg : _registers) {
+        sum += 1.0 / static_cast<double>(1ULL << reg);
+        zero_registers += reg == 0;
+    }
+    constexpr double m = NUM_REGISTERS;
+    double estimate = 0.7213 / (1 + 1.079 / m) * m * m / sum;
+    if (estimate <= 2.5 * m && zero_registers != 0) {
+        // use linear counting for small cardinality
+        estimate = m * std::log(m / zero_registers);
+    }
+    return estimate;
+}
+
 AggregationNode::AggregationNode(ObjectPool* pool, const TPlanNode& tnode,
                                  const DescriptorTbl& descs)
         : ExecNode(pool, tnode, descs),
@@ -344,6 +389,11 @@ Status AggregationNode::prepare_profile(RuntimeState* state) {
     _hash_table_iterate_timer = ADD_TIMER(runtime_profile(), "HashTableIterateTime");
     _insert_keys_to_column_timer = ADD_TIMER(runtime_profile(), "InsertKeysToColumnTime");
     _streaming_agg_timer = ADD_TIMER(runtime_profile(), "StreamingAggTime");
+    _streaming_agg_pass_through_rows_counter =
+            ADD_COUNTER(runtime_profile(), "StreamingAggPassThroughRows", TUnit::UNIT);
+    _preagg_estimate_timer = ADD_TIMER(runtime_profile(), "PreaggCardinalityEstimateTime");
+    _preagg_mode_switch_counter =
+            ADD_COUNTER(runtime_profile(), "PreaggModeSwitchTimes", TUnit::UNIT);
     _hash_table_size_counter = ADD_COUNTER(runtime_profile(), "HashTableSize", TUnit::UNIT);
     _hash_table_input_counter = ADD_COUNTER(runtime_profile(), "HashTableInputCount", TUnit::UNIT);
     _max_row_size_counter = ADD_COUNTER(runtime_profile(), "MaxRowSizeInBytes", TUnit::UNIT);
@@ -457,6 +507,7 @@ Status AggregationNode::prepare_profile(RuntimeState* state) {
             _executor.pre_agg =
                     std::bind<Status>(&AggregationNode::_pre_agg_with_serialized_key, this,
                                       std::placeholders::_1, std::placeholders::_2);
+            _adaptive_preagg = state->enable_adaptive_preaggregation();
         }
 
         if (_needs_finalize) {
@@ -479,10 +530,10 @@ Status AggregationNode::prepare_profile(RuntimeState* state) {
 
     fmt::memory_buffer msg;
     fmt::format_to(msg,
-                   "(_is_merge: {}, _needs_finalize: {}, Streaming Preaggregation: {}, agg size: "
-                   "{}, limit: {})",
+                   "(_is_merge: {}, _needs_finalize: {}, Streaming Preaggregation: {}, Adaptive "
+                   "Preaggregation: {}, agg size: {}, limit: {})",
                    _is_merge ? "true" : "false", _needs_finalize ? "true" : "false",
-                   _is_streaming_preagg ? "true" : "false",
+                   _is_streaming_preagg ? "true" : "false", _adaptive_preagg ? "true" : "false",
                    std::to_string(_aggregate_evaluators.size()), std::to_string(_limit));
     runtime_profile()->add_info_string("AggInfos:", fmt::to_string(msg));
     return Status::OK();
@@ -493,6 +544,8 @@ Status AggregationNode::prepare(RuntimeState* state) {
 
     RETURN_IF_ERROR(ExecNode::prepare(state));
     RETURN_IF_ERROR(prepare_profile(state));
+    // spill io should not block the worker threads of pipeline task scheduler
+    _spill_context.async_io = state->enable_pipeline_exec();
     return Status::OK();
 }
 
@@ -592,15 +645,18 @@ Status AggregationNode::pull(doris::RuntimeState* state, vectorized::Block* bloc
 }
 
 Status AggregationNode::sink(doris::RuntimeState* state, vectorized::Block* in_block, bool eos) {
+    // The sink operator is blocked until the previous async spill io finishes.
+    DCHECK(!is_spill_io_running());
+    RETURN_IF_ERROR(_spill_context.io_status);
     if (in_block->rows() > 0) {
         RETURN_IF_ERROR(_executor.execute(in_block));
-        RETURN_IF_ERROR(_try_spill_disk());
+        RETURN_IF_ERROR(_try_spill_disk(state));
         _executor.update_memusage();
     }
     if (eos) {
         if (_spill_context.has_data) {
-            _try_spill_disk(true);
-            RETURN_IF_ERROR(_spill_context.prepare_for_reading());
+            // `_can_read` is set after the spill streams are ready for reading.
+            return _try_spill_disk(state, true);
         }
         _can_read = true;
     }
@@ -811,13 +867,6 @@ bool AggregationNode::_should_expand_preagg_hash_tables() {
                 // Need some rows in tables to have valid statistics.
                 if (ht_rows == 0) return true;
 
-                // Find the appropriate reduction factor in our table for the current hash table sizes.
-                int cache_level = 0;
-                while (cache_level + 1 < STREAMING_HT_MIN_REDUCTION_SIZE &&
-                       ht_mem >= STREAMING_HT_MIN_REDUCTION[cache_level + 1].min_ht_mem) {
-                    ++cache_level;
-                }
-
                 // Compare the number of rows in the hash table with the number of input rows that
                 // were aggregated into it. Exclude passed through rows from this calculation since
                 // they were not in hash tables.
@@ -840,8 +889,7 @@ bool AggregationNode::_should_expand_preagg_hash_tables() {
                 //  double estimated_reduction = aggregated_input_rows >= expected_input_rows
                 //      ? current_reduction
                 //      : 1 + (expected_input_rows / aggregated_input_rows) * (current_reduction - 1);
-                double min_reduction =
-                        STREAMING_HT_MIN_REDUCTION[cache_level].streaming_ht_min_reduction;
+                double min_reduction = get_streaming_ht_min_reduction(ht_mem);
 
                 //  COUNTER_SET(preagg_estimated_reduction_, estimated_reduction);
                 //    COUNTER_SET(preagg_streaming_ht_min_reduction_, min_reduction);
@@ -852,6 +900,61 @@ bool AggregationNode::_should_expand_preagg_hash_tables() {
             _agg_data->_aggregated_method_variant);
 }
 
+bool AggregationNode::_should_pass_through_block(const ColumnRawPtrs& key_columns, size_t rows,
+                                                 size_t ht_mem) {
+    auto& ctx = _adaptive_preagg_context;
+    const double min_reduction = get_streaming_ht_min_reduction(ht_mem);
+    if (!ctx.pass_through) {
+        // Need some rows in tables to have valid statistics.
+        if (ctx.last_reduction == 0 || ctx.last_reduction > min_reduction) {
+            return false;
+        }
+        _set_preagg_pass_through(true);
+        return true;
+    }
+
+    if (++ctx.passed_through_blocks >= ctx.recheck_interval) {
+        // The distinct keys of a block do not tell whether they are in the hash table already,
+        // so aggregate a block once in a while to measure the real reduction.
+        ctx.passed_through_blocks = 0;
+        ctx.rechecking = true;
+        return false;
+    }
+
+    double distinct_keys = 0;
+    {
+        SCOPED_TIMER(_preagg_estimate_timer);
+        distinct_keys = ctx.estimator.estimate(key_columns, rows);
+    }
+    if (static_cast<double>(rows) / std::max(distinct_keys, 1.0) > min_reduction) {
+        _set_preagg_pass_through(false);
+        return false;
+    }
+    return true;
+}
+
+void AggregationNode::_update_preagg_reduction(size_t rows, size_t new_groups, size_t ht_mem) {
+    auto& ctx = _adaptive_preagg_context;
+    ctx.last_reduction = static_cast<double>(rows) / std::max<size_t>(new_groups, 1);
+    if (ctx.rechecking) {
+        ctx.rechecking = false;
+        if (ctx.last_reduction > get_streaming_ht_min_reduction(ht_mem)) {
+            _set_preagg_pass_through(false);
+        } else {
+            ctx.recheck_interval = std::min(ctx.recheck_interval * 2,
+                                            AdaptivePreaggContext::MAX_RECHECK_INTERVAL);
+        }
+    }
+}
+
+void AggregationNode::_set_preagg_pass_through(bool pass_through) {
+    auto& ctx = _adaptive_preagg_context;
+    ctx.pass_through = pass_through;
+    ctx.passed_through_blocks = 0;
+    ctx.recheck_interval = AdaptivePreaggContext::MIN_RECHECK_INTERVAL;
+    COUNTER_UPDATE(_preagg_mode_switch_counter, 1);
+}
+
 size_t AggregationNode::_memory_usage() const {
     size_t usage = 0;
     std::visit(
@@ -1004,18 +1107,8 @@ void AggregationNode::_find_in_hash_table(AggregateDataPtr* places, ColumnRawPtr
                 _pre_serialize_key_if_need(state, agg_method, key_columns, num_rows);
 
                 if constexpr (HashTableTraits<HashTableType>::is_phmap) {
-                    if (_hash_values.size() < num_rows) _hash_values.resize(num_rows);
-                    if constexpr (ColumnsHashing::IsPreSerializedKeysHashMethodTraits<
-                                          AggState>::value) {
-                        for (size_t i = 0; i < num_rows; ++i) {
-                            _hash_values[i] = agg_method.data.hash(agg_method.keys[i]);
-                        }
-                    } else {
-                        for (size_t i = 0; i < num_rows; ++i) {
-                            _hash_values[i] =
-                                    agg_method.data.hash(state.get_key_holder(i, *_agg_arena_pool));
-                        }
-                    }
+                    state.get_hash_values(agg_method.data, num_rows, *_agg_arena_pool,
+                                          _hash_values);
                 }
 
                 /// For all rows.
@@ -1073,70 +1166,80 @@ Status AggregationNode::_pre_agg_with_serialized_key(doris::vectorized::Block* i
     // pressure. In either case we should always use the remaining space in the hash table
     // to avoid wasting memory.
     // But for fixed hash map, it never need to expand
+    // With adaptive pre-aggregation, the block is passed through as soon as aggregating does not
+    // reduce the input enough, instead of only when the hash table has to expand.
     bool ret_flag = false;
+    size_t ht_mem = 0;
     RETURN_IF_ERROR(std::visit(
             [&](auto&& agg_method) -> Status {
-                if (auto& hash_tbl = agg_method.data; hash_tbl.add_elem_size_overflow(rows)) {
+                auto& hash_tbl = agg_method.data;
+                ht_mem = hash_tbl.get_buffer_size_in_bytes();
+                bool pass_through =
+                        _adaptive_preagg && _should_pass_through_block(key_columns, rows, ht_mem);
+                if (!pass_through && hash_tbl.add_elem_size_overflow(rows)) {
                     /// If too much memory is used during the pre-aggregation stage,
                     /// it is better to output the data directly without performing further aggregation.
                     const bool used_too_much_memory =
                             (_external_agg_bytes_threshold > 0 &&
                              _memory_usage() > _external_agg_bytes_threshold);
-                    // do not try to do agg, just init and serialize directly return the out_block
-                    if (!_should_expand_preagg_hash_tables() || used_too_much_memory) {
-                        SCOPED_TIMER(_streaming_agg_timer);
-                        ret_flag = true;
-
-                        // will serialize value data to string column.
-                        // non-nullable column(id in `_make_nullable_keys`)
-                        // will be converted to nullable.
-                        bool mem_reuse = _make_nullable_keys.empty() && out_block->mem_reuse();
-
-                        std::vector<DataTypePtr> data_types;
-                        MutableColumns value_columns;
-                        for (int i = 0; i < _aggregate_evaluators.size(); ++i) {
-                            auto data_type =
-                                    _aggregate_evaluators[i]->function()->get_serialized_type();
-                            if (mem_reuse) {
-                                value_columns.emplace_back(
-                                        std::move(*out_block->get_by_position(i + key_size).column)
-                                                .mutate());
-                            } else {
-                                // slot type of value it should always be string type
-                                value_columns.emplace_back(_aggregate_evaluators[i]
-                                                                   ->function()
-                                                                   ->create_serialize_column());
-                            }
-                            data_types.emplace_back(data_type);
+                    pass_through = used_too_much_memory ||
+                                   (!_adaptive_preagg && !_should_expand_preagg_hash_tables());
+                }
+                // do not try to do agg, just init and serialize directly return the out_block
+                if (pass_through) {
+                    SCOPED_TIMER(_streaming_agg_timer);
+                    ret_flag = true;
+                    COUNTER_UPDATE(_streaming_agg_pass_through_rows_counter, rows);
+
+                    // will serialize value data to string column.
+                    // non-nullable column(id in `_make_nullable_keys`)
+                    // will be converted to nullable.
+                    bool mem_reuse = _make_nullable_keys.empty() && out_block->mem_reuse();
+
+                    std::vector<DataTypePtr> data_types;
+                    MutableColumns value_columns;
+                    for (int i = 0; i < _aggregate_evaluators.size(); ++i) {
+                        auto data_type =
+                                _aggregate_evaluators[i]->function()->get_serialized_type();
+                        if (mem_reuse) {
+                            value_columns.emplace_back(
+                                    std::move(*out_block->get_by_position(i + key_size).column)
+                                            .mutate());
+                        } else {
+                            // slot type of value it should always be string type
+                            value_columns.emplace_back(_aggregate_evaluators[i]
+                                                               ->function()
+                                                               ->create_serialize_column());
                         }
+                        data_types.emplace_back(data_type);
+                    }
 
-                        for (int i = 0; i != _aggregate_evaluators.size(); ++i) {
-                            SCOPED_TIMER(_serialize_data_timer);
-                            RETURN_IF_ERROR(
-                                    _aggregate_evaluators[i]->streaming_agg_serialize_to_column(
-                                            in_block, value_columns[i], rows,
-                                            _agg_arena_pool.get()));
-                        }
+                    for (int i = 0; i != _aggregate_evaluators.size(); ++i) {
+                        SCOPED_TIMER(_serialize_data_timer);
+                        RETURN_IF_ERROR(
+                                _aggregate_evaluators[i]->streaming_agg_serialize_to_column(
+                                        in_block, value_columns[i], rows,
+                                        _agg_arena_pool.get()));
+                    }
 
-                        if (!mem_reuse) {
-                            ColumnsWithTypeAndName columns_with_schema;
-                            for (int i = 0; i < key_size; ++i) {
-                                columns_with_schema.emplace_back(
-                                        key_columns[i]->clone_resized(rows),
-                                        _probe_expr_ctxs[i]->root()->data_type(),
-                                        _probe_expr_ctxs[i]->root()->expr_name());
-                            }
-                            for (int i = 0; i < value_columns.size(); ++i) {
-                                columns_with_schema.emplace_back(std::move(value_columns[i]),
-                                                                 data_types[i], "");
-                            }
-                            out_block->swap(Block(columns_with_schema));
-                        } else {
-                            for (int i = 0; i < key_size; ++i) {
-                                std::move(*out_block->get_by_position(i).column)
-                                        .mutate()
-                                        ->insert_range_from(*key_columns[i], 0, rows);
-                            }
+                    if (!mem_reuse) {
+                        ColumnsWithTypeAndName columns_with_schema;
+                        for (int i = 0; i < key_size; ++i) {
+                            columns_with_schema.emplace_back(
+                                    key_columns[i]->clone_resized(rows),
+                                    _probe_expr_ctxs[i]->root()->data_type(),
+                                    _probe_expr_ctxs[i]->root()->expr_name());
+                        }
+                        for (int i = 0; i < value_columns.size(); ++i) {
+                            columns_with_schema.emplace_back(std::move(value_columns[i]),
+                                                             data_types[i], "");
+                        }
+                        out_block->swap(Block(columns_with_schema));
+                    } else {
+                        for (int i = 0; i < key_size; ++i) {
+                            std::move(*out_block->get_by_position(i).column)
+                                    .mutate()
+                                    ->insert_range_from(*key_columns[i], 0, rows);
                         }
                     }
                 }
@@ -1145,6 +1248,7 @@ Status AggregationNode::_pre_agg_with_serialized_key(doris::vectorized::Block* i
             _agg_data->_aggregated_method_variant));
 
     if (!ret_flag) {
+        const size_t ht_rows = _get_hash_table_size();
         RETURN_IF_CATCH_EXCEPTION(_emplace_into_hash_table(_places.data(), key_columns, rows));
 
         for (int i = 0; i < _aggregate_evaluators.size(); ++i) {
@@ -1152,6 +1256,10 @@ Status AggregationNode::_pre_agg_with_serialized_key(doris::vectorized::Block* i
                     in_block, _offsets_of_aggregate_states[i], _places.data(),
                     _agg_arena_pool.get(), _should_expand_hash_table));
         }
+
+        if (_adaptive_preagg) {
+            _update_preagg_reduction(rows, _get_hash_table_size() - ht_rows, ht_mem);
+        }
     }
 
     return Status::OK();
@@ -1233,7 +1341,8 @@ Status AggregationNode::_serialize_hash_table_to_block(HashTableCtxType& context
 }
 
 template <typename HashTableCtxType, typename HashTableType>
-Status AggregationNode::_spill_hash_table(HashTableCtxType& agg_method, HashTableType& hash_table) {
+Status AggregationNode::_spill_hash_table(HashTableCtxType& agg_method, HashTableType& hash_table,
+                                          std::vector<Block>& partitioned_blocks) {
     Block block;
     std::vector<typename HashTableType::key_type> keys;
     RETURN_IF_ERROR(_serialize_hash_table_to_block(agg_method, hash_table, block, keys));
@@ -1245,15 +1354,6 @@ Status AggregationNode::_spill_hash_table(HashTableCtxType& agg_method, HashTabl
         _spill_context.runtime_profile = _runtime_profile->create_child("Spill", true, true);
     }
 
-    BlockSpillWriterUPtr writer;
-    RETURN_IF_ERROR(ExecEnv::GetInstance()->block_spill_mgr()->get_writer(
-            std::numeric_limits<int32_t>::max(), writer, _spill_context.runtime_profile));
-    Defer defer {[&]() {
-        // redundant call is ok
-        writer->close();
-    }};
-    _spill_context.stream_ids.emplace_back(writer->get_id());
-
     std::vector<size_t> partitioned_indices(block.rows());
     std::vector<size_t> blocks_rows(_spill_partition_helper->partition_count);
 
@@ -1272,12 +1372,13 @@ Status AggregationNode::_spill_hash_table(HashTableCtxType& agg_method, HashTabl
         blocks_rows[index]++;
     }
 
+    partitioned_blocks.reserve(_spill_partition_helper->partition_count);
     for (size_t i = 0; i < _spill_partition_helper->partition_count; ++i) {
         Block block_to_write = block.clone_empty();
         if (blocks_rows[i] == 0) {
             /// Here write one empty block to ensure there are enough blocks in the file,
             /// blocks' count should be equal with partition_count.
-            writer->write(block_to_write);
+            partitioned_blocks.emplace_back(std::move(block_to_write));
             continue;
         }
 
@@ -1309,18 +1410,18 @@ Status AggregationNode::_spill_hash_table(HashTableCtxType& agg_method, HashTabl
         }
 
         CHECK_EQ(mutable_block.rows(), blocks_rows[i]);
-        RETURN_IF_ERROR(writer->write(mutable_block.to_block()));
+        partitioned_blocks.emplace_back(mutable_block.to_block());
     }
-    RETURN_IF_ERROR(writer->close());
 
     return Status::OK();
 }
 
-Status AggregationNode::_try_spill_disk(bool eos) {
+Status AggregationNode::_try_spill_disk(RuntimeState* state, bool eos) {
     if (_external_agg_bytes_threshold == 0) {
         return Status::OK();
     }
-    return std::visit(
+    std::vector<Block> partitioned_blocks;
+    RETURN_IF_ERROR(std::visit(
             [&](auto&& agg_method) -> Status {
                 auto& hash_table = agg_method.data;
                 if (!eos && _memory_usage() < _external_agg_bytes_threshold) {
@@ -1331,10 +1432,118 @@ Status AggregationNode::_try_spill_disk(bool eos) {
                     return Status::OK();
                 }
 
-                RETURN_IF_ERROR(_spill_hash_table(agg_method, hash_table));
+                RETURN_IF_ERROR(_spill_hash_table(agg_method, hash_table, partitioned_blocks));
                 return _reset_hash_table();
             },
-            _agg_data->_aggregated_method_variant);
+            _agg_data->_aggregated_method_variant));
+
+    if (partitioned_blocks.empty() && !eos) {
+        return Status::OK();
+    }
+    return _write_spill_blocks(state, std::move(partitioned_blocks), eos);
+}
+
+Status AggregationNode::_write_spill_blocks(RuntimeState* state, std::vector<Block>&& blocks,
+                                            bool eos) {
+    auto* spill_manager = ExecEnv::GetInstance()->block_spill_mgr();
+    const auto data_dir_index = spill_manager->select_data_dir();
+    if (!_spill_context.async_io) {
+        if (!blocks.empty()) {
+            RETURN_IF_ERROR(_spill_context.write_blocks(data_dir_index, blocks));
+        }
+        if (eos) {
+            RETURN_IF_ERROR(_spill_context.prepare_for_reading());
+            _can_read = true;
+        }
+        return Status::OK();
+    }
+
+    auto spill_blocks = std::make_shared<std::vector<Block>>(std::move(blocks));
+    return _submit_spill_io(state, data_dir_index, [this, spill_blocks, data_dir_index, eos]() {
+        Status st;
+        if (!spill_blocks->empty()) {
+            st = _spill_context.write_blocks(data_dir_index, *spill_blocks);
+            spill_blocks->clear();
+        }
+        if (eos) {
+            if (st.ok()) {
+                st = _spill_context.prepare_for_reading();
+            }
+            // The error is returned by the `pull` of source operator.
+            _can_read = true;
+        }
+        return st;
+    });
+}
+
+Status AggregationNode::_submit_spill_io(RuntimeState* state, size_t data_dir_index,
+                                         std::function<Status()> io_func) {
+    ++_spill_context.running_io_tasks;
+    auto st = ExecEnv::GetInstance()->block_spill_mgr()->submit_io(
+            data_dir_index, [this, state, io_func = std::move(io_func)]() mutable {
+                SCOPED_ATTACH_TASK(state);
+                auto st = io_func();
+                if (!st.ok()) {
+                    std::lock_guard<std::mutex> l(_spill_context.io_status_lock);
+                    _spill_context.io_status = st;
+                }
+                // release the resources captured by `io_func` with the query mem tracker
+                io_func = nullptr;
+                --_spill_context.running_io_tasks;
+            });
+    if (!st.ok()) {
+        --_spill_context.running_io_tasks;
+    }
+    return st;
+}
+
+Status AggregationNode::_prepare_spilt_data(RuntimeState* state, bool* ready) {
+    *ready = false;
+    if (!_spill_context.async_io) {
+        *ready = true;
+        return Status::OK();
+    }
+
+    if (is_spill_io_running()) {
+        // The pipeline task is blocked by `is_waiting_for_spill_io()` until the io finishes.
+        _spill_context.source_waiting = true;
+        return Status::OK();
+    }
+    _spill_context.source_waiting = false;
+    RETURN_IF_ERROR(_spill_context.io_status);
+
+    if (_spill_context.read_blocks_ready) {
+        *ready = true;
+        return Status::OK();
+    }
+    _spill_context.source_waiting = true;
+    return _read_spilt_data_async(state);
+}
+
+Status AggregationNode::_read_spilt_data_async(RuntimeState* state) {
+    DCHECK(!_spill_context.read_blocks_ready);
+    DCHECK(!is_spill_io_running());
+    const auto read_cursor = _spill_context.read_cursor;
+    auto* spill_manager = ExecEnv::GetInstance()->block_spill_mgr();
+
+    // The spill streams of each data dir are read in the spill io thread pool of the data dir,
+    // and the partition is ready once all the io tasks finish.
+    std::map<size_t, std::vector<size_t>> data_dir_streams;
+    for (size_t i = 0; i != _spill_context.stream_ids.size(); ++i) {
+        data_dir_streams[spill_manager->get_data_dir_index(_spill_context.stream_ids[i])]
+                .emplace_back(i);
+    }
+    _spill_context.read_blocks.clear();
+    _spill_context.read_blocks.resize(_spill_context.stream_ids.size());
+    for (auto& [data_dir_index, stream_indices] : data_dir_streams) {
+        RETURN_IF_ERROR(_submit_spill_io(
+                state, data_dir_index, [this, read_cursor, stream_indices = stream_indices]() {
+                    return _spill_context.read_partition(read_cursor, stream_indices,
+                                                         _spill_context.read_blocks);
+                }));
+    }
+    _spill_context.read_blocks_ready = true;
+    return Status::OK();
 }
 
 Status AggregationNode::_execute_with_serialized_key(Block* block) {
@@ -1345,16 +1554,19 @@ Status AggregationNode::_execute_with_serialized_key(Block* block) {
     }
 }
 
-Status AggregationNode::_merge_spilt_data() {
+Status AggregationNode::_merge_spilt_data(RuntimeState* state) {
     CHECK(!_spill_context.stream_ids.empty());
 
-    for (auto& reader : _spill_context.readers) {
-        CHECK_LT(_spill_context.read_cursor, reader->block_count());
-        reader->seek(_spill_context.read_cursor);
-        Block block;
-        bool eos;
-        RETURN_IF_ERROR(reader->read(&block, &eos));
+    std::vector<Block> blocks;
+    if (_spill_context.async_io) {
+        DCHECK(_spill_context.read_blocks_ready);
+        blocks.swap(_spill_context.read_blocks);
+        _spill_context.read_blocks_ready = false;
+    } else {
+        RETURN_IF_ERROR(_spill_context.read_partition(_spill_context.read_cursor, blocks));
+    }
 
+    for (auto& block : blocks) {
         if (!block.empty()) {
             auto st = _merge_with_serialized_key_helper<false /* limit */, true /* for_spill */>(
                     &block);
@@ -1362,6 +1574,12 @@ Status AggregationNode::_merge_spilt_data() {
         }
     }
     _spill_context.read_cursor++;
+
+    if (_spill_context.async_io &&
+        _spill_context.read_cursor < _spill_partition_helper->partition_count) {
+        // read the next partition ahead while the results of this partition are being output
+        RETURN_IF_ERROR(_read_spilt_data_async(state));
+    }
     return Status::OK();
 }
 
@@ -1373,8 +1591,15 @@ Status AggregationNode::_get_result_with_spilt_data(RuntimeState* state, Block*
         if (_spill_context.read_cursor == _spill_partition_helper->partition_count) {
             break;
         }
+        bool ready = false;
+        RETURN_IF_ERROR(_prepare_spilt_data(state, &ready));
+        if (!ready) {
+            // wait for the spill io thread pool to read the partition
+            *eos = false;
+            return Status::OK();
+        }
         RETURN_IF_ERROR(_reset_hash_table());
-        RETURN_IF_ERROR(_merge_spilt_data());
+        RETURN_IF_ERROR(_merge_spilt_data(state));
         _aggregate_data_container->init_once();
     }
 
@@ -1515,8 +1740,15 @@ Status AggregationNode::_serialize_with_serialized_key_result_with_spilt_data(Ru
         if (_spill_context.read_cursor == _spill_partition_helper->partition_count) {
             break;
         }
+        bool ready = false;
+        RETURN_IF_ERROR(_prepare_spilt_data(state, &ready));
+        if (!ready) {
+            // wait for the spill io thread pool to read the partition
+            *eos = false;
+            return Status::OK();
+        }
         RETURN_IF_ERROR(_reset_hash_table());
-        RETURN_IF_ERROR(_merge_spilt_data());
+        RETURN_IF_ERROR(_merge_spilt_data(state));
         _aggregate_data_container->init_once();
     }
 
@@ -1703,6 +1935,49 @@ void AggregationNode::_release_mem() {
     _values.swap(tmp_values);
 }
 
+Status AggSpillContext::write_blocks(size_t data_dir_index, const std::vector<Block>& blocks) {
+    BlockSpillWriterUPtr writer;
+    RETURN_IF_ERROR(ExecEnv::GetInstance()->block_spill_mgr()->get_writer(
+            data_dir_index, std::numeric_limits<int32_t>::max(), writer, runtime_profile));
+    Defer defer {[&]() {
+        // redundant call is ok
+        writer->close();
+    }};
+    stream_ids.emplace_back(writer->get_id());
+
+    for (const auto& block : blocks) {
+        RETURN_IF_ERROR(writer->write(block));
+    }
+    return writer->close();
+}
+
+Status AggSpillContext::read_partition(size_t partition_index, std::vector<Block>& blocks) {
+    blocks.clear();
+    blocks.reserve(readers.size());
+    for (auto& reader : readers) {
+        CHECK_LT(partition_index, reader->block_count());
+        reader->seek(partition_index);
+        Block block;
+        bool eos;
+        RETURN_IF_ERROR(reader->read(&block, &eos));
+        blocks.emplace_back(std::move(block));
+    }
+    return Status::OK();
+}
+
+Status AggSpillContext::read_partition(size_t partition_index,
+                                      const std::vector<size_t>& stream_indices,
+                                      std::vector<Block>& blocks) {
+    for (auto stream_index : stream_indices) {
+        auto& reader = readers[stream_index];
+        CHECK_LT(partition_index, reader->block_count());
+        reader->seek(partition_index);
+        bool eos;
+        RETURN_IF_ERROR(reader->read(&blocks[stream_index], &eos));
+    }
+    return Status::OK();
+}
+
 Status AggSpillContext::prepare_for_reading() {
     if (readers_prepared) {
         return Status::OK();
@@ -23,8 +23,10 @@
 #include <stdint.h>
 
 #include <algorithm>
+#include <atomic>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <ostream>
 #include <string>
 #include <type_traits>
@@ -803,8 +805,33 @@ struct AggSpillContext {
 
     size_t read_cursor {};
 
+    /// When `async_io` is set(pipeline engine), the spill io runs in the spill io thread pool
+    /// of data dirs instead of the pipeline worker threads, see `AggregationNode::_submit_spill_io`.
+    bool async_io = false;
+    /// number of the async spill io tasks which are submitted but not finished
+    std::atomic<size_t> running_io_tasks = 0;
+    /// the source operator could not go on until the running io finishes
+    std::atomic<bool> source_waiting = false;
+    /// status of the failed async spill io task if any
+    std::mutex io_status_lock;
+    Status io_status;
+    /// blocks of the partition at `read_cursor` read ahead by the async spill io task
+    std::vector<Block> read_blocks;
+    bool read_blocks_ready = false;
+
     Status prepare_for_reading();
 
+    /// write the blocks of all partitions into a new spill stream in the data dir
+    Status write_blocks(size_t data_dir_index, const std::vector<Block>& blocks);
+
+    /// read the blocks of the partition at `partition_index` from all spill streams
+    Status read_partition(size_t partition_index, std::vector<Block>& blocks);
+
+    /// read the blocks of the partition at `partition_index` from the spill streams at
+    /// `stream_indices` into the same positions of `blocks`
+    Status read_partition(size_t partition_index, const std::vector<size_t>& stream_indices,
+                          std::vector<Block>& blocks);
+
     ~AggSpillContext() {
         for (auto& reader : readers) {
             if (reader) {
@@ -830,6 +857,38 @@ struct SpillPartitionHelper {
     }
 };
 
+/// A small HyperLogLog(1024 registers, about 3% standard error) to estimate the distinct keys
+/// of one input block of the streaming pre-aggregation without touching the hash table.
+class BlockKeysCardinalityEstimator {
+public:
+    double estimate(const ColumnRawPtrs& key_columns, size_t rows);
+
+private:
+    static constexpr int PRECISION = 10;
+    static constexpr size_t NUM_REGISTERS = 1 << PRECISION;
+
+    std::vector<uint64_t> _hashes;
+    uint8_t _registers[NUM_REGISTERS];
+};
+
+/// State of the adaptive streaming pre-aggregation, which decides for every input block whether
+/// to aggregate it or to pass it through, see `AggregationNode::_should_pass_through_block`.
+struct AdaptivePreaggContext {
+    /// the first re-check happens after so many blocks are passed through, and the interval
+    /// doubles each time the re-check still does not get enough reduction
+    static constexpr int64_t MIN_RECHECK_INTERVAL = 16;
+    static constexpr int64_t MAX_RECHECK_INTERVAL = 1024;
+
+    bool pass_through = false;
+    /// input rows divided by the new groups of the last aggregated block
+    double last_reduction = 0;
+    /// the block being aggregated is a re-check under pass through mode
+    bool rechecking = false;
+    int64_t passed_through_blocks = 0;
+    int64_t recheck_interval = MIN_RECHECK_INTERVAL;
+    BlockKeysCardinalityEstimator estimator;
+};
+
 // not support spill
 class AggregationNode : public ::doris::ExecNode {
 public:
@@ -849,6 +908,10 @@ public:
     Status sink(doris::RuntimeState* state, vectorized::Block* input_block, bool eos) override;
     Status do_pre_agg(vectorized::Block* input_block, vectorized::Block* output_block);
     bool is_streaming_preagg() const { return _is_streaming_preagg; }
+    bool is_spill_io_running() const { return _spill_context.running_io_tasks > 0; }
+    bool is_waiting_for_spill_io() const {
+        return _spill_context.source_waiting && is_spill_io_running();
+    }
     bool is_aggregate_evaluators_empty() const { return _aggregate_evaluators.empty(); }
     void _make_nullable_output_key(Block* block);
 
@@ -916,6 +979,9 @@ private:
     RuntimeProfile::Counter* _hash_table_iterate_timer;
     RuntimeProfile::Counter* _insert_keys_to_column_timer;
     RuntimeProfile::Counter* _streaming_agg_timer;
+    RuntimeProfile::Counter* _streaming_agg_pass_through_rows_counter;
+    RuntimeProfile::Counter* _preagg_estimate_timer;
+    RuntimeProfile::Counter* _preagg_mode_switch_counter;
     RuntimeProfile::Counter* _hash_table_size_counter;
     RuntimeProfile::Counter* _max_row_size_counter;
     RuntimeProfile::Counter* _memory_usage_counter;
@@ -923,6 +989,8 @@ private:
     RuntimeProfile::HighWaterMarkCounter* _serialize_key_arena_memory_usage;
 
     bool _should_expand_hash_table = true;
+    bool _adaptive_preagg = false;
+    AdaptivePreaggContext _adaptive_preagg_context;
     bool _should_limit_output = false;
     bool _reach_limit = false;
     bool _agg_data_created_without_key = false;
@@ -937,6 +1005,14 @@ private:
     /// the preagg should pass through any rows it can't fit in its tables.
     bool _should_expand_preagg_hash_tables();
 
+    /// Adaptive pre-aggregation: return true if the block should be passed through. In aggregate
+    /// mode it is decided by the reduction of the last aggregated block, in pass through mode by
+    /// the reduction estimated from the distinct keys of the block itself.
+    bool _should_pass_through_block(const ColumnRawPtrs& key_columns, size_t rows, size_t ht_mem);
+    /// Record the reduction of the block just aggregated, which added `new_groups` groups.
+    void _update_preagg_reduction(size_t rows, size_t new_groups, size_t ht_mem);
+    void _set_preagg_pass_through(bool pass_through);
+
     size_t _get_hash_table_size();
 
     Status _create_agg_status(AggregateDataPtr data);
@@ -952,7 +1028,20 @@ private:
     Status _get_with_serialized_key_result(RuntimeState* state, Block* block, bool* eos);
     Status _get_result_with_serialized_key_non_spill(RuntimeState* state, Block* block, bool* eos);
 
-    Status _merge_spilt_data();
+    Status _merge_spilt_data(RuntimeState* state);
+
+    /// Set `ready` if the spilt data of the partition at `read_cursor` could be merged now,
+    /// otherwise it is being read by the spill io thread pool and `is_waiting_for_spill_io()`
+    /// is true until the reading finishes.
+    Status _prepare_spilt_data(RuntimeState* state, bool* ready);
+
+    Status _read_spilt_data_async(RuntimeState* state);
+
+    /// Run `io_func` in the spill io thread pool of the data dir.
+    Status _submit_spill_io(RuntimeState* state, size_t data_dir_index,
+                            std::function<Status()> io_func);
+
+    Status _write_spill_blocks(RuntimeState* state, std::vector<Block>&& blocks, bool eos);
 
     Status _get_result_with_spilt_data(RuntimeState* state, Block* block, bool* eos);
 
@@ -1153,14 +1242,15 @@ private:
 
     Status _reset_hash_table();
 
-    Status _try_spill_disk(bool eos = false);
+    Status _try_spill_disk(RuntimeState* state, bool eos = false);
 
     template <typename HashTableCtxType, typename HashTableType, typename KeyType>
     Status _serialize_hash_table_to_block(HashTableCtxType& context, HashTableType& hash_table,
                                           Block& block, std::vector<KeyType>& keys);
 
     template <typename HashTableCtxType, typename HashTableType>
-    Status _spill_hash_table(HashTableCtxType& agg_method, HashTableType& hash_table);
+    Status _spill_hash_table(HashTableCtxType& agg_method, HashTableType& hash_table,
+                             std::vector<Block>& partitioned_blocks);
 
     void _find_in_hash_table(AggregateDataPtr* places, ColumnRawPtrs& key_columns, size_t num_rows);
 
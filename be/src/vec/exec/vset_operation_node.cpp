@@ -23,6 +23,7 @@
 #include <glog/logging.h>
 #include <opentelemetry/nostd/shared_ptr.h>
 
+#include <algorithm>
 #include <array>
 #include <atomic>
 #include <ostream>
@@ -82,25 +83,29 @@ struct HashTableBuild {
             key_getter.set_serialized_keys(hash_table_ctx.keys.data());
         }
 
-        for (size_t k = 0; k < _rows; ++k) {
-            if (k % 65536 == 0) {
-                RETURN_IF_CANCELLED(_state);
-            }
-            auto emplace_result = key_getter.emplace_key(hash_table_ctx.hash_table, k,
-                                                         *(_operation_node->_arena));
-
-            if (k + 1 < _rows) {
-                key_getter.prefetch(hash_table_ctx.hash_table, k + 1, *(_operation_node->_arena));
-            }
-
-            if (emplace_result.is_inserted()) { //only inserted once as the same key, others skip
-                new (&emplace_result.get_mapped()) Mapped({k, _offset});
-            }
+        std::vector<size_t> hash_values;
+        key_getter.get_hash_values(hash_table_ctx.hash_table, _rows, *(_operation_node->_arena),
+                                   hash_values);
+
+        for (size_t begin = 0; begin < _rows; begin += BATCH_ROWS) {
+            RETURN_IF_CANCELLED(_state);
+            key_getter.emplace_keys(
+                    hash_table_ctx.hash_table, hash_values, begin,
+                    std::min(begin + BATCH_ROWS, static_cast<size_t>(_rows)),
+                    *(_operation_node->_arena), [&](size_t k, auto& emplace_result) {
+                        //only inserted once as the same key, others skip
+                        if (emplace_result.is_inserted()) {
+                            new (&emplace_result.get_mapped()) Mapped({k, _offset});
+                        }
+                    });
         }
         return Status::OK();
     }
 
 private:
+    // check whether the query is cancelled every BATCH_ROWS rows
+    static constexpr size_t BATCH_ROWS = 65536;
+
     const int _rows;
     const uint8_t _offset;
     ColumnRawPtrs& _build_raw_ptrs;
@@ -133,21 +138,23 @@ struct HashTableProbe {
         }
 
         if constexpr (std::is_same_v<typename HashTableContext::Mapped, RowRefListWithFlags>) {
-            for (int probe_index = 0; probe_index < _probe_rows; probe_index++) {
-                auto find_result =
-                        key_getter.find_key(hash_table_ctx.hash_table, probe_index, *_arena);
-                if (find_result.is_found()) { //if found, marked visited
-                    auto it = find_result.get_mapped().begin();
-                    if (!(it->visited)) {
-                        it->visited = true;
-                        if constexpr (is_intersected) { //intersected
-                            _operation_node->_valid_element_in_hash_tbl++;
-                        } else {
-                            _operation_node->_valid_element_in_hash_tbl--; //except
+            key_getter.get_hash_values(hash_table_ctx.hash_table, _probe_rows, *_arena,
+                                       _hash_values);
+            key_getter.find_keys(
+                    hash_table_ctx.hash_table, _hash_values, 0, _probe_rows, *_arena,
+                    [&](size_t, auto& find_result) {
+                        if (find_result.is_found()) { //if found, marked visited
+                            auto it = find_result.get_mapped().begin();
+                            if (!(it->visited)) {
+                                it->visited = true;
+                                if constexpr (is_intersected) { //intersected
+                                    _operation_node->_valid_element_in_hash_tbl++;
+                                } else {
+                                    _operation_node->_valid_element_in_hash_tbl--; //except
+                                }
+                            }
                         }
-                    }
-                }
-            }
+                    });
         } else {
             LOG(FATAL) << "Invalid RowRefListType!";
         }
@@ -160,6 +167,7 @@ private:
     ColumnRawPtrs& _probe_raw_ptrs;
     std::unique_ptr<Arena> _arena;
     std::vector<StringRef> _probe_keys;
+    std::vector<size_t> _hash_values;
 };
 
 template <bool is_intersect>
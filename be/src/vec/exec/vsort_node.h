@@ -74,6 +74,8 @@ public:
 
     Status sink(RuntimeState* state, vectorized::Block* input_block, bool eos) override;
 
+    bool is_spill_io_running() const { return _sorter && _sorter->is_spill_io_running(); }
+
 protected:
     void debug_string(int indentation_level, std::stringstream* out) const override;
 
@@ -59,13 +59,12 @@ public:
 
     const VExprSPtr get_impl() const override { return _impl; }
 
-    // if filter rate less than this, bloom filter will set always true
-    constexpr static double EXPECTED_FILTER_RATE = 0.4;
-
+    // if filter rate less than config::runtime_filter_min_filter_rate after
+    // config::bloom_filter_predicate_check_row_num rows, the filter will set always true
     static void calculate_filter(int64_t filter_rows, int64_t scan_rows, bool& has_calculate,
                                  bool& always_true) {
         if ((!has_calculate) && (scan_rows > config::bloom_filter_predicate_check_row_num)) {
-            if (filter_rows / (scan_rows * 1.0) < VRuntimeFilterWrapper::EXPECTED_FILTER_RATE) {
+            if (filter_rows / (scan_rows * 1.0) < config::runtime_filter_min_filter_rate) {
                 always_true = true;
             }
             has_calculate = true;
@@ -22,7 +22,9 @@
 #include <re2/stringpiece.h>
 
 #include <algorithm>
+#include <cctype>
 #include <cstddef>
+#include <cstring>
 #include <ostream>
 #include <utility>
 #include <vector>
@@ -65,6 +67,7 @@ static const re2::RE2 LIKE_ALLPASS_RE("%+");
 Status LikeSearchState::clone(LikeSearchState& cloned) {
     cloned.escape_char = escape_char;
     cloned.set_search_string(search_string);
+    cloned.set_required_literals(required_literals, literals_only);
 
     std::string re_pattern;
     FunctionLike::convert_like_pattern(this, pattern_str, &re_pattern);
@@ -91,6 +94,79 @@ Status LikeSearchState::clone(LikeSearchState& cloned) {
     return Status::OK();
 }
 
+void LikeSearchState::set_required_literals(std::vector<std::string> literals,
+                                            bool literals_only_arg) {
+    required_literals.clear();
+    for (auto& literal : literals) {
+        if (!literal.empty()) {
+            required_literals.emplace_back(std::move(literal));
+        }
+    }
+    literals_only = literals_only_arg;
+
+    // searchers keep pointers to the literals, build them after required_literals is final
+    literal_searchers.clear();
+    literal_searchers.reserve(required_literals.size());
+    longest_literal_index = 0;
+    for (size_t i = 0; i < required_literals.size(); ++i) {
+        literal_searchers.emplace_back(required_literals[i].data(), required_literals[i].size());
+        if (required_literals[i].size() > required_literals[longest_literal_index].size()) {
+            longest_literal_index = i;
+        }
+    }
+}
+
+bool LikeSearchState::match_required_literals(const StringRef& val) const {
+    // the literals are split from a concatenation, so they appear in order without overlapping
+    const char* pos = val.data;
+    const char* end = val.data + val.size;
+    for (size_t i = 0; i < literal_searchers.size(); ++i) {
+        pos = literal_searchers[i].search(pos, end);
+        if (pos == end) {
+            return false;
+        }
+        pos += required_literals[i].size();
+    }
+    return true;
+}
+
+void LikeSearchState::search_required_literals(const ColumnString& val,
+                                               ColumnUInt8::Container& result) const {
+    const auto& offsets = val.get_offsets();
+    const UInt8* begin = val.get_chars().data();
+    const UInt8* end = begin + val.get_chars().size();
+    const UInt8* pos = begin;
+    const auto& searcher = literal_searchers[longest_literal_index];
+    const size_t needle_size = required_literals[longest_literal_index].size();
+    const bool single_literal = literal_searchers.size() == 1;
+
+    memset(result.data(), 0, val.size());
+
+    /// Search the longest literal in all strings at once, and only check the others
+    /// in the strings it hits.
+    size_t i = 0;
+    while (pos < end) {
+        pos = searcher.search(pos, end);
+        if (pos >= end) {
+            break;
+        }
+
+        /// begin + offsets[i] is the end of string i
+        while (begin + offsets[i] <= pos) {
+            ++i;
+        }
+
+        if (pos + needle_size <= begin + offsets[i]) {
+            result[i] = single_literal ||
+                        match_required_literals(StringRef(begin + offsets[i - 1],
+                                                          offsets[i] - offsets[i - 1]));
+        }
+
+        pos = begin + offsets[i];
+        ++i;
+    }
+}
+
 Status FunctionLikeBase::constant_allpass_fn(LikeSearchState* state, const ColumnString& val,
                                              const StringRef& pattern,
                                              ColumnUInt8::Container& result) {
@@ -255,6 +331,14 @@ Status FunctionLikeBase::constant_substring_fn_scalar(LikeSearchState* state, co
 
 Status FunctionLikeBase::constant_regex_fn_scalar(LikeSearchState* state, const StringRef& val,
                                                   const StringRef& pattern, unsigned char* result) {
+    if (state->has_required_literals()) {
+        *result = state->match_required_literals(val);
+        if (!*result || state->literals_only) {
+            return Status::OK();
+        }
+        *result = 0;
+    }
+
     if (state->hs_database) { // use hyperscan
         auto ret = hs_scan(state->hs_database.get(), val.data, val.size, 0, state->hs_scratch.get(),
                            doris::vectorized::LikeSearchState::hs_match_handler, (void*)result);
@@ -302,8 +386,24 @@ Status FunctionLikeBase::constant_regex_fn(LikeSearchState* state, const ColumnS
                                            const StringRef& pattern,
                                            ColumnUInt8::Container& result) {
     auto sz = val.size();
+    // rows without the required literals can not match, so the regex only runs on the
+    // candidate rows marked by the literal search
+    const bool prefiltered = state->has_required_literals();
+    if (prefiltered) {
+        state->search_required_literals(val, result);
+        if (state->literals_only) {
+            return Status::OK();
+        }
+    }
+
     if (state->hs_database) { // use hyperscan
         for (size_t i = 0; i < sz; i++) {
+            if (prefiltered) {
+                if (!result[i]) {
+                    continue;
+                }
+                result[i] = 0;
+            }
             const auto& str_ref = val.get_data_at(i);
             auto ret = hs_scan(state->hs_database.get(), str_ref.data, str_ref.size, 0,
                                state->hs_scratch.get(),
@@ -315,6 +415,9 @@ Status FunctionLikeBase::constant_regex_fn(LikeSearchState* state, const ColumnS
         }
     } else { // fallback to re2
         for (size_t i = 0; i < sz; i++) {
+            if (prefiltered && !result[i]) {
+                continue;
+            }
             const auto& str_ref = val.get_data_at(i);
             *(result.data() + i) = RE2::PartialMatch(re2::StringPiece(str_ref.data, str_ref.size),
                                                      *state->regex.get());
@@ -371,8 +474,24 @@ Status FunctionLikeBase::constant_regex_fn_predicate(LikeSearchState* state,
                                                      const uint16_t* sel, size_t sz) {
     auto data_ptr = reinterpret_cast<const StringRef*>(val.get_data().data());
 
+    const bool prefiltered = state->has_required_literals();
+    if (prefiltered) {
+        for (size_t i = 0; i < sz; i++) {
+            result[i] = state->match_required_literals(data_ptr[sel[i]]);
+        }
+        if (state->literals_only) {
+            return Status::OK();
+        }
+    }
+
     if (state->hs_database) { // use hyperscan
         for (size_t i = 0; i < sz; i++) {
+            if (prefiltered) {
+                if (!result[i]) {
+                    continue;
+                }
+                result[i] = 0;
+            }
             auto ret = hs_scan(state->hs_database.get(), data_ptr[sel[i]].data,
                                data_ptr[sel[i]].size, 0, state->hs_scratch.get(),
                                doris::vectorized::LikeSearchState::hs_match_handler,
@@ -383,6 +502,9 @@ Status FunctionLikeBase::constant_regex_fn_predicate(LikeSearchState* state,
         }
     } else { // fallback to re2
         for (size_t i = 0; i < sz; i++) {
+            if (prefiltered && !result[i]) {
+                continue;
+            }
             *(result.data() + i) = RE2::PartialMatch(
                     re2::StringPiece(data_ptr[sel[i]].data, data_ptr[sel[i]].size),
                     *state->regex.get());
@@ -654,6 +776,124 @@ void FunctionLike::remove_escape_character(std::string* search_string) {
     }
 }
 
+void FunctionLike::extract_required_literals(const std::string& pattern, char escape_char,
+                                             std::vector<std::string>* literals,
+                                             bool* literals_only) {
+    literals->clear();
+    // without `_`, a pattern like `%a%b%` is exactly "contains a, then b"
+    *literals_only = pattern.size() > 1 && pattern.front() == '%';
+
+    std::string literal;
+    bool is_escaped = false;
+    bool ends_with_wildcard = false;
+    for (char c : pattern) {
+        ends_with_wildcard = false;
+        if (!is_escaped && (c == '%' || c == '_')) {
+            if (c == '_') {
+                *literals_only = false;
+            }
+            ends_with_wildcard = c == '%';
+            if (!literal.empty()) {
+                literals->emplace_back(std::move(literal));
+                literal.clear();
+            }
+        } else if (!is_escaped && c == escape_char) {
+            is_escaped = true;
+        } else {
+            literal.append(1, c);
+            is_escaped = false;
+        }
+    }
+    if (!literal.empty()) {
+        literals->emplace_back(std::move(literal));
+    }
+    *literals_only = *literals_only && ends_with_wildcard;
+}
+
+// Collect the literal runs that every match of a regex must contain. It is conservative:
+// alternations and inline flags give up, groups stop the extraction, and a character
+// followed by an optional quantifier is dropped.
+static void extract_regex_required_literals(const std::string& pattern,
+                                            std::vector<std::string>* literals) {
+    literals->clear();
+    if (pattern.find('|') != std::string::npos || pattern.find("(?") != std::string::npos) {
+        return;
+    }
+
+    std::string literal;
+    auto flush = [&]() {
+        if (!literal.empty()) {
+            literals->emplace_back(std::move(literal));
+            literal.clear();
+        }
+    };
+    auto pop_last_char = [&]() {
+        // drop a whole utf-8 character
+        while (!literal.empty() && (static_cast<uint8_t>(literal.back()) & 0xC0) == 0x80) {
+            literal.pop_back();
+        }
+        if (!literal.empty()) {
+            literal.pop_back();
+        }
+    };
+
+    const size_t size = pattern.size();
+    for (size_t i = 0; i < size; ++i) {
+        char c = pattern[i];
+        if (c == '\\') {
+            if (i + 1 >= size || std::isalnum(static_cast<unsigned char>(pattern[i + 1]))) {
+                // character classes, hex and unicode escapes, quoting, ...
+                break;
+            }
+            literal.append(1, pattern[++i]);
+        } else if (c == '(') {
+            break;
+        } else if (c == '[') {
+            flush();
+            // skip the bracket expression, `]` right after `[` or `[^` is a literal
+            size_t j = i + 1;
+            if (j < size && pattern[j] == '^') {
+                ++j;
+            }
+            if (j < size && pattern[j] == ']') {
+                ++j;
+            }
+            while (j < size && pattern[j] != ']') {
+                if (pattern[j] == '\\') {
+                    ++j;
+                } else if (pattern[j] == '[' && j + 1 < size && pattern[j + 1] == ':') {
+                    auto class_end = pattern.find(":]", j + 2);
+                    if (class_end == std::string::npos) {
+                        break;
+                    }
+                    j = class_end + 1;
+                }
+                ++j;
+            }
+            if (j >= size) {
+                break;
+            }
+            i = j;
+        } else if (c == '?' || c == '*') {
+            pop_last_char();
+            flush();
+        } else if (c == '{') {
+            pop_last_char();
+            flush();
+            auto brace_end = pattern.find('}', i + 1);
+            if (brace_end == std::string::npos) {
+                break;
+            }
+            i = brace_end;
+        } else if (c == '+' || c == '.' || c == '^' || c == '$') {
+            flush();
+        } else {
+            literal.append(1, c);
+        }
+    }
+    flush();
+}
+
 bool re2_full_match(const std::string& str, const RE2& re, std::vector<std::string>& results) {
     if (!re.ok()) {
         return false;
@@ -799,6 +1039,12 @@ Status FunctionLike::open(FunctionContext* context, FunctionContext::FunctionSta
                 }
             }
 
+            std::vector<std::string> literals;
+            bool literals_only = false;
+            extract_required_literals(pattern_str, state->search_state.escape_char, &literals,
+                                      &literals_only);
+            state->search_state.set_required_literals(std::move(literals), literals_only);
+
             state->function = constant_regex_fn;
             state->predicate_like_function = constant_regex_fn_predicate;
             state->scalar_function = constant_regex_fn_scalar;
@@ -867,6 +1113,10 @@ Status FunctionRegexp::open(FunctionContext* context, FunctionContext::FunctionS
                     return Status::InternalError("Invalid regex expression: {}", pattern_str);
                 }
             }
+            std::vector<std::string> literals;
+            extract_regex_required_literals(pattern_str, &literals);
+            state->search_state.set_required_literals(std::move(literals), false);
+
             state->function = constant_regex_fn;
             state->predicate_like_function = constant_regex_fn_predicate;
             state->scalar_function = constant_regex_fn_scalar;
@@ -28,6 +28,7 @@
 #include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "common/status.h"
 #include "runtime/define_primitive_type.h"
@@ -38,6 +39,7 @@
 #include "vec/columns/columns_number.h"
 #include "vec/columns/predicate_column.h"
 #include "vec/common/string_ref.h"
+#include "vec/common/string_searcher.h"
 #include "vec/core/column_numbers.h"
 #include "vec/core/types.h"
 #include "vec/data_types/data_type_number.h"
@@ -101,10 +103,29 @@ struct LikeSearchState {
         return 1;
     }
 
+    /// Literals that every matched value must contain, in the order of the constant pattern
+    /// evaluated by hyperscan or re2. The longest one is searched in the whole chars buffer
+    /// of the column first, and the regex only runs on the rows containing all of them.
+    std::vector<std::string> required_literals;
+    std::vector<ASCIICaseSensitiveStringSearcher> literal_searchers;
+    size_t longest_literal_index = 0;
+    /// The pattern is like `%literal1%literal2%`, so matching the literals in order is the
+    /// whole match and the regex does not need to run at all.
+    bool literals_only = false;
+
     LikeSearchState() : escape_char('\\') {}
 
     Status clone(LikeSearchState& cloned);
 
+    void set_required_literals(std::vector<std::string> literals, bool literals_only_arg);
+
+    bool has_required_literals() const { return !literal_searchers.empty(); }
+
+    /// Set result to 1 for the rows containing all the required literals, and 0 for the others.
+    void search_required_literals(const ColumnString& val, ColumnUInt8::Container& result) const;
+
+    bool match_required_literals(const StringRef& val) const;
+
     void set_search_string(const std::string& search_string_arg) {
         search_string = search_string_arg;
         search_string_sv = StringRef(search_string);
@@ -269,6 +290,10 @@ private:
                                      std::string* re_pattern);
 
     static void remove_escape_character(std::string* search_string);
+
+    /// Split the pattern by the wildcards, every literal between them is required.
+    static void extract_required_literals(const std::string& pattern, char escape_char,
+                                          std::vector<std::string>* literals, bool* literals_only);
 };
 
 class FunctionRegexp : public FunctionLikeBase {
@@ -143,6 +143,7 @@ Status VCollectIterator::build_heap(std::vector<RowsetReaderSharedPtr>& rs_reade
         // build merge heap with two children, a base rowset as level0iterator and
         // other cumulative rowsets as a level1iterator
         if (_children.size() > 1) {
+            _reader->_stats.merged_rowset_number += _children.size();
             // find 'base rowset', 'base rowset' is the rowset which contains the max row number
             int64_t max_row_num = 0;
             int base_reader_idx = 0;
@@ -88,16 +88,30 @@ Status RowSourcesBuffer::append(const std::vector<RowSource>& row_sources) {
 Status RowSourcesBuffer::seek_to_begin() {
     _buf_idx = 0;
     if (_fd > 0) {
-        auto offset = lseek(_fd, 0, SEEK_SET);
-        if (offset != 0) {
-            LOG(WARNING) << "failed to seek to 0";
-            return Status::InternalError("failed to seek to 0");
-        }
+        _read_offset = 0;
         _reset_buffer();
     }
     return Status::OK();
 }
 
+Status RowSourcesBuffer::persist() {
+    RETURN_IF_ERROR(_create_buffer_file());
+    RETURN_IF_ERROR(flush());
+    return seek_to_begin();
+}
+
+Status RowSourcesBuffer::create_reader(std::unique_ptr<RowSourcesBuffer>* reader) const {
+    if (_fd < 0 || !_buffer->empty()) {
+        return Status::InternalError("row sources buffer of tablet {} is not persisted",
+                                     _tablet_id);
+    }
+    reader->reset(new RowSourcesBuffer(_tablet_id, _tablet_path, _reader_type));
+    (*reader)->_fd = _fd;
+    (*reader)->_owns_fd = false;
+    (*reader)->_total_size = _total_size;
+    return Status::OK();
+}
+
 Status RowSourcesBuffer::has_remaining() {
     if (_buf_idx < _buffer->size()) {
         return Status::OK();
@@ -196,30 +210,33 @@ Status RowSourcesBuffer::flush() {
 }
 
 Status RowSourcesBuffer::_serialize() {
-    size_t rows = _buffer->size();
-    if (rows == 0) {
-        return Status::OK();
-    }
-    // write size
-    ssize_t bytes_written = ::write(_fd, &rows, sizeof(rows));
-    if (bytes_written != sizeof(size_t)) {
-        LOG(WARNING) << "failed to write buffer size to file, bytes_written=" << bytes_written;
-        return Status::InternalError("fail to write buffer size to file");
-    }
-    // write data
-    StringRef ref = _buffer->get_raw_data();
-    bytes_written = ::write(_fd, ref.data, ref.size * sizeof(UInt16));
-    if (bytes_written != _buffer->byte_size()) {
-        LOG(WARNING) << "failed to write buffer data to file, bytes_written=" << bytes_written
-                     << " buffer size=" << _buffer->byte_size();
-        return Status::InternalError("fail to write buffer size to file");
+    // Write in batches of limited size, so that a reader only needs to hold a batch.
+    constexpr size_t max_batch_rows = 1024 * 1024;
+    const UInt16* data = _buffer->get_data().data();
+    for (size_t offset = 0; offset < _buffer->size(); offset += max_batch_rows) {
+        size_t rows = std::min(max_batch_rows, _buffer->size() - offset);
+        // write size
+        ssize_t bytes_written = ::write(_fd, &rows, sizeof(rows));
+        if (bytes_written != sizeof(size_t)) {
+            LOG(WARNING) << "failed to write buffer size to file, bytes_written="
+                         << bytes_written;
+            return Status::InternalError("fail to write buffer size to file");
+        }
+        // write data
+        bytes_written = ::write(_fd, data + offset, rows * sizeof(UInt16));
+        if (bytes_written != rows * sizeof(UInt16)) {
+            LOG(WARNING) << "failed to write buffer data to file, bytes_written="
+                         << bytes_written << " buffer size=" << rows * sizeof(UInt16);
+            return Status::InternalError("fail to write buffer size to file");
+        }
     }
     return Status::OK();
 }
 
 Status RowSourcesBuffer::_deserialize() {
+    // Read by offset instead of the file position, which is shared with the readers.
     size_t rows = 0;
-    ssize_t bytes_read = ::read(_fd, &rows, sizeof(rows));
+    ssize_t bytes_read = ::pread(_fd, &rows, sizeof(rows), _read_offset);
     if (bytes_read == 0) {
         LOG(WARNING) << "end of row source buffer file";
         return Status::EndOfFile("end of row source buffer file");
@@ -227,14 +244,16 @@ Status RowSourcesBuffer::_deserialize() {
         LOG(WARNING) << "failed to read buffer size from file, bytes_read=" << bytes_read;
         return Status::InternalError("failed to read buffer size from file");
     }
+    _read_offset += sizeof(rows);
     _buffer->resize(rows);
     auto& internal_data = _buffer->get_data();
-    bytes_read = ::read(_fd, internal_data.data(), rows * sizeof(UInt16));
+    bytes_read = ::pread(_fd, internal_data.data(), rows * sizeof(UInt16), _read_offset);
     if (bytes_read != rows * sizeof(UInt16)) {
         LOG(WARNING) << "failed to read buffer data from file, bytes_read=" << bytes_read
                      << ", expect bytes=" << rows * sizeof(UInt16);
         return Status::InternalError("failed to read buffer data from file");
     }
+    _read_offset += rows * sizeof(UInt16);
     return Status::OK();
 }
 
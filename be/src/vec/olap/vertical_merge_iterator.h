@@ -91,7 +91,7 @@ public:
 
     ~RowSourcesBuffer() {
         _reset_buffer();
-        if (_fd > 0) {
+        if (_fd > 0 && _owns_fd) {
             ::close(_fd);
         }
     }
@@ -100,6 +100,15 @@ public:
     Status append(const std::vector<RowSource>& row_sources);
     Status flush();
 
+    // Create a buffer reading all the row sources from begin, with its own read position.
+    // Readers can be used concurrently with each other and this buffer, all the row sources
+    // are moved to the buffer file for that. Must be called after all row sources are
+    // appended and before this buffer is read.
+    // Write all the row sources into the buffer file, after that readers can be created
+    // concurrently by create_reader(), which only shares the file.
+    Status persist();
+    Status create_reader(std::unique_ptr<RowSourcesBuffer>* reader) const;
+
     RowSource current() {
         DCHECK(_buf_idx < _buffer->size());
         return RowSource(_buffer->get_element(_buf_idx));
@@ -138,6 +147,10 @@ private:
     ReaderType _reader_type = ReaderType::UNKNOWN;
     uint64_t _buf_idx = 0;
     int _fd = -1;
+    // readers created by create_reader() share the buffer file of their creator
+    bool _owns_fd = true;
+    // position of the next serialized batch to read in the buffer file
+    uint64_t _read_offset = 0;
     ColumnUInt16::MutablePtr _buffer;
     uint64_t _total_size = 0;
 };
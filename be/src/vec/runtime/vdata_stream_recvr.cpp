@@ -103,6 +103,8 @@ Status VDataStreamRecvr::SenderQueue::_inner_get_batch_without_lock(Block* block
         closure_pair.second.stop();
         _recvr->_buffer_full_total_timer->update(closure_pair.second.elapsed_time());
     }
+    // the memory of the receiver is released, the local senders may be able to write
+    _recvr->_write_dependency.notify();
     block->swap(*next_block);
     *eos = false;
     return Status::OK();
@@ -170,6 +172,7 @@ void VDataStreamRecvr::SenderQueue::add_block(const PBlock& pblock, int be_numbe
     }
     _recvr->_blocks_memory_usage->add(block_byte_size);
     _data_arrival_cv.notify_one();
+    _recvr->_read_dependency.notify();
 }
 
 void VDataStreamRecvr::SenderQueue::add_block(Block* block, bool use_move) {
@@ -207,6 +210,7 @@ void VDataStreamRecvr::SenderQueue::add_block(Block* block, bool use_move) {
 
     _block_queue.emplace_back(std::move(nblock), block_mem_size);
     _data_arrival_cv.notify_one();
+    _recvr->_read_dependency.notify();
 
     if (_recvr->exceeds_limit(block_mem_size)) {
         // yiguolei
@@ -238,6 +242,7 @@ void VDataStreamRecvr::SenderQueue::decrement_senders(int be_number) {
               << " node_id=" << _recvr->dest_node_id() << " #senders=" << _num_remaining_senders;
     if (_num_remaining_senders == 0) {
         _data_arrival_cv.notify_one();
+        _recvr->_read_dependency.notify();
     }
 }
 
@@ -254,6 +259,8 @@ void VDataStreamRecvr::SenderQueue::cancel() {
     // Wake up all threads waiting to produce/consume batches.  They will all
     // notice that the stream is cancelled and handle it.
     _data_arrival_cv.notify_all();
+    _recvr->_read_dependency.notify();
+    _recvr->_write_dependency.notify();
     // _data_removal_cv.notify_all();
     // PeriodicCounterUpdater::StopTimeSeriesCounter(
     //         _recvr->_bytes_received_time_series_counter);
@@ -427,6 +434,8 @@ void VDataStreamRecvr::close() {
     _mgr = nullptr;
 
     _merger.reset();
+    // the local senders do not wait for a closed receiver
+    _write_dependency.notify();
     if (_peak_memory_usage_counter) {
         _peak_memory_usage_counter->set(_mem_tracker->peak_consumption());
     }
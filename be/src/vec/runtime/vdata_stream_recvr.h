@@ -40,6 +40,7 @@
 #include "common/global_types.h"
 #include "common/object_pool.h"
 #include "common/status.h"
+#include "pipeline/wakeup_dependency.h"
 #include "runtime/descriptors.h"
 #include "runtime/query_statistics.h"
 #include "util/runtime_profile.h"
@@ -109,6 +110,11 @@ public:
 
     bool is_closed() const { return _is_closed; }
 
+    // Notified when blocks arrive, the senders finish or the stream is cancelled.
+    pipeline::WakeupDependency* read_dependency() { return &_read_dependency; }
+    // Notified when the memory of the blocks is released or the receiver is closed.
+    pipeline::WakeupDependency* write_dependency() { return &_write_dependency; }
+
 private:
     class SenderQueue;
     class PipSenderQueue;
@@ -164,6 +170,9 @@ private:
     std::shared_ptr<QueryStatisticsRecvr> _sub_plan_query_statistics_recvr;
 
     bool _enable_pipeline;
+
+    pipeline::WakeupDependency _read_dependency;
+    pipeline::WakeupDependency _write_dependency;
 };
 
 class ThreadClosure : public google::protobuf::Closure {
@@ -269,6 +278,7 @@ public:
             _recvr->_blocks_memory_usage->add(block_mem_size);
             _data_arrival_cv.notify_one();
         }
+        _recvr->_read_dependency.notify();
     }
 };
 } // namespace vectorized
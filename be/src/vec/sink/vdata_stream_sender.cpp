@@ -812,4 +812,17 @@ bool VDataStreamSender::channel_all_can_write() {
     }
 }
 
+pipeline::WakeupDependency* VDataStreamSender::channel_write_dependency() {
+    if ((_part_type == TPartitionType::UNPARTITIONED || _channels.size() == 1) &&
+        !_only_local_exchange) {
+        return nullptr;
+    }
+    for (auto channel : _channels) {
+        if (!channel->can_write()) {
+            return channel->_local_recvr->write_dependency();
+        }
+    }
+    return nullptr;
+}
+
 } // namespace doris::vectorized
@@ -120,6 +120,11 @@ public:
 
     bool channel_all_can_write();
 
+    // The receiver of a local channel that can not be written, which notifies when the channel
+    // may be written again. nullptr if the broadcast buffer is used, its blocks are released when
+    // the rpcs of the ExchangeSinkBuffer finish.
+    pipeline::WakeupDependency* channel_write_dependency();
+
     const RowDescriptor& row_desc() { return _row_desc; }
 
 protected:
@@ -30,6 +30,7 @@
 #include "exec/tablet_info.h"
 #include "runtime/descriptors.h"
 #include "runtime/runtime_state.h"
+#include "util/bitmap.h"
 #include "vec/core/block.h"
 
 namespace doris {
@@ -85,5 +86,73 @@ Status OlapTabletFinder::find_tablet(RuntimeState* state, vectorized::Block* blo
     return status;
 }
 
+Status OlapTabletFinder::find_tablets(RuntimeState* state, vectorized::Block* block,
+                                      size_t num_rows, const Bitmap* filter_bitmap,
+                                      std::vector<const VOlapTablePartition*>& partitions,
+                                      std::vector<uint32_t>& tablet_indexes,
+                                      bool& stop_processing) {
+    _vpartition->find_partitions(block, num_rows, partitions);
+
+    const VOlapTablePartition* last_partition = nullptr;
+    for (size_t row = 0; row < num_rows; ++row) {
+        if (filter_bitmap != nullptr && filter_bitmap->Get(row)) {
+            partitions[row] = nullptr;
+            continue;
+        }
+        const auto* partition = partitions[row];
+        if (partition == nullptr) {
+            RETURN_IF_ERROR(state->append_error_msg_to_file(
+                    []() -> std::string { return ""; },
+                    [&]() -> std::string {
+                        fmt::memory_buffer buf;
+                        fmt::format_to(buf, "no partition for this tuple. tuple={}",
+                                       block->dump_data(row, 1));
+                        return fmt::to_string(buf);
+                    },
+                    &stop_processing));
+            _num_filtered_rows++;
+            if (stop_processing) {
+                return Status::EndOfFile("Encountered unqualified data, stop processing");
+            }
+            continue;
+        }
+        if (!partition->is_mutable) {
+            _num_immutable_partition_filtered_rows++;
+            partitions[row] = nullptr;
+            continue;
+        }
+        if (partition != last_partition) {
+            if (partition->num_buckets <= 0) {
+                return Status::InternalError("num_buckets must be greater than 0, num_buckets={}",
+                                             partition->num_buckets);
+            }
+            _partition_ids.emplace(partition->id);
+            last_partition = partition;
+        }
+    }
+
+    if (_find_tablet_mode == FindTabletMode::FIND_TABLET_EVERY_ROW) {
+        _vpartition->find_tablets(block, num_rows, partitions, tablet_indexes);
+        return Status::OK();
+    }
+    // all rows of a partition go to the same tablet
+    tablet_indexes.assign(num_rows, 0);
+    for (size_t row = 0; row < num_rows; ++row) {
+        const auto* partition = partitions[row];
+        if (partition == nullptr) {
+            continue;
+        }
+        auto it = _partition_to_tablet_map.find(partition->id);
+        if (it == _partition_to_tablet_map.end()) {
+            BlockRow block_row = {block, static_cast<int32_t>(row)};
+            it = _partition_to_tablet_map
+                         .emplace(partition->id, _vpartition->find_tablet(&block_row, *partition))
+                         .first;
+        }
+        tablet_indexes[row] = it->second;
+    }
+    return Status::OK();
+}
+
 } // namespace stream_load
 } // namespace doris
\ No newline at end of file
@@ -24,6 +24,7 @@
 #include "vec/core/block.h"
 
 namespace doris {
+class Bitmap;
 namespace stream_load {
 
 class OlapTabletFinder {
@@ -43,6 +44,13 @@ public:
                        const VOlapTablePartition** partition, uint32_t& tablet_index,
                        bool& filtered, bool& is_continue);
 
+    // Find the partitions and tablets of the first `num_rows' rows in block at once. The rows
+    // set in `filter_bitmap', or not loaded for other reasons, get a nullptr partition.
+    Status find_tablets(RuntimeState* state, vectorized::Block* block, size_t num_rows,
+                        const Bitmap* filter_bitmap,
+                        std::vector<const VOlapTablePartition*>& partitions,
+                        std::vector<uint32_t>& tablet_indexes, bool& stop_processing);
+
     bool is_find_tablet_every_sink() {
         return _find_tablet_mode == FindTabletMode::FIND_TABLET_EVERY_SINK;
     }
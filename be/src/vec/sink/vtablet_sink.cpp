@@ -55,6 +55,7 @@
 #include "runtime/define_primitive_type.h"
 #include "runtime/descriptors.h"
 #include "runtime/exec_env.h"
+#include "runtime/load_channel_mgr.h"
 #include "runtime/runtime_state.h"
 #include "runtime/thread_context.h"
 #include "service/backend_options.h"
@@ -284,6 +285,9 @@ Status VNodeChannel::init(RuntimeState* state) {
                                      _node_info.host, _node_info.brpc_port, channel_info());
     }
 
+    _is_local = _node_info.host == BackendOptions::get_localhost() &&
+                _node_info.brpc_port == config::brpc_port;
+
     _rpc_timeout_ms = state->execution_timeout() * 1000;
     _timeout_watch.start();
 
@@ -681,6 +685,13 @@ void VNodeChannel::try_send_block(RuntimeState* state) {
     // tablet_ids has already set when add row
     request.set_packet_seq(_next_packet_seq);
     auto block = mutable_block->to_block();
+    // The eos request is still sent by rpc, so the tablets channel is closed asynchronously.
+    bool send_local = _is_local && config::enable_local_tablet_writer_add_block && !request.eos();
+    if (send_local) {
+        _add_block_locally(request, block);
+        _next_packet_seq++;
+        return;
+    }
     if (block.rows() > 0) {
         SCOPED_ATOMIC_TIMER(&_serialize_batch_ns);
         size_t uncompressed_bytes = 0, compressed_bytes = 0;
@@ -789,6 +800,33 @@ void VNodeChannel::try_send_block(RuntimeState* state) {
     _next_packet_seq++;
 }
 
+void VNodeChannel::_add_block_locally(const PTabletWriterAddBlockRequest& request,
+                                      const vectorized::Block& block) {
+    // No rpc is sent, so the controller is not reset. A new call id would be created by reset()
+    // and never be used, and join() could wait on it. The eos request resets it before the rpc.
+    _add_block_closure->result.Clear();
+    {
+        // the memory of the memtables written here belongs to the load, unlike the rpc path
+        SCOPED_SWITCH_THREAD_MEM_TRACKER_LIMITER(_state->query_mem_tracker());
+        int64_t execution_time_ns = 0;
+        Status st;
+        {
+            SCOPED_RAW_TIMER(&execution_time_ns);
+            st = _state->exec_env()->load_channel_mgr()->add_batch(
+                    request, &_add_block_closure->result, block.rows() > 0 ? &block : nullptr);
+        }
+        if (!st.ok()) {
+            LOG(WARNING) << "tablet writer add block locally failed, " << channel_info()
+                         << ", err=" << st;
+        }
+        st.to_protobuf(_add_block_closure->result.mutable_status());
+        _add_block_closure->result.set_execution_time_us(execution_time_ns / NANOS_PER_MICRO);
+        _add_block_closure->result.set_wait_execution_time_us(0);
+    }
+    // the result is handled the same as a finished rpc
+    _add_block_closure->Run();
+}
+
 void VNodeChannel::cancel(const std::string& cancel_msg) {
     if (_is_closed) {
         // skip the channels that have been canceled or close_wait.
@@ -1251,20 +1289,19 @@ Status VOlapTableSink::send(RuntimeState* state, vectorized::Block* input_block,
         RETURN_IF_ERROR(_single_partition_generate(state, block.get(), channel_to_payload, num_rows,
                                                    has_filtered_rows));
     } else {
+        std::vector<const VOlapTablePartition*> partitions;
+        std::vector<uint32_t> tablet_indexes;
+        RETURN_IF_ERROR(_tablet_finder->find_tablets(
+                state, block.get(), num_rows,
+                has_filtered_rows ? &_block_convertor->filter_bitmap() : nullptr, partitions,
+                tablet_indexes, stop_processing));
         for (int i = 0; i < num_rows; ++i) {
-            if (UNLIKELY(has_filtered_rows) && _block_convertor->filter_bitmap().Get(i)) {
-                continue;
-            }
-            const VOlapTablePartition* partition = nullptr;
-            bool is_continue = false;
-            uint32_t tablet_index = 0;
-            RETURN_IF_ERROR(_tablet_finder->find_tablet(
-                    state, block.get(), i, &partition, tablet_index, stop_processing, is_continue));
-            if (is_continue) {
+            if (partitions[i] == nullptr) {
                 continue;
             }
             // each row
-            _generate_row_distribution_payload(channel_to_payload, partition, tablet_index, i, 1);
+            _generate_row_distribution_payload(channel_to_payload, partitions[i],
+                                               tablet_indexes[i], i, 1);
         }
     }
     _row_distribution_watch.stop();
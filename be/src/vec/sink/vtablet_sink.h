@@ -302,6 +302,9 @@ public:
 protected:
     void _close_check();
     void _cancel_with_msg(const std::string& msg);
+    // Write the block of request into the load channel of this BE in process.
+    void _add_block_locally(const PTabletWriterAddBlockRequest& request,
+                            const vectorized::Block& block);
 
     VOlapTableSink* _parent = nullptr;
     IndexChannel* _index_channel = nullptr;
@@ -345,6 +348,8 @@ protected:
     std::atomic<int> _pending_batches_num {0}; // reuse for vectorized
 
     std::shared_ptr<PBackendService_Stub> _stub = nullptr;
+    // whether the node is this BE, the blocks are handed to its load channel in process then
+    bool _is_local = false;
     RefCountClosure<PTabletWriterOpenResult>* _open_closure = nullptr;
 
     std::vector<TTabletWithPartition> _all_tablets;
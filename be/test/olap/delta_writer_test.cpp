@@ -26,6 +26,7 @@
 #include <iostream>
 #include <map>
 #include <memory>
+#include <numeric>
 #include <string>
 #include <utility>
 
@@ -307,6 +308,51 @@ static void create_tablet_request_with_sequence_col(int64_t tablet_id, int32_t s
     request->tablet_schema.columns.push_back(sequence_col);
 }
 
+static void create_tablet_request_with_dup_keys(int64_t tablet_id, int32_t schema_hash,
+                                                TCreateTabletReq* request) {
+    request->tablet_id = tablet_id;
+    request->__set_version(1);
+    request->tablet_schema.schema_hash = schema_hash;
+    request->tablet_schema.short_key_column_count = 1;
+    request->tablet_schema.keys_type = TKeysType::DUP_KEYS;
+    request->tablet_schema.storage_type = TStorageType::COLUMN;
+    request->__set_storage_format(TStorageFormat::V2);
+
+    TColumn k1;
+    k1.column_name = "k1";
+    k1.__set_is_key(true);
+    k1.column_type.type = TPrimitiveType::INT;
+    request->tablet_schema.columns.push_back(k1);
+
+    TColumn v1;
+    v1.column_name = "v1";
+    v1.__set_is_key(false);
+    v1.column_type.type = TPrimitiveType::BIGINT;
+    v1.__set_aggregation_type(TAggregationType::NONE);
+    request->tablet_schema.columns.push_back(v1);
+}
+
+static TDescriptorTable create_descriptor_tablet_with_dup_keys() {
+    TDescriptorTableBuilder dtb;
+    TTupleDescriptorBuilder tuple_builder;
+
+    tuple_builder.add_slot(TSlotDescriptorBuilder()
+                                   .type(TYPE_INT)
+                                   .column_name("k1")
+                                   .column_pos(0)
+                                   .nullable(false)
+                                   .build());
+    tuple_builder.add_slot(TSlotDescriptorBuilder()
+                                   .type(TYPE_BIGINT)
+                                   .column_name("v1")
+                                   .column_pos(1)
+                                   .nullable(false)
+                                   .build());
+    tuple_builder.build(&dtb);
+
+    return dtb.desc_tbl();
+}
+
 static TDescriptorTable create_descriptor_tablet() {
     TDescriptorTableBuilder dtb;
     TTupleDescriptorBuilder tuple_builder;
@@ -464,6 +510,8 @@ public:
     ~TestDeltaWriter() {}
     static void SetUpTestSuite() {
         config::min_file_descriptor_number = 100;
+        // the split flush pool is only created when the engine is opened
+        config::flush_split_thread_num_per_store = 2;
         set_up();
     }
 
@@ -681,6 +729,118 @@ TEST_F(TestDeltaWriter, vec_write) {
     delete delta_writer;
 }
 
+TEST_F(TestDeltaWriter, vec_split_flush) {
+    RuntimeProfile profile("CreateTablet");
+    TCreateTabletReq request;
+    create_tablet_request_with_dup_keys(10006, 270068378, &request);
+    Status res = k_engine->create_tablet(request, &profile);
+    ASSERT_TRUE(res.ok());
+
+    TDescriptorTable tdesc_tbl = create_descriptor_tablet_with_dup_keys();
+    ObjectPool obj_pool;
+    DescriptorTbl* desc_tbl = nullptr;
+    DescriptorTbl::create(&obj_pool, tdesc_tbl, &desc_tbl);
+    TupleDescriptor* tuple_desc = desc_tbl->get_tuple_descriptor(0);
+    OlapTableSchemaParam param;
+
+    PUniqueId load_id;
+    load_id.set_hi(0);
+    load_id.set_lo(0);
+    WriteRequest write_req;
+    write_req.tablet_id = 10006;
+    write_req.schema_hash = 270068378;
+    write_req.txn_id = 20004;
+    write_req.partition_id = 30004;
+    write_req.load_id = load_id;
+    write_req.tuple_desc = tuple_desc;
+    write_req.slots = &(tuple_desc->slots());
+    write_req.is_high_priority = false;
+    write_req.table_schema_param = &param;
+    DeltaWriter* delta_writer = nullptr;
+    RuntimeProfile writer_profile("LoadChannels");
+    DeltaWriter::open(&write_req, &delta_writer, &writer_profile, TUniqueId());
+    ASSERT_NE(delta_writer, nullptr);
+
+    // the memtable of 1000 rows is split into 4 ranges of 250 rows
+    config::memtable_flush_split_min_rows = 100;
+    config::memtable_flush_split_max_num = 4;
+    const int num_rows = 1000;
+    const int num_segments = 4;
+    vectorized::Block block;
+    for (const auto& slot_desc : tuple_desc->slots()) {
+        block.insert(vectorized::ColumnWithTypeAndName(slot_desc->get_empty_mutable_column(),
+                                                       slot_desc->get_data_type_ptr(),
+                                                       slot_desc->col_name()));
+    }
+    {
+        auto columns = block.mutate_columns();
+        for (int i = 0; i < num_rows; ++i) {
+            // 7919 is a prime, so the keys are a shuffle of [0, num_rows)
+            int32_t k1 = i * 7919 % num_rows;
+            int64_t v1 = k1 * 10;
+            columns[0]->insert_data((const char*)&k1, sizeof(k1));
+            columns[1]->insert_data((const char*)&v1, sizeof(v1));
+        }
+    }
+    std::vector<int> row_idxs(num_rows);
+    std::iota(row_idxs.begin(), row_idxs.end(), 0);
+    res = delta_writer->write(&block, row_idxs);
+    ASSERT_TRUE(res.ok());
+
+    res = delta_writer->close();
+    ASSERT_TRUE(res.ok());
+    res = delta_writer->wait_flush();
+    ASSERT_TRUE(res.ok());
+    res = delta_writer->build_rowset();
+    ASSERT_TRUE(res.ok());
+    res = delta_writer->commit_txn(PSlaveTabletNodes(), false);
+    ASSERT_TRUE(res.ok());
+    config::memtable_flush_split_min_rows = 0;
+
+    std::map<TabletInfo, RowsetSharedPtr> tablet_related_rs;
+    StorageEngine::instance()->txn_manager()->get_txn_related_tablets(
+            write_req.txn_id, write_req.partition_id, &tablet_related_rs);
+    ASSERT_EQ(1, tablet_related_rs.size());
+    RowsetSharedPtr rowset = tablet_related_rs.begin()->second;
+    ASSERT_EQ(num_rows, rowset->num_rows());
+    ASSERT_EQ(num_segments, rowset->num_segments());
+    std::vector<segment_v2::SegmentSharedPtr> segments;
+    res = ((BetaRowset*)rowset.get())->load_segments(&segments);
+    ASSERT_TRUE(res.ok());
+    ASSERT_EQ(num_segments, segments.size());
+
+    // the segments are in key order, and so are the rows in each of them
+    int32_t expected_key = 0;
+    std::shared_ptr<Schema> schema = std::make_shared<Schema>(rowset->tablet_schema());
+    for (int i = 0; i < num_segments; ++i) {
+        OlapReaderStatistics stats;
+        StorageReadOptions opts;
+        opts.stats = &stats;
+        opts.tablet_schema = rowset->tablet_schema();
+        std::unique_ptr<RowwiseIterator> iter;
+        ASSERT_TRUE(segments[i]->new_iterator(schema, opts, &iter).ok());
+        ASSERT_EQ(num_rows / num_segments, static_cast<int>(segments[i]->num_rows()));
+        while (true) {
+            auto read_block = rowset->tablet_schema()->create_block();
+            res = iter->next_batch(&read_block);
+            if (res.is<ErrorCode::END_OF_FILE>()) {
+                break;
+            }
+            ASSERT_TRUE(res.ok());
+            for (size_t row = 0; row < read_block.rows(); ++row) {
+                ASSERT_EQ(expected_key, read_block.get_by_position(0).column->get_int(row));
+                ASSERT_EQ(expected_key * 10, read_block.get_by_position(1).column->get_int(row));
+                ++expected_key;
+            }
+        }
+        ASSERT_EQ(num_rows / num_segments * (i + 1), expected_key);
+    }
+
+    res = k_engine->tablet_manager()->drop_tablet(request.tablet_id, request.replica_id, false);
+    ASSERT_TRUE(res.ok());
+    delete delta_writer;
+}
+
 TEST_F(TestDeltaWriter, vec_sequence_col) {
     std::unique_ptr<RuntimeProfile> profile;
     profile = std::make_unique<RuntimeProfile>("CreateTablet");
@@ -1046,4 +1206,115 @@ TEST_F(TestDeltaWriter, vec_sequence_col_concurrent_write) {
     delete delta_writer1;
     delete delta_writer2;
 }
+
+TEST_F(TestDeltaWriter, vec_async_calc_delete_bitmap_on_flush) {
+    RuntimeProfile profile("CreateTablet");
+    TCreateTabletReq request;
+    create_tablet_request_with_sequence_col(10007, 270068379, &request, true);
+    Status res = k_engine->create_tablet(request, &profile);
+    ASSERT_TRUE(res.ok());
+    TabletSharedPtr tablet = k_engine->tablet_manager()->get_tablet(request.tablet_id);
+    ASSERT_NE(tablet, nullptr);
+
+    TDescriptorTable tdesc_tbl = create_descriptor_tablet_with_sequence_col();
+    ObjectPool obj_pool;
+    DescriptorTbl* desc_tbl = nullptr;
+    DescriptorTbl::create(&obj_pool, tdesc_tbl, &desc_tbl);
+    TupleDescriptor* tuple_desc = desc_tbl->get_tuple_descriptor(0);
+    OlapTableSchemaParam param;
+
+    // Each element of `segments' is the keys [first, second) of a segment, written with the
+    // sequence value `seq'.
+    auto load = [&](int64_t txn_id, const std::vector<std::pair<int8_t, int8_t>>& segments,
+                    int32_t seq, RuntimeProfile* writer_profile, DeltaWriter** delta_writer) {
+        PUniqueId load_id;
+        load_id.set_hi(0);
+        load_id.set_lo(txn_id);
+        WriteRequest write_req;
+        write_req.tablet_id = request.tablet_id;
+        write_req.schema_hash = request.tablet_schema.schema_hash;
+        write_req.txn_id = txn_id;
+        write_req.partition_id = 30005;
+        write_req.load_id = load_id;
+        write_req.tuple_desc = tuple_desc;
+        write_req.slots = &(tuple_desc->slots());
+        write_req.is_high_priority = false;
+        write_req.table_schema_param = &param;
+        DeltaWriter::open(&write_req, delta_writer, writer_profile, TUniqueId());
+        ASSERT_NE(*delta_writer, nullptr);
+
+        for (const auto& [first, last] : segments) {
+            vectorized::Block block;
+            for (const auto& slot_desc : tuple_desc->slots()) {
+                block.insert(vectorized::ColumnWithTypeAndName(
+                        slot_desc->get_empty_mutable_column(), slot_desc->get_data_type_ptr(),
+                        slot_desc->col_name()));
+            }
+            for (int8_t k1 = first; k1 < last; ++k1) {
+                generate_data(&block, k1, 123, seq);
+            }
+            std::vector<int> row_idxs(last - first);
+            std::iota(row_idxs.begin(), row_idxs.end(), 0);
+            ASSERT_TRUE((*delta_writer)->write(&block, row_idxs).ok());
+            // each range of keys is flushed to a segment of its own
+            ASSERT_TRUE((*delta_writer)->memtable_writer()->flush_memtable_and_wait(true).ok());
+        }
+        ASSERT_TRUE((*delta_writer)->close().ok());
+        ASSERT_TRUE((*delta_writer)->wait_flush().ok());
+        ASSERT_TRUE((*delta_writer)->build_rowset().ok());
+        ASSERT_TRUE((*delta_writer)->submit_calc_delete_bitmap_task().ok());
+        ASSERT_TRUE((*delta_writer)->wait_calc_delete_bitmap().ok());
+        ASSERT_TRUE((*delta_writer)->commit_txn(PSlaveTabletNodes(), false).ok());
+    };
+    auto get_rowset = [&](int64_t txn_id) {
+        std::map<TabletInfo, RowsetSharedPtr> tablet_related_rs;
+        StorageEngine::instance()->txn_manager()->get_txn_related_tablets(txn_id, 30005,
+                                                                          &tablet_related_rs);
+        EXPECT_EQ(1, tablet_related_rs.size());
+        return tablet_related_rs.begin()->second;
+    };
+
+    // the first load writes the keys [0, 60), and is published
+    RuntimeProfile writer_profile1("LoadChannels1");
+    DeltaWriter* delta_writer1 = nullptr;
+    load(20005, {{0, 60}}, 100, &writer_profile1, &delta_writer1);
+    RowsetSharedPtr rowset1 = get_rowset(20005);
+    {
+        Version version(tablet->rowset_with_max_version()->end_version() + 1,
+                        tablet->rowset_with_max_version()->end_version() + 1);
+        TabletPublishStatistics pstats;
+        res = k_engine->txn_manager()->publish_txn(tablet->data_dir()->get_meta(), 30005, 20005,
+                                                   request.tablet_id,
+                                                   request.tablet_schema.schema_hash,
+                                                   tablet->tablet_uid(), version, &pstats);
+        ASSERT_TRUE(res.ok());
+        ASSERT_TRUE(tablet->add_inc_rowset(rowset1).ok());
+    }
+
+    // The second load writes two segments, [0, 40) and [20, 60). Their delete bitmaps against
+    // the first load are calculated in background while the following memtables are flushed.
+    config::enable_async_calc_delete_bitmap_on_flush = true;
+    RuntimeProfile writer_profile2("LoadChannels2");
+    DeltaWriter* delta_writer2 = nullptr;
+    load(20006, {{0, 40}, {20, 60}}, 110, &writer_profile2, &delta_writer2);
+    config::enable_async_calc_delete_bitmap_on_flush = false;
+    RowsetSharedPtr rowset2 = get_rowset(20006);
+    ASSERT_EQ(2, rowset2->num_segments());
+
+    auto delete_bitmap = delta_writer2->get_delete_bitmap();
+    for (int row = 0; row < 60; ++row) {
+        // all the keys of the first load are overwritten
+        EXPECT_TRUE(delete_bitmap->contains({rowset1->rowset_id(), 0, 0}, row)) << row;
+        // the keys [20, 40) of the first segment are overwritten by the second segment
+        EXPECT_EQ(row >= 20 && row < 40,
+                  delete_bitmap->contains({rowset2->rowset_id(), 0, 0}, row))
+                << row;
+        EXPECT_FALSE(delete_bitmap->contains({rowset2->rowset_id(), 1, 0}, row)) << row;
+    }
+
+    res = k_engine->tablet_manager()->drop_tablet(request.tablet_id, request.replica_id, false);
+    ASSERT_TRUE(res.ok());
+    delete delta_writer1;
+    delete delta_writer2;
+}
 } // namespace doris
@@ -0,0 +1,228 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <gen_cpp/Descriptors_types.h>
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/config.h"
+#include "common/object_pool.h"
+#include "olap/memtable.h"
+#include "olap/tablet_schema.h"
+#include "olap/tablet_schema_helper.h"
+#include "runtime/descriptor_helper.h"
+#include "runtime/descriptors.h"
+#include "runtime/memory/mem_tracker.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/column_vector.h"
+#include "vec/core/block.h"
+#include "vec/data_types/data_type_nullable.h"
+#include "vec/data_types/data_type_number.h"
+#include "vec/data_types/data_type_string.h"
+
+namespace doris {
+
+static constexpr int NUM_BATCHES = 10;
+static constexpr int ROWS_PER_BATCH = 200;
+
+// Loads the same rows into memtables with the hash aggregation on and off, the results of each
+// flush must be the same.
+class MemTableHashAggTest : public testing::Test {
+protected:
+    void SetUp() override {
+        _hash_aggregation = config::enable_memtable_hash_aggregation;
+
+        // k0 int nullable, k1 varchar, v2 int, v3 int
+        TDescriptorTableBuilder dtb;
+        TTupleDescriptorBuilder tuple_builder;
+        tuple_builder.add_slot(TSlotDescriptorBuilder()
+                                       .type(TYPE_INT)
+                                       .column_name("k0")
+                                       .column_pos(0)
+                                       .nullable(true)
+                                       .build());
+        tuple_builder.add_slot(TSlotDescriptorBuilder()
+                                       .string_type(64)
+                                       .column_name("k1")
+                                       .column_pos(1)
+                                       .nullable(false)
+                                       .build());
+        tuple_builder.add_slot(TSlotDescriptorBuilder()
+                                       .type(TYPE_INT)
+                                       .column_name("v2")
+                                       .column_pos(2)
+                                       .nullable(false)
+                                       .build());
+        tuple_builder.add_slot(TSlotDescriptorBuilder()
+                                       .type(TYPE_INT)
+                                       .column_name("v3")
+                                       .column_pos(3)
+                                       .nullable(false)
+                                       .build());
+        tuple_builder.build(&dtb);
+        ASSERT_TRUE(DescriptorTbl::create(&_obj_pool, dtb.desc_tbl(), &_desc_tbl).ok());
+        _tuple_desc = _desc_tbl->get_tuple_descriptor(0);
+    }
+
+    void TearDown() override { config::enable_memtable_hash_aggregation = _hash_aggregation; }
+
+    static void init_schema(KeysType keys_type, TabletSchema* schema) {
+        schema->append_column(create_int_key(0, true));
+        schema->append_column(create_varchar_key(1, false));
+        if (keys_type == KeysType::AGG_KEYS) {
+            schema->append_column(
+                    create_int_value(2, FieldAggregationMethod::OLAP_FIELD_AGGREGATION_SUM, false));
+        } else {
+            schema->append_column(create_int_value(
+                    2, FieldAggregationMethod::OLAP_FIELD_AGGREGATION_REPLACE, false));
+        }
+        schema->append_column(
+                create_int_value(3, FieldAggregationMethod::OLAP_FIELD_AGGREGATION_REPLACE, false));
+        schema->_keys_type = keys_type;
+    }
+
+    // 20 distinct keys, one of them with a null k0.
+    static vectorized::Block create_block(int batch) {
+        auto k0 = vectorized::ColumnInt32::create();
+        auto k0_null_map = vectorized::ColumnUInt8::create();
+        auto k1 = vectorized::ColumnString::create();
+        auto v2 = vectorized::ColumnInt32::create();
+        auto v3 = vectorized::ColumnInt32::create();
+        for (int i = 0; i < ROWS_PER_BATCH; ++i) {
+            int row = batch * ROWS_PER_BATCH + i;
+            k0->insert_value(row % 20);
+            k0_null_map->insert_value(row % 20 == 7);
+            std::string k1_value = "key_" + std::to_string(row % 5);
+            k1->insert_data(k1_value.data(), k1_value.size());
+            v2->insert_value(row);
+            v3->insert_value(row % 13);
+        }
+        auto int_type = std::make_shared<vectorized::DataTypeInt32>();
+        auto nullable_k0 =
+                vectorized::ColumnNullable::create(std::move(k0), std::move(k0_null_map));
+        return vectorized::Block(
+                {{std::move(nullable_k0), vectorized::make_nullable(int_type), "k0"},
+                 {std::move(k1), std::make_shared<vectorized::DataTypeString>(), "k1"},
+                 {std::move(v2), int_type, "v2"},
+                 {std::move(v3), int_type, "v3"}});
+    }
+
+    std::unique_ptr<MemTable> create_memtable(const TabletSchema* schema) {
+        return std::make_unique<MemTable>(10001, schema, &_tuple_desc->slots(), _tuple_desc, false,
+                                          _insert_tracker, _flush_tracker);
+    }
+
+    // Insert all batches, the memtable is flushed every `batches_per_flush` batches. Odd batches
+    // insert only their even rows. The memtable is shrunk when it needs to, like MemTableWriter.
+    std::vector<std::unique_ptr<vectorized::Block>> load(const TabletSchema* schema,
+                                                         bool hash_aggregation,
+                                                         int batches_per_flush,
+                                                         size_t* num_hash_merged_rows) {
+        config::enable_memtable_hash_aggregation = hash_aggregation;
+        std::vector<std::unique_ptr<vectorized::Block>> flushed_blocks;
+        *num_hash_merged_rows = 0;
+        auto memtable = create_memtable(schema);
+        for (int batch = 0; batch < NUM_BATCHES; ++batch) {
+            auto block = create_block(batch);
+            if (batch % 2 == 0) {
+                memtable->insert(&block, {}, true);
+            } else {
+                std::vector<int> row_idxs;
+                for (int i = 0; i < ROWS_PER_BATCH; i += 2) {
+                    row_idxs.push_back(i);
+                }
+                memtable->insert(&block, row_idxs, false);
+            }
+            if (memtable->need_agg()) {
+                memtable->shrink_memtable_by_agg();
+            }
+            if ((batch + 1) % batches_per_flush == 0 || batch + 1 == NUM_BATCHES) {
+                *num_hash_merged_rows += memtable->_num_hash_merged_rows;
+                flushed_blocks.push_back(memtable->to_block());
+                memtable = create_memtable(schema);
+            }
+        }
+        return flushed_blocks;
+    }
+
+    static void check_same_blocks(const std::vector<std::unique_ptr<vectorized::Block>>& expected,
+                                  const std::vector<std::unique_ptr<vectorized::Block>>& actual) {
+        ASSERT_EQ(expected.size(), actual.size());
+        for (size_t i = 0; i < expected.size(); ++i) {
+            ASSERT_EQ(expected[i]->rows(), actual[i]->rows());
+            ASSERT_EQ(expected[i]->columns(), actual[i]->columns());
+            for (size_t cid = 0; cid < expected[i]->columns(); ++cid) {
+                const auto& expected_column = *expected[i]->get_by_position(cid).column;
+                const auto& actual_column = *actual[i]->get_by_position(cid).column;
+                for (size_t row = 0; row < expected[i]->rows(); ++row) {
+                    EXPECT_EQ(0, expected_column.compare_at(row, row, actual_column, -1))
+                            << "flush " << i << ", column " << cid << ", row " << row;
+                }
+            }
+        }
+    }
+
+    void check_hash_aggregation(KeysType keys_type, int batches_per_flush) {
+        TabletSchema schema;
+        init_schema(keys_type, &schema);
+        size_t sort_merged_rows = 0;
+        auto expected = load(&schema, false, batches_per_flush, &sort_merged_rows);
+        size_t hash_merged_rows = 0;
+        auto actual = load(&schema, true, batches_per_flush, &hash_merged_rows);
+        EXPECT_EQ(0, sort_merged_rows);
+        if (keys_type == KeysType::AGG_KEYS) {
+            EXPECT_GT(hash_merged_rows, 0);
+        } else {
+            // only the aggregate key tables are merged on insert
+            EXPECT_EQ(0, hash_merged_rows);
+        }
+        check_same_blocks(expected, actual);
+    }
+
+    ObjectPool _obj_pool;
+    DescriptorTbl* _desc_tbl = nullptr;
+    TupleDescriptor* _tuple_desc = nullptr;
+    std::shared_ptr<MemTracker> _insert_tracker = std::make_shared<MemTracker>("MemTableInsert");
+    std::shared_ptr<MemTracker> _flush_tracker = std::make_shared<MemTracker>("MemTableFlush");
+    bool _hash_aggregation = false;
+};
+
+TEST_F(MemTableHashAggTest, AggKeys) {
+    check_hash_aggregation(KeysType::AGG_KEYS, NUM_BATCHES);
+}
+
+TEST_F(MemTableHashAggTest, AggKeysPartialFlush) {
+    check_hash_aggregation(KeysType::AGG_KEYS, 3);
+}
+
+TEST_F(MemTableHashAggTest, AggKeysShrink) {
+    // every insert exceeds the buffer, so the memtables without hash aggregation are shrunk
+    auto write_buffer_size_for_agg = config::write_buffer_size_for_agg;
+    config::write_buffer_size_for_agg = 1;
+    check_hash_aggregation(KeysType::AGG_KEYS, 4);
+    config::write_buffer_size_for_agg = write_buffer_size_for_agg;
+}
+
+TEST_F(MemTableHashAggTest, UniqueKeys) {
+    check_hash_aggregation(KeysType::UNIQUE_KEYS, 3);
+}
+
+} // namespace doris
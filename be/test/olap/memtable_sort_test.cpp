@@ -17,7 +17,17 @@
 
 #include <gtest/gtest.h>
 
+#include <set>
+
 #include "olap/memtable.h"
+#include "olap/tablet_schema.h"
+#include "olap/tablet_schema_helper.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/column_vector.h"
+#include "vec/data_types/data_type_nullable.h"
+#include "vec/data_types/data_type_number.h"
+#include "vec/data_types/data_type_string.h"
 
 namespace doris {
 
@@ -80,4 +90,61 @@ TEST_F(MemTableSortTest, Tie) {
     EXPECT_FALSE(it3.next());
 }
 
+TEST_F(MemTableSortTest, NormalizedKeySorter) {
+    TabletSchema tablet_schema;
+    tablet_schema.append_column(create_int_key(0, true));
+    tablet_schema.append_column(create_int_key(1, false));
+    tablet_schema.append_column(create_varchar_key(2));
+    NormalizedKeySorter sorter(&tablet_schema);
+    // varchar column can not be normalized
+    EXPECT_EQ(sorter.num_columns(), 2);
+
+    auto c0 = vectorized::ColumnInt32::create();
+    auto null_map = vectorized::ColumnUInt8::create();
+    auto c1 = vectorized::ColumnInt32::create();
+    auto c2 = vectorized::ColumnString::create();
+    // c0: null, 3, -5, 3, null, -5, 3
+    // c1: 1, -2, 7, -2, 0, -7, 1
+    std::vector<int32_t> c0_values = {0, 3, -5, 3, 0, -5, 3};
+    std::vector<uint8_t> c0_nulls = {1, 0, 0, 0, 1, 0, 0};
+    std::vector<int32_t> c1_values = {1, -2, 7, -2, 0, -7, 1};
+    for (size_t i = 0; i < c0_values.size(); ++i) {
+        c0->insert_value(c0_values[i]);
+        null_map->insert_value(c0_nulls[i]);
+        c1->insert_value(c1_values[i]);
+        c2->insert_data("a", 1);
+    }
+    auto int_type = std::make_shared<vectorized::DataTypeInt32>();
+    auto string_type = std::make_shared<vectorized::DataTypeString>();
+    auto nullable_c0 = vectorized::ColumnNullable::create(std::move(c0), std::move(null_map));
+    vectorized::Block block({{std::move(nullable_c0), vectorized::make_nullable(int_type), "c0"},
+                             {std::move(c1), int_type, "c1"},
+                             {std::move(c2), string_type, "c2"}});
+    vectorized::MutableBlock mutable_block(std::move(block));
+
+    std::vector<std::unique_ptr<RowInBlock>> rows;
+    std::vector<RowInBlock*> row_in_blocks;
+    for (size_t i = 0; i < c0_values.size(); ++i) {
+        rows.emplace_back(std::make_unique<RowInBlock>(i));
+        row_in_blocks.push_back(rows.back().get());
+    }
+    Tie tie {0, row_in_blocks.size()};
+    sorter.sort(mutable_block, row_in_blocks, tie);
+
+    // null first, rows 1 and 3 have the same keys
+    EXPECT_EQ(row_in_blocks[0]->_row_pos, 4);
+    EXPECT_EQ(row_in_blocks[1]->_row_pos, 0);
+    EXPECT_EQ(row_in_blocks[2]->_row_pos, 5);
+    EXPECT_EQ(row_in_blocks[3]->_row_pos, 2);
+    EXPECT_EQ((std::set<size_t> {row_in_blocks[4]->_row_pos, row_in_blocks[5]->_row_pos}),
+              (std::set<size_t> {1, 3}));
+    EXPECT_EQ(row_in_blocks[6]->_row_pos, 6);
+
+    auto it = tie.iter();
+    EXPECT_TRUE(it.next());
+    EXPECT_EQ(it.left(), 4);
+    EXPECT_EQ(it.right(), 6);
+    EXPECT_FALSE(it.next());
+}
+
 } // namespace doris
@@ -20,7 +20,9 @@
 #include <gtest/gtest-message.h>
 #include <gtest/gtest-test-part.h>
 
+#include "common/config.h"
 #include "gtest/gtest_pred_impl.h"
+#include "util/doris_metrics.h"
 
 namespace doris {
 
@@ -258,4 +260,156 @@ TEST(StoragePageCacheTest, mixed_pages) {
     }
 }
 
+TEST(StoragePageCacheTest, admission) {
+    config::enable_page_cache_admission = true;
+    StoragePageCache cache(kNumShards * 2048, 0, 0, kNumShards);
+    segment_v2::PageTypePB page_type = segment_v2::DATA_PAGE;
+
+    // there is room for the page
+    StoragePageCache::CacheKey key("abc", 0, 0);
+    EXPECT_TRUE(cache.admit(key, 1024, page_type, false));
+
+    // the page can not be cached without eviction, it has to be missed twice
+    StoragePageCache::CacheKey big_key("big", 0, 0);
+    size_t big_charge = kNumShards * 2048;
+    EXPECT_FALSE(cache.admit(big_key, big_charge, page_type, false));
+    EXPECT_TRUE(cache.admit(big_key, big_charge, page_type, false));
+
+    // pages of large scan are admitted by frequency even if there is room
+    StoragePageCache::CacheKey scan_key("scan", 0, 0);
+    EXPECT_FALSE(cache.admit(scan_key, 1024, page_type, true));
+    // the access which is not recorded is counted in
+    EXPECT_TRUE(cache.admit(scan_key, 1024, page_type, true, false));
+    EXPECT_FALSE(cache.admit(StoragePageCache::CacheKey("scan", 0, 1), 1024, page_type, true));
+    EXPECT_TRUE(cache.admit(scan_key, 1024, page_type, true));
+    config::enable_page_cache_admission = false;
+}
+
+TEST(StoragePageCacheTest, admission_min_frequency) {
+    config::enable_page_cache_admission = true;
+    config::page_cache_admission_min_frequency = 3;
+    StoragePageCache cache(kNumShards * 2048, 0, 0, kNumShards);
+    segment_v2::PageTypePB page_type = segment_v2::DATA_PAGE;
+
+    StoragePageCache::CacheKey key("abc", 0, 0);
+    EXPECT_FALSE(cache.admit(key, 1024, page_type, true));
+    EXPECT_FALSE(cache.admit(key, 1024, page_type, true));
+    EXPECT_TRUE(cache.admit(key, 1024, page_type, true));
+
+    // the accesses which are not recorded do not raise the frequency
+    StoragePageCache::CacheKey prefetch_key("prefetch", 0, 0);
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_FALSE(cache.admit(prefetch_key, 1024, page_type, true, false));
+    }
+    EXPECT_FALSE(cache.admit(prefetch_key, 1024, page_type, true));
+    config::page_cache_admission_min_frequency = 2;
+    config::enable_page_cache_admission = false;
+}
+
+TEST(StoragePageCacheTest, admission_disabled) {
+    StoragePageCache cache(kNumShards * 2048, 0, 0, kNumShards);
+    segment_v2::PageTypePB page_type = segment_v2::DATA_PAGE;
+    auto* metrics = DorisMetrics::instance();
+    int64_t admitted = metrics->data_page_cache_admitted_total->value();
+    int64_t rejected = metrics->data_page_cache_rejected_total->value();
+
+    // every page is admitted, and nothing is counted
+    StoragePageCache::CacheKey key("abc", 0, 0);
+    EXPECT_TRUE(cache.admit(key, kNumShards * 2048, page_type, false));
+    EXPECT_TRUE(cache.admit(key, 1024, page_type, true));
+    EXPECT_EQ(admitted, metrics->data_page_cache_admitted_total->value());
+    EXPECT_EQ(rejected, metrics->data_page_cache_rejected_total->value());
+}
+
+TEST(StoragePageCacheTest, unrecorded_access_metrics) {
+    config::enable_page_cache_admission = true;
+    StoragePageCache cache(kNumShards * 2048, 0, 0, kNumShards);
+    segment_v2::PageTypePB page_type = segment_v2::DATA_PAGE;
+    auto* metrics = DorisMetrics::instance();
+    int64_t hit = metrics->data_page_cache_lookup_hit_total->value();
+    int64_t miss = metrics->data_page_cache_lookup_miss_total->value();
+    int64_t admitted = metrics->data_page_cache_admitted_total->value();
+    int64_t rejected = metrics->data_page_cache_rejected_total->value();
+
+    StoragePageCache::CacheKey key("abc", 0, 0);
+    {
+        // the accesses of prefetch are not counted
+        PageCacheHandle handle;
+        EXPECT_FALSE(cache.lookup(key, &handle, page_type, false));
+        EXPECT_TRUE(cache.admit(key, 1024, page_type, false, false));
+        DataPage* data = new DataPage(1024);
+        cache.insert(key, data, &handle, page_type);
+        PageCacheHandle cached_handle;
+        EXPECT_TRUE(cache.lookup(key, &cached_handle, page_type, false));
+    }
+    EXPECT_EQ(hit, metrics->data_page_cache_lookup_hit_total->value());
+    EXPECT_EQ(miss, metrics->data_page_cache_lookup_miss_total->value());
+    EXPECT_EQ(admitted, metrics->data_page_cache_admitted_total->value());
+    EXPECT_EQ(rejected, metrics->data_page_cache_rejected_total->value());
+
+    // the accesses of reads are
+    {
+        PageCacheHandle handle;
+        EXPECT_TRUE(cache.lookup(key, &handle, page_type));
+        EXPECT_FALSE(cache.lookup(StoragePageCache::CacheKey("abc", 0, 1), &handle, page_type));
+        EXPECT_TRUE(cache.admit(StoragePageCache::CacheKey("abc", 0, 1), 1024, page_type, false));
+    }
+    EXPECT_EQ(hit + 1, metrics->data_page_cache_lookup_hit_total->value());
+    EXPECT_EQ(miss + 1, metrics->data_page_cache_lookup_miss_total->value());
+    EXPECT_EQ(admitted + 1, metrics->data_page_cache_admitted_total->value());
+    EXPECT_EQ(rejected, metrics->data_page_cache_rejected_total->value());
+    config::enable_page_cache_admission = false;
+}
+
+TEST(FrequencySketchTest, frequency) {
+    FrequencySketch sketch(1024);
+    const uint64_t hash = 0x9E3779B97F4A7C15ULL;
+    EXPECT_EQ(0u, sketch.frequency(hash));
+    for (int i = 0; i < 3; ++i) {
+        sketch.increment(hash);
+    }
+    EXPECT_EQ(3u, sketch.frequency(hash));
+    EXPECT_EQ(0u, sketch.frequency(hash + 1));
+
+    // the counter saturates
+    for (int i = 0; i < 100; ++i) {
+        sketch.increment(hash);
+    }
+    EXPECT_EQ(FrequencySketch::kMaxFrequency, sketch.frequency(hash));
+}
+
+TEST(FrequencySketchTest, aging) {
+    FrequencySketch sketch(1000);
+    // the width is rounded up to 1024, so counters are halved every 10 * 1024 increments
+    EXPECT_EQ(1024, sketch._width);
+    EXPECT_EQ(10 * 1024, sketch._sample_size);
+
+    const uint64_t hash = 0x9E3779B97F4A7C15ULL;
+    for (int i = 0; i < 15; ++i) {
+        sketch.increment(hash);
+    }
+    EXPECT_EQ(15, sketch._additions.load());
+    // increments of a saturated key are not counted
+    sketch.increment(hash);
+    EXPECT_EQ(15, sketch._additions.load());
+
+    // increments of other keys can not lower the frequency, only aging can
+    uint64_t i = 1;
+    for (; i <= sketch._sample_size; ++i) {
+        sketch.increment(i * 0xC2B2AE3D27D4EB4FULL);
+        if (sketch.frequency(hash) < FrequencySketch::kMaxFrequency) {
+            break;
+        }
+    }
+    // each increment of a key which is not saturated is counted
+    EXPECT_GE(i, sketch._sample_size - 15);
+    EXPECT_LE(i, sketch._sample_size);
+    EXPECT_EQ(FrequencySketch::kMaxFrequency / 2, sketch.frequency(hash));
+    EXPECT_EQ(sketch._sample_size / 2, sketch._additions.load());
+
+    // the key can be counted again
+    sketch.increment(hash);
+    EXPECT_EQ(FrequencySketch::kMaxFrequency / 2 + 1, sketch.frequency(hash));
+}
+
 } // namespace doris
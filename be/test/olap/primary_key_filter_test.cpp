@@ -0,0 +1,140 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/primary_key_filter.h"
+
+#include <gtest/gtest-message.h>
+#include <gtest/gtest-test-part.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest_pred_impl.h"
+#include "gutil/stringprintf.h"
+#include "olap/rowset/beta_rowset.h"
+#include "olap/rowset/rowset_meta.h"
+#include "runtime/memory/mem_tracker.h"
+
+namespace doris {
+
+class PrimaryKeyFilterTest : public testing::Test {
+protected:
+    static RowsetSharedPtr create_rowset(int64_t id) {
+        auto rs_meta = std::make_shared<RowsetMeta>();
+        RowsetId rowset_id;
+        rowset_id.init(id);
+        rs_meta->set_rowset_id(rowset_id);
+        return std::make_shared<BetaRowset>(nullptr, "", rs_meta);
+    }
+
+    static std::string key(int i) { return StringPrintf("key_%08d", i); }
+};
+
+TEST_F(PrimaryKeyFilterTest, lookup) {
+    std::vector<RowsetSharedPtr> rowsets {create_rowset(3), create_rowset(2), create_rowset(1)};
+    PrimaryKeyFilter filter(rowsets, 10);
+    // rowset i has i + 1 segments, and each segment holds 1000 keys
+    int num_keys = 0;
+    for (uint32_t rs = 0; rs < rowsets.size(); ++rs) {
+        for (uint32_t seg = 0; seg <= rs; ++seg) {
+            EXPECT_TRUE(filter.start_segment(rs, seg).ok());
+            for (int i = 0; i < 1000; ++i) {
+                filter.add_key(key(num_keys++));
+            }
+        }
+    }
+    EXPECT_TRUE(filter.build().ok());
+    EXPECT_EQ(6000, filter.num_keys());
+    EXPECT_EQ(3, filter.num_rowsets());
+
+    num_keys = 0;
+    for (uint32_t rs = 0; rs < rowsets.size(); ++rs) {
+        for (uint32_t seg = 0; seg <= rs; ++seg) {
+            for (int i = 0; i < 1000; ++i) {
+                uint32_t rowset_idx = 0;
+                uint32_t segment_id = 0;
+                EXPECT_TRUE(filter.lookup(key(num_keys++), &rowset_idx, &segment_id));
+                EXPECT_EQ(rs, rowset_idx);
+                EXPECT_EQ(seg, segment_id);
+            }
+        }
+    }
+
+    // absent keys are rarely reported, at a rate of about 2^-16
+    int false_positives = 0;
+    for (int i = num_keys; i < num_keys + 100000; ++i) {
+        uint32_t rowset_idx = 0;
+        uint32_t segment_id = 0;
+        false_positives += filter.lookup(key(i), &rowset_idx, &segment_id);
+    }
+    EXPECT_LT(false_positives, 20);
+}
+
+TEST_F(PrimaryKeyFilterTest, empty) {
+    std::vector<RowsetSharedPtr> rowsets {create_rowset(1)};
+    PrimaryKeyFilter filter(rowsets, 1);
+    EXPECT_TRUE(filter.start_segment(0, 0).ok());
+    EXPECT_TRUE(filter.build().ok());
+    uint32_t rowset_idx = 0;
+    uint32_t segment_id = 0;
+    EXPECT_FALSE(filter.lookup(key(0), &rowset_idx, &segment_id));
+}
+
+TEST_F(PrimaryKeyFilterTest, duplicate_key) {
+    std::vector<RowsetSharedPtr> rowsets {create_rowset(1)};
+    PrimaryKeyFilter filter(rowsets, 1);
+    EXPECT_TRUE(filter.start_segment(0, 0).ok());
+    filter.add_key(key(0));
+    filter.add_key(key(1));
+    filter.add_key(key(0));
+    auto st = filter.build();
+    EXPECT_TRUE(st.is<ErrorCode::NOT_IMPLEMENTED_ERROR>()) << st;
+}
+
+TEST_F(PrimaryKeyFilterTest, mem_tracker) {
+    std::vector<RowsetSharedPtr> rowsets {create_rowset(1)};
+    auto mem_tracker = std::make_shared<MemTracker>("PrimaryKeyFilterTest");
+    {
+        PrimaryKeyFilter filter(rowsets, 1, mem_tracker);
+        EXPECT_TRUE(filter.start_segment(0, 0).ok());
+        for (int i = 0; i < 1000; ++i) {
+            filter.add_key(key(i));
+        }
+        EXPECT_EQ(0, mem_tracker->consumption());
+        EXPECT_TRUE(filter.build().ok());
+        EXPECT_GT(mem_tracker->consumption(), 0);
+        EXPECT_EQ(static_cast<int64_t>(filter.memory_usage()), mem_tracker->consumption());
+    }
+    EXPECT_EQ(0, mem_tracker->consumption());
+}
+
+TEST_F(PrimaryKeyFilterTest, covered_by) {
+    auto rs1 = create_rowset(1);
+    auto rs2 = create_rowset(2);
+    auto rs3 = create_rowset(3);
+    auto rs4 = create_rowset(4);
+    PrimaryKeyFilter filter({rs2, rs1}, 5);
+    EXPECT_TRUE(filter.covered_by({rs2, rs1}));
+    EXPECT_TRUE(filter.covered_by({rs4, rs3, rs2, rs1}));
+    EXPECT_FALSE(filter.covered_by({rs1}));
+    EXPECT_FALSE(filter.covered_by({rs4, rs3}));
+    EXPECT_FALSE(filter.covered_by({rs3, rs2}));
+    EXPECT_FALSE(filter.covered_by({}));
+}
+
+} // namespace doris
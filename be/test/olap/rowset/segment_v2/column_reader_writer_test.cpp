@@ -668,6 +668,128 @@ TEST_F(ColumnReaderWriterTest, test_nullable) {
     delete[] double_vals;
 }
 
+TEST_F(ColumnReaderWriterTest, test_append_pages) {
+    int num_rows = LOOP_LESS_OR_MORE(10000, 100000);
+    auto fs = io::global_local_filesystem();
+    auto create_writer = [](ColumnMetaPB* meta, io::FileWriter* file_writer,
+                            std::unique_ptr<ColumnWriter>* writer) {
+        ColumnWriterOptions writer_opts;
+        writer_opts.meta = meta;
+        writer_opts.meta->set_column_id(0);
+        writer_opts.meta->set_unique_id(0);
+        writer_opts.meta->set_type(FieldType::OLAP_FIELD_TYPE_INT);
+        writer_opts.meta->set_length(0);
+        writer_opts.meta->set_encoding(BIT_SHUFFLE);
+        writer_opts.meta->set_compression(segment_v2::CompressionTypePB::LZ4F);
+        writer_opts.meta->set_is_nullable(true);
+        writer_opts.need_zone_map = true;
+        TabletColumn column(OLAP_FIELD_AGGREGATION_NONE, FieldType::OLAP_FIELD_TYPE_INT);
+        EXPECT_TRUE(ColumnWriter::create(writer_opts, &column, file_writer, writer).ok());
+        EXPECT_TRUE((*writer)->init().ok());
+    };
+    auto finish_writer = [](ColumnWriter* writer, io::FileWriter* file_writer) {
+        EXPECT_TRUE(writer->finish().ok());
+        EXPECT_TRUE(writer->write_data().ok());
+        EXPECT_TRUE(writer->write_ordinal_index().ok());
+        EXPECT_TRUE(writer->write_zone_map().ok());
+        EXPECT_TRUE(file_writer->close().ok());
+    };
+
+    // write the source column
+    std::vector<int32_t> src(num_rows);
+    std::vector<uint8_t> src_is_null(BitmapSize(num_rows));
+    for (int i = 0; i < num_rows; ++i) {
+        src[i] = i * 3;
+        BitmapChange(src_is_null.data(), i, (i % 7) == 0);
+    }
+    ColumnMetaPB src_meta;
+    std::string src_fname = TEST_DIR + "/append_pages_src";
+    {
+        io::FileWriterPtr file_writer;
+        ASSERT_TRUE(fs->create_file(src_fname, &file_writer).ok());
+        std::unique_ptr<ColumnWriter> writer;
+        create_writer(&src_meta, file_writer.get(), &writer);
+        for (int i = 0; i < num_rows; ++i) {
+            EXPECT_TRUE(writer->append(BitmapTest(src_is_null.data(), i), &src[i]).ok());
+        }
+        finish_writer(writer.get(), file_writer.get());
+    }
+
+    // copy the pages of the source column twice
+    io::FileReaderSPtr src_reader_file;
+    ASSERT_EQ(fs->open_file(src_fname, &src_reader_file), Status::OK());
+    ColumnReaderOptions reader_opts;
+    std::unique_ptr<ColumnReader> src_reader;
+    ASSERT_TRUE(
+            ColumnReader::create(reader_opts, src_meta, num_rows, src_reader_file, &src_reader)
+                    .ok());
+    std::vector<PagePointer> src_pages;
+    std::vector<ZoneMapPB> src_zone_maps;
+    ASSERT_TRUE(src_reader->get_data_pages(&src_pages, &src_zone_maps).ok());
+    EXPECT_GT(src_pages.size(), 1);
+    EXPECT_EQ(src_pages.size(), src_zone_maps.size());
+
+    ColumnMetaPB dst_meta;
+    std::string dst_fname = TEST_DIR + "/append_pages_dst";
+    {
+        io::FileWriterPtr file_writer;
+        ASSERT_TRUE(fs->create_file(dst_fname, &file_writer).ok());
+        std::unique_ptr<ColumnWriter> writer;
+        create_writer(&dst_meta, file_writer.get(), &writer);
+        OlapReaderStatistics stats;
+        ColumnIteratorOptions iter_opts;
+        iter_opts.file_reader = src_reader_file.get();
+        iter_opts.stats = &stats;
+        iter_opts.type = DATA_PAGE;
+        auto* scalar_writer = static_cast<ScalarColumnWriter*>(writer.get());
+        EXPECT_TRUE(scalar_writer->append_pages(src_reader.get(), iter_opts).ok());
+        EXPECT_TRUE(scalar_writer->append_pages(src_reader.get(), iter_opts).ok());
+        finish_writer(writer.get(), file_writer.get());
+    }
+
+    // read the copied column and check
+    io::FileReaderSPtr dst_reader_file;
+    ASSERT_EQ(fs->open_file(dst_fname, &dst_reader_file), Status::OK());
+    std::unique_ptr<ColumnReader> dst_reader;
+    ASSERT_TRUE(ColumnReader::create(reader_opts, dst_meta, 2 * num_rows, dst_reader_file,
+                                     &dst_reader)
+                        .ok());
+    std::vector<PagePointer> dst_pages;
+    std::vector<ZoneMapPB> dst_zone_maps;
+    ASSERT_TRUE(dst_reader->get_data_pages(&dst_pages, &dst_zone_maps).ok());
+    EXPECT_EQ(2 * src_pages.size(), dst_pages.size());
+    EXPECT_EQ(dst_pages.size(), dst_zone_maps.size());
+
+    ColumnIterator* iter = nullptr;
+    ASSERT_TRUE(dst_reader->new_iterator(&iter).ok());
+    std::unique_ptr<ColumnIterator> iter_guard(iter);
+    ColumnIteratorOptions iter_opts;
+    OlapReaderStatistics stats;
+    iter_opts.stats = &stats;
+    iter_opts.file_reader = dst_reader_file.get();
+    ASSERT_TRUE(iter->init(iter_opts).ok());
+
+    auto type_info = get_scalar_type_info(FieldType::OLAP_FIELD_TYPE_INT);
+    vectorized::Arena pool;
+    std::unique_ptr<ColumnVectorBatch> cvb;
+    ColumnVectorBatch::create(0, true, type_info, nullptr, &cvb);
+    cvb->resize(1024);
+    ColumnBlock col(cvb.get(), &pool);
+    for (int rowid = 0; rowid < 2 * num_rows; rowid += 997) {
+        ASSERT_TRUE(iter->seek_to_ordinal(rowid).ok());
+        size_t rows_read = 1024;
+        ColumnBlockView dst(&col);
+        ASSERT_TRUE(iter->next_batch(&rows_read, &dst).ok());
+        for (int j = 0; j < rows_read; ++j) {
+            int idx = (rowid + j) % num_rows;
+            EXPECT_EQ(BitmapTest(src_is_null.data(), idx), col.is_null(j));
+            if (!col.is_null(j)) {
+                EXPECT_EQ(src[idx], *reinterpret_cast<const int32_t*>(col.cell_ptr(j)));
+            }
+        }
+    }
+}
+
 TEST_F(ColumnReaderWriterTest, test_types) {
     size_t num_uint8_rows = LOOP_LESS_OR_MORE(1024, 1024 * 1024);
     uint8_t* is_null = new uint8_t[num_uint8_rows];
@@ -0,0 +1,175 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/rowset/segment_v2/page_io.h"
+
+#include <gen_cpp/segment_v2.pb.h>
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "io/fs/file_reader.h"
+#include "io/fs/file_writer.h"
+#include "io/fs/local_file_system.h"
+#include "olap/olap_common.h"
+#include "olap/page_cache.h"
+#include "olap/rowset/segment_v2/page_handle.h"
+#include "util/slice.h"
+
+namespace doris {
+namespace segment_v2 {
+
+static const std::string TEST_DIR = "./ut_dir/page_io_test";
+static constexpr size_t PAGE_BODY_SIZE = 1000;
+
+class PageIOTest : public testing::Test {
+protected:
+    void SetUp() override {
+        EXPECT_TRUE(io::global_local_filesystem()->delete_and_create_directory(TEST_DIR).ok());
+    }
+
+    void TearDown() override {
+        EXPECT_TRUE(io::global_local_filesystem()->delete_directory(TEST_DIR).ok());
+    }
+
+    // Write `num_pages` data pages, the bytes of the body of page i are all 'a' + i.
+    void write_pages(const std::string& file_name, int num_pages) {
+        io::FileWriterPtr file_writer;
+        ASSERT_TRUE(io::global_local_filesystem()->create_file(file_name, &file_writer).ok());
+        for (int i = 0; i < num_pages; ++i) {
+            std::string body(PAGE_BODY_SIZE, 'a' + i);
+            PageFooterPB footer;
+            footer.set_type(DATA_PAGE);
+            footer.set_uncompressed_size(body.size());
+            footer.mutable_data_page_footer()->set_num_values(body.size());
+            footer.mutable_data_page_footer()->set_nullmap_size(0);
+            PagePointer pp;
+            ASSERT_TRUE(PageIO::write_page(file_writer.get(), {Slice(body)}, footer, &pp).ok());
+            _page_pointers.push_back(pp);
+        }
+        ASSERT_TRUE(file_writer->close().ok());
+        ASSERT_TRUE(io::global_local_filesystem()->open_file(file_name, &_file_reader).ok());
+    }
+
+    PageReadOptions page_options(int page_index) {
+        PageReadOptions opts;
+        opts.file_reader = _file_reader.get();
+        opts.page_pointer = _page_pointers[page_index];
+        opts.stats = &_stats;
+        opts.use_page_cache = true;
+        opts.type = DATA_PAGE;
+        return opts;
+    }
+
+    void check_page(int page_index) {
+        PageHandle handle;
+        Slice body;
+        PageFooterPB footer;
+        ASSERT_TRUE(PageIO::read_and_decompress_page(page_options(page_index), &handle, &body,
+                                                     &footer)
+                            .ok());
+        EXPECT_EQ(std::string(PAGE_BODY_SIZE, 'a' + page_index), body.to_string());
+    }
+
+    static void evict_unused_pages() {
+        StoragePageCache::instance()->_data_page_cache->get()->prune();
+    }
+
+    std::vector<PagePointer> _page_pointers;
+    io::FileReaderSPtr _file_reader;
+    OlapReaderStatistics _stats;
+};
+
+TEST_F(PageIOTest, PrefetchMergesNeighboringPages) {
+    write_pages(TEST_DIR + "/merge", 4);
+
+    // page 0 and page 1 are adjacent, page 3 is one page away from them
+    std::vector<PageHandle> handles;
+    ASSERT_TRUE(PageIO::prefetch_pages({page_options(3), page_options(0), page_options(1)}, 0,
+                                       1 << 20, &handles)
+                        .ok());
+    EXPECT_EQ(2, _stats.prefetch_io_num);
+    EXPECT_EQ(3, _stats.prefetched_pages_num);
+    EXPECT_EQ(3, handles.size());
+
+    // page 3 is cached already, only page 2 is read
+    std::vector<PageHandle> more_handles;
+    ASSERT_TRUE(PageIO::prefetch_pages({page_options(2), page_options(3)}, 0, 1 << 20,
+                                       &more_handles)
+                        .ok());
+    EXPECT_EQ(3, _stats.prefetch_io_num);
+    EXPECT_EQ(4, _stats.prefetched_pages_num);
+
+    const auto bytes_read = _stats.compressed_bytes_read;
+    for (int i = 0; i < 4; ++i) {
+        check_page(i);
+    }
+    EXPECT_EQ(4, _stats.cached_pages_num);
+    EXPECT_EQ(bytes_read, _stats.compressed_bytes_read);
+}
+
+TEST_F(PageIOTest, PrefetchMergedReadIsBounded) {
+    write_pages(TEST_DIR + "/bounded", 4);
+
+    std::vector<PageHandle> handles;
+    ASSERT_TRUE(PageIO::prefetch_pages({page_options(0), page_options(1), page_options(2),
+                                        page_options(3)},
+                                       1 << 20, _page_pointers[0].size * 2, &handles)
+                        .ok());
+    EXPECT_EQ(2, _stats.prefetch_io_num);
+    EXPECT_EQ(4, _stats.prefetched_pages_num);
+    for (int i = 0; i < 4; ++i) {
+        check_page(i);
+    }
+}
+
+TEST_F(PageIOTest, PrefetchedPagesArePinned) {
+    write_pages(TEST_DIR + "/pinned", 3);
+
+    std::vector<PageHandle> handles;
+    ASSERT_TRUE(PageIO::prefetch_pages({page_options(0), page_options(1)}, 0, 1 << 20, &handles)
+                        .ok());
+    EXPECT_EQ(1, _stats.prefetch_io_num);
+
+    // pages already in cache are not read again, but pinned as well
+    std::vector<PageHandle> cached_handles;
+    ASSERT_TRUE(PageIO::prefetch_pages({page_options(0), page_options(1)}, 0, 1 << 20,
+                                       &cached_handles)
+                        .ok());
+    EXPECT_EQ(1, _stats.prefetch_io_num);
+    EXPECT_EQ(2, cached_handles.size());
+
+    // the pinned pages survive the eviction, so they are not read twice
+    evict_unused_pages();
+    const auto bytes_read = _stats.compressed_bytes_read;
+    check_page(0);
+    check_page(1);
+    EXPECT_EQ(2, _stats.cached_pages_num);
+    EXPECT_EQ(bytes_read, _stats.compressed_bytes_read);
+
+    // once released, they can be evicted
+    handles.clear();
+    cached_handles.clear();
+    evict_unused_pages();
+    check_page(0);
+    EXPECT_EQ(2, _stats.cached_pages_num);
+    EXPECT_EQ(bytes_read + _page_pointers[0].size, _stats.compressed_bytes_read);
+}
+
+} // namespace segment_v2
+} // namespace doris
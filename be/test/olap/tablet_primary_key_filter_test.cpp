@@ -0,0 +1,346 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <gen_cpp/AgentService_types.h>
+#include <gen_cpp/Types_types.h>
+#include <gen_cpp/olap_file.pb.h>
+#include <gtest/gtest-message.h>
+#include <gtest/gtest-test-part.h>
+#include <stdint.h>
+#include <unistd.h>
+
+#include <memory>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include "common/config.h"
+#include "common/status.h"
+#include "gtest/gtest_pred_impl.h"
+#include "io/fs/local_file_system.h"
+#include "io/io_common.h"
+#include "olap/key_coder.h"
+#include "olap/olap_common.h"
+#include "olap/options.h"
+#include "olap/primary_key_filter.h"
+#include "olap/rowset/rowset.h"
+#include "olap/rowset/rowset_factory.h"
+#include "olap/rowset/rowset_writer.h"
+#include "olap/rowset/rowset_writer_context.h"
+#include "olap/storage_engine.h"
+#include "olap/tablet.h"
+#include "olap/tablet_meta.h"
+#include "olap/tablet_schema.h"
+#include "olap/utils.h"
+#include "util/key_util.h"
+#include "vec/core/block.h"
+
+namespace doris {
+using namespace ErrorCode;
+
+static const uint32_t MAX_PATH_LEN = 1024;
+static const std::string kTestDir = "/ut_dir/tablet_primary_key_filter_test";
+static StorageEngine* k_engine = nullptr;
+
+// Tablet::lookup_row_key() must give the same results with the primary key filter of the
+// tablet and without it.
+class TabletPrimaryKeyFilterTest : public testing::Test {
+protected:
+    // (key, sequence value) of a row
+    using Rows = std::vector<std::tuple<int32_t, int32_t>>;
+
+    void SetUp() override {
+        char buffer[MAX_PATH_LEN];
+        EXPECT_NE(getcwd(buffer, MAX_PATH_LEN), nullptr);
+        _absolute_dir = std::string(buffer) + kTestDir;
+        EXPECT_TRUE(io::global_local_filesystem()->delete_and_create_directory(_absolute_dir).ok());
+        doris::EngineOptions options;
+        k_engine = new StorageEngine(options);
+        StorageEngine::_s_instance = k_engine;
+        _enable_pk_filter = config::enable_tablet_primary_key_filter;
+    }
+
+    void TearDown() override {
+        config::enable_tablet_primary_key_filter = _enable_pk_filter;
+        EXPECT_TRUE(io::global_local_filesystem()->delete_directory(_absolute_dir).ok());
+        if (k_engine != nullptr) {
+            k_engine->stop();
+            delete k_engine;
+            k_engine = nullptr;
+        }
+    }
+
+    // A merge-on-write unique key tablet of (k INT, v INT, DELETE_SIGN[, SEQUENCE_COL INT]).
+    TabletSharedPtr create_tablet(bool has_sequence_col) {
+        std::vector<std::tuple<std::string, TPrimitiveType::type, bool>> columns {
+                {"k", TPrimitiveType::INT, true},
+                {"v", TPrimitiveType::INT, false},
+                {DELETE_SIGN, TPrimitiveType::TINYINT, false}};
+        if (has_sequence_col) {
+            columns.emplace_back(SEQUENCE_COL, TPrimitiveType::INT, false);
+        }
+        std::vector<TColumn> cols;
+        std::unordered_map<uint32_t, uint32_t> col_ordinal_to_unique_id;
+        for (uint32_t i = 0; i < columns.size(); i++) {
+            TColumn col;
+            col.__set_column_name(std::get<0>(columns[i]));
+            col.column_type.type = std::get<1>(columns[i]);
+            col.__set_is_key(std::get<2>(columns[i]));
+            cols.push_back(col);
+            col_ordinal_to_unique_id[i] = i;
+        }
+
+        TTabletSchema t_tablet_schema;
+        t_tablet_schema.__set_short_key_column_count(1);
+        t_tablet_schema.__set_schema_hash(3333);
+        t_tablet_schema.__set_keys_type(TKeysType::UNIQUE_KEYS);
+        t_tablet_schema.__set_storage_type(TStorageType::COLUMN);
+        t_tablet_schema.__set_columns(cols);
+        t_tablet_schema.__set_delete_sign_idx(2);
+        if (has_sequence_col) {
+            t_tablet_schema.__set_sequence_col_idx(3);
+        }
+        TabletMetaSharedPtr tablet_meta(
+                new TabletMeta(1, 1, 1, 1, 1, 1, t_tablet_schema, columns.size(),
+                               col_ordinal_to_unique_id, UniqueId(1, 2),
+                               TTabletType::TABLET_TYPE_DISK, TCompressionType::LZ4F, 0, true));
+        TabletSharedPtr tablet(new Tablet(tablet_meta, nullptr));
+        EXPECT_TRUE(tablet->init().ok());
+        return tablet;
+    }
+
+    // Write a rowset of `version` with a segment for each of `segments`, and add it to `tablet`.
+    RowsetSharedPtr add_rowset(TabletSharedPtr tablet, int64_t version,
+                               const std::vector<Rows>& segments) {
+        static int64_t inc_id = 10000;
+        auto tablet_schema = tablet->tablet_schema();
+        RowsetWriterContext context;
+        context.rowset_id.init(inc_id++);
+        context.rowset_type = BETA_ROWSET;
+        context.rowset_state = VISIBLE;
+        context.tablet_schema = tablet_schema;
+        context.rowset_dir = _absolute_dir;
+        context.version = Version(version, version);
+        context.segments_overlap = NONOVERLAPPING;
+        context.max_rows_per_segment = UINT32_MAX;
+        context.enable_unique_key_merge_on_write = true;
+
+        std::unique_ptr<RowsetWriter> rowset_writer;
+        EXPECT_TRUE(RowsetFactory::create_rowset_writer(context, false, &rowset_writer).ok());
+        for (auto& rows : segments) {
+            vectorized::Block block = tablet_schema->create_block();
+            auto columns = block.mutate_columns();
+            for (auto [key, seq] : rows) {
+                int32_t value = key * 10;
+                int8_t delete_sign = 0;
+                columns[0]->insert_data((const char*)&key, sizeof(key));
+                columns[1]->insert_data((const char*)&value, sizeof(value));
+                columns[2]->insert_data((const char*)&delete_sign, sizeof(delete_sign));
+                if (tablet_schema->has_sequence_col()) {
+                    columns[3]->insert_data((const char*)&seq, sizeof(seq));
+                }
+            }
+            EXPECT_TRUE(rowset_writer->add_block(&block).ok());
+            EXPECT_TRUE(rowset_writer->flush().ok());
+        }
+        RowsetSharedPtr rowset = rowset_writer->build();
+        EXPECT_NE(nullptr, rowset);
+        EXPECT_TRUE(tablet->add_rowset(rowset).ok());
+        return rowset;
+    }
+
+    static Rows make_rows(int32_t begin, int32_t end, int32_t seq = 0) {
+        Rows rows;
+        for (int32_t key = begin; key < end; key++) {
+            rows.emplace_back(key, seq);
+        }
+        return rows;
+    }
+
+    static void delete_row(TabletSharedPtr tablet, RowsetSharedPtr rowset, uint32_t segment_id,
+                           uint32_t row_id, int64_t version) {
+        tablet->tablet_meta()->delete_bitmap().add({rowset->rowset_id(), segment_id, version},
+                                                   row_id);
+    }
+
+    static std::string encode_key(int32_t key, const int32_t* seq = nullptr) {
+        std::string encoded_key;
+        const KeyCoder* coder = get_key_coder(FieldType::OLAP_FIELD_TYPE_INT);
+        encoded_key.push_back(KEY_NORMAL_MARKER);
+        coder->full_encode_ascending(&key, &encoded_key);
+        if (seq != nullptr) {
+            encoded_key.push_back(KEY_NORMAL_MARKER);
+            coder->full_encode_ascending(seq, &encoded_key);
+        }
+        return encoded_key;
+    }
+
+    // Build the primary key filter of `tablet` if `enable_pk_filter`, otherwise drop it.
+    static void update_pk_filter(TabletSharedPtr tablet, bool enable_pk_filter) {
+        config::enable_tablet_primary_key_filter = enable_pk_filter;
+        EXPECT_TRUE(tablet->update_primary_key_filter().ok());
+        EXPECT_EQ(enable_pk_filter, tablet->_pk_filter != nullptr);
+    }
+
+    static Status lookup(TabletSharedPtr tablet, const std::vector<RowsetSharedPtr>& rowsets,
+                         int64_t version, const std::string& encoded_key, bool with_seq_col,
+                         RowLocation* loc) {
+        std::vector<std::unique_ptr<SegmentCacheHandle>> segment_caches(rowsets.size());
+        return tablet->lookup_row_key(encoded_key, with_seq_col, rowsets, loc, version,
+                                      segment_caches);
+    }
+
+    static void expect_found(TabletSharedPtr tablet, const std::vector<RowsetSharedPtr>& rowsets,
+                             int64_t version, int32_t key, RowsetSharedPtr rowset,
+                             uint32_t segment_id, uint32_t row_id) {
+        RowLocation loc;
+        auto st = lookup(tablet, rowsets, version, encode_key(key), false, &loc);
+        ASSERT_TRUE(st.ok()) << "key: " << key << ", st: " << st;
+        EXPECT_EQ(rowset->rowset_id(), loc.rowset_id) << "key: " << key;
+        EXPECT_EQ(segment_id, loc.segment_id) << "key: " << key;
+        EXPECT_EQ(row_id, loc.row_id) << "key: " << key;
+    }
+
+    static void expect_not_found(TabletSharedPtr tablet,
+                                 const std::vector<RowsetSharedPtr>& rowsets, int64_t version,
+                                 int32_t key) {
+        RowLocation loc;
+        auto st = lookup(tablet, rowsets, version, encode_key(key), false, &loc);
+        EXPECT_TRUE(st.is<NOT_FOUND>()) << "key: " << key << ", st: " << st;
+    }
+
+    std::string _absolute_dir;
+    bool _enable_pk_filter = false;
+};
+
+TEST_F(TabletPrimaryKeyFilterTest, lookup_row_key) {
+    for (bool enable_pk_filter : {false, true}) {
+        auto tablet = create_tablet(false);
+        auto rs2 = add_rowset(tablet, 2, {make_rows(0, 50), make_rows(50, 100)});
+        // keys 50-99 are overwritten, and key 40 is deleted before the filter is built
+        auto rs3 = add_rowset(tablet, 3, {make_rows(50, 150)});
+        for (uint32_t row_id = 0; row_id < 50; row_id++) {
+            delete_row(tablet, rs2, 1, row_id, 3);
+        }
+        delete_row(tablet, rs2, 0, 40, 3);
+        update_pk_filter(tablet, enable_pk_filter);
+        if (enable_pk_filter) {
+            EXPECT_EQ(2, tablet->_pk_filter->num_rowsets());
+            EXPECT_EQ(149, tablet->_pk_filter->num_keys());
+            EXPECT_EQ(3, tablet->_pk_filter->version());
+        }
+
+        // keys 20 and 120 are overwritten by the rowset not covered by the filter, and key 30
+        // is deleted after the filter is built
+        auto rs4 = add_rowset(tablet, 4, {{{20, 0}, {120, 0}}});
+        delete_row(tablet, rs2, 0, 20, 4);
+        delete_row(tablet, rs3, 0, 70, 4);
+        delete_row(tablet, rs2, 0, 30, 5);
+
+        std::vector<RowsetSharedPtr> rowsets {rs4, rs3, rs2};
+        if (enable_pk_filter) {
+            EXPECT_TRUE(tablet->_pk_filter->covered_by(rowsets));
+        }
+        expect_found(tablet, rowsets, 5, 10, rs2, 0, 10);
+        expect_found(tablet, rowsets, 5, 20, rs4, 0, 0);
+        expect_not_found(tablet, rowsets, 5, 30);
+        expect_not_found(tablet, rowsets, 5, 40);
+        expect_found(tablet, rowsets, 5, 60, rs3, 0, 10);
+        expect_found(tablet, rowsets, 5, 120, rs4, 0, 1);
+        expect_found(tablet, rowsets, 5, 149, rs3, 0, 99);
+        expect_not_found(tablet, rowsets, 5, 150);
+        expect_not_found(tablet, rowsets, 5, -1);
+        // key 30 is not deleted yet at version 4
+        expect_found(tablet, rowsets, 4, 30, rs2, 0, 30);
+
+        // the filter is not used for rowsets which don't end with the covered rowsets
+        std::vector<RowsetSharedPtr> newer_rowsets {rs4, rs3};
+        expect_found(tablet, newer_rowsets, 5, 60, rs3, 0, 10);
+        expect_not_found(tablet, newer_rowsets, 5, 10);
+    }
+}
+
+TEST_F(TabletPrimaryKeyFilterTest, lookup_row_key_with_sequence_col) {
+    for (bool enable_pk_filter : {false, true}) {
+        auto tablet = create_tablet(true);
+        auto rs2 = add_rowset(tablet, 2, {make_rows(0, 100, 10)});
+        // keys 0-49 are loaded again with a lower sequence value, so the new rows are deleted
+        Rows rows = make_rows(0, 50, 5);
+        Rows new_rows = make_rows(100, 150, 5);
+        rows.insert(rows.end(), new_rows.begin(), new_rows.end());
+        auto rs3 = add_rowset(tablet, 3, {rows});
+        for (uint32_t row_id = 0; row_id < 50; row_id++) {
+            delete_row(tablet, rs3, 0, row_id, 3);
+        }
+        update_pk_filter(tablet, enable_pk_filter);
+        if (enable_pk_filter) {
+            EXPECT_EQ(150, tablet->_pk_filter->num_keys());
+        }
+
+        // key 60 is loaded with a higher sequence value and key 70 with a lower one by the
+        // rowset not covered by the filter
+        auto rs4 = add_rowset(tablet, 4, {{{60, 20}, {70, 1}}});
+        delete_row(tablet, rs2, 0, 60, 4);
+        delete_row(tablet, rs4, 0, 1, 4);
+
+        std::vector<RowsetSharedPtr> rowsets {rs4, rs3, rs2};
+        expect_found(tablet, rowsets, 4, 10, rs2, 0, 10);
+        expect_found(tablet, rowsets, 4, 60, rs4, 0, 0);
+        expect_found(tablet, rowsets, 4, 70, rs2, 0, 70);
+        expect_found(tablet, rowsets, 4, 120, rs3, 0, 70);
+        expect_not_found(tablet, rowsets, 4, 150);
+
+        // the sequence value of the live row is compared with the given one
+        RowLocation loc;
+        int32_t seq = 15;
+        auto st = lookup(tablet, rowsets, 4, encode_key(60, &seq), true, &loc);
+        EXPECT_TRUE(st.is<ALREADY_EXIST>()) << st;
+        EXPECT_EQ(rs4->rowset_id(), loc.rowset_id);
+        st = lookup(tablet, rowsets, 4, encode_key(10, &seq), true, &loc);
+        EXPECT_TRUE(st.ok()) << st;
+        EXPECT_EQ(rs2->rowset_id(), loc.rowset_id);
+        EXPECT_EQ(10, loc.row_id);
+    }
+}
+
+TEST_F(TabletPrimaryKeyFilterTest, need_update_primary_key_filter) {
+    config::enable_tablet_primary_key_filter = true;
+    int32_t rebuild_percent = config::tablet_primary_key_filter_rebuild_percent;
+    config::tablet_primary_key_filter_rebuild_percent = 20;
+    auto tablet = create_tablet(false);
+    add_rowset(tablet, 2, {make_rows(0, 100)});
+    // no filter yet
+    EXPECT_TRUE(tablet->need_update_primary_key_filter(ReaderType::READER_CUMULATIVE_COMPACTION));
+    update_pk_filter(tablet, true);
+
+    add_rowset(tablet, 3, {make_rows(100, 110)});
+    EXPECT_FALSE(tablet->need_update_primary_key_filter(ReaderType::READER_CUMULATIVE_COMPACTION));
+    EXPECT_TRUE(tablet->need_update_primary_key_filter(ReaderType::READER_BASE_COMPACTION));
+    EXPECT_TRUE(tablet->need_update_primary_key_filter(ReaderType::READER_FULL_COMPACTION));
+    // 20 rows are loaded since the filter of 100 keys was built
+    add_rowset(tablet, 4, {make_rows(110, 120)});
+    EXPECT_TRUE(tablet->need_update_primary_key_filter(ReaderType::READER_CUMULATIVE_COMPACTION));
+
+    // the filter is dropped once disabled
+    config::enable_tablet_primary_key_filter = false;
+    EXPECT_FALSE(tablet->need_update_primary_key_filter(ReaderType::READER_BASE_COMPACTION));
+    EXPECT_EQ(nullptr, tablet->_pk_filter);
+    config::tablet_primary_key_filter_rebuild_percent = rebuild_percent;
+}
+
+} // namespace doris
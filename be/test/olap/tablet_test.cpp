@@ -287,6 +287,37 @@ TEST_F(TestTablet, pad_rowset) {
     ASSERT_TRUE(_tablet->capture_rs_readers(version, &splits).ok());
 }
 
+TEST_F(TestTablet, read_heat) {
+    TabletSharedPtr tablet(new Tablet(_tablet_meta, nullptr));
+    int64_t now_ms = UnixMillis();
+    EXPECT_EQ(0, tablet->read_heat(now_ms));
+
+    int64_t half_life_ms = config::compaction_read_heat_half_life_sec * 1000;
+    tablet->update_read_amplification(90, 10);
+    EXPECT_NEAR(100, tablet->read_heat(UnixMillis()), 1);
+    tablet->update_read_amplification(100, 0);
+    EXPECT_NEAR(200, tablet->read_heat(UnixMillis()), 1);
+    EXPECT_NEAR(100, tablet->read_heat(UnixMillis() + half_life_ms), 1);
+    EXPECT_NEAR(50, tablet->read_heat(UnixMillis() + 2 * half_life_ms), 1);
+}
+
+TEST_F(TestTablet, compaction_priority) {
+    TabletSharedPtr tablet(new Tablet(_tablet_meta, nullptr));
+    int64_t now_ms = UnixMillis();
+    auto weight = config::compaction_read_heat_weight;
+    // not boosted by default
+    tablet->update_read_amplification(1, 0);
+    EXPECT_EQ(10, tablet->calc_compaction_priority(10, now_ms));
+
+    config::compaction_read_heat_weight = 0.5;
+    // 1 + 0.5 * log2(1 + 1)
+    EXPECT_NEAR(15, tablet->calc_compaction_priority(10, now_ms), 0.1);
+    // the boost is capped at 2
+    tablet->update_read_amplification(1000, 0);
+    EXPECT_NEAR(20, tablet->calc_compaction_priority(10, now_ms), 0.1);
+    config::compaction_read_heat_weight = weight;
+}
+
 TEST_F(TestTablet, cooldown_policy) {
     std::vector<RowsetMetaSharedPtr> rs_metas;
     RowsetMetaSharedPtr ptr1(new RowsetMeta());
@@ -0,0 +1,154 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "pipeline/task_queue.h"
+
+#include <gen_cpp/Types_types.h>
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <set>
+#include <vector>
+
+#include "common/config.h"
+#include "pipeline/pipeline.h"
+#include "pipeline/pipeline_task.h"
+#include "util/cpu_info.h"
+
+namespace doris::pipeline {
+
+static constexpr size_t NUM_CORES = 8;
+
+// Simulates two NUMA nodes, the first half of the cores of CpuInfo are on node 0 and the rest on
+// node 1. A queue of NUM_CORES workers puts workers 0-3 on node 0 and workers 4-7 on node 1.
+class TaskQueueTest : public testing::Test {
+protected:
+    void SetUp() override {
+        if (CpuInfo::max_num_cores_ < 2) {
+            GTEST_SKIP() << "two NUMA nodes need at least two cores";
+        }
+        _numa_aware_scheduling = config::enable_pipeline_numa_aware_scheduling;
+        _max_num_numa_nodes = CpuInfo::max_num_numa_nodes_;
+        std::vector<int> core_to_numa_node;
+        for (int core = 0; core < CpuInfo::max_num_cores_; ++core) {
+            _core_to_numa_node.push_back(CpuInfo::core_to_numa_node_[core]);
+            core_to_numa_node.push_back(core < CpuInfo::max_num_cores_ / 2 ? 0 : 1);
+        }
+        CpuInfo::_init_fake_numa_for_test(2, core_to_numa_node);
+        config::enable_pipeline_numa_aware_scheduling = true;
+    }
+
+    void TearDown() override {
+        if (_core_to_numa_node.empty()) {
+            return;
+        }
+        config::enable_pipeline_numa_aware_scheduling = _numa_aware_scheduling;
+        CpuInfo::_init_fake_numa_for_test(_max_num_numa_nodes, _core_to_numa_node);
+    }
+
+    // The tasks are never executed, they only need a pipeline for the previous core id.
+    PipelineTask* create_task() {
+        PipelinePtr pipeline =
+                std::make_shared<Pipeline>(0, std::weak_ptr<PipelineFragmentContext>());
+        Operators operators {nullptr};
+        OperatorPtr sink;
+        _tasks.push_back(std::make_unique<PipelineTask>(pipeline, 0, nullptr, operators, sink,
+                                                        nullptr, nullptr));
+        return _tasks.back().get();
+    }
+
+    // Push a task to each of the given workers, then steal them all from `core_id`. Returns the
+    // workers the tasks were stolen from.
+    std::vector<int> steal_order(MultiCoreTaskQueue* queue, size_t core_id,
+                                 const std::vector<size_t>& cores) {
+        for (auto core : cores) {
+            EXPECT_TRUE(queue->push_back(create_task(), core).ok());
+        }
+        std::vector<int> order;
+        while (auto* task = queue->_steal_take(core_id)) {
+            order.push_back(task->get_core_id());
+        }
+        return order;
+    }
+
+    bool _numa_aware_scheduling = false;
+    int _max_num_numa_nodes = 0;
+    std::vector<int> _core_to_numa_node;
+    std::vector<std::unique_ptr<PipelineTask>> _tasks;
+};
+
+TEST_F(TaskQueueTest, GroupWorkersByNumaNode) {
+    MultiCoreTaskQueue queue(NUM_CORES);
+    EXPECT_EQ((std::vector<std::vector<size_t>> {{0, 1, 2, 3}, {4, 5, 6, 7}}),
+              queue._numa_node_cores);
+    EXPECT_EQ((std::vector<size_t> {0, 0, 0, 0, 1, 1, 1, 1}), queue._core_numa_node);
+    EXPECT_EQ((std::vector<size_t> {0, 1, 2, 3, 0, 1, 2, 3}), queue._core_idx_in_node);
+    queue.close();
+}
+
+TEST_F(TaskQueueTest, NumaAwareSchedulingDisabled) {
+    config::enable_pipeline_numa_aware_scheduling = false;
+    MultiCoreTaskQueue queue(NUM_CORES);
+    EXPECT_EQ((std::vector<std::vector<size_t>> {{0, 1, 2, 3, 4, 5, 6, 7}}),
+              queue._numa_node_cores);
+    EXPECT_EQ((std::vector<size_t> {0, 1, 2, 3, 4, 5, 6, 7}), queue._core_idx_in_node);
+
+    TUniqueId instance_id;
+    instance_id.__set_hi(1);
+    instance_id.__set_lo(2);
+    EXPECT_EQ(0, queue._numa_node_of_instance(instance_id));
+    queue.close();
+}
+
+TEST_F(TaskQueueTest, PlaceInstancesOnOneNumaNode) {
+    MultiCoreTaskQueue queue(NUM_CORES);
+    std::set<size_t> numa_nodes;
+    for (int64_t i = 0; i < 16; ++i) {
+        TUniqueId instance_id;
+        instance_id.__set_hi(0x1234);
+        instance_id.__set_lo(0x1234 + i);
+        size_t numa_node = queue._numa_node_of_instance(instance_id);
+        EXPECT_EQ(static_cast<size_t>((0x1234 ^ (0x1234 + i)) % 2), numa_node);
+        // all the tasks of an instance go to the same node
+        EXPECT_EQ(numa_node, queue._numa_node_of_instance(instance_id));
+        numa_nodes.insert(numa_node);
+    }
+    EXPECT_EQ((std::set<size_t> {0, 1}), numa_nodes);
+
+    // a task scheduled before goes back to its previous worker
+    auto* task = create_task();
+    task->set_previous_core_id(6);
+    ASSERT_TRUE(queue.push_back(task).ok());
+    EXPECT_EQ(task, queue._prio_task_queue_list[6].try_take(false));
+    queue.close();
+}
+
+TEST_F(TaskQueueTest, StealFromSameNumaNodeFirst) {
+    MultiCoreTaskQueue queue(NUM_CORES);
+    // the workers of the same node after the thief come first, then the other node in order
+    EXPECT_EQ((std::vector<int> {2, 3, 0, 4, 5, 6, 7}),
+              steal_order(&queue, 1, {0, 2, 3, 4, 5, 6, 7}));
+    EXPECT_EQ((std::vector<int> {7, 4, 5, 0, 1, 2, 3}),
+              steal_order(&queue, 6, {0, 1, 2, 3, 4, 5, 7}));
+    // the thief does not steal from itself
+    ASSERT_TRUE(queue.push_back(create_task(), 3).ok());
+    EXPECT_EQ(nullptr, queue._steal_take(3));
+    EXPECT_EQ(std::vector<int> {3}, steal_order(&queue, 0, {}));
+    queue.close();
+}
+
+} // namespace doris::pipeline
@@ -0,0 +1,116 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "pipeline/wakeup_dependency.h"
+
+#include <gtest/gtest.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "pipeline/task_scheduler.h"
+
+namespace doris::pipeline {
+
+// The tasks are only passed around by pointer, and the schedulers are not started, so the tasks
+// woken up stay in their _woken_tasks.
+static PipelineTask* fake_task(intptr_t id) {
+    return reinterpret_cast<PipelineTask*>(id);
+}
+
+TEST(WakeupDependencyTest, ParkWithStaleSequence) {
+    WakeupDependency dependency;
+    BlockedTaskScheduler scheduler(nullptr);
+
+    uint64_t wakeup_seq = dependency.wakeup_seq();
+    dependency.notify();
+    EXPECT_FALSE(dependency.park(fake_task(1), &scheduler, wakeup_seq));
+    EXPECT_TRUE(scheduler._woken_tasks.empty());
+
+    EXPECT_TRUE(dependency.park(fake_task(1), &scheduler, dependency.wakeup_seq()));
+    EXPECT_TRUE(scheduler._woken_tasks.empty());
+}
+
+TEST(WakeupDependencyTest, NotifyWakesUpParkedTasksOnly) {
+    WakeupDependency dependency;
+    WakeupDependency other_dependency;
+    BlockedTaskScheduler scheduler(nullptr);
+    BlockedTaskScheduler other_scheduler(nullptr);
+
+    EXPECT_TRUE(dependency.park(fake_task(1), &scheduler, dependency.wakeup_seq()));
+    EXPECT_TRUE(dependency.park(fake_task(2), &other_scheduler, dependency.wakeup_seq()));
+    EXPECT_TRUE(other_dependency.park(fake_task(3), &scheduler, other_dependency.wakeup_seq()));
+
+    dependency.notify();
+    EXPECT_EQ(std::vector<PipelineTask*> {fake_task(1)}, scheduler._woken_tasks);
+    EXPECT_EQ(std::vector<PipelineTask*> {fake_task(2)}, other_scheduler._woken_tasks);
+
+    // the woken tasks are not parked any more
+    dependency.notify();
+    EXPECT_EQ(1, scheduler._woken_tasks.size());
+    EXPECT_EQ(1, other_scheduler._woken_tasks.size());
+
+    other_dependency.notify();
+    EXPECT_EQ((std::vector<PipelineTask*> {fake_task(1), fake_task(3)}), scheduler._woken_tasks);
+}
+
+TEST(WakeupDependencyTest, UnparkAll) {
+    WakeupDependency dependency;
+    BlockedTaskScheduler scheduler(nullptr);
+    BlockedTaskScheduler other_scheduler(nullptr);
+
+    EXPECT_TRUE(dependency.park(fake_task(1), &scheduler, dependency.wakeup_seq()));
+    EXPECT_TRUE(dependency.park(fake_task(2), &other_scheduler, dependency.wakeup_seq()));
+    EXPECT_TRUE(dependency.park(fake_task(3), &scheduler, dependency.wakeup_seq()));
+
+    std::vector<PipelineTask*> tasks;
+    dependency.unpark_all(&scheduler, &tasks);
+    EXPECT_EQ((std::vector<PipelineTask*> {fake_task(1), fake_task(3)}), tasks);
+
+    // the unparked tasks are not handed back to the scheduler again
+    dependency.notify();
+    EXPECT_TRUE(scheduler._woken_tasks.empty());
+    EXPECT_EQ(std::vector<PipelineTask*> {fake_task(2)}, other_scheduler._woken_tasks);
+
+    tasks.clear();
+    dependency.unpark_all(&other_scheduler, &tasks);
+    EXPECT_TRUE(tasks.empty());
+}
+
+TEST(WakeupDependencyTest, NoLostWakeup) {
+    for (int i = 0; i < 1000; ++i) {
+        WakeupDependency dependency;
+        BlockedTaskScheduler scheduler(nullptr);
+        std::atomic<bool> ready = false;
+
+        std::thread notifier([&]() {
+            ready = true;
+            dependency.notify();
+        });
+        // the same order as the scheduler: read the sequence, check the state, then park
+        uint64_t wakeup_seq = dependency.wakeup_seq();
+        bool parked = !ready && dependency.park(fake_task(1), &scheduler, wakeup_seq);
+        notifier.join();
+
+        // a parked task must have been woken up by the notification
+        EXPECT_EQ(parked ? 1 : 0, scheduler._woken_tasks.size());
+    }
+}
+
+} // namespace doris::pipeline
@@ -52,14 +52,20 @@
 #include "olap/types.h"
 #include "testutil/test_util.h"
 #include "util/debug_util.h"
+#include "vec/columns/columns_number.h"
+#include "vec/common/arena.h"
+#include "vec/common/columns_hashing.h"
+#include "vec/common/hash_table/hash.h"
+#include "vec/common/hash_table/ph_hash_map.h"
 
 DEFINE_string(operation, "Custom",
               "valid operation: Custom, BinaryDictPageEncode, BinaryDictPageDecode, SegmentScan, "
               "SegmentWrite, "
-              "SegmentScanByFile, SegmentWriteByFile");
+              "SegmentScanByFile, SegmentWriteByFile, HashTableEmplace");
 DEFINE_string(input_file, "./sample.dat", "input file directory");
 DEFINE_string(column_type, "int,varchar", "valid type: int, char, varchar, string");
 DEFINE_string(rows_number, "10000", "rows number");
+DEFINE_string(key_cardinality, "1000000", "distinct keys number, used by HashTableEmplace");
 DEFINE_string(iterations, "10",
               "run times, this is set to 0 means the number of iterations is automatically set ");
 
@@ -78,6 +84,8 @@ std::string get_usage(const std::string& progname) {
           "--rows_number=10000 --iterations=40\n";
     ss << "./benchmark_tool --operation=SegmentScan --column_type=int,varchar "
           "--rows_number=10000 --iterations=0\n";
+    ss << "./benchmark_tool --operation=HashTableEmplace "
+          "--rows_number=10000000 --key_cardinality=1000000 --iterations=10\n";
     ss << "./benchmark_tool --operation=SegmentWrite --column_type=int "
           "--rows_number=10000 --iterations=10\n";
     ss << "./benchmark_tool --operation=SegmentScanByFile --input_file=./sample.dat "
@@ -229,6 +237,67 @@ private:
     int _rows_number;
 }; // namespace doris
 
+// Emplace a column of UInt64 keys into a PHHashMap, either row by row (hash and probe one row
+// at a time) or batched (hash the whole column first, then emplace with the bucket
+// HASH_MAP_PREFETCH_DIST rows ahead prefetched). Vary --key_cardinality to compare them with
+// the hash table smaller and larger than the cache.
+class HashTableEmplaceBenchmark : public BaseBenchmark {
+public:
+    using HashMap = PHHashMap<vectorized::UInt64, vectorized::AggregateDataPtr,
+                              HashCRC32<vectorized::UInt64>>;
+    using State = vectorized::ColumnsHashing::HashMethodOneNumber<
+            HashMap::value_type, vectorized::AggregateDataPtr, vectorized::UInt64, false>;
+
+    HashTableEmplaceBenchmark(const std::string& name, int iterations, int rows_number,
+                              int key_cardinality, bool batched)
+            : BaseBenchmark(name + (batched ? "/batched" : "/row_by_row") +
+                                    "/rows_number:" + std::to_string(rows_number) +
+                                    "/key_cardinality:" + std::to_string(key_cardinality),
+                            iterations),
+              _rows_number(rows_number),
+              _key_cardinality(key_cardinality),
+              _batched(batched) {}
+    ~HashTableEmplaceBenchmark() override = default;
+
+    void init() override {
+        if (!_keys) {
+            _keys = vectorized::ColumnUInt64::create();
+            std::mt19937_64 rng(0);
+            for (int i = 0; i < _rows_number; i++) {
+                _keys->insert_value(rng() % _key_cardinality);
+            }
+        }
+        _hash_map = std::make_unique<HashMap>();
+        _arena = std::make_unique<vectorized::Arena>();
+    }
+
+    void run() override {
+        State state(_keys.get());
+        size_t inserted = 0;
+        if (_batched) {
+            state.get_hash_values(*_hash_map, _rows_number, *_arena, _hash_values);
+            state.emplace_keys(*_hash_map, _hash_values, 0, _rows_number, *_arena,
+                               [&](size_t, auto& emplace_result) {
+                                   inserted += emplace_result.is_inserted();
+                               });
+        } else {
+            for (int i = 0; i < _rows_number; i++) {
+                inserted += state.emplace_key(*_hash_map, i, *_arena).is_inserted();
+            }
+        }
+        benchmark::DoNotOptimize(inserted);
+    }
+
+private:
+    int _rows_number;
+    int _key_cardinality;
+    bool _batched;
+    vectorized::ColumnUInt64::MutablePtr _keys;
+    std::unique_ptr<HashMap> _hash_map;
+    std::unique_ptr<vectorized::Arena> _arena;
+    std::vector<size_t> _hash_values;
+};
+
 // This is sample custom test. User can write custom test code at custom_init()&custom_run().
 // Call method: ./benchmark_tool --operation=Custom
 class CustomBenchmark : public BaseBenchmark {
@@ -286,6 +355,12 @@ public:
         } else if (equal_ignore_case(FLAGS_operation, "BinaryDictPageDecode")) {
             benchmarks.emplace_back(new doris::BinaryDictPageDecodeBenchmark(
                     FLAGS_operation, std::stoi(FLAGS_iterations), std::stoi(FLAGS_rows_number)));
+        } else if (equal_ignore_case(FLAGS_operation, "HashTableEmplace")) {
+            for (bool batched : {false, true}) {
+                benchmarks.emplace_back(new doris::HashTableEmplaceBenchmark(
+                        FLAGS_operation, std::stoi(FLAGS_iterations), std::stoi(FLAGS_rows_number),
+                        std::stoi(FLAGS_key_cardinality), batched));
+            }
         } else {
             std::cout << "operation invalid!" << std::endl;
         }
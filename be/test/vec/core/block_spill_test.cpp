@@ -22,6 +22,7 @@
 #include <unistd.h>
 
 #include <cmath>
+#include <future>
 #include <iostream>
 #include <memory>
 #include <string>
@@ -494,4 +495,47 @@ TEST_F(TestBlockSpill, TestBitmap) {
     auto bitmap_str = convert_bitmap_to_string(real_column->get_element(0));
     EXPECT_EQ(bitmap_str, expected_bitmap_str[3 * batch_size]);
 }
+
+TEST_F(TestBlockSpill, TestSubmitIO) {
+    int batch_size = 3;
+    auto col = vectorized::ColumnVector<int>::create();
+    for (int i = 0; i < batch_size; ++i) {
+        col->get_data().push_back(i);
+    }
+    vectorized::DataTypePtr data_type(std::make_shared<vectorized::DataTypeInt32>());
+    vectorized::Block block({vectorized::ColumnWithTypeAndName(col->get_ptr(), data_type,
+                                                               "spill_block_test_submit_io")});
+
+    auto data_dir_index = block_spill_manager->select_data_dir();
+    EXPECT_EQ(data_dir_index, 0U);
+    vectorized::BlockSpillWriterUPtr spill_block_writer;
+    auto st = block_spill_manager->get_writer(data_dir_index, batch_size, spill_block_writer,
+                                              profile_);
+    EXPECT_TRUE(st.ok());
+    auto stream_id = spill_block_writer->get_id();
+    EXPECT_EQ(block_spill_manager->get_data_dir_index(stream_id), data_dir_index);
+
+    std::promise<Status> write_status;
+    st = block_spill_manager->submit_io(data_dir_index, [&]() {
+        auto write_st = spill_block_writer->write(block);
+        if (write_st.ok()) {
+            write_st = spill_block_writer->close();
+        }
+        write_status.set_value(write_st);
+    });
+    EXPECT_TRUE(st.ok());
+    EXPECT_TRUE(write_status.get_future().get().ok());
+
+    vectorized::BlockSpillReaderUPtr spill_block_reader;
+    st = block_spill_manager->get_reader(stream_id, spill_block_reader, profile_);
+    EXPECT_TRUE(st.ok());
+
+    vectorized::Block block_read;
+    bool eos = false;
+    st = spill_block_reader->read(&block_read, &eos);
+    EXPECT_TRUE(st.ok());
+    EXPECT_FALSE(eos);
+    EXPECT_EQ(block_read.rows(), batch_size);
+    spill_block_reader->close();
+}
 } // namespace doris
@@ -156,6 +156,66 @@ void serialize_and_deserialize_test(segment_v2::CompressionTypePB compression_ty
         std::string s2 = pblock2.DebugString();
         EXPECT_EQ(s1, s2);
     }
+    // low cardinality string, dictionary encoded if enabled
+    for (bool dict_encoding : {true, false}) {
+        config::enable_block_string_dict_encoding = dict_encoding;
+        auto strcol = vectorized::ColumnString::create();
+        std::vector<std::string> vals = {"beijing", "shanghai", "", "shenzhen"};
+        for (int i = 0; i < 1024; ++i) {
+            strcol->insert_data(vals[i % 7 % 4].c_str(), vals[i % 7 % 4].size());
+        }
+        vectorized::DataTypePtr data_type(std::make_shared<vectorized::DataTypeString>());
+        vectorized::ColumnWithTypeAndName type_and_name(strcol->get_ptr(), data_type,
+                                                        "test_dict_string");
+        vectorized::Block block({type_and_name});
+        PBlock pblock;
+        block_to_pb(block, &pblock, compression_type);
+        auto plain_bytes = data_type->get_uncompressed_serialized_bytes(
+                *strcol, BeExecVersionManager::get_newest_version());
+        if (dict_encoding) {
+            EXPECT_LT(static_cast<int64_t>(pblock.uncompressed_size()), plain_bytes);
+        } else {
+            EXPECT_EQ(static_cast<int64_t>(pblock.uncompressed_size()), plain_bytes);
+        }
+        std::string s1 = pblock.DebugString();
+
+        vectorized::Block block2(pblock);
+        EXPECT_EQ(1024, block2.rows());
+        const auto& column = block2.get_by_position(0).column;
+        for (int i = 0; i < 1024; ++i) {
+            EXPECT_EQ(vals[i % 7 % 4], column->get_data_at(i).to_string());
+        }
+        PBlock pblock2;
+        block_to_pb(block2, &pblock2, compression_type);
+        std::string s2 = pblock2.DebugString();
+        EXPECT_EQ(s1, s2);
+    }
+    // high cardinality string, the sampled rows skip the dictionary
+    {
+        config::enable_block_string_dict_encoding = true;
+        auto strcol = vectorized::ColumnString::create();
+        for (int i = 0; i < 1024; ++i) {
+            std::string val = "value_" + std::to_string(i);
+            strcol->insert_data(val.c_str(), val.size());
+        }
+        vectorized::DataTypePtr data_type(std::make_shared<vectorized::DataTypeString>());
+        vectorized::ColumnWithTypeAndName type_and_name(strcol->get_ptr(), data_type,
+                                                        "test_plain_string");
+        vectorized::Block block({type_and_name});
+        PBlock pblock;
+        block_to_pb(block, &pblock, compression_type);
+        EXPECT_EQ(static_cast<int64_t>(pblock.uncompressed_size()),
+                  data_type->get_uncompressed_serialized_bytes(
+                          *strcol, BeExecVersionManager::get_newest_version()));
+
+        vectorized::Block block2(pblock);
+        EXPECT_EQ(1024, block2.rows());
+        const auto& column = block2.get_by_position(0).column;
+        for (int i = 0; i < 1024; ++i) {
+            EXPECT_EQ("value_" + std::to_string(i), column->get_data_at(i).to_string());
+        }
+        config::enable_block_string_dict_encoding = false;
+    }
     // decimal
     {
         vectorized::DataTypePtr decimal_data_type(doris::vectorized::create_decimal(27, 9, true));
@@ -0,0 +1,64 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/vaggregation_node.h"
+
+#include <gtest/gtest-message.h>
+#include <gtest/gtest-test-part.h>
+
+#include <vector>
+
+#include "gtest/gtest_pred_impl.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/columns_number.h"
+
+namespace doris::vectorized {
+
+TEST(BlockKeysCardinalityEstimatorTest, Estimate) {
+    BlockKeysCardinalityEstimator estimator;
+    for (size_t distinct_keys : {1, 10, 100, 1000, 4096}) {
+        auto column = ColumnInt64::create();
+        for (size_t i = 0; i < 4096; ++i) {
+            column->insert_value(i % distinct_keys);
+        }
+        ColumnRawPtrs key_columns {column.get()};
+        auto estimate = estimator.estimate(key_columns, column->size());
+        EXPECT_NEAR(estimate, distinct_keys, distinct_keys * 0.1 + 1);
+    }
+}
+
+TEST(BlockKeysCardinalityEstimatorTest, MultipleKeys) {
+    BlockKeysCardinalityEstimator estimator;
+    auto int_column = ColumnInt32::create();
+    auto nested_column = ColumnString::create();
+    auto null_map = ColumnUInt8::create();
+    for (size_t i = 0; i < 4096; ++i) {
+        int_column->insert_value(i % 8);
+        auto str = std::to_string(i % 64);
+        nested_column->insert_data(str.data(), str.size());
+        null_map->insert_value(i % 64 == 0);
+    }
+    auto string_column = ColumnNullable::create(std::move(nested_column), std::move(null_map));
+
+    // i % 64 decides both keys, so there are 64 distinct keys
+    ColumnRawPtrs key_columns {int_column.get(), string_column.get()};
+    auto estimate = estimator.estimate(key_columns, int_column->size());
+    EXPECT_NEAR(estimate, 64, 64 * 0.1);
+}
+
+} // namespace doris::vectorized
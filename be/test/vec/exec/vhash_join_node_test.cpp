@@ -0,0 +1,435 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/join/vhash_join_node.h"
+
+#include <gen_cpp/Exprs_types.h>
+#include <gen_cpp/Opcodes_types.h>
+#include <gen_cpp/PaloInternalService_types.h>
+#include <gen_cpp/PlanNodes_types.h>
+#include <gtest/gtest-message.h>
+#include <gtest/gtest-test-part.h>
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/config.h"
+#include "common/object_pool.h"
+#include "common/status.h"
+#include "exprs/runtime_filter.h"
+#include "gtest/gtest_pred_impl.h"
+#include "io/fs/local_file_system.h"
+#include "olap/options.h"
+#include "runtime/block_spill_manager.h"
+#include "runtime/descriptor_helper.h"
+#include "runtime/descriptors.h"
+#include "runtime/exec_env.h"
+#include "runtime/memory/mem_tracker_limiter.h"
+#include "runtime/runtime_filter_mgr.h"
+#include "runtime/runtime_state.h"
+#include "runtime/types.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/columns_number.h"
+#include "vec/core/block.h"
+#include "vec/data_types/data_type_nullable.h"
+#include "vec/data_types/data_type_number.h"
+
+namespace doris::vectorized {
+
+static const std::string SPILL_TEST_DIR = "./ut_dir/hash_join_spill_test";
+
+static constexpr TPlanNodeId JOIN_NODE_ID = 0;
+// the scan node of probe side, which is the target of the runtime filter
+static constexpr TPlanNodeId PROBE_SCAN_NODE_ID = 1;
+static constexpr TPlanNodeId BUILD_SCAN_NODE_ID = 2;
+
+// tuples of probe side, build side, output of both sides and output of one side
+static constexpr TTupleId PROBE_TUPLE_ID = 0;
+static constexpr TTupleId BUILD_TUPLE_ID = 1;
+static constexpr TTupleId BOTH_SIDES_TUPLE_ID = 2;
+static constexpr TTupleId ONE_SIDE_TUPLE_ID = 3;
+static constexpr TSlotId PROBE_KEY_SLOT_ID = 0;
+static constexpr TSlotId BUILD_KEY_SLOT_ID = 2;
+
+static constexpr size_t PROBE_ROWS = 4000;
+static constexpr size_t BUILD_ROWS = 3000;
+static constexpr size_t BLOCK_ROWS = 500;
+static constexpr int BATCH_SIZE = 256;
+static constexpr int64_t QUERY_MEM_LIMIT = 1L << 30;
+
+// Probe keys are in [0, 1000) and build keys are in [500, 2000), so both sides have rows which
+// could not be joined. Every build key is repeated twice, and some keys of both sides are null.
+static int32_t probe_key(size_t row) {
+    return row % 97 == 0 ? -1 : row % 1000;
+}
+
+static int32_t build_key(size_t row) {
+    return row % 89 == 0 ? -1 : row * 7 % 1500 + 500;
+}
+
+// Rows [begin, end) of a side, the key of a row is null if `key_of` returns -1.
+static Block create_block(size_t begin, size_t end, int32_t (*key_of)(size_t)) {
+    auto key_column = ColumnNullable::create(ColumnInt32::create(), ColumnUInt8::create());
+    auto value_column = ColumnNullable::create(ColumnInt32::create(), ColumnUInt8::create());
+    for (size_t row = begin; row < end; ++row) {
+        int32_t key = key_of(row);
+        if (key < 0) {
+            key_column->insert_default();
+        } else {
+            key_column->insert_data(reinterpret_cast<const char*>(&key), sizeof(key));
+        }
+        auto value = static_cast<int32_t>(row);
+        value_column->insert_data(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+    auto type = make_nullable(std::make_shared<DataTypeInt32>());
+    return Block({{std::move(key_column), type, "k"}, {std::move(value_column), type, "v"}});
+}
+
+static TExpr create_slot_ref(TSlotId slot_id, TTupleId tuple_id) {
+    TExprNode node;
+    node.__set_node_type(TExprNodeType::SLOT_REF);
+    node.__set_type(create_type_desc(TYPE_INT));
+    node.__set_num_children(0);
+    node.__set_is_nullable(true);
+    TSlotRef slot_ref;
+    slot_ref.__set_slot_id(slot_id);
+    slot_ref.__set_tuple_id(tuple_id);
+    node.__set_slot_ref(slot_ref);
+    TExpr expr;
+    expr.nodes.push_back(node);
+    return expr;
+}
+
+static void wait_for_spill_io(const HashJoinNode& node) {
+    while (node.is_spill_io_running()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+struct JoinOptions {
+    bool enable_join_spill = true;
+    // spill io runs in the spill io thread pool with the pipeline engine
+    bool enable_pipeline_engine = false;
+    int external_join_partition_bits = 4;
+    bool runtime_filter = false;
+    // bytes consumed by the query before the join starts
+    int64_t consumed_bytes = 0;
+};
+
+struct JoinResult {
+    std::vector<std::string> rows;
+    bool spilled = false;
+    bool runtime_filter_ignored = false;
+};
+
+class HashJoinSpillTest : public testing::Test {
+public:
+    static void SetUpTestSuite() {
+        EXPECT_TRUE(
+                io::global_local_filesystem()->delete_and_create_directory(SPILL_TEST_DIR).ok());
+        std::vector<StorePath> paths;
+        paths.emplace_back(SPILL_TEST_DIR, -1);
+        _block_spill_mgr = std::make_unique<BlockSpillManager>(paths);
+        EXPECT_TRUE(_block_spill_mgr->init().ok());
+    }
+
+    static void TearDownTestSuite() {
+        ExecEnv::GetInstance()->_block_spill_mgr = nullptr;
+        _block_spill_mgr.reset();
+        EXPECT_TRUE(io::global_local_filesystem()->delete_directory(SPILL_TEST_DIR).ok());
+    }
+
+protected:
+    void SetUp() override {
+        ExecEnv::GetInstance()->_block_spill_mgr = _block_spill_mgr.get();
+        // spill the build side once its first block is sunk
+        _spill_mem_limit_percent = config::hash_join_spill_mem_limit_percent;
+        config::hash_join_spill_mem_limit_percent = 0;
+
+        TDescriptorTableBuilder builder;
+        for (int num_slots : {2, 2, 4, 2}) {
+            TTupleDescriptorBuilder tuple_builder;
+            for (int i = 0; i < num_slots; ++i) {
+                tuple_builder.add_slot(TSlotDescriptorBuilder()
+                                               .type(TYPE_INT)
+                                               .nullable(true)
+                                               .column_name("c" + std::to_string(i))
+                                               .column_pos(i)
+                                               .build());
+            }
+            tuple_builder.build(&builder);
+        }
+        _desc_tbl = builder.desc_tbl();
+    }
+
+    void TearDown() override {
+        config::hash_join_spill_mem_limit_percent = _spill_mem_limit_percent;
+    }
+
+    static TPlanNode create_join_node(TJoinOp::type join_op, bool runtime_filter) {
+        TEqJoinCondition eq_join_conjunct;
+        eq_join_conjunct.__set_left(create_slot_ref(PROBE_KEY_SLOT_ID, PROBE_TUPLE_ID));
+        eq_join_conjunct.__set_right(create_slot_ref(BUILD_KEY_SLOT_ID, BUILD_TUPLE_ID));
+        eq_join_conjunct.__set_opcode(TExprOpcode::EQ);
+
+        THashJoinNode hash_join_node;
+        hash_join_node.__set_join_op(join_op);
+        hash_join_node.__set_eq_join_conjuncts({eq_join_conjunct});
+        hash_join_node.__set_is_broadcast_join(false);
+        if (join_op == TJoinOp::LEFT_SEMI_JOIN || join_op == TJoinOp::LEFT_ANTI_JOIN) {
+            hash_join_node.__set_vintermediate_tuple_id_list({PROBE_TUPLE_ID});
+            hash_join_node.__set_voutput_tuple_id(ONE_SIDE_TUPLE_ID);
+        } else if (join_op == TJoinOp::RIGHT_SEMI_JOIN || join_op == TJoinOp::RIGHT_ANTI_JOIN) {
+            hash_join_node.__set_vintermediate_tuple_id_list({BUILD_TUPLE_ID});
+            hash_join_node.__set_voutput_tuple_id(ONE_SIDE_TUPLE_ID);
+        } else {
+            hash_join_node.__set_vintermediate_tuple_id_list({PROBE_TUPLE_ID, BUILD_TUPLE_ID});
+            hash_join_node.__set_voutput_tuple_id(BOTH_SIDES_TUPLE_ID);
+        }
+
+        TPlanNode tnode;
+        tnode.__set_node_id(JOIN_NODE_ID);
+        tnode.__set_node_type(TPlanNodeType::HASH_JOIN_NODE);
+        tnode.__set_num_children(2);
+        tnode.__set_limit(-1);
+        tnode.__set_row_tuples({PROBE_TUPLE_ID, BUILD_TUPLE_ID});
+        tnode.__set_nullable_tuples({false, false});
+        tnode.__set_compact_data(false);
+        tnode.__set_hash_join_node(hash_join_node);
+        if (runtime_filter) {
+            TRuntimeFilterDesc desc;
+            desc.__set_filter_id(0);
+            desc.__set_src_expr(create_slot_ref(BUILD_KEY_SLOT_ID, BUILD_TUPLE_ID));
+            desc.__set_expr_order(0);
+            std::map<TPlanNodeId, TExpr> target_exprs = {
+                    {PROBE_SCAN_NODE_ID, create_slot_ref(PROBE_KEY_SLOT_ID, PROBE_TUPLE_ID)}};
+            desc.__set_planId_to_target_expr(target_exprs);
+            desc.__set_is_broadcast_join(false);
+            desc.__set_has_local_targets(true);
+            desc.__set_has_remote_targets(false);
+            desc.__set_type(TRuntimeFilterType::MIN_MAX);
+            tnode.__set_runtime_filters({desc});
+        }
+        return tnode;
+    }
+
+    // The children only provide the row descriptors of both sides, their blocks are sunk and
+    // pushed into the join directly.
+    static TPlanNode create_scan_node(TPlanNodeId node_id, TTupleId tuple_id) {
+        TPlanNode tnode;
+        tnode.__set_node_id(node_id);
+        tnode.__set_node_type(TPlanNodeType::EXCHANGE_NODE);
+        tnode.__set_num_children(0);
+        tnode.__set_limit(-1);
+        tnode.__set_row_tuples({tuple_id});
+        tnode.__set_nullable_tuples({false});
+        tnode.__set_compact_data(false);
+        return tnode;
+    }
+
+    Status run_join(TJoinOp::type join_op, const JoinOptions& options, JoinResult* result) {
+        TQueryOptions query_options;
+        query_options.__set_batch_size(BATCH_SIZE);
+        query_options.__set_enable_join_spill(options.enable_join_spill);
+        query_options.__set_external_join_partition_bits(options.external_join_partition_bits);
+        query_options.__set_enable_pipeline_engine(options.enable_pipeline_engine);
+
+        ObjectPool pool;
+        RuntimeState state(TUniqueId(), query_options, TQueryGlobals(), ExecEnv::GetInstance());
+        auto query_mem_tracker = std::make_shared<MemTrackerLimiter>(
+                MemTrackerLimiter::Type::QUERY, "HashJoinSpillTest", QUERY_MEM_LIMIT);
+        state.set_query_mem_tracker(query_mem_tracker);
+        RETURN_IF_ERROR(state.runtime_filter_mgr()->init());
+        DescriptorTbl* desc_tbl = nullptr;
+        RETURN_IF_ERROR(DescriptorTbl::create(&pool, _desc_tbl, &desc_tbl));
+        state.set_desc_tbl(desc_tbl);
+
+        auto tnode = create_join_node(join_op, options.runtime_filter);
+        HashJoinNode node(&pool, tnode, *desc_tbl);
+        for (auto [node_id, tuple_id] : {std::make_pair(PROBE_SCAN_NODE_ID, PROBE_TUPLE_ID),
+                                         std::make_pair(BUILD_SCAN_NODE_ID, BUILD_TUPLE_ID)}) {
+            auto child_tnode = create_scan_node(node_id, tuple_id);
+            auto* child = pool.add(new ExecNode(&pool, child_tnode, *desc_tbl));
+            RETURN_IF_ERROR(child->init(child_tnode, &state));
+            node._children.push_back(child);
+        }
+        RETURN_IF_ERROR(node.init(tnode, &state));
+        IRuntimeFilter* consumer = nullptr;
+        if (options.runtime_filter) {
+            const auto& desc = tnode.runtime_filters[0];
+            RETURN_IF_ERROR(state.runtime_filter_mgr()->register_consumer_filter(
+                    desc, query_options, PROBE_SCAN_NODE_ID));
+            RETURN_IF_ERROR(state.runtime_filter_mgr()->get_consume_filter(
+                    desc.filter_id, PROBE_SCAN_NODE_ID, &consumer));
+        }
+        RETURN_IF_ERROR(node.prepare(&state));
+        RETURN_IF_ERROR(node.alloc_resource(&state));
+
+        query_mem_tracker->consume(options.consumed_bytes);
+        auto st = _execute(&state, &node, result);
+        wait_for_spill_io(node);
+        query_mem_tracker->release(options.consumed_bytes);
+
+        result->spilled = node.is_spilled();
+        result->runtime_filter_ignored = consumer != nullptr && consumer->_is_ignored;
+        std::sort(result->rows.begin(), result->rows.end());
+        RETURN_IF_ERROR(node.close(&state));
+        return st;
+    }
+
+    // Run the join with and without spill, and compare the results.
+    void check_spilled_join(TJoinOp::type join_op, JoinOptions options) {
+        JoinResult expected;
+        JoinOptions in_memory_options;
+        in_memory_options.enable_join_spill = false;
+        auto st = run_join(join_op, in_memory_options, &expected);
+        ASSERT_TRUE(st.ok()) << st;
+        ASSERT_FALSE(expected.spilled);
+        ASSERT_FALSE(expected.rows.empty());
+
+        for (bool enable_pipeline_engine : {false, true}) {
+            options.enable_pipeline_engine = enable_pipeline_engine;
+            JoinResult result;
+            st = run_join(join_op, options, &result);
+            ASSERT_TRUE(st.ok()) << st;
+            EXPECT_TRUE(result.spilled);
+            EXPECT_EQ(expected.rows, result.rows)
+                    << "join op: " << join_op << ", pipeline: " << enable_pipeline_engine;
+        }
+    }
+
+private:
+    // Sink all the build blocks, then push the probe blocks and pull the joined rows like the
+    // pipeline operators, waiting for the async spill io between the calls.
+    static Status _execute(RuntimeState* state, HashJoinNode* node, JoinResult* result) {
+        for (size_t begin = 0; begin < BUILD_ROWS; begin += BLOCK_ROWS) {
+            auto block = create_block(begin, std::min(begin + BLOCK_ROWS, BUILD_ROWS), build_key);
+            RETURN_IF_ERROR(node->sink(state, &block, false));
+            wait_for_spill_io(*node);
+        }
+        Block eos_block;
+        RETURN_IF_ERROR(node->sink(state, &eos_block, true));
+        wait_for_spill_io(*node);
+
+        size_t probe_begin = 0;
+        bool eos = false;
+        while (!eos) {
+            while (node->need_more_input_data()) {
+                node->prepare_for_next();
+                auto probe_end = std::min(probe_begin + BLOCK_ROWS, PROBE_ROWS);
+                auto block = create_block(probe_begin, probe_end, probe_key);
+                probe_begin = probe_end;
+                RETURN_IF_ERROR(node->push(state, &block, probe_begin == PROBE_ROWS));
+                wait_for_spill_io(*node);
+            }
+            Block output_block;
+            RETURN_IF_ERROR(node->pull(state, &output_block, &eos));
+            wait_for_spill_io(*node);
+            for (size_t row = 0; row < output_block.rows(); ++row) {
+                result->rows.push_back(output_block.dump_one_line(row, output_block.columns()));
+            }
+        }
+        return Status::OK();
+    }
+
+    static std::unique_ptr<BlockSpillManager> _block_spill_mgr;
+    int32_t _spill_mem_limit_percent = 0;
+    TDescriptorTable _desc_tbl;
+};
+
+std::unique_ptr<BlockSpillManager> HashJoinSpillTest::_block_spill_mgr;
+
+TEST_F(HashJoinSpillTest, InnerJoin) {
+    check_spilled_join(TJoinOp::INNER_JOIN, JoinOptions());
+}
+
+TEST_F(HashJoinSpillTest, LeftOuterJoin) {
+    check_spilled_join(TJoinOp::LEFT_OUTER_JOIN, JoinOptions());
+}
+
+TEST_F(HashJoinSpillTest, RightOuterJoin) {
+    check_spilled_join(TJoinOp::RIGHT_OUTER_JOIN, JoinOptions());
+}
+
+TEST_F(HashJoinSpillTest, FullOuterJoin) {
+    check_spilled_join(TJoinOp::FULL_OUTER_JOIN, JoinOptions());
+}
+
+TEST_F(HashJoinSpillTest, SemiJoin) {
+    check_spilled_join(TJoinOp::LEFT_SEMI_JOIN, JoinOptions());
+    check_spilled_join(TJoinOp::RIGHT_SEMI_JOIN, JoinOptions());
+}
+
+TEST_F(HashJoinSpillTest, AntiJoin) {
+    check_spilled_join(TJoinOp::LEFT_ANTI_JOIN, JoinOptions());
+    check_spilled_join(TJoinOp::RIGHT_ANTI_JOIN, JoinOptions());
+}
+
+TEST_F(HashJoinSpillTest, PartitionBits) {
+    for (int bits : {2, 8}) {
+        JoinOptions options;
+        options.external_join_partition_bits = bits;
+        check_spilled_join(TJoinOp::FULL_OUTER_JOIN, options);
+    }
+}
+
+TEST_F(HashJoinSpillTest, NotSpilledWhenDisabled) {
+    JoinOptions options;
+    options.enable_join_spill = false;
+    JoinResult result;
+    auto st = run_join(TJoinOp::INNER_JOIN, options, &result);
+    ASSERT_TRUE(st.ok()) << st;
+    EXPECT_FALSE(result.spilled);
+}
+
+// The runtime filters could not be built from the spilled build side, so their consumers are
+// told to ignore them instead of waiting until timeout.
+TEST_F(HashJoinSpillTest, IgnoreRuntimeFilters) {
+    JoinResult expected;
+    JoinOptions in_memory_options;
+    in_memory_options.enable_join_spill = false;
+    auto st = run_join(TJoinOp::INNER_JOIN, in_memory_options, &expected);
+    ASSERT_TRUE(st.ok()) << st;
+
+    JoinOptions options;
+    options.runtime_filter = true;
+    JoinResult result;
+    st = run_join(TJoinOp::INNER_JOIN, options, &result);
+    ASSERT_TRUE(st.ok()) << st;
+    EXPECT_TRUE(result.spilled);
+    EXPECT_TRUE(result.runtime_filter_ignored);
+    EXPECT_EQ(expected.rows, result.rows);
+}
+
+// A spilled partition is not partitioned again, so the join fails if the build side of it does
+// not fit into the memory limit of query.
+TEST_F(HashJoinSpillTest, SpilledPartitionExceedsMemLimit) {
+    JoinOptions options;
+    options.consumed_bytes = QUERY_MEM_LIMIT + 1;
+    JoinResult result;
+    auto st = run_join(TJoinOp::INNER_JOIN, options, &result);
+    EXPECT_TRUE(result.spilled);
+    EXPECT_TRUE(st.is<ErrorCode::MEM_LIMIT_EXCEEDED>()) << st;
+    EXPECT_NE(st.to_string().find("external_join_partition_bits"), std::string::npos) << st;
+}
+
+} // namespace doris::vectorized
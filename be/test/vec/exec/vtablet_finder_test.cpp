@@ -0,0 +1,390 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/sink/vtablet_finder.h"
+
+#include <fmt/format.h>
+#include <gen_cpp/Descriptors_types.h>
+#include <gen_cpp/Exprs_types.h>
+#include <gtest/gtest-message.h>
+#include <gtest/gtest-test-part.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "exec/tablet_info.h"
+#include "gtest/gtest_pred_impl.h"
+#include "runtime/decimalv2_value.h"
+#include "runtime/descriptor_helper.h"
+#include "runtime/descriptors.h"
+#include "runtime/runtime_state.h"
+#include "vec/core/block.h"
+#include "vec/runtime/vdatetime_value.h"
+
+namespace doris {
+namespace stream_load {
+
+static constexpr int64_t kIndexId = 4;
+
+// the columns of the table, all of them are nullable
+enum ColumnIndex { K_INT = 0, K_DATE, K_DATETIME, K_DATEV2, K_DECIMALV2, K_STRING };
+
+static TTypeDesc scalar_type(TPrimitiveType::type type) {
+    TTypeNode node;
+    node.type = TTypeNodeType::SCALAR;
+    node.__isset.scalar_type = true;
+    node.scalar_type.type = type;
+    TTypeDesc type_desc;
+    type_desc.types.push_back(node);
+    return type_desc;
+}
+
+static TExprNode int_literal(TPrimitiveType::type type, int64_t value) {
+    TExprNode node;
+    node.node_type = TExprNodeType::INT_LITERAL;
+    node.type = scalar_type(type);
+    node.num_children = 0;
+    TIntLiteral literal;
+    literal.value = value;
+    node.__set_int_literal(literal);
+    return node;
+}
+
+static TExprNode date_literal(TPrimitiveType::type type, const std::string& value) {
+    TExprNode node;
+    node.node_type = TExprNodeType::DATE_LITERAL;
+    node.type = scalar_type(type);
+    node.num_children = 0;
+    TDateLiteral literal;
+    literal.value = value;
+    node.__set_date_literal(literal);
+    return node;
+}
+
+static TExprNode string_literal(const std::string& value) {
+    TExprNode node;
+    node.node_type = TExprNodeType::STRING_LITERAL;
+    node.type = scalar_type(TPrimitiveType::VARCHAR);
+    node.num_children = 0;
+    TStringLiteral literal;
+    literal.value = value;
+    node.__set_string_literal(literal);
+    return node;
+}
+
+static TOlapTablePartition make_partition(int64_t id, int num_buckets) {
+    TOlapTablePartition partition;
+    partition.id = id;
+    partition.num_buckets = num_buckets;
+    partition.indexes.resize(1);
+    partition.indexes[0].index_id = kIndexId;
+    for (int i = 0; i < num_buckets; ++i) {
+        partition.indexes[0].tablets.push_back(id * 100 + i);
+    }
+    return partition;
+}
+
+static TOlapTablePartition make_range_partition(int64_t id, int num_buckets,
+                                                const std::vector<TExprNode>& start_keys,
+                                                const std::vector<TExprNode>& end_keys) {
+    auto partition = make_partition(id, num_buckets);
+    if (!start_keys.empty()) {
+        partition.__set_start_keys(start_keys);
+    }
+    if (!end_keys.empty()) {
+        partition.__set_end_keys(end_keys);
+    }
+    return partition;
+}
+
+static TOlapTablePartition make_list_partition(int64_t id, int num_buckets,
+                                               const std::vector<TExprNode>& values) {
+    auto partition = make_partition(id, num_buckets);
+    std::vector<std::vector<TExprNode>> in_keys;
+    for (const auto& value : values) {
+        in_keys.push_back({value});
+    }
+    partition.__set_in_keys(in_keys);
+    return partition;
+}
+
+class VOlapTabletFinderTest : public testing::Test {
+public:
+    void SetUp() override {
+        TDescriptorTableBuilder dtb;
+        TTupleDescriptorBuilder tuple_builder;
+        tuple_builder.add_slot(
+                TSlotDescriptorBuilder().type(TYPE_INT).column_name("k_int").column_pos(0).build());
+        tuple_builder.add_slot(TSlotDescriptorBuilder()
+                                       .type(TYPE_DATE)
+                                       .column_name("k_date")
+                                       .column_pos(1)
+                                       .build());
+        tuple_builder.add_slot(TSlotDescriptorBuilder()
+                                       .type(TYPE_DATETIME)
+                                       .column_name("k_datetime")
+                                       .column_pos(2)
+                                       .build());
+        tuple_builder.add_slot(TSlotDescriptorBuilder()
+                                       .type(TYPE_DATEV2)
+                                       .column_name("k_datev2")
+                                       .column_pos(3)
+                                       .build());
+        tuple_builder.add_slot(TSlotDescriptorBuilder()
+                                       .decimal_type(27, 9)
+                                       .column_name("k_decimalv2")
+                                       .column_pos(4)
+                                       .build());
+        tuple_builder.add_slot(TSlotDescriptorBuilder()
+                                       .string_type(32)
+                                       .column_name("k_string")
+                                       .column_pos(5)
+                                       .build());
+        tuple_builder.build(&dtb);
+        TDescriptorTable desc_tbl = dtb.desc_tbl();
+
+        TOlapTableSchemaParam tschema;
+        tschema.db_id = 1;
+        tschema.table_id = 2;
+        tschema.version = 0;
+        tschema.slot_descs = desc_tbl.slotDescriptors;
+        tschema.tuple_desc = desc_tbl.tupleDescriptors[0];
+        tschema.indexes.resize(1);
+        tschema.indexes[0].id = kIndexId;
+        for (const auto& slot_desc : desc_tbl.slotDescriptors) {
+            tschema.indexes[0].columns.push_back(slot_desc.colName);
+        }
+        _schema = std::make_shared<OlapTableSchemaParam>();
+        ASSERT_TRUE(_schema->init(tschema).ok());
+    }
+
+protected:
+    std::unique_ptr<VOlapTablePartitionParam> create_partition_param(
+            const std::vector<std::string>& partition_columns,
+            const std::vector<std::string>& distributed_columns,
+            const std::vector<TOlapTablePartition>& partitions) {
+        TOlapTablePartitionParam tpartition;
+        tpartition.db_id = 1;
+        tpartition.table_id = 2;
+        tpartition.version = 0;
+        tpartition.__set_partition_columns(partition_columns);
+        if (!distributed_columns.empty()) {
+            tpartition.__set_distributed_columns(distributed_columns);
+        }
+        tpartition.partitions = partitions;
+        auto vpartition = std::make_unique<VOlapTablePartitionParam>(_schema, tpartition);
+        auto st = vpartition->init();
+        EXPECT_TRUE(st.ok()) << st;
+        return vpartition;
+    }
+
+    // Rows with pseudo random values. About one value in 17 of each column is null.
+    vectorized::Block create_block(size_t num_rows) {
+        vectorized::Block block;
+        for (const auto* slot_desc : _schema->tuple_desc()->slots()) {
+            block.insert({slot_desc->get_empty_mutable_column(), slot_desc->get_data_type_ptr(),
+                          slot_desc->col_name()});
+        }
+        auto columns = block.mutate_columns();
+        uint64_t seed = 42;
+        auto next = [&seed](uint64_t bound) {
+            seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+            return (seed >> 33) % bound;
+        };
+        for (size_t row = 0; row < num_rows; ++row) {
+            int32_t int_value = static_cast<int32_t>(next(500)) - 50;
+            std::string date_str =
+                    fmt::format("2023-{:02d}-{:02d}", next(12) + 1, next(28) + 1);
+            std::string datetime_str = fmt::format("{} {:02d}:30:00", date_str, next(24));
+            vectorized::VecDateTimeValue date_value;
+            date_value.from_date_str(date_str.data(), date_str.size());
+            date_value.cast_to_date();
+            vectorized::VecDateTimeValue datetime_value;
+            datetime_value.from_date_str(datetime_str.data(), datetime_str.size());
+            datetime_value.to_datetime();
+            vectorized::DateV2Value<vectorized::DateV2ValueType> datev2_value;
+            datev2_value.from_date_str(date_str.data(), date_str.size());
+            DecimalV2Value decimal_value(static_cast<int64_t>(next(1000)) - 500,
+                                         static_cast<int64_t>(next(1000000000)));
+            std::string string_value = fmt::format("s{}", next(50));
+
+            const char* values[] = {reinterpret_cast<const char*>(&int_value),
+                                    reinterpret_cast<const char*>(&date_value),
+                                    reinterpret_cast<const char*>(&datetime_value),
+                                    reinterpret_cast<const char*>(&datev2_value),
+                                    reinterpret_cast<const char*>(&decimal_value),
+                                    string_value.data()};
+            for (size_t col = 0; col < columns.size(); ++col) {
+                if ((row + col * 5) % 17 == 0) {
+                    columns[col]->insert_data(nullptr, 0);
+                } else {
+                    columns[col]->insert_data(values[col],
+                                              col == K_STRING ? string_value.size() : 0);
+                }
+            }
+        }
+        block.set_columns(std::move(columns));
+        return block;
+    }
+
+    // Route the rows in batch and row by row, and check the results are the same.
+    // The tablet of each row is compared as well if `same_tablets' is true, the tablets of
+    // random distribution are chosen at random.
+    void check_batch_matches_rows(VOlapTablePartitionParam* vpartition,
+                                  OlapTabletFinder::FindTabletMode mode, bool same_tablets) {
+        const size_t num_rows = 4096;
+        auto block = create_block(num_rows);
+        RuntimeState state;
+        OlapTabletFinder batch_finder(vpartition, mode);
+        OlapTabletFinder row_finder(vpartition, mode);
+
+        std::vector<const VOlapTablePartition*> partitions;
+        std::vector<uint32_t> tablet_indexes;
+        bool stop_processing = false;
+        ASSERT_TRUE(batch_finder
+                            .find_tablets(&state, &block, num_rows, nullptr, partitions,
+                                          tablet_indexes, stop_processing)
+                            .ok());
+        ASSERT_FALSE(stop_processing);
+        ASSERT_EQ(num_rows, partitions.size());
+        ASSERT_EQ(num_rows, tablet_indexes.size());
+
+        size_t num_routed_rows = 0;
+        std::map<int64_t, uint32_t> partition_to_tablet;
+        for (size_t row = 0; row < num_rows; ++row) {
+            const VOlapTablePartition* partition = nullptr;
+            uint32_t tablet_index = 0;
+            bool is_continue = false;
+            ASSERT_TRUE(row_finder
+                                .find_tablet(&state, &block, row, &partition, tablet_index,
+                                             stop_processing, is_continue)
+                                .ok());
+            if (is_continue) {
+                EXPECT_EQ(nullptr, partitions[row]) << "row " << row;
+                continue;
+            }
+            ASSERT_EQ(partition, partitions[row]) << "row " << row;
+            ASSERT_LT(tablet_indexes[row], partition->num_buckets);
+            if (same_tablets) {
+                EXPECT_EQ(tablet_index, tablet_indexes[row]) << "row " << row;
+            } else if (mode != OlapTabletFinder::FIND_TABLET_EVERY_ROW) {
+                // all rows of a partition go to one tablet
+                auto it = partition_to_tablet.emplace(partition->id, tablet_indexes[row]).first;
+                EXPECT_EQ(it->second, tablet_indexes[row]) << "row " << row;
+            }
+            num_routed_rows++;
+        }
+        EXPECT_GT(num_routed_rows, 0);
+        EXPECT_EQ(row_finder.num_filtered_rows(), batch_finder.num_filtered_rows());
+        EXPECT_EQ(row_finder.num_immutable_partition_filtered_rows(),
+                  batch_finder.num_immutable_partition_filtered_rows());
+        EXPECT_EQ(row_finder.partition_ids(), batch_finder.partition_ids());
+    }
+
+    std::shared_ptr<OlapTableSchemaParam> _schema;
+};
+
+static const std::vector<std::string> kAllColumns = {"k_int",     "k_date",      "k_datetime",
+                                                      "k_datev2",  "k_decimalv2", "k_string"};
+
+// Partitioned by one integer column, the partitions are found by binary search on the column.
+TEST_F(VOlapTabletFinderTest, int_range_partition) {
+    auto int_key = [](int64_t value) { return int_literal(TPrimitiveType::INT, value); };
+    auto immutable_partition = make_range_partition(13, 3, {int_key(100)}, {int_key(200)});
+    immutable_partition.__set_is_mutable(false);
+    // there is a hole of [200, 300), the last partition has no end key
+    auto vpartition = create_partition_param(
+            {"k_int"}, kAllColumns,
+            {make_range_partition(11, 3, {}, {int_key(0)}),
+             make_range_partition(12, 5, {int_key(0)}, {int_key(100)}), immutable_partition,
+             make_range_partition(14, 7, {int_key(300)}, {})});
+    check_batch_matches_rows(vpartition.get(), OlapTabletFinder::FIND_TABLET_EVERY_ROW, true);
+}
+
+TEST_F(VOlapTabletFinderTest, datev2_range_partition) {
+    auto date_key = [](const std::string& value) {
+        return date_literal(TPrimitiveType::DATEV2, value);
+    };
+    auto vpartition = create_partition_param(
+            {"k_datev2"}, {"k_decimalv2", "k_int"},
+            {make_range_partition(11, 2, {}, {date_key("2023-03-01")}),
+             make_range_partition(12, 4, {date_key("2023-03-01")}, {date_key("2023-07-15")}),
+             make_range_partition(13, 3, {date_key("2023-09-01")}, {date_key("2024-01-01")})});
+    check_batch_matches_rows(vpartition.get(), OlapTabletFinder::FIND_TABLET_EVERY_ROW, true);
+}
+
+// Partitioned by DATE and DATETIME, the partitions are found row by row by the comparator.
+TEST_F(VOlapTabletFinderTest, date_range_partition) {
+    auto date_key = [](const std::string& value) {
+        return date_literal(TPrimitiveType::DATE, value);
+    };
+    auto vpartition = create_partition_param(
+            {"k_date"}, {"k_date", "k_datetime"},
+            {make_range_partition(11, 2, {}, {date_key("2023-04-01")}),
+             make_range_partition(12, 4, {date_key("2023-04-01")}, {date_key("2023-10-01")})});
+    check_batch_matches_rows(vpartition.get(), OlapTabletFinder::FIND_TABLET_EVERY_ROW, true);
+
+    auto datetime_key = [](const std::string& value) {
+        return date_literal(TPrimitiveType::DATETIME, value);
+    };
+    vpartition = create_partition_param(
+            {"k_datetime"}, {"k_string", "k_decimalv2"},
+            {make_range_partition(11, 3, {}, {datetime_key("2023-06-15 12:00:00")}),
+             make_range_partition(12, 5, {datetime_key("2023-06-15 12:00:00")}, {})});
+    check_batch_matches_rows(vpartition.get(), OlapTabletFinder::FIND_TABLET_EVERY_ROW, true);
+}
+
+TEST_F(VOlapTabletFinderTest, list_partition) {
+    auto int_key = [](int64_t value) { return int_literal(TPrimitiveType::INT, value); };
+    std::vector<TExprNode> small_values;
+    std::vector<TExprNode> large_values;
+    for (int i = 0; i < 100; ++i) {
+        small_values.push_back(int_key(i));
+        large_values.push_back(int_key(i + 200));
+    }
+    auto vpartition = create_partition_param({"k_int"}, kAllColumns,
+                                             {make_list_partition(11, 3, small_values),
+                                              make_list_partition(12, 4, large_values)});
+    check_batch_matches_rows(vpartition.get(), OlapTabletFinder::FIND_TABLET_EVERY_ROW, true);
+
+    // the rows of the strings not listed go to the default partition
+    auto default_partition = make_list_partition(13, 2, {});
+    default_partition.__set_is_default_partition(true);
+    vpartition = create_partition_param(
+            {"k_string"}, {"k_int", "k_datev2"},
+            {make_list_partition(11, 3, {string_literal("s1"), string_literal("s2")}),
+             make_list_partition(12, 4, {string_literal("s10"), string_literal("s20")}),
+             default_partition});
+    check_batch_matches_rows(vpartition.get(), OlapTabletFinder::FIND_TABLET_EVERY_ROW, true);
+}
+
+TEST_F(VOlapTabletFinderTest, random_distribution) {
+    auto int_key = [](int64_t value) { return int_literal(TPrimitiveType::INT, value); };
+    auto vpartition = create_partition_param(
+            {"k_int"}, {},
+            {make_range_partition(11, 3, {}, {int_key(0)}),
+             make_range_partition(12, 5, {int_key(0)}, {int_key(250)}),
+             make_range_partition(13, 7, {int_key(250)}, {})});
+    check_batch_matches_rows(vpartition.get(), OlapTabletFinder::FIND_TABLET_EVERY_BATCH, false);
+    check_batch_matches_rows(vpartition.get(), OlapTabletFinder::FIND_TABLET_EVERY_SINK, false);
+    check_batch_matches_rows(vpartition.get(), OlapTabletFinder::FIND_TABLET_EVERY_ROW, false);
+}
+
+} // namespace stream_load
+} // namespace doris
@@ -61,6 +61,18 @@ TEST(FunctionLikeTest, like) {
                         {{std::string("abc"), std::string("_a_")}, uint8_t(0)},
                         {{std::string("abc"), std::string("a__")}, uint8_t(1)},
                         {{std::string("abc"), std::string("a_")}, uint8_t(0)},
+                        // multiple literals
+                        {{std::string("db error: timeout"), std::string("%error%timeout%")},
+                         uint8_t(1)},
+                        {{std::string("timeout error"), std::string("%error%timeout%")},
+                         uint8_t(0)},
+                        {{std::string("errortimeout"), std::string("%error%timeout%")}, uint8_t(1)},
+                        {{std::string("abab"), std::string("%ab%ab%")}, uint8_t(1)},
+                        {{std::string("aba"), std::string("%ab%ab%")}, uint8_t(0)},
+                        {{std::string("a%b x"), std::string("%a\\%b%x%")}, uint8_t(1)},
+                        {{std::string("ab x"), std::string("%a\\%b%x%")}, uint8_t(0)},
+                        {{std::string("xab_cd"), std::string("%ab_cd")}, uint8_t(1)},
+                        {{std::string("xabcde"), std::string("%ab_cd")}, uint8_t(0)},
                         // null
                         {{std::string("abc"), Null()}, Null()},
                         {{Null(), std::string("_x__ab%")}, Null()}};
@@ -97,6 +109,17 @@ TEST(FunctionLikeTest, regexp) {
                         {{std::string("abc"), std::string(".c")}, uint8_t(1)},
                         {{std::string("abc"), std::string(".b.")}, uint8_t(1)},
                         {{std::string("abc"), std::string(".a.")}, uint8_t(0)},
+                        // required literals
+                        {{std::string("error 500: timeout"), std::string("error [0-9]+.*timeout")},
+                         uint8_t(1)},
+                        {{std::string("error x: timeout"), std::string("error [0-9]+.*timeout")},
+                         uint8_t(0)},
+                        {{std::string("colr"), std::string("colou?r")}, uint8_t(1)},
+                        {{std::string("color"), std::string("colou?r")}, uint8_t(1)},
+                        {{std::string("a.b"), std::string("a\\.b+c?")}, uint8_t(1)},
+                        {{std::string("axb"), std::string("a\\.b+c?")}, uint8_t(0)},
+                        {{std::string("abd"), std::string("ab(c|d)")}, uint8_t(1)},
+                        {{std::string("xyz"), std::string("abc|xyz")}, uint8_t(1)},
                         // null
                         {{std::string("abc"), Null()}, Null()},
                         {{Null(), std::string("xxx.*")}, Null()}};
@@ -61,6 +61,7 @@
 #include "olap/tablet_meta.h"
 #include "olap/tablet_schema.h"
 #include "olap/utils.h"
+#include "util/threadpool.h"
 #include "util/uid_util.h"
 #include "vec/columns/column.h"
 #include "vec/core/block.h"
@@ -1069,5 +1070,131 @@ TEST_F(VerticalCompactionTest, TestAggKeyVerticalMerge) {
     }
 }
 
+TEST_F(VerticalCompactionTest, TestParallelValueGroupsVerticalMerge) {
+    const int num_value_columns = 4;
+    const int num_input_rowset = 2;
+    const int num_segments = 2;
+    const int rows_per_segment = 10000;
+    TabletSchemaSPtr tablet_schema = std::make_shared<TabletSchema>();
+    TabletSchemaPB tablet_schema_pb;
+    tablet_schema_pb.set_keys_type(DUP_KEYS);
+    tablet_schema_pb.set_num_short_key_columns(1);
+    tablet_schema_pb.set_num_rows_per_row_block(1024);
+    tablet_schema_pb.set_compress_kind(COMPRESS_NONE);
+    tablet_schema_pb.set_next_column_unique_id(num_value_columns + 2);
+    for (int i = 0; i <= num_value_columns; ++i) {
+        ColumnPB* column = tablet_schema_pb.add_column();
+        column->set_unique_id(i + 1);
+        column->set_name("c" + std::to_string(i + 1));
+        column->set_type("INT");
+        column->set_is_key(i == 0);
+        column->set_length(4);
+        column->set_index_length(4);
+        column->set_is_nullable(false);
+        column->set_is_bf_column(false);
+    }
+    tablet_schema->init_from_pb(tablet_schema_pb);
+    TabletSharedPtr tablet = create_tablet(*tablet_schema, false, 0, false);
+
+    // keys of the rowsets and segments interleave, values tell the rowset apart
+    std::vector<RowsetSharedPtr> input_rowsets;
+    for (int rs = 0; rs < num_input_rowset; ++rs) {
+        RowsetWriterContext writer_context;
+        create_rowset_writer_context(tablet_schema, OVERLAPPING, UINT32_MAX, &writer_context);
+        std::unique_ptr<RowsetWriter> rowset_writer;
+        EXPECT_TRUE(
+                RowsetFactory::create_rowset_writer(writer_context, false, &rowset_writer).ok());
+        for (int seg = 0; seg < num_segments; ++seg) {
+            vectorized::Block block = tablet_schema->create_block();
+            auto columns = block.mutate_columns();
+            for (int n = 0; n < rows_per_segment; ++n) {
+                int32_t key = n * num_input_rowset * num_segments + rs * num_segments + seg;
+                for (int i = 0; i <= num_value_columns; ++i) {
+                    int32_t value = i == 0 ? key : key * 10 + i + rs;
+                    columns[i]->insert_data((const char*)&value, sizeof(value));
+                }
+            }
+            EXPECT_TRUE(rowset_writer->add_block(&block).ok());
+            EXPECT_TRUE(rowset_writer->flush().ok());
+        }
+        input_rowsets.push_back(rowset_writer->build());
+    }
+
+    auto compact = [&](std::vector<std::vector<int32_t>>* output_data) {
+        std::vector<RowsetReaderSharedPtr> input_rs_readers;
+        for (auto& rowset : input_rowsets) {
+            RowsetReaderSharedPtr rs_reader;
+            EXPECT_TRUE(rowset->create_reader(&rs_reader).ok());
+            input_rs_readers.push_back(std::move(rs_reader));
+        }
+        RowsetWriterContext writer_context;
+        create_rowset_writer_context(tablet_schema, NONOVERLAPPING, 3456, &writer_context);
+        std::unique_ptr<RowsetWriter> output_rs_writer;
+        EXPECT_TRUE(RowsetFactory::create_rowset_writer(writer_context, true, &output_rs_writer)
+                            .ok());
+        Merger::Statistics stats;
+        EXPECT_TRUE(Merger::vertical_merge_rowsets(tablet, ReaderType::READER_BASE_COMPACTION,
+                                                   tablet_schema, input_rs_readers,
+                                                   output_rs_writer.get(), 3456, &stats)
+                            .ok());
+        RowsetSharedPtr out_rowset = output_rs_writer->build();
+        EXPECT_TRUE(out_rowset != nullptr);
+
+        RowsetReaderContext reader_context;
+        reader_context.tablet_schema = tablet_schema;
+        reader_context.need_ordered_result = false;
+        std::vector<uint32_t> return_columns;
+        for (uint32_t i = 0; i <= num_value_columns; ++i) {
+            return_columns.push_back(i);
+        }
+        reader_context.return_columns = &return_columns;
+        RowsetReaderSharedPtr output_rs_reader;
+        create_and_init_rowset_reader(out_rowset.get(), reader_context, &output_rs_reader);
+        vectorized::Block output_block;
+        Status s;
+        do {
+            block_create(tablet_schema, &output_block);
+            s = output_rs_reader->next_block(&output_block);
+            for (auto i = 0; i < output_block.rows(); i++) {
+                std::vector<int32_t> row;
+                for (auto& column : output_block.get_columns_with_type_and_name()) {
+                    row.push_back(column.column->get_int(i));
+                }
+                output_data->push_back(std::move(row));
+            }
+        } while (s.ok());
+        EXPECT_EQ(Status::Error<END_OF_FILE>(""), s);
+    };
+
+    // one column per group, so there are several value groups to compact in parallel
+    config::vertical_compaction_num_columns_per_group = 1;
+    std::vector<std::vector<int32_t>> serial_output;
+    compact(&serial_output);
+
+    config::vertical_compaction_parallel_group_threads = 2;
+    EXPECT_TRUE(ThreadPoolBuilder("VerticalCompactionGroupThreadPool")
+                        .set_min_threads(2)
+                        .set_max_threads(2)
+                        .build(&k_engine->_vertical_compaction_thread_pool)
+                        .ok());
+    std::vector<std::vector<int32_t>> parallel_output;
+    compact(&parallel_output);
+    k_engine->_vertical_compaction_thread_pool->shutdown();
+    k_engine->_vertical_compaction_thread_pool.reset();
+    config::vertical_compaction_parallel_group_threads = 0;
+    config::vertical_compaction_num_columns_per_group = 5;
+
+    int num_rows = num_input_rowset * num_segments * rows_per_segment;
+    EXPECT_EQ(num_rows, serial_output.size());
+    EXPECT_EQ(serial_output, parallel_output);
+    for (int32_t key = 0; key < std::min<int>(num_rows, serial_output.size()); ++key) {
+        int rs = key % (num_input_rowset * num_segments) / num_segments;
+        EXPECT_EQ(key, serial_output[key][0]);
+        for (int i = 1; i <= num_value_columns; ++i) {
+            EXPECT_EQ(key * 10 + i + rs, serial_output[key][i]);
+        }
+    }
+}
+
 } // namespace vectorized
 } // namespace doris
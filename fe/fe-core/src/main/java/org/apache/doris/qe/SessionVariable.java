@@ -102,6 +102,7 @@ public class SessionVariable implements Serializable, Writable {
     public static final int MIN_EXEC_MEM_LIMIT = 2097152;
     public static final String BATCH_SIZE = "batch_size";
     public static final String DISABLE_STREAMING_PREAGGREGATIONS = "disable_streaming_preaggregations";
+    public static final String ENABLE_ADAPTIVE_PREAGGREGATION = "enable_adaptive_preaggregation";
     public static final String DISABLE_COLOCATE_PLAN = "disable_colocate_plan";
     public static final String ENABLE_COLOCATE_SCAN = "enable_colocate_scan";
     public static final String ENABLE_BUCKET_SHUFFLE_JOIN = "enable_bucket_shuffle_join";
@@ -307,6 +308,8 @@ public class SessionVariable implements Serializable, Writable {
     public static final String EXTERNAL_SORT_BYTES_THRESHOLD = "external_sort_bytes_threshold";
     public static final String EXTERNAL_AGG_BYTES_THRESHOLD = "external_agg_bytes_threshold";
     public static final String EXTERNAL_AGG_PARTITION_BITS = "external_agg_partition_bits";
+    public static final String ENABLE_JOIN_SPILL = "enable_join_spill";
+    public static final String EXTERNAL_JOIN_PARTITION_BITS = "external_join_partition_bits";
 
     public static final String ENABLE_TWO_PHASE_READ_OPT = "enable_two_phase_read_opt";
     public static final String TOPN_OPT_LIMIT_THRESHOLD = "topn_opt_limit_threshold";
@@ -548,6 +551,11 @@ public class SessionVariable implements Serializable, Writable {
     @VariableMgr.VarAttr(name = DISABLE_STREAMING_PREAGGREGATIONS, fuzzy = true)
     public boolean disableStreamPreaggregations = false;
 
+    // If enabled, streaming pre-aggregation estimates the distinct keys of each input block
+    // and passes the block through without aggregating when it could not be reduced enough.
+    @VariableMgr.VarAttr(name = ENABLE_ADAPTIVE_PREAGGREGATION, fuzzy = true)
+    public boolean enableAdaptivePreaggregation = false;
+
     @VariableMgr.VarAttr(name = DISABLE_COLOCATE_PLAN)
     public boolean disableColocatePlan = false;
 
@@ -963,6 +971,19 @@ public class SessionVariable implements Serializable, Writable {
             checker = "checkExternalAggPartitionBits", fuzzy = true)
     public int externalAggPartitionBits = 8; // means that the hash table will be partitioned into 256 blocks.
 
+    // If enabled, hash join will partition its build side and probe side into spill files
+    // once the memory usage of the query is close to the query memory limit.
+    @VariableMgr.VarAttr(name = ENABLE_JOIN_SPILL)
+    public boolean enableJoinSpill = false;
+
+    // Each partition of a spilled hash join keeps a spill file of the build side and one of the
+    // probe side open, so the partition count is bounded tighter than the one of aggregation.
+    public static final int MIN_EXTERNAL_JOIN_PARTITION_BITS = 2;
+    public static final int MAX_EXTERNAL_JOIN_PARTITION_BITS = 8;
+    @VariableMgr.VarAttr(name = EXTERNAL_JOIN_PARTITION_BITS,
+            checker = "checkExternalJoinPartitionBits")
+    public int externalJoinPartitionBits = 4; // means that the join data will be partitioned into 16 files.
+
     // Whether enable two phase read optimization
     // 1. read related rowids along with necessary column data
     // 2. spawn fetch RPC to other nodes to get related data by sorted rowids
@@ -1113,6 +1134,7 @@ public class SessionVariable implements Serializable, Writable {
         // This will cause be dead loop, disable it first
         // this.disableJoinReorder = random.nextBoolean();
         this.disableStreamPreaggregations = random.nextBoolean();
+        this.enableAdaptivePreaggregation = random.nextBoolean();
         this.partitionedHashJoinRowsThreshold = random.nextBoolean() ? 8 : 1048576;
         this.partitionedHashAggRowsThreshold = random.nextBoolean() ? 8 : 1048576;
         this.enableShareHashTableForBroadcastJoin = random.nextBoolean();
@@ -2041,6 +2063,16 @@ public class SessionVariable implements Serializable, Writable {
         }
     }
 
+    public void checkExternalJoinPartitionBits(String externalJoinPartitionBits) {
+        int value = Integer.valueOf(externalJoinPartitionBits);
+        if (value < MIN_EXTERNAL_JOIN_PARTITION_BITS || value > MAX_EXTERNAL_JOIN_PARTITION_BITS) {
+            LOG.warn("external join partition bits: {}, min: {}, max: {}",
+                    value, MIN_EXTERNAL_JOIN_PARTITION_BITS, MAX_EXTERNAL_JOIN_PARTITION_BITS);
+            throw new UnsupportedOperationException("external_join_partition_bits: min value is "
+                    + MIN_EXTERNAL_JOIN_PARTITION_BITS + " max value is " + MAX_EXTERNAL_JOIN_PARTITION_BITS);
+        }
+    }
+
     public boolean isEnableFileCache() {
         return enableFileCache;
     }
@@ -2119,6 +2151,7 @@ public class SessionVariable implements Serializable, Writable {
 
         tResult.setBatchSize(batchSize);
         tResult.setDisableStreamPreaggregations(disableStreamPreaggregations);
+        tResult.setEnableAdaptivePreaggregation(enableAdaptivePreaggregation);
 
         if (maxScanKeyNum > -1) {
             tResult.setMaxScanKeyNum(maxScanKeyNum);
@@ -2162,6 +2195,10 @@ public class SessionVariable implements Serializable, Writable {
 
         tResult.setExternalAggPartitionBits(externalAggPartitionBits);
 
+        tResult.setEnableJoinSpill(enableJoinSpill);
+
+        tResult.setExternalJoinPartitionBits(externalJoinPartitionBits);
+
         tResult.setEnableFileCache(enableFileCache);
 
         tResult.setFileCacheBasePath(fileCacheBasePath);
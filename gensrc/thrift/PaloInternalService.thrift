@@ -229,6 +229,16 @@ struct TQueryOptions {
   76: optional bool enable_inverted_index_query = true;
 
   77: optional bool truncate_char_or_varchar_columns = false
+
+  // spill build side and probe side of hash join into disk when the query memory is running out
+  78: optional bool enable_join_spill = false
+
+  // partition count(1 << external_join_partition_bits) when spill hash join data into disk
+  79: optional i32 external_join_partition_bits = 4
+
+  // decide whether to aggregate or pass through each input block of streaming pre-aggregation
+  // by the estimated distinct keys of the block
+  80: optional bool enable_adaptive_preaggregation = false
 }
 
 
@@ -0,0 +1,100 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+// The blocks sent to the tablets on the same BE are handed to the load channel without rpc
+// when enable_local_tablet_writer_add_block is on. The loaded data must be the same as the
+// data loaded by rpc.
+suite("test_insert_local_tablet_writer") {
+    def backendId_to_backendIP = [:]
+    def backendId_to_backendHttpPort = [:]
+    getBackendIpHttpPort(backendId_to_backendIP, backendId_to_backendHttpPort)
+    def set_local_add_block = { enable ->
+        for (String backendId in backendId_to_backendIP.keySet()) {
+            String be_host = backendId_to_backendIP[backendId]
+            String be_http_port = backendId_to_backendHttpPort[backendId]
+            curl("POST", "http://${be_host}:${be_http_port}/api/update_config?enable_local_tablet_writer_add_block=${enable}")
+        }
+    }
+
+    def create_tables = { suffix ->
+        sql "drop table if exists test_local_writer_dup_${suffix}"
+        sql """ create table test_local_writer_dup_${suffix} (
+            k1 int, k2 bigint, v1 varchar(32), v2 decimal(27, 9)
+        ) duplicate key(k1, k2)
+        partition by range(k1) (
+            partition p1 values less than ("5000"),
+            partition p2 values less than ("10000"),
+            partition p3 values less than maxvalue
+        )
+        distributed by hash(k2) buckets 4 properties("replication_num"="1");
+        """
+        sql "drop table if exists test_local_writer_uniq_${suffix}"
+        sql """ create table test_local_writer_uniq_${suffix} (
+            k1 int, v1 varchar(32), v2 bigint
+        ) unique key(k1)
+        distributed by hash(k1) buckets 3 properties("replication_num"="1");
+        """
+    }
+
+    def load = { suffix ->
+        sql """ insert into test_local_writer_dup_${suffix}
+            select number, number % 77, if(number % 13 = 0, null, concat('v', number)),
+                number / 7
+            from numbers("number" = "15000");
+        """
+        sql """ insert into test_local_writer_uniq_${suffix}
+            select number, concat('v', number), number
+            from numbers("number" = "3000");
+        """
+        // the second load replaces the rows of half of the keys
+        sql """ insert into test_local_writer_uniq_${suffix}
+            select number * 2, concat('w', number), number * 10
+            from numbers("number" = "1500");
+        """
+    }
+
+    def queries = [
+        "select count(*), count(v1), sum(k2), sum(v2) from test_local_writer_dup_{}",
+        "select * from test_local_writer_dup_{} where k1 % 1000 = 7 order by k1, k2",
+        "select count(*), sum(v2), max(v1) from test_local_writer_uniq_{}",
+        "select * from test_local_writer_uniq_{} where k1 % 250 < 2 order by k1"
+    ]
+
+    // small blocks, so that each node channel sends many blocks before eos
+    sql "set batch_size = 256"
+    create_tables("rpc")
+    create_tables("local")
+    set_local_add_block(false)
+    load("rpc")
+    set_local_add_block(true)
+    try {
+        load("local")
+    } finally {
+        set_local_add_block(false)
+    }
+
+    for (String query in queries) {
+        assertEquals(sql(query.replace("{}", "rpc")), sql(query.replace("{}", "local")))
+    }
+    assertEquals(15000L, sql("select count(*) from test_local_writer_dup_local")[0][0])
+    assertEquals(3000L, sql("select count(*) from test_local_writer_uniq_local")[0][0])
+
+    for (String suffix in ["rpc", "local"]) {
+        sql "drop table if exists test_local_writer_dup_${suffix}"
+        sql "drop table if exists test_local_writer_uniq_${suffix}"
+    }
+}
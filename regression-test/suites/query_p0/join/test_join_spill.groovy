@@ -0,0 +1,98 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+suite("test_join_spill", "query,p0") {
+    def leftTable = "test_join_spill_l"
+    def rightTable = "test_join_spill_r"
+
+    sql "drop table if exists ${leftTable}"
+    sql "drop table if exists ${rightTable}"
+    sql """ create table ${leftTable} (
+        k1 int, v1 int
+    ) distributed by hash(v1) buckets 3 properties("replication_num"="1");
+    """
+    sql """ create table ${rightTable} (
+        k1 int, v1 varchar(32)
+    ) distributed by hash(k1) buckets 3 properties("replication_num"="1");
+    """
+    // the join keys of some rows are null, and some keys only exist in one side
+    sql """ insert into ${leftTable}
+        select if(number % 97 = 0, null, number % 15000), number
+        from numbers("number" = "20000");
+    """
+    sql """ insert into ${rightTable}
+        select if(number % 89 = 0, null, number + 5000), concat('v', number)
+        from numbers("number" = "20000");
+    """
+
+    def queries = [
+        """ select count(*), count(l.k1), count(r.k1), sum(l.v1), max(r.v1)
+            from ${leftTable} l join [shuffle] ${rightTable} r on l.k1 = r.k1 """,
+        """ select count(*), count(l.k1), count(r.k1), sum(l.v1), max(r.v1)
+            from ${leftTable} l left join [shuffle] ${rightTable} r on l.k1 = r.k1 """,
+        """ select count(*), count(l.k1), count(r.k1), sum(l.v1), max(r.v1)
+            from ${leftTable} l right join [shuffle] ${rightTable} r on l.k1 = r.k1 """,
+        """ select count(*), count(l.k1), count(r.k1), sum(l.v1), max(r.v1)
+            from ${leftTable} l full join [shuffle] ${rightTable} r on l.k1 = r.k1 """,
+        """ select count(*), sum(l.v1)
+            from ${leftTable} l left semi join [shuffle] ${rightTable} r on l.k1 = r.k1 """,
+        """ select count(*), sum(l.v1)
+            from ${leftTable} l left anti join [shuffle] ${rightTable} r on l.k1 = r.k1 """,
+        """ select count(*), max(r.v1)
+            from ${leftTable} l right semi join [shuffle] ${rightTable} r on l.k1 = r.k1 """,
+        """ select count(*), max(r.v1)
+            from ${leftTable} l right anti join [shuffle] ${rightTable} r on l.k1 = r.k1 """,
+        """ select l.k1, l.v1, r.v1
+            from ${leftTable} l join [shuffle] ${rightTable} r
+            on l.k1 = r.k1 and l.v1 > 10000 and r.v1 like 'v1%'
+            order by l.k1, l.v1, r.v1 limit 100 """
+    ]
+
+    sql "set enable_join_spill = false"
+    def expected_results = queries.collect { sql it }
+
+    def backendId_to_backendIP = [:]
+    def backendId_to_backendHttpPort = [:]
+    getBackendIpHttpPort(backendId_to_backendIP, backendId_to_backendHttpPort)
+    def set_spill_mem_limit_percent = { percent ->
+        for (String backendId in backendId_to_backendIP.keySet()) {
+            String be_host = backendId_to_backendIP[backendId]
+            String be_http_port = backendId_to_backendHttpPort[backendId]
+            curl("POST", "http://${be_host}:${be_http_port}/api/update_config?hash_join_spill_mem_limit_percent=${percent}")
+        }
+    }
+
+    // any memory consumption of the query spills the build side once it has more than one block
+    set_spill_mem_limit_percent(0)
+    try {
+        sql "set enable_join_spill = true"
+        sql "set external_join_partition_bits = 4"
+        sql "set batch_size = 1024"
+        for (def enable_pipeline in [true, false]) {
+            sql "set enable_pipeline_engine = ${enable_pipeline}"
+            queries.eachWithIndex { query, i ->
+                assertEquals(expected_results[i], sql(query))
+            }
+        }
+    } finally {
+        set_spill_mem_limit_percent(80)
+        sql "set enable_join_spill = false"
+    }
+
+    sql "drop table if exists ${leftTable}"
+    sql "drop table if exists ${rightTable}"
+}